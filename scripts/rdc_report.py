@@ -0,0 +1,60 @@
+# Compare muda builds with and without relocatable device code (MUDA_WITH_RDC):
+# wall clock build time of the benchmark target, and the spawn/dynamic
+# parallelism benchmark of each build.
+#
+# usage: python scripts/rdc_report.py [--config Release] [--jobs 8]
+
+import argparse
+import os
+import subprocess
+import sys
+import time
+
+root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+
+def build(rdc, config, jobs):
+    build_dir = os.path.join(root, 'build_rdc_' + ('on' if rdc else 'off'))
+    subprocess.check_call(['cmake', '-S', root, '-B', build_dir,
+                           '-DMUDA_BUILD_TEST=ON',
+                           '-DMUDA_BUILD_EXAMPLE=OFF',
+                           '-DMUDA_WITH_RDC=' + ('ON' if rdc else 'OFF'),
+                           '-DCMAKE_BUILD_TYPE=' + config])
+    # a clean rebuild, so the time covers every translation unit and the device link
+    begin = time.time()
+    subprocess.check_call(['cmake', '--build', build_dir, '--config', config,
+                           '--target', 'muda_benchmark', '--clean-first',
+                           '-j', str(jobs)])
+    return build_dir, time.time() - begin
+
+
+def find_binary(build_dir, config):
+    for sub in ['test', os.path.join('test', config)]:
+        for name in ['muda_benchmark', 'muda_benchmark.exe']:
+            path = os.path.join(build_dir, sub, name)
+            if os.path.exists(path):
+                return path
+    sys.exit('muda_benchmark not found in ' + build_dir)
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--config', default='Release')
+    parser.add_argument('--jobs', type=int, default=os.cpu_count())
+    args = parser.parse_args()
+
+    times = {}
+    for rdc in [True, False]:
+        build_dir, seconds = build(rdc, args.config, args.jobs)
+        times[rdc] = seconds
+        print('\n==== MUDA_WITH_RDC=%s ====' % ('ON' if rdc else 'OFF'))
+        subprocess.check_call([find_binary(build_dir, args.config),
+                               'spawn_launch_benchmark'])
+
+    print('\n==== build time (muda_benchmark, clean) ====')
+    for rdc in [True, False]:
+        print('MUDA_WITH_RDC=%-3s %8.1f s' % ('ON' if rdc else 'OFF', times[rdc]))
+
+
+if __name__ == '__main__':
+    main()
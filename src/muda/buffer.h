@@ -5,4 +5,6 @@
 #include <muda/buffer/buffer_view.h>
 #include <muda/buffer/graph_buffer_view.h>
 #include <muda/buffer/var_view.h>
-#include <muda/buffer/graph_var_view.h>
\ No newline at end of file
+#include <muda/buffer/graph_var_view.h>
+#include <muda/buffer/device_append_buffer.h>
+#include <muda/buffer/virtual_buffer.h>
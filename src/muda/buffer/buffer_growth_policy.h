@@ -0,0 +1,129 @@
+/*****************************************************************/ /**
+ * \file   buffer_growth_policy.h
+ * \brief  How a device buffer picks its new capacity when a resize
+ * exceeds the current one. Pure host logic.
+ *********************************************************************/
+#pragma once
+#include <cstddef>
+#include <algorithm>
+#include <muda/muda_def.h>
+#include <muda/tools/extent.h>
+
+namespace muda
+{
+enum class BufferGrowth
+{
+    // capacity = required size, the default, no memory is wasted
+    Exact,
+    // capacity = max(required size, capacity * factor), amortized O(1) growth
+    Geometric,
+    // capacity = required bytes rounded up to a multiple of the page size
+    PageRounded,
+};
+
+/**
+ * \class BufferGrowthPolicy
+ *
+ * \brief Capacity growth policy of `DeviceBuffer`, `DeviceBuffer2D` and `DeviceBuffer3D`.
+ *
+ * Only used when a resize exceeds the capacity, `reserve()` is always exact.
+ *
+ * \code
+ *  DeviceBuffer<int> buffer;
+ *  buffer.growth_policy(BufferGrowthPolicy::geometric(1.5));
+ *  // or only for some launches
+ *  BufferLaunch().growth_policy(BufferGrowthPolicy::page_rounded()).resize(buffer, n);
+ * \endcode
+ */
+class BufferGrowthPolicy
+{
+    BufferGrowth m_kind       = BufferGrowth::Exact;
+    double       m_factor     = 2.0;
+    size_t       m_page_bytes = 2 * 1024 * 1024;
+
+  public:
+    constexpr BufferGrowthPolicy() = default;
+    constexpr BufferGrowthPolicy(BufferGrowth kind, double factor, size_t page_bytes)
+        : m_kind(kind)
+        , m_factor(factor)
+        , m_page_bytes(page_bytes)
+    {
+    }
+
+    static constexpr BufferGrowthPolicy exact() { return {}; }
+    // factor should be > 1, 1.5 ~ 2 is common
+    static constexpr BufferGrowthPolicy geometric(double factor = 2.0)
+    {
+        return {BufferGrowth::Geometric, factor, 2 * 1024 * 1024};
+    }
+    // 2MB is the allocation granularity of cudaMalloc on most devices
+    static constexpr BufferGrowthPolicy page_rounded(size_t page_bytes = 2 * 1024 * 1024)
+    {
+        return {BufferGrowth::PageRounded, 2.0, page_bytes};
+    }
+
+    constexpr auto kind() const { return m_kind; }
+    constexpr auto factor() const { return m_factor; }
+    constexpr auto page_bytes() const { return m_page_bytes; }
+
+    /**
+     * \brief The new capacity (in elements) to hold `required` elements.
+     *
+     * \param capacity current capacity in elements
+     * \param required required size in elements, > capacity
+     * \param element_bytes size of one element
+     */
+    MUDA_INLINE MUDA_HOST size_t grow(size_t capacity, size_t required, size_t element_bytes) const
+    {
+        if(required <= capacity)
+            return capacity;
+
+        switch(m_kind)
+        {
+            case BufferGrowth::Geometric: {
+                auto grown = static_cast<size_t>(static_cast<double>(capacity) * m_factor);
+                return std::max(required, grown);
+            }
+            case BufferGrowth::PageRounded: {
+                if(element_bytes == 0 || m_page_bytes == 0)
+                    return required;
+                auto bytes   = required * element_bytes;
+                auto rounded = (bytes + m_page_bytes - 1) / m_page_bytes * m_page_bytes;
+                return std::max(required, rounded / element_bytes);
+            }
+            case BufferGrowth::Exact:
+            default:
+                return required;
+        }
+    }
+
+    // 2D: each dimension grows on its own, a row counts as one element of the height
+    MUDA_INLINE MUDA_HOST Extent2D grow(Extent2D capacity, Extent2D required, size_t element_bytes) const
+    {
+        auto width = grow(capacity.width(), std::max(required.width(), capacity.width()), element_bytes);
+        auto height = grow(capacity.height(),
+                           std::max(required.height(), capacity.height()),
+                           width * element_bytes);
+        return Extent2D{height, width};
+    }
+
+    // 3D: each dimension grows on its own, a row/slice counts as one element of the height/depth
+    MUDA_INLINE MUDA_HOST Extent3D grow(Extent3D capacity, Extent3D required, size_t element_bytes) const
+    {
+        auto width = grow(capacity.width(), std::max(required.width(), capacity.width()), element_bytes);
+        auto height = grow(capacity.height(),
+                           std::max(required.height(), capacity.height()),
+                           width * element_bytes);
+        auto depth = grow(capacity.depth(),
+                          std::max(required.depth(), capacity.depth()),
+                          height * width * element_bytes);
+        return Extent3D{depth, height, width};
+    }
+
+    // policy used by `append`: never exact, so that appending is amortized O(1)
+    MUDA_INLINE MUDA_HOST BufferGrowthPolicy for_append() const
+    {
+        return m_kind == BufferGrowth::Exact ? geometric() : *this;
+    }
+};
+}  // namespace muda
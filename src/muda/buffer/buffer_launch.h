@@ -2,6 +2,8 @@
 #include <muda/launch/launch_base.h>
 #include <muda/muda_config.h>
 #include <muda/tools/extent.h>
+#include <optional>
+#include <muda/buffer/buffer_growth_policy.h>
 
 namespace muda
 {
@@ -37,6 +39,8 @@ class BufferLaunch : public LaunchBase<BufferLaunch>
 {
     int m_grid_dim  = 0;
     int m_block_dim = -1;  // we use automatic block dim choose as default.
+    // overrides the growth policy of the buffers resized by this launch
+    std::optional<BufferGrowthPolicy> m_growth;
 
   public:
     // default config
@@ -57,6 +61,13 @@ class BufferLaunch : public LaunchBase<BufferLaunch>
     {
     }
 
+    // use this growth policy instead of the buffer's own for the following resizes
+    MUDA_HOST BufferLaunch& growth_policy(const BufferGrowthPolicy& policy) MUDA_NOEXCEPT
+    {
+        m_growth = policy;
+        return *this;
+    }
+
     /**********************************************************************************************
     * 
     * Buffer API
@@ -89,6 +100,13 @@ class BufferLaunch : public LaunchBase<BufferLaunch>
     MUDA_HOST BufferLaunch& resize(DeviceBuffer3D<T>& buffer, Extent3D extent, const T& val);
 
 
+    // append to the end of the buffer, capacity grows geometrically even if the growth policy is exact
+    template <typename T>
+    MUDA_HOST BufferLaunch& append(DeviceBuffer<T>& buffer, CBufferView<T> src);
+    template <typename T>
+    MUDA_HOST BufferLaunch& append(DeviceBuffer<T>& buffer, const T* host, size_t count);
+
+
     template <typename T>
     MUDA_HOST BufferLaunch& clear(DeviceBuffer<T>& buffer);
     template <typename T>
@@ -247,6 +265,12 @@ class BufferLaunch : public LaunchBase<BufferLaunch>
                                  const ComputeGraphVar<T>&         val);
 
   private:
+    template <typename Buffer>
+    MUDA_HOST BufferGrowthPolicy growth_policy_of(const Buffer& buffer) const
+    {
+        return m_growth.value_or(buffer.growth_policy());
+    }
+
     template <typename T, typename FConstruct>
     MUDA_HOST BufferLaunch& resize(DeviceBuffer<T>& buffer, size_t new_size, FConstruct&& fct);
 
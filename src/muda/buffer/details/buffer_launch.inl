@@ -142,6 +142,42 @@ MUDA_HOST BufferLaunch& BufferLaunch::resize(DeviceBuffer3D<T>& buffer,
     return resize(buffer, extent, [&](Buffer3DView<T> view) { fill(view, val); });
 }
 
+template <typename T>
+MUDA_HOST BufferLaunch& BufferLaunch::append(DeviceBuffer<T>& buffer, CBufferView<T> src)
+{
+    MUDA_ASSERT(ComputeGraphBuilder::is_direct_launching(),
+                "cannot append to a buffer in a compute graph");
+    // src may alias the buffer, the old memory is freed only after the construction
+    NDReshaper::resize(m_grid_dim,
+                       m_block_dim,
+                       m_stream,
+                       buffer,
+                       buffer.size() + src.size(),
+                       [&](BufferView<T> view)  // copy construct
+                       {
+                           details::buffer::kernel_copy_construct<T>(
+                               m_grid_dim, m_block_dim, m_stream, view, src);
+                       },
+                       growth_policy_of(buffer).for_append());
+    return *this;
+}
+
+template <typename T>
+MUDA_HOST BufferLaunch& BufferLaunch::append(DeviceBuffer<T>& buffer, const T* host, size_t count)
+{
+    MUDA_ASSERT(ComputeGraphBuilder::is_direct_launching(),
+                "cannot append to a buffer in a compute graph");
+    NDReshaper::resize(m_grid_dim,
+                       m_block_dim,
+                       m_stream,
+                       buffer,
+                       buffer.size() + count,
+                       [&](BufferView<T> view)  // copy from host
+                       { copy(view, host); },
+                       growth_policy_of(buffer).for_append());
+    return *this;
+}
+
 template <typename T>
 MUDA_HOST BufferLaunch& BufferLaunch::clear(DeviceBuffer<T>& buffer)
 {
@@ -635,7 +671,8 @@ MUDA_HOST BufferLaunch& BufferLaunch::resize(DeviceBuffer<T>& buffer, size_t new
     MUDA_ASSERT(ComputeGraphBuilder::is_direct_launching(),
                 "cannot resize a buffer in a compute graph");
     NDReshaper::resize(
-        m_grid_dim, m_block_dim, m_stream, buffer, new_size, std::forward<FConstruct>(fct));
+        m_grid_dim, m_block_dim, m_stream, buffer, new_size, std::forward<FConstruct>(fct),
+        growth_policy_of(buffer));
     return *this;
 }
 
@@ -647,7 +684,8 @@ MUDA_HOST BufferLaunch& BufferLaunch::resize(DeviceBuffer2D<T>& buffer,
     MUDA_ASSERT(ComputeGraphBuilder::is_direct_launching(),
                 "cannot resize a buffer in a compute graph");
     NDReshaper::resize(
-        m_grid_dim, m_block_dim, m_stream, buffer, new_extent, std::forward<FConstruct>(fct));
+        m_grid_dim, m_block_dim, m_stream, buffer, new_extent, std::forward<FConstruct>(fct),
+        growth_policy_of(buffer));
     return *this;
 }
 //using T          = float;
@@ -661,7 +699,8 @@ MUDA_HOST BufferLaunch& BufferLaunch::resize(DeviceBuffer3D<T>& buffer,
                 "cannot resize a buffer in a compute graph");
 
     NDReshaper::resize(
-        m_grid_dim, m_block_dim, m_stream, buffer, new_extent, std::forward<FConstruct>(fct));
+        m_grid_dim, m_block_dim, m_stream, buffer, new_extent, std::forward<FConstruct>(fct),
+        growth_policy_of(buffer));
     return *this;
 }
 }  // namespace muda
\ No newline at end of file
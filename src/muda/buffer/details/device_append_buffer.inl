@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <muda/buffer/buffer_launch.h>
+
+namespace muda
+{
+template <typename T>
+DeviceAppendBuffer<T>::DeviceAppendBuffer(size_t capacity_hint)
+    : m_data(capacity_hint)
+    , m_count(0)
+{
+}
+
+template <typename T>
+size_t DeviceAppendBuffer<T>::required_size() const
+{
+    int count = m_count;
+    return static_cast<size_t>(count);
+}
+
+template <typename T>
+size_t DeviceAppendBuffer<T>::size() const
+{
+    return std::min(required_size(), capacity());
+}
+
+template <typename T>
+void DeviceAppendBuffer<T>::reserve(size_t capacity)
+{
+    if(capacity > this->capacity())
+        m_data.resize(capacity);
+}
+
+template <typename T>
+void DeviceAppendBuffer<T>::clear()
+{
+    m_count = 0;
+}
+
+template <typename T>
+AppendBufferViewer<T> DeviceAppendBuffer<T>::viewer() MUDA_NOEXCEPT
+{
+    return AppendBufferViewer<T>{
+        m_data.data(), m_count.data(), static_cast<int>(m_data.size())};
+}
+
+template <typename T>
+template <typename F>
+size_t DeviceAppendBuffer<T>::retry_if_overflow(F&& f)
+{
+    auto begin = size();
+    f();
+    auto required = required_size();
+    if(required > capacity())
+    {
+        reserve(std::max(required, 2 * capacity()));
+        m_count = static_cast<int>(begin);
+        f();
+        required = required_size();
+        MUDA_ASSERT(required <= capacity(),
+                    "DeviceAppendBuffer: the rerun needs more space (%lld) than the first run (capacity=%lld), "
+                    "the appending kernels must be deterministic in count",
+                    (long long)required,
+                    (long long)capacity());
+    }
+    return required;
+}
+
+template <typename T>
+BufferView<T> DeviceAppendBuffer<T>::view()
+{
+    return m_data.view(0, size());
+}
+
+template <typename T>
+CBufferView<T> DeviceAppendBuffer<T>::view() const
+{
+    return m_data.view(0, size());
+}
+
+template <typename T>
+void DeviceAppendBuffer<T>::copy_to(std::vector<T>& host) const
+{
+    host.resize(size());
+    view().copy_to(host.data());
+}
+}  // namespace muda
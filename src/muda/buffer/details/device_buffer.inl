@@ -26,13 +26,15 @@ DeviceBuffer<T>::DeviceBuffer(const DeviceBuffer<T>& other)
         .alloc(*this, other.size())  //
         .copy(view(), other.view())  //
         .wait();
+    m_growth = other.m_growth;
 }
 
 template <typename T>
 DeviceBuffer<T>::DeviceBuffer(DeviceBuffer<T>&& other) MUDA_NOEXCEPT
     : m_data(other.m_data),
       m_size(other.m_size),
-      m_capacity(other.m_capacity)
+      m_capacity(other.m_capacity),
+      m_growth(other.m_growth)
 {
     other.m_data     = nullptr;
     other.m_size     = 0;
@@ -45,6 +47,8 @@ DeviceBuffer<T>& DeviceBuffer<T>::operator=(const DeviceBuffer<T>& other)
     if(this == &other)
         return *this;
 
+    // like the copy constructor, the copy takes the growth policy too
+    m_growth = other.m_growth;
     BufferLaunch()
         .resize(*this, other.size())  //
         .copy(view(), other.view())   //
@@ -69,6 +73,7 @@ DeviceBuffer<T>& DeviceBuffer<T>::operator=(DeviceBuffer<T>&& other)
     m_data     = other.m_data;
     m_size     = other.m_size;
     m_capacity = other.m_capacity;
+    m_growth   = other.m_growth;
 
     other.m_data     = nullptr;
     other.m_size     = 0;
@@ -175,6 +180,22 @@ void DeviceBuffer<T>::fill(const T& v)
     view().fill(v);
 };
 
+template <typename T>
+void DeviceBuffer<T>::append(CBufferView<T> other)
+{
+    BufferLaunch()
+        .append(*this, other)  //
+        .wait();
+}
+
+template <typename T>
+void DeviceBuffer<T>::append(const std::vector<T>& host)
+{
+    BufferLaunch()
+        .append(*this, host.data(), host.size())  //
+        .wait();
+}
+
 template <typename T>
 Dense1D<T> DeviceBuffer<T>::viewer() MUDA_NOEXCEPT
 {
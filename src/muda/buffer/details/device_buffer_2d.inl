@@ -26,6 +26,7 @@ DeviceBuffer2D<T>::DeviceBuffer2D(const DeviceBuffer2D<T>& other)
         .resize(*this, other.extent())  //
         .copy(view(), other.view())     //
         .wait();
+    m_growth = other.m_growth;
 }
 
 template <typename T>
@@ -33,7 +34,8 @@ DeviceBuffer2D<T>::DeviceBuffer2D(DeviceBuffer2D<T>&& other) MUDA_NOEXCEPT
     : m_data(other.m_data),
       m_pitch_bytes(other.m_pitch_bytes),
       m_extent(other.m_extent),
-      m_capacity(other.m_capacity)
+      m_capacity(other.m_capacity),
+      m_growth(other.m_growth)
 {
     other.m_data        = nullptr;
     other.m_pitch_bytes = 0;
@@ -47,6 +49,8 @@ DeviceBuffer2D<T>& DeviceBuffer2D<T>::operator=(const DeviceBuffer2D<T>& other)
     if(this == &other)
         return *this;
 
+    // like the copy constructor, the copy takes the growth policy too
+    m_growth = other.m_growth;
     BufferLaunch()
         .resize(*this, other.extent())  //
         .copy(view(), other.view())     //
@@ -68,6 +72,7 @@ DeviceBuffer2D<T>& DeviceBuffer2D<T>::operator=(DeviceBuffer2D<T>&& other)
     m_pitch_bytes = other.m_pitch_bytes;
     m_extent      = other.m_extent;
     m_capacity    = other.m_capacity;
+    m_growth      = other.m_growth;
 
     other.m_data        = nullptr;
     other.m_pitch_bytes = 0;
@@ -27,6 +27,7 @@ DeviceBuffer3D<T>::DeviceBuffer3D(const DeviceBuffer3D<T>& other)
         .resize(*this, other.extent())  //
         .copy(view(), other.view())    //
         .wait();
+    m_growth = other.m_growth;
 }
 
 template <typename T>
@@ -35,7 +36,8 @@ DeviceBuffer3D<T>::DeviceBuffer3D(DeviceBuffer3D<T>&& other) MUDA_NOEXCEPT
       m_pitch_bytes(other.m_pitch_bytes),
       m_pitch_bytes_area(other.m_pitch_bytes_area),
       m_extent(other.m_extent),
-      m_capacity(other.m_capacity)
+      m_capacity(other.m_capacity),
+      m_growth(other.m_growth)
 {
     other.m_data             = nullptr;
     other.m_pitch_bytes      = 0;
@@ -50,6 +52,8 @@ DeviceBuffer3D<T>& DeviceBuffer3D<T>::operator=(const DeviceBuffer3D<T>& other)
     if(this == &other)
         return *this;
 
+    // like the copy constructor, the copy takes the growth policy too
+    m_growth = other.m_growth;
     BufferLaunch()
         .resize(*this, other.extent())  //
         .copy(view(), other.view())     //
@@ -72,6 +76,7 @@ DeviceBuffer3D<T>& DeviceBuffer3D<T>::operator=(DeviceBuffer3D<T>&& other)
     m_pitch_bytes_area = other.m_pitch_bytes_area;
     m_extent           = other.m_extent;
     m_capacity         = other.m_capacity;
+    m_growth           = other.m_growth;
 
     other.m_data             = nullptr;
     other.m_pitch_bytes      = 0;
@@ -0,0 +1,234 @@
+#include <algorithm>
+#include <memory>
+#include <muda/launch/memory.h>
+#include <muda/buffer/buffer_launch.h>
+
+namespace muda
+{
+template <typename T>
+VirtualBuffer<T>::VirtualBuffer(size_t max_size, VirtualMemoryBackend backend)
+    : m_memory(max_size * sizeof(T), backend)
+{
+}
+
+template <typename T>
+VirtualBuffer<T>::VirtualBuffer(VirtualBuffer&& other) MUDA_NOEXCEPT
+    : m_memory(std::move(other.m_memory)),
+      m_size(other.m_size),
+      m_growth(other.m_growth)
+{
+    other.m_size = 0;
+}
+
+template <typename T>
+VirtualBuffer<T>& VirtualBuffer<T>::operator=(VirtualBuffer&& other)
+{
+    if(this == &other)
+        return *this;
+
+    clear();
+    m_memory = std::move(other.m_memory);
+    m_size   = other.m_size;
+    m_growth = other.m_growth;
+
+    other.m_size = 0;
+    return *this;
+}
+
+template <typename T>
+void VirtualBuffer<T>::construct(size_t begin, size_t end)
+{
+    if(begin >= end)
+        return;
+
+    if(is_host())
+    {
+        std::uninitialized_value_construct(data() + begin, data() + end);
+        return;
+    }
+
+    BufferView<T> to_construct{data(), begin, end - begin};
+    if constexpr(std::is_trivially_constructible_v<T>)
+    {
+        Memory().set(to_construct.data(), to_construct.size() * sizeof(T), 0).wait();
+    }
+    else
+    {
+        static_assert(std::is_constructible_v<T>,
+                      "The type T must be constructible, which means T must have a 0-arg constructor");
+        details::buffer::kernel_construct(0, 256, nullptr, to_construct);
+        checkCudaErrors(cudaStreamSynchronize(nullptr));
+    }
+}
+
+template <typename T>
+void VirtualBuffer<T>::destruct(size_t begin, size_t end)
+{
+    if(begin >= end)
+        return;
+
+    if(is_host())
+    {
+        std::destroy(data() + begin, data() + end);
+        return;
+    }
+
+    details::buffer::kernel_destruct(0, 256, nullptr, BufferView<T>{data(), begin, end - begin});
+    checkCudaErrors(cudaStreamSynchronize(nullptr));
+}
+
+template <typename T>
+void VirtualBuffer<T>::resize(size_t new_size)
+{
+    if(new_size == m_size)
+        return;
+
+    if(new_size < m_size)
+    {
+        destruct(new_size, m_size);
+        m_size = new_size;
+        return;
+    }
+
+    // new pages are mapped behind the old ones, nothing is moved
+    reserve(new_size);
+    construct(m_size, new_size);
+    m_size = new_size;
+}
+
+template <typename T>
+void VirtualBuffer<T>::resize(size_t new_size, const T& value)
+{
+    auto old_size = m_size;
+    resize(new_size);
+    if(new_size <= old_size)
+        return;
+
+    if(is_host())
+        std::fill(data() + old_size, data() + new_size, value);
+    else
+        view(old_size, new_size - old_size).fill(value);
+}
+
+template <typename T>
+void VirtualBuffer<T>::reserve(size_t new_capacity)
+{
+    m_memory.commit(new_capacity * sizeof(T), m_growth);
+}
+
+template <typename T>
+void VirtualBuffer<T>::clear()
+{
+    resize(0);
+}
+
+template <typename T>
+void VirtualBuffer<T>::shrink_to_fit()
+{
+    m_memory.decommit(m_size * sizeof(T));
+}
+
+template <typename T>
+void VirtualBuffer<T>::fill(const T& v)
+{
+    if(is_host())
+        std::fill(data(), data() + m_size, v);
+    else
+        view().fill(v);
+}
+
+template <typename T>
+void VirtualBuffer<T>::append(CBufferView<T> other)
+{
+    if(other.size() == 0)
+        return;
+
+    auto old_size = m_size;
+    m_memory.commit((old_size + other.size()) * sizeof(T), m_growth.for_append());
+    m_size = old_size + other.size();
+
+    if(is_host())
+        std::uninitialized_copy(other.data(), other.data() + other.size(), data() + old_size);
+    else
+        BufferLaunch().copy(view(old_size, other.size()), other).wait();
+}
+
+template <typename T>
+void VirtualBuffer<T>::append(const std::vector<T>& host)
+{
+    if(host.empty())
+        return;
+
+    auto old_size = m_size;
+    m_memory.commit((old_size + host.size()) * sizeof(T), m_growth.for_append());
+    m_size = old_size + host.size();
+
+    if(is_host())
+        std::uninitialized_copy(host.begin(), host.end(), data() + old_size);
+    else
+        view(old_size, host.size()).copy_from(host.data());
+}
+
+template <typename T>
+void VirtualBuffer<T>::copy_to(std::vector<T>& host) const
+{
+    host.resize(m_size);
+    if(is_host())
+        std::copy(data(), data() + m_size, host.begin());
+    else
+        view().copy_to(host.data());
+}
+
+template <typename T>
+void VirtualBuffer<T>::copy_from(const std::vector<T>& host)
+{
+    resize(host.size());
+    if(is_host())
+        std::copy(host.begin(), host.end(), data());
+    else
+        view().copy_from(host.data());
+}
+
+template <typename T>
+Dense1D<T> VirtualBuffer<T>::viewer() MUDA_NOEXCEPT
+{
+    return view().viewer();
+}
+
+template <typename T>
+CDense1D<T> VirtualBuffer<T>::cviewer() const MUDA_NOEXCEPT
+{
+    return view().cviewer();
+}
+
+template <typename T>
+BufferView<T> VirtualBuffer<T>::view(size_t offset, size_t size) MUDA_NOEXCEPT
+{
+    return view().subview(offset, size);
+}
+
+template <typename T>
+BufferView<T> VirtualBuffer<T>::view() MUDA_NOEXCEPT
+{
+    return BufferView<T>{data(), 0, m_size};
+}
+
+template <typename T>
+CBufferView<T> VirtualBuffer<T>::view(size_t offset, size_t size) const MUDA_NOEXCEPT
+{
+    return view().subview(offset, size);
+}
+
+template <typename T>
+CBufferView<T> VirtualBuffer<T>::view() const MUDA_NOEXCEPT
+{
+    return CBufferView<T>{data(), 0, m_size};
+}
+
+template <typename T>
+VirtualBuffer<T>::~VirtualBuffer()
+{
+    if(data())
+        clear();
+}
+}  // namespace muda
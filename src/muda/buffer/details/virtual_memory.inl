@@ -0,0 +1,336 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <cuda.h>
+#include <muda/tools/platform.h>
+#include <muda/check/check_cuda_errors.h>
+#include <muda/tools/debug_log.h>
+
+#if defined(MUDA_PLATFORM_WINDOWS)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace muda
+{
+namespace details::virtual_memory
+{
+    /*************************************************************************
+    * Host: reserve with no access, commit by enabling read/write
+    *************************************************************************/
+
+    MUDA_INLINE size_t host_granularity()
+    {
+#if defined(MUDA_PLATFORM_WINDOWS)
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return info.dwPageSize;
+#else
+        return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+    }
+
+    MUDA_INLINE std::byte* host_reserve(size_t bytes)
+    {
+#if defined(MUDA_PLATFORM_WINDOWS)
+        auto ptr = VirtualAlloc(nullptr, bytes, MEM_RESERVE, PAGE_NOACCESS);
+        if(!ptr)
+            throw runtime_error("VirtualAlloc(MEM_RESERVE) failed, error="
+                                + std::to_string(GetLastError()));
+#else
+        auto ptr = mmap(nullptr, bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if(ptr == MAP_FAILED)
+            throw runtime_error(std::string{"mmap reserve failed: "} + std::strerror(errno));
+#endif
+        return reinterpret_cast<std::byte*>(ptr);
+    }
+
+    MUDA_INLINE void host_commit(std::byte* ptr, size_t bytes)
+    {
+#if defined(MUDA_PLATFORM_WINDOWS)
+        if(!VirtualAlloc(ptr, bytes, MEM_COMMIT, PAGE_READWRITE))
+            throw runtime_error("VirtualAlloc(MEM_COMMIT) failed, error="
+                                + std::to_string(GetLastError()));
+#else
+        if(mprotect(ptr, bytes, PROT_READ | PROT_WRITE) != 0)
+            throw runtime_error(std::string{"mprotect commit failed: "} + std::strerror(errno));
+#endif
+    }
+
+    MUDA_INLINE void host_decommit(std::byte* ptr, size_t bytes)
+    {
+#if defined(MUDA_PLATFORM_WINDOWS)
+        VirtualFree(ptr, bytes, MEM_DECOMMIT);
+#else
+        // drop the pages, then forbid access again
+        madvise(ptr, bytes, MADV_DONTNEED);
+        mprotect(ptr, bytes, PROT_NONE);
+#endif
+    }
+
+    MUDA_INLINE void host_release(std::byte* ptr, size_t bytes)
+    {
+#if defined(MUDA_PLATFORM_WINDOWS)
+        VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+        munmap(ptr, bytes);
+#endif
+    }
+
+    /*************************************************************************
+    * Device: CUDA virtual memory management
+    *************************************************************************/
+
+    MUDA_INLINE CUmemAllocationProp device_allocation_prop(int device)
+    {
+        CUmemAllocationProp prop{};
+        prop.type          = CU_MEM_ALLOCATION_TYPE_PINNED;
+        prop.location.type = CU_MEM_LOCATION_TYPE_DEVICE;
+        prop.location.id   = device;
+        return prop;
+    }
+
+    MUDA_INLINE int device_current()
+    {
+        // make sure the primary context exists before using the driver api
+        checkCudaErrors(cudaFree(nullptr));
+        int device = 0;
+        checkCudaErrors(cudaGetDevice(&device));
+
+        int supported = 0;
+        checkCudaErrors(cuDeviceGetAttribute(
+            &supported, CU_DEVICE_ATTRIBUTE_VIRTUAL_MEMORY_MANAGEMENT_SUPPORTED, device));
+        if(!supported)
+            throw not_implemented("device " + std::to_string(device)
+                                  + " doesn't support virtual memory management");
+        return device;
+    }
+
+    MUDA_INLINE size_t device_granularity(int device)
+    {
+        auto   prop        = device_allocation_prop(device);
+        size_t granularity = 0;
+        checkCudaErrors(cuMemGetAllocationGranularity(
+            &granularity, &prop, CU_MEM_ALLOC_GRANULARITY_RECOMMENDED));
+        return granularity;
+    }
+
+    MUDA_INLINE std::byte* device_reserve(size_t bytes, size_t granularity)
+    {
+        CUdeviceptr ptr = 0;
+        checkCudaErrors(cuMemAddressReserve(&ptr, bytes, granularity, 0, 0));
+        return reinterpret_cast<std::byte*>(ptr);
+    }
+
+    MUDA_INLINE unsigned long long device_commit(int device, std::byte* ptr, size_t bytes)
+    {
+        auto prop = device_allocation_prop(device);
+
+        CUmemGenericAllocationHandle handle;
+        checkCudaErrors(cuMemCreate(&handle, bytes, &prop, 0));
+
+        auto     dptr   = reinterpret_cast<CUdeviceptr>(ptr);
+        CUresult result = cuMemMap(dptr, bytes, 0, handle, 0);
+        if(result == CUDA_SUCCESS)
+        {
+            CUmemAccessDesc access{};
+            access.location = prop.location;
+            access.flags    = CU_MEM_ACCESS_FLAGS_PROT_READWRITE;
+            result          = cuMemSetAccess(dptr, bytes, &access, 1);
+            if(result != CUDA_SUCCESS)
+                cuMemUnmap(dptr, bytes);
+        }
+        if(result != CUDA_SUCCESS)
+        {
+            // give the physical memory back before reporting
+            cuMemRelease(handle);
+            checkCudaErrors(result);
+        }
+        return handle;
+    }
+
+    MUDA_INLINE void device_decommit(std::byte* ptr, size_t bytes, unsigned long long handle)
+    {
+        // kernels may still be using the pages
+        checkCudaErrors(cudaDeviceSynchronize());
+        checkCudaErrors(cuMemUnmap(reinterpret_cast<CUdeviceptr>(ptr), bytes));
+        checkCudaErrors(cuMemRelease(handle));
+    }
+
+    MUDA_INLINE void device_release(std::byte* ptr, size_t bytes)
+    {
+        checkCudaErrors(cuMemAddressFree(reinterpret_cast<CUdeviceptr>(ptr), bytes));
+    }
+}  // namespace details::virtual_memory
+
+/*****************************************************************************
+* VirtualReservation
+*****************************************************************************/
+
+MUDA_INLINE VirtualReservation::VirtualReservation(size_t reserve_bytes, size_t granularity)
+    : m_granularity(granularity)
+    , m_reserved(round_up(reserve_bytes, granularity))
+{
+}
+
+MUDA_INLINE size_t VirtualReservation::round_up(size_t bytes, size_t granularity)
+{
+    if(granularity == 0)
+        return bytes;
+    return (bytes + granularity - 1) / granularity * granularity;
+}
+
+MUDA_INLINE VirtualReservation::Chunk VirtualReservation::plan_commit(size_t required,
+                                                                      const BufferGrowthPolicy& growth) const
+{
+    if(required <= m_committed)
+        return Chunk{m_committed, 0};
+
+    if(required > m_reserved)
+        throw out_of_range("virtual memory: " + std::to_string(required)
+                           + " bytes required, only " + std::to_string(m_reserved)
+                           + " bytes reserved");
+
+    auto target = growth.grow(m_committed, required, 1);
+    target      = std::min(round_up(target, m_granularity), m_reserved);
+    return Chunk{m_committed, target - m_committed};
+}
+
+MUDA_INLINE void VirtualReservation::record_commit(const Chunk& chunk)
+{
+    MUDA_ASSERT(chunk.offset == m_committed, "chunks must be committed in order");
+    MUDA_ASSERT(chunk.offset + chunk.bytes <= m_reserved, "chunk exceeds the reservation");
+    if(chunk.bytes == 0)
+        return;
+    m_chunks.push_back(chunk);
+    m_committed += chunk.bytes;
+}
+
+MUDA_INLINE const VirtualReservation::Chunk* VirtualReservation::plan_decommit(size_t keep_bytes) const MUDA_NOEXCEPT
+{
+    if(m_chunks.empty() || m_chunks.back().offset < keep_bytes)
+        return nullptr;
+    return &m_chunks.back();
+}
+
+MUDA_INLINE void VirtualReservation::record_decommit()
+{
+    MUDA_ASSERT(!m_chunks.empty(), "nothing to decommit");
+    m_committed -= m_chunks.back().bytes;
+    m_chunks.pop_back();
+}
+
+/*****************************************************************************
+* VirtualMemory
+*****************************************************************************/
+
+MUDA_INLINE VirtualMemory::VirtualMemory(size_t reserve_bytes, VirtualMemoryBackend backend)
+    : m_backend(backend)
+{
+    using namespace details::virtual_memory;
+
+    if(m_backend == VirtualMemoryBackend::Host)
+    {
+        m_reservation = VirtualReservation{reserve_bytes, host_granularity()};
+        if(m_reservation.reserved())
+            m_data = host_reserve(m_reservation.reserved());
+    }
+    else
+    {
+        m_device         = device_current();
+        auto granularity = device_granularity(m_device);
+        m_reservation    = VirtualReservation{reserve_bytes, granularity};
+        if(m_reservation.reserved())
+            m_data = device_reserve(m_reservation.reserved(), granularity);
+    }
+}
+
+MUDA_INLINE VirtualMemory::VirtualMemory(VirtualMemory&& other) MUDA_NOEXCEPT
+    : m_backend(other.m_backend),
+      m_device(other.m_device),
+      m_data(other.m_data),
+      m_reservation(std::move(other.m_reservation))
+{
+    other.m_data        = nullptr;
+    other.m_reservation = VirtualReservation{};
+}
+
+MUDA_INLINE VirtualMemory& VirtualMemory::operator=(VirtualMemory&& other)
+{
+    if(this == &other)
+        return *this;
+
+    release();
+
+    m_backend     = other.m_backend;
+    m_device      = other.m_device;
+    m_data        = other.m_data;
+    m_reservation = std::move(other.m_reservation);
+
+    other.m_data        = nullptr;
+    other.m_reservation = VirtualReservation{};
+    return *this;
+}
+
+MUDA_INLINE VirtualMemory::~VirtualMemory()
+{
+    release();
+}
+
+MUDA_INLINE void VirtualMemory::commit(size_t bytes, const BufferGrowthPolicy& growth)
+{
+    using namespace details::virtual_memory;
+
+    auto chunk = m_reservation.plan_commit(bytes, growth);
+    if(chunk.bytes == 0)
+        return;
+
+    auto ptr = m_data + chunk.offset;
+    if(m_backend == VirtualMemoryBackend::Host)
+        host_commit(ptr, chunk.bytes);
+    else
+        chunk.handle = device_commit(m_device, ptr, chunk.bytes);
+
+    m_reservation.record_commit(chunk);
+}
+
+MUDA_INLINE void VirtualMemory::decommit(size_t keep_bytes)
+{
+    using namespace details::virtual_memory;
+
+    while(auto chunk = m_reservation.plan_decommit(keep_bytes))
+    {
+        auto ptr = m_data + chunk->offset;
+        if(m_backend == VirtualMemoryBackend::Host)
+            host_decommit(ptr, chunk->bytes);
+        else
+            device_decommit(ptr, chunk->bytes, chunk->handle);
+        m_reservation.record_decommit();
+    }
+}
+
+MUDA_INLINE void VirtualMemory::release()
+{
+    using namespace details::virtual_memory;
+
+    if(!m_data)
+        return;
+
+    decommit(0);
+
+    if(m_backend == VirtualMemoryBackend::Host)
+        host_release(m_data, m_reservation.reserved());
+    else
+        device_release(m_data, m_reservation.reserved());
+
+    m_data        = nullptr;
+    m_reservation = VirtualReservation{};
+}
+}  // namespace muda
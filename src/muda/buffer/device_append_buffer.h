@@ -0,0 +1,81 @@
+/*****************************************************************/ /**
+ * \file   device_append_buffer.h
+ * \brief  A device buffer filled by kernels with `push_back`, replacing the
+ * two-pass count / scan / fill pattern when the output size is unknown.
+ *********************************************************************/
+#pragma once
+#include <muda/buffer/device_buffer.h>
+#include <muda/buffer/device_var.h>
+#include <muda/viewer/append_buffer_viewer.h>
+
+namespace muda
+{
+/**
+ * \class DeviceAppendBuffer
+ *
+ * \brief Output buffer with a capacity hint, overflow is recorded on device
+ * and fixed by `retry_if_overflow`.
+ *
+ * \code
+ *  DeviceAppendBuffer<CollisionPair> pairs(hint);
+ *  pairs.clear();
+ *  pairs.retry_if_overflow(
+ *      [&]
+ *      {
+ *          ParallelFor().apply(N,
+ *              [pairs = pairs.viewer()] __device__(int i) mutable
+ *              {
+ *                  if(expensive_test(i))
+ *                      pairs.push_back(make_pair(i));
+ *              });
+ *      });
+ *  auto result = pairs.view();
+ * \endcode
+ *
+ * With a good hint the pass runs once, on overflow the buffer grows to the
+ * exact required size (at least doubling) and the pass reruns. The capacity
+ * is kept, so later passes of similar size are single pass again.
+ */
+template <typename T>
+class DeviceAppendBuffer
+{
+  private:
+    DeviceBuffer<T> m_data;  // m_data.size() is the capacity
+    DeviceVar<int>  m_count;
+
+  public:
+    using value_type = T;
+
+    DeviceAppendBuffer(size_t capacity_hint = 0);
+
+    // read back the element count (sync), may exceed capacity() on overflow
+    size_t required_size() const;
+    // read back the element count (sync), clamped to capacity()
+    size_t size() const;
+    size_t capacity() const MUDA_NOEXCEPT { return m_data.size(); }
+    bool   overflowed() const { return required_size() > capacity(); }
+
+    void reserve(size_t capacity);
+    void clear();
+
+    AppendBufferViewer<T> viewer() MUDA_NOEXCEPT;
+
+    /**
+     * \brief Run `f` (which launches the appending kernels), if the buffer
+     * overflows, grow it, drop the partial results of `f` and rerun `f`.
+     *
+     * The elements appended before this call are kept.
+     *
+     * \return the number of elements after `f` (sync)
+     */
+    template <typename F>
+    size_t retry_if_overflow(F&& f);
+
+    BufferView<T>  view();
+    CBufferView<T> view() const;
+
+    void copy_to(std::vector<T>& host) const;
+};
+}  // namespace muda
+
+#include "details/device_append_buffer.inl"
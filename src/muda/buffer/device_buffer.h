@@ -15,6 +15,7 @@
 #include <vector>
 #include <muda/viewer/dense.h>
 #include <muda/buffer/buffer_view.h>
+#include <muda/buffer/buffer_growth_policy.h>
 
 namespace muda
 {
@@ -36,6 +37,7 @@ class HostVector;
  * \li clear
  * \li fill
  * \li shrink_to_fit
+ * \li append with amortized O(1) growth
  * \li make view or subview from it
  * \li make a safe viewer from it
  * 
@@ -48,9 +50,10 @@ class DeviceBuffer
     friend class BufferLaunch;
     friend class NDReshaper;
 
-    size_t m_size     = 0;
-    size_t m_capacity = 0;
-    T*     m_data     = nullptr;
+    size_t             m_size     = 0;
+    size_t             m_capacity = 0;
+    T*                 m_data     = nullptr;
+    BufferGrowthPolicy m_growth;
 
   public:
     using value_type = T;
@@ -78,6 +81,17 @@ class DeviceBuffer
     void shrink_to_fit();
     void fill(const T& v);
 
+    // append to the end, capacity grows geometrically even if the growth policy is exact
+    void append(CBufferView<T> other);
+    void append(const std::vector<T>& host);
+
+    // capacity growth policy when a resize exceeds the capacity, exact by default
+    const auto& growth_policy() const MUDA_NOEXCEPT { return m_growth; }
+    void growth_policy(const BufferGrowthPolicy& policy) MUDA_NOEXCEPT
+    {
+        m_growth = policy;
+    }
+
     Dense1D<T>  viewer() MUDA_NOEXCEPT;
     CDense1D<T> cviewer() const MUDA_NOEXCEPT;
 
@@ -5,6 +5,7 @@
 #include <vector>
 #include <muda/viewer/dense.h>
 #include <muda/buffer/buffer_2d_view.h>
+#include <muda/buffer/buffer_growth_policy.h>
 
 namespace muda
 {
@@ -14,10 +15,11 @@ class DeviceBuffer2D
   private:
     friend class BufferLaunch;
     friend class NDReshaper;
-    T*       m_data        = nullptr;
-    size_t   m_pitch_bytes = 0;
-    Extent2D m_extent      = Extent2D::Zero();
-    Extent2D m_capacity    = Extent2D::Zero();
+    T*                 m_data        = nullptr;
+    size_t             m_pitch_bytes = 0;
+    Extent2D           m_extent      = Extent2D::Zero();
+    Extent2D           m_capacity    = Extent2D::Zero();
+    BufferGrowthPolicy m_growth;
 
   public:
     using value_type = T;
@@ -43,6 +45,13 @@ class DeviceBuffer2D
     void shrink_to_fit();
     void fill(const T& v);
 
+    // capacity growth policy when a resize exceeds the capacity, exact by default
+    const auto& growth_policy() const MUDA_NOEXCEPT { return m_growth; }
+    void growth_policy(const BufferGrowthPolicy& policy) MUDA_NOEXCEPT
+    {
+        m_growth = policy;
+    }
+
     Dense2D<T>  viewer() MUDA_NOEXCEPT { return view().viewer(); }
     CDense2D<T> cviewer() const MUDA_NOEXCEPT { return view().viewer(); }
 
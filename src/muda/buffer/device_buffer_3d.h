@@ -15,6 +15,7 @@
 #include <vector>
 #include <muda/viewer/dense.h>
 #include <muda/buffer/buffer_3d_view.h>
+#include <muda/buffer/buffer_growth_policy.h>
 
 namespace muda
 {
@@ -25,11 +26,12 @@ class DeviceBuffer3D
     friend class BufferLaunch;
     friend class NDReshaper;
 
-    T*       m_data             = nullptr;
-    size_t   m_pitch_bytes      = 0;
-    size_t   m_pitch_bytes_area = 0;
-    Extent3D m_extent           = Extent3D::Zero();
-    Extent3D m_capacity         = Extent3D::Zero();
+    T*                 m_data             = nullptr;
+    size_t             m_pitch_bytes      = 0;
+    size_t             m_pitch_bytes_area = 0;
+    Extent3D           m_extent           = Extent3D::Zero();
+    Extent3D           m_capacity         = Extent3D::Zero();
+    BufferGrowthPolicy m_growth;
 
   public:
     using value_type = T;
@@ -55,6 +57,13 @@ class DeviceBuffer3D
     void shrink_to_fit();
     void fill(const T& v);
 
+    // capacity growth policy when a resize exceeds the capacity, exact by default
+    const auto& growth_policy() const MUDA_NOEXCEPT { return m_growth; }
+    void growth_policy(const BufferGrowthPolicy& policy) MUDA_NOEXCEPT
+    {
+        m_growth = policy;
+    }
+
     Dense3D<T>  viewer() MUDA_NOEXCEPT { return view().viewer(); }
     CDense3D<T> cviewer() const MUDA_NOEXCEPT { return view().viewer(); }
 
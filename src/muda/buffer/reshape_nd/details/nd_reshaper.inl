@@ -70,7 +70,8 @@ void NDReshaper::resize(int              grid_dim,
                         cudaStream_t     stream,
                         DeviceBuffer<T>& buffer,
                         size_t           new_size,
-                        FConstruct&&     fct)
+                        FConstruct&&     fct,
+                        const BufferGrowthPolicy& growth)
 {
     using namespace details::buffer;
 
@@ -107,7 +108,8 @@ void NDReshaper::resize(int              grid_dim,
     }
     else
     {
-        new_buffer = reserve_1d<T>(stream, new_size);
+        auto new_capacity = growth.grow(m_capacity, new_size, sizeof(T));
+        new_buffer        = reserve_1d<T>(stream, new_capacity);
 
         if(m_data)
         {
@@ -118,7 +120,7 @@ void NDReshaper::resize(int              grid_dim,
 
         // construct the rest new memory
         {
-            BufferView<T> to_construct = new_buffer.subview(old_size);
+            BufferView<T> to_construct = new_buffer.subview(old_size, new_size - old_size);
             fct(to_construct);
         }
 
@@ -133,7 +135,7 @@ void NDReshaper::resize(int              grid_dim,
 
         m_data     = new_buffer.origin_data();
         m_size     = new_size;
-        m_capacity = new_size;
+        m_capacity = new_capacity;
         return;
     }
 }
@@ -215,7 +217,8 @@ MUDA_HOST void NDReshaper::resize(int                grid_dim,
                                   cudaStream_t       stream,
                                   DeviceBuffer2D<T>& buffer,
                                   Extent2D           new_extent,
-                                  FConstruct&&       fct)
+                                  FConstruct&&       fct,
+                                  const BufferGrowthPolicy& growth)
 {
     using namespace details::buffer;
 
@@ -246,7 +249,7 @@ MUDA_HOST void NDReshaper::resize(int                grid_dim,
         // at least one dimension is smaller than the new extent
         // so we need to allocate a new buffer (m_capacity)
         // which is bigger than the new_extent in all dimensions
-        auto new_capacity = max(new_extent, m_capacity);
+        auto new_capacity = growth.grow(m_capacity, new_extent, sizeof(T));
         new_buffer        = reserve_2d<T>(stream, new_capacity);
 
         m_data        = new_buffer.origin_data();
@@ -430,7 +433,8 @@ MUDA_HOST void NDReshaper::resize(int                grid_dim,
                                   cudaStream_t       stream,
                                   DeviceBuffer3D<T>& buffer,
                                   Extent3D           new_extent,
-                                  FConstruct&&       fct)
+                                  FConstruct&&       fct,
+                                  const BufferGrowthPolicy& growth)
 {
     using namespace details::buffer;
 
@@ -463,7 +467,7 @@ MUDA_HOST void NDReshaper::resize(int                grid_dim,
         // at least one dimension is smaller than the new extent
         // so we need to allocate a new buffer (m_capacity)
         // which is bigger than the new_extent in all dimensions
-        auto new_capacity = max(new_extent, m_capacity);
+        auto new_capacity = growth.grow(m_capacity, new_extent, sizeof(T));
         new_buffer        = reserve_3d<T>(stream, new_capacity);
 
         m_data             = new_buffer.origin_data();
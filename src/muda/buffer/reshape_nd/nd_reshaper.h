@@ -1,5 +1,6 @@
 #pragma once
 #include <cuda.h>
+#include <muda/buffer/buffer_growth_policy.h>
 
 namespace muda
 {
@@ -21,7 +22,8 @@ class NDReshaper
                                  cudaStream_t     stream,
                                  DeviceBuffer<T>& buffer,
                                  size_t           new_size,
-                                 FConstruct&&     fct);
+                                 FConstruct&&     fct,
+                                 const BufferGrowthPolicy& growth = {});
 
     template <typename T>
     static MUDA_HOST void shrink_to_fit(int              grid_dim,
@@ -45,7 +47,8 @@ class NDReshaper
                                  cudaStream_t       stream,
                                  DeviceBuffer2D<T>& buffer,
                                  Extent2D           new_extent,
-                                 FConstruct&&       fct);
+                                 FConstruct&&       fct,
+                                 const BufferGrowthPolicy& growth = {});
 
     template <typename T>
     static MUDA_HOST void shrink_to_fit(int                grid_dim,
@@ -66,7 +69,8 @@ class NDReshaper
                                  cudaStream_t       stream,
                                  DeviceBuffer3D<T>& buffer,
                                  Extent3D           new_extent,
-                                 FConstruct&&       fct);
+                                 FConstruct&&       fct,
+                                 const BufferGrowthPolicy& growth = {});
 
     template <typename T>
     static MUDA_HOST void shrink_to_fit(int                grid_dim,
@@ -0,0 +1,118 @@
+/*****************************************************************/ /**
+ * \file   virtual_buffer.h
+ * \brief  A growable buffer on top of a reserved virtual address range.
+ * Growing only maps new pages behind the existing ones, data is never moved,
+ * so pointers, views and viewers stay valid and the peak memory of a growth
+ * is the new size, not old + new.
+ *********************************************************************/
+#pragma once
+#include <vector>
+#include <muda/viewer/dense.h>
+#include <muda/buffer/buffer_view.h>
+#include <muda/buffer/virtual_memory.h>
+
+namespace muda
+{
+/**
+ * \class VirtualBuffer
+ *
+ * \brief A `DeviceBuffer` like buffer whose capacity can grow up to `max_size()`
+ * without reallocation.
+ *
+ * The address range for `max_size` elements is reserved on construction (cheap, no
+ * memory is allocated), `resize`/`reserve` commit physical memory on demand and
+ * `shrink_to_fit` gives it back. `data()` never changes during the lifetime.
+ *
+ * With `VirtualMemoryBackend::Host` the buffer lives in pageable host memory and
+ * no CUDA call is made, e.g. for the host backend of the cub wrappers.
+ *
+ * \code
+ *  VirtualBuffer<int> buffer(1 << 30); // up to 1G ints
+ *  auto viewer = buffer.viewer();
+ *  buffer.resize(1 << 20);             // commit 4MB
+ *  buffer.resize(1 << 28);             // commit 1GB, buffer.data() is unchanged
+ * \endcode
+ */
+template <typename T>
+class VirtualBuffer
+{
+    VirtualMemory      m_memory;
+    size_t             m_size = 0;
+    BufferGrowthPolicy m_growth;
+
+  public:
+    using value_type = T;
+
+    VirtualBuffer() = default;
+    // reserve the address range of `max_size` elements, nothing is committed yet
+    explicit VirtualBuffer(size_t               max_size,
+                           VirtualMemoryBackend backend = VirtualMemoryBackend::Device);
+
+    VirtualBuffer(const VirtualBuffer&)            = delete;
+    VirtualBuffer& operator=(const VirtualBuffer&) = delete;
+    VirtualBuffer(VirtualBuffer&& other) MUDA_NOEXCEPT;
+    VirtualBuffer& operator=(VirtualBuffer&& other);
+
+    void copy_to(std::vector<T>& host) const;
+    void copy_from(const std::vector<T>& host);
+
+    // new elements are value-initialized, throws `out_of_range` beyond `max_size()`
+    void resize(size_t new_size);
+    void resize(size_t new_size, const T& value);
+    void reserve(size_t new_capacity);
+    void clear();
+    // decommit the chunks entirely beyond size()
+    void shrink_to_fit();
+    void fill(const T& v);
+
+    void append(CBufferView<T> other);
+    void append(const std::vector<T>& host);
+
+    // how much more than required to commit when growing, exact (granularity rounded) by default
+    const auto& growth_policy() const MUDA_NOEXCEPT { return m_growth; }
+    void growth_policy(const BufferGrowthPolicy& policy) MUDA_NOEXCEPT
+    {
+        m_growth = policy;
+    }
+
+    Dense1D<T>  viewer() MUDA_NOEXCEPT;
+    CDense1D<T> cviewer() const MUDA_NOEXCEPT;
+
+    BufferView<T>  view(size_t offset, size_t size = ~0) MUDA_NOEXCEPT;
+    BufferView<T>  view() MUDA_NOEXCEPT;
+    CBufferView<T> view(size_t offset, size_t size = ~0) const MUDA_NOEXCEPT;
+    CBufferView<T> view() const MUDA_NOEXCEPT;
+    operator BufferView<T>() MUDA_NOEXCEPT { return view(); }
+    operator CBufferView<T>() const MUDA_NOEXCEPT { return view(); }
+
+    ~VirtualBuffer();
+
+    auto size() const MUDA_NOEXCEPT { return m_size; }
+    // committed elements
+    auto capacity() const MUDA_NOEXCEPT
+    {
+        return m_memory.committed_bytes() / sizeof(T);
+    }
+    // reserved elements, the capacity can never exceed it
+    auto max_size() const MUDA_NOEXCEPT
+    {
+        return m_memory.reserved_bytes() / sizeof(T);
+    }
+    auto backend() const MUDA_NOEXCEPT { return m_memory.backend(); }
+    bool is_host() const MUDA_NOEXCEPT
+    {
+        return m_memory.backend() == VirtualMemoryBackend::Host;
+    }
+    T* data() MUDA_NOEXCEPT { return reinterpret_cast<T*>(m_memory.data()); }
+    const T* data() const MUDA_NOEXCEPT
+    {
+        return reinterpret_cast<const T*>(m_memory.data());
+    }
+
+  private:
+    void construct(size_t begin, size_t end);
+    void destruct(size_t begin, size_t end);
+};
+}  // namespace muda
+
+#include "details/virtual_buffer.inl"
@@ -0,0 +1,128 @@
+/*****************************************************************/ /**
+ * \file   virtual_memory.h
+ * \brief  Reserve a virtual address range once, then back it with physical
+ * memory on demand. The base address never changes, so growing never copies.
+ *
+ * Device memory uses the CUDA virtual memory management driver API
+ * (cuMemAddressReserve / cuMemCreate / cuMemMap), host memory uses
+ * mmap (VirtualAlloc on Windows) reserve and commit.
+ *********************************************************************/
+#pragma once
+#include <cstddef>
+#include <vector>
+#include <muda/muda_def.h>
+#include <muda/exception.h>
+#include <muda/buffer/buffer_growth_policy.h>
+
+namespace muda
+{
+enum class VirtualMemoryBackend
+{
+    // device memory, CUDA virtual memory management
+    Device,
+    // pageable host memory, for the host backend and CPU-only nodes
+    Host,
+};
+
+/**
+ * \class VirtualReservation
+ *
+ * \brief Bookkeeping of a reserved address range, whose prefix is committed
+ * chunk by chunk. Pure host logic, no memory is touched.
+ *
+ * Every commit appends one chunk (one physical allocation on the device), chunks
+ * are decommitted from the back. All sizes are multiples of the granularity.
+ */
+class VirtualReservation
+{
+  public:
+    class Chunk
+    {
+      public:
+        size_t offset = 0;
+        size_t bytes  = 0;
+        // CUmemGenericAllocationHandle for device memory, unused for host memory
+        unsigned long long handle = 0;
+    };
+
+  private:
+    size_t             m_granularity = 0;
+    size_t             m_reserved    = 0;
+    size_t             m_committed   = 0;
+    std::vector<Chunk> m_chunks;
+
+  public:
+    VirtualReservation() = default;
+    VirtualReservation(size_t reserve_bytes, size_t granularity);
+
+    static size_t round_up(size_t bytes, size_t granularity);
+
+    auto        granularity() const MUDA_NOEXCEPT { return m_granularity; }
+    auto        reserved() const MUDA_NOEXCEPT { return m_reserved; }
+    auto        committed() const MUDA_NOEXCEPT { return m_committed; }
+    const auto& chunks() const MUDA_NOEXCEPT { return m_chunks; }
+
+    /**
+     * \brief The chunk to commit so that at least `required` bytes are committed.
+     *
+     * `growth` may ask for more than required, the result is rounded up to the
+     * granularity and clamped to the reservation. Returns an empty chunk if nothing
+     * needs to be committed, throws `out_of_range` if `required` exceeds the reservation.
+     */
+    Chunk plan_commit(size_t required, const BufferGrowthPolicy& growth = {}) const;
+    void  record_commit(const Chunk& chunk);
+
+    // the last chunk if it lies entirely beyond `keep_bytes`, otherwise nullptr
+    const Chunk* plan_decommit(size_t keep_bytes) const MUDA_NOEXCEPT;
+    void         record_decommit();
+};
+
+/**
+ * \class VirtualMemory
+ *
+ * \brief A reserved virtual address range with a committed prefix, move only.
+ *
+ * \code
+ *  VirtualMemory memory(1ull << 36); // reserve 64GB of address space, nothing is allocated
+ *  memory.commit(1ull << 20);        // 1MB usable at memory.data()
+ *  memory.commit(1ull << 30);        // 1GB usable at the same memory.data()
+ *  memory.decommit(0);               // give the physical memory back
+ * \endcode
+ */
+class VirtualMemory
+{
+    VirtualMemoryBackend m_backend = VirtualMemoryBackend::Device;
+    int                  m_device  = 0;
+    std::byte*           m_data    = nullptr;
+    VirtualReservation   m_reservation;
+
+  public:
+    VirtualMemory() = default;
+    // reserve `reserve_bytes` of address space (rounded up to the granularity) on the current device
+    explicit VirtualMemory(size_t               reserve_bytes,
+                           VirtualMemoryBackend backend = VirtualMemoryBackend::Device);
+
+    VirtualMemory(const VirtualMemory&)            = delete;
+    VirtualMemory& operator=(const VirtualMemory&) = delete;
+    VirtualMemory(VirtualMemory&& other) MUDA_NOEXCEPT;
+    VirtualMemory& operator=(VirtualMemory&& other);
+    ~VirtualMemory();
+
+    // make sure at least `bytes` are backed by memory, data() never changes
+    void commit(size_t bytes, const BufferGrowthPolicy& growth = {});
+    // give back the chunks entirely beyond `keep_bytes`
+    void decommit(size_t keep_bytes);
+    // decommit everything and free the address range
+    void release();
+
+    auto        backend() const MUDA_NOEXCEPT { return m_backend; }
+    auto        device() const MUDA_NOEXCEPT { return m_device; }
+    std::byte*  data() const MUDA_NOEXCEPT { return m_data; }
+    auto        reserved_bytes() const MUDA_NOEXCEPT { return m_reservation.reserved(); }
+    auto        committed_bytes() const MUDA_NOEXCEPT { return m_reservation.committed(); }
+    auto        granularity() const MUDA_NOEXCEPT { return m_reservation.granularity(); }
+    const auto& reservation() const MUDA_NOEXCEPT { return m_reservation; }
+};
+}  // namespace muda
+
+#include "details/virtual_memory.inl"
@@ -10,6 +10,7 @@
 #include <muda/check/check_cusparse.h>
 #include <muda/check/check_cublas.h>
 #include <muda/check/check_cusolver.h>
+#include <muda/check/check_cu.h>
 
 MUDA_INLINE MUDA_GENERIC const char* mudaCudaGetErrorEnum(cudaError_t error)
 {
@@ -0,0 +1,15 @@
+#pragma once
+#include <muda/muda_def.h>
+#include <cuda.h>
+
+MUDA_INLINE MUDA_GENERIC const char* mudaCudaGetErrorEnum(CUresult error)
+{
+#ifdef __CUDA_ARCH__
+    return "<CUresult>";
+#else
+    const char* name = nullptr;
+    if(cuGetErrorName(error, &name) != CUDA_SUCCESS || !name)
+        return "<unknown>";
+    return name;
+#endif
+}
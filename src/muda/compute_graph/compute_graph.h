@@ -7,7 +7,10 @@
 #include <muda/mstl/span.h>
 #include <muda/graph/graph.h>
 #include <muda/graph/graph_viewer.h>
+#include <muda/buffer/buffer_fwd.h>
 #include <muda/compute_graph/compute_graph_flag.h>
+#include <muda/compute_graph/compute_graph_conditional_type.h>
+#include <muda/compute_graph/compute_graph_topo_cache.h>
 #include <muda/compute_graph/compute_graph_phase.h>
 #include <muda/compute_graph/compute_graph_node_type.h>
 #include <muda/compute_graph/compute_graph_node_id.h>
@@ -52,6 +55,8 @@ class ComputeGraph
     class GraphPhaseGuard
     {
         ComputeGraph& m_cg;
+        // a body graph may be built or launched inside a closure of its parent
+        ComputeGraph* m_prev_graph = nullptr;
 
       public:
         GraphPhaseGuard(ComputeGraph& cg, ComputeGraphPhase phase);
@@ -127,6 +132,32 @@ class ComputeGraph
 
     AddNodeProxy create_node(std::string_view node_name);
 
+    /**************************************************************
+    * 
+    * Graph Control Flow API
+    * 
+    * The body is another ComputeGraph sharing the same var manager,
+    * it is not launched by itself, but inlined into this graph as a
+    * sub graph. `cond` is a device int, so no host readback is needed.
+    * 
+    * Building  : maps to a conditional graph node (cuda 12.4+), or
+    *             falls back to tail launch relaunches, which requires
+    *             ComputeGraphFlag::DeviceLaunch and that no node
+    *             depends on the conditional node.
+    * Serial    : a plain host loop reading `cond` back.
+    * 
+    ***************************************************************/
+
+    // run body until `cond` becomes 0, body is responsible for updating `cond`
+    ComputeGraph& create_while_node(std::string_view               node_name,
+                                    ComputeGraphVar<VarView<int>>& cond,
+                                    ComputeGraph&                  body);
+
+    // run body once if `cond` is not 0
+    ComputeGraph& create_if_node(std::string_view               node_name,
+                                 ComputeGraphVar<VarView<int>>& cond,
+                                 ComputeGraph&                  body);
+
 
     /**************************************************************
     * 
@@ -142,6 +173,29 @@ class ComputeGraph
 
     void launch(cudaStream_t s = nullptr) { return launch(false, s); }
 
+    /**************************************************************
+    * 
+    * Graph Topology Cache API
+    * 
+    * The topology (var usages, graph nodes and dependencies of the
+    * closures) can be exported after discovery and imported in later
+    * runs, so building doesn't need the TopoBuilding pass. Vars are
+    * referred by name, so they should be created before importing.
+    * 
+    ***************************************************************/
+
+    // hash of the graph name and the closure names, keys the cache
+    uint64_t topo_signature() const;
+
+    // discover the topology if not yet, and serialize it
+    std::vector<std::byte> export_topo();
+
+    // return false and import nothing if the blob doesn't belong to this graph.
+    // in Validate mode, the topology is discovered as usual, and false is
+    // returned if the blob differs from it (a stale cache)
+    bool import_topo(span<const std::byte>     blob,
+                     ComputeGraphTopoCacheMode mode = ComputeGraphTopoCacheMode::Trust);
+
     /**************************************************************
     * 
     * Graph Event Query API
@@ -186,6 +240,27 @@ class ComputeGraph
 
     void serial_launch();
 
+    // capture the serial launch of this graph as a cuda graph
+    cudaGraph_t serial_capture();
+
+    ComputeGraph& add_conditional_node(std::string&&                  name,
+                                       ComputeGraphConditionalType    type,
+                                       ComputeGraphVar<VarView<int>>& cond,
+                                       ComputeGraph&                  body);
+
+    void conditional(ComputeGraphConditionalType    type,
+                     ComputeGraphVar<VarView<int>>& cond,
+                     ComputeGraph&                  body);
+
+    // let the current closure use all the vars used by body
+    void inherit_var_usages(ComputeGraph& body);
+
+    void check_conditional_nodes() const;
+
+    ComputeGraphNodeBase* create_cached_node(ComputeGraphNodeType type,
+                                             uint8_t              extra,
+                                             uint64_t             access_index);
+
     void _update();
 
     void check_vars_valid();
@@ -227,6 +302,8 @@ class ComputeGraph
     bool         m_is_capturing          = false;
     // in capture func, we don't allow any var eval()
     bool m_is_in_capture_func = false;
+    // serial launching to build the body of a conditional node
+    bool m_is_serial_capturing = false;
     // if we have already built the topo, we don't do that again
     bool m_is_topo_built = false;
 };
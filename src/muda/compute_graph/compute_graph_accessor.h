@@ -4,6 +4,7 @@
 #include <muda/graph/kernel_node.h>
 #include <muda/graph/memory_node.h>
 #include <muda/graph/event_node.h>
+#include <muda/compute_graph/compute_graph_conditional_type.h>
 namespace muda
 {
 namespace details
@@ -37,6 +38,9 @@ namespace details
         void set_event_record_node(cudaEvent_t event);
         void set_event_wait_node(cudaEvent_t event);
         void set_capture_node(cudaGraph_t sub_graph);
+        void set_conditional_node(ComputeGraphConditionalType type,
+                                  const int*                  cond,
+                                  ComputeGraph&               body);
 
         /************************************************************************************
         * 
@@ -89,6 +93,11 @@ namespace details
         void add_capture_node(cudaGraph_t sub_graph);
         void update_capture_node(cudaGraph_t sub_graph);
 
+        void add_conditional_node(ComputeGraphConditionalType type,
+                                  const int*                  cond,
+                                  ComputeGraph&               body);
+        void update_conditional_node(const int* cond, ComputeGraph& body);
+
         template <typename F>
         void access_graph(F&& f);
 
@@ -0,0 +1,9 @@
+#pragma once
+namespace muda
+{
+enum class ComputeGraphConditionalType
+{
+    If,     // run the body once if the condition is non-zero
+    While,  // run the body until the condition becomes zero
+};
+}
@@ -38,11 +38,18 @@ class ComputeGraphNodeBase
     uint64_t    m_access_index;
 
     ComputeGraphNodeType m_type;
-    cudaGraphNode_t      m_cuda_node = nullptr;
+    cudaGraphNode_t      m_cuda_node       = nullptr;
+    // the first cuda node when this node expands to a chain of cuda nodes
+    cudaGraphNode_t m_cuda_entry_node = nullptr;
 
 
     auto handle() const { return m_cuda_node; }
     void set_handle(cudaGraphNode_t handle) { m_cuda_node = handle; }
+    auto entry_handle() const
+    {
+        return m_cuda_entry_node ? m_cuda_entry_node : m_cuda_node;
+    }
+    void set_entry_handle(cudaGraphNode_t handle) { m_cuda_entry_node = handle; }
     auto is_valid() const { return m_cuda_node; }
 };
 
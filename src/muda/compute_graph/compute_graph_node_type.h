@@ -12,6 +12,7 @@ enum class ComputeGraphNodeType : uint8_t
     CaptureNode,
     EventRecordNode,
     EventWaitNode,
+    ConditionalNode,
     Max
 };
 
@@ -33,6 +34,8 @@ inline std::string_view enum_name(ComputeGraphNodeType t)
             return "EventRecordNode";
         case ComputeGraphNodeType::EventWaitNode:
             return "EventWaitNode";
+        case ComputeGraphNodeType::ConditionalNode:
+            return "ConditionalNode";
         default:
             return "Unknown";
     }
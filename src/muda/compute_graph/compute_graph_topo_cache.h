@@ -0,0 +1,122 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <muda/mstl/span.h>
+
+namespace muda
+{
+enum class ComputeGraphTopoCacheMode
+{
+    // take the cached topology as is, closures are not invoked until building
+    Trust,
+    // discover the topology as usual and compare it with the cache
+    Validate,
+};
+
+namespace details
+{
+    constexpr uint32_t ComputeGraphTopoMagic   = 0x5447434du;  // "MCGT"
+    constexpr uint32_t ComputeGraphTopoVersion = 1;
+
+    // FNV-1a, stable across runs and platforms
+    class ComputeGraphTopoHasher
+    {
+        uint64_t m_hash = 14695981039346656037ull;
+
+      public:
+        void add(const void* data, size_t size)
+        {
+            auto bytes = static_cast<const unsigned char*>(data);
+            for(size_t i = 0; i < size; ++i)
+            {
+                m_hash ^= bytes[i];
+                m_hash *= 1099511628211ull;
+            }
+        }
+
+        void add(std::string_view str)
+        {
+            auto size = static_cast<uint32_t>(str.size());
+            add(&size, sizeof(size));
+            add(str.data(), str.size());
+        }
+
+        uint64_t value() const { return m_hash; }
+    };
+
+    class ComputeGraphTopoWriter
+    {
+        std::vector<std::byte> m_blob;
+
+      public:
+        template <typename T>
+        void write(const T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+            auto offset = m_blob.size();
+            m_blob.resize(offset + sizeof(T));
+            std::memcpy(m_blob.data() + offset, &value, sizeof(T));
+        }
+
+        void write(std::string_view str)
+        {
+            write(static_cast<uint32_t>(str.size()));
+            auto offset = m_blob.size();
+            m_blob.resize(offset + str.size());
+            std::memcpy(m_blob.data() + offset, str.data(), str.size());
+        }
+
+        std::vector<std::byte> blob() && { return std::move(m_blob); }
+    };
+
+    // all reads fail softly, check `ok()` after reading
+    class ComputeGraphTopoReader
+    {
+        span<const std::byte> m_blob;
+        size_t                m_offset = 0;
+        bool                  m_ok     = true;
+
+      public:
+        ComputeGraphTopoReader(span<const std::byte> blob)
+            : m_blob(blob)
+        {
+        }
+
+        template <typename T>
+        T read()
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+            T value{};
+            if(!m_ok || m_offset + sizeof(T) > m_blob.size())
+            {
+                m_ok = false;
+                return value;
+            }
+            std::memcpy(&value, m_blob.data() + m_offset, sizeof(T));
+            m_offset += sizeof(T);
+            return value;
+        }
+
+        std::string read_string()
+        {
+            auto size = read<uint32_t>();
+            if(!m_ok || m_offset + size > m_blob.size())
+            {
+                m_ok = false;
+                return {};
+            }
+            std::string str(reinterpret_cast<const char*>(m_blob.data() + m_offset), size);
+            m_offset += size;
+            return str;
+        }
+
+        bool ok() const { return m_ok; }
+        bool at_end() const { return m_offset == m_blob.size(); }
+    };
+}  // namespace details
+}  // namespace muda
@@ -2,6 +2,8 @@
 #include <string>
 #include <set>
 #include <map>
+#include <mutex>
+#include <vector>
 #include <muda/launch/event.h>
 #include <muda/mstl/span.h>
 #include <muda/type_traits/type_modifier.h>
@@ -15,7 +17,7 @@ namespace muda
 {
 class ComputeGraphVarBase
 {
-    std::string_view        m_name;
+    std::string             m_name;
     ComputeGraphVarManager* m_var_manager = nullptr;
     VarId                   m_var_id;
     bool                    m_is_valid;
@@ -74,6 +76,8 @@ class ComputeGraphVarBase
     void base_building_eval();
     void base_building_ceval() const;
     void remove_related_closure_infos(ComputeGraph* graph);
+    // a snapshot, so that no lock is held while waiting on the graphs
+    std::vector<ComputeGraph*> related_graphs() const;
 
     class RelatedClosureInfo
     {
@@ -82,6 +86,8 @@ class ComputeGraphVarBase
         std::set<ClosureId> closure_ids;
     };
 
+    // graphs sharing this var may be built on different threads
+    mutable std::mutex                                  m_related_closure_infos_mutex;
     mutable std::map<ComputeGraph*, RelatedClosureInfo> m_related_closure_infos;
 };
 
@@ -5,12 +5,20 @@
 #include <unordered_set>
 #include <vector>
 #include <memory>
+#include <mutex>
 #include <muda/mstl/span.h>
 #include <muda/compute_graph/compute_graph_flag.h>
 #include <muda/compute_graph/compute_graph_fwd.h>
 #include <muda/compute_graph/graphviz_options.h>
 namespace muda
 {
+/**
+ * \brief Owns the vars shared by a set of ComputeGraphs.
+ *
+ * Var creation/lookup and graph registration are thread-safe, so independent
+ * graphs sharing one manager can be built in parallel (one graph per thread).
+ * Updating a var while a graph using it is being built is not allowed.
+ */
 class ComputeGraphVarManager
 {
     template <typename T>
@@ -51,6 +59,7 @@ class ComputeGraphVarManager
     void sync(const span<const ComputeGraphVarBase*> vars) const;
     void sync_on(cudaStream_t stream, const span<const ComputeGraphVarBase*> vars) const;
 
+    // not thread-safe, don't call it while graphs are being created or destroyed
     const auto& graphs() const { return m_graphs; }
     void graphviz(std::ostream& os, const ComputeGraphGraphvizOptions& options = {}) const;
 
@@ -59,10 +68,18 @@ class ComputeGraphVarManager
     friend class ComputeGraphNodeBase;
     friend class ComputeGraphClosure;
     std::vector<ComputeGraph*> unique_graphs(span<const ComputeGraphVarBase*> vars) const;
+    template <typename Var, typename... Args>
+    Var& emplace_var(std::string_view name, Args&&... args);
+    ComputeGraphVarBase* find_var_base(std::string_view name) const;
+    void                 register_graph(ComputeGraph* graph);
+    void unregister_graph(ComputeGraph* graph);
     std::unordered_map<std::string, ComputeGraphVarBase*> m_vars_map;
     std::vector<ComputeGraphVarBase*>                     m_vars;
     std::unordered_set<ComputeGraph*>                     m_graphs;
-    span<const ComputeGraphVarBase*>                      var_span() const;
+    // guard m_vars_map, m_vars and m_graphs
+    mutable std::mutex m_mutex;
+    // a snapshot of m_vars, safe to iterate while other threads create vars
+    std::vector<const ComputeGraphVarBase*> vars_snapshot() const;
 };
 }  // namespace muda
 
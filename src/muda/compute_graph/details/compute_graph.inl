@@ -1,6 +1,8 @@
 #include <memory>
+#include <algorithm>
 #include <muda/exception.h>
 #include <muda/debug.h>
+#include <muda/buffer/var_view.h>
 #include <muda/compute_graph/compute_graph.h>
 #include <muda/compute_graph/compute_graph_builder.h>
 #include <muda/compute_graph/compute_graph_var.h>
@@ -19,6 +21,7 @@ MUDA_INLINE ComputeGraph::AddNodeProxy::AddNodeProxy(ComputeGraph& cg, std::stri
 
 MUDA_INLINE ComputeGraph::GraphPhaseGuard::GraphPhaseGuard(ComputeGraph& cg, ComputeGraphPhase phase)
     : m_cg(cg)
+    , m_prev_graph(ComputeGraphBuilder::current_graph())
 {
     m_cg.set_current_graph_as_this();
     m_cg.m_current_graph_phase = phase;
@@ -27,7 +30,7 @@ MUDA_INLINE ComputeGraph::GraphPhaseGuard::GraphPhaseGuard(ComputeGraph& cg, Com
 MUDA_INLINE ComputeGraph::GraphPhaseGuard::~GraphPhaseGuard()
 {
     m_cg.m_current_graph_phase = ComputeGraphPhase::None;
-    ComputeGraph::clear_current_graph();
+    ComputeGraphBuilder::current_graph(m_prev_graph);
 }
 
 MUDA_INLINE ComputeGraph& ComputeGraph::AddNodeProxy::operator<<(std::function<void()>&& f) &&
@@ -162,6 +165,7 @@ MUDA_INLINE void ComputeGraph::build()
     }
     if(!m_is_topo_built)
         build_deps();
+    check_conditional_nodes();
     cuda_graph_add_deps();
 
     m_graph_exec = m_graph.instantiate(m_flags);
@@ -182,6 +186,19 @@ MUDA_INLINE void ComputeGraph::serial_launch()
     }
 }
 
+MUDA_INLINE cudaGraph_t ComputeGraph::serial_capture()
+{
+    auto& s                 = shared_capture_stream();
+    m_current_single_stream = s;
+    m_is_serial_capturing   = true;
+    s.begin_capture();
+    serial_launch();
+    cudaGraph_t g;
+    s.end_capture(&g);
+    m_is_serial_capturing = false;
+    return g;
+}
+
 MUDA_INLINE void ComputeGraph::check_vars_valid()
 {
     for(auto&& [local_id, var] : m_related_vars)
@@ -206,6 +223,333 @@ MUDA_INLINE ComputeGraph& ComputeGraph::add_node(std::string&& name,
     return *this;
 }
 
+MUDA_INLINE ComputeGraph& ComputeGraph::create_while_node(std::string_view node_name,
+                                                         ComputeGraphVar<VarView<int>>& cond,
+                                                         ComputeGraph& body)
+{
+    return add_conditional_node(
+        std::string{node_name}, ComputeGraphConditionalType::While, cond, body);
+}
+
+MUDA_INLINE ComputeGraph& ComputeGraph::create_if_node(std::string_view node_name,
+                                                      ComputeGraphVar<VarView<int>>& cond,
+                                                      ComputeGraph& body)
+{
+    return add_conditional_node(
+        std::string{node_name}, ComputeGraphConditionalType::If, cond, body);
+}
+
+MUDA_INLINE ComputeGraph& ComputeGraph::add_conditional_node(std::string&& name,
+                                                             ComputeGraphConditionalType type,
+                                                             ComputeGraphVar<VarView<int>>& cond,
+                                                             ComputeGraph& body)
+{
+    MUDA_ASSERT(&body != this, "ComputeGraph[%s]: a graph can't be the body of itself", m_name.c_str());
+    MUDA_ASSERT(body.m_var_manager == m_var_manager,
+                "ComputeGraph[%s]: body graph[%s] should share the same var manager",
+                m_name.c_str(),
+                body.m_name.c_str());
+    return add_node(std::move(name),
+                    [this, type, &cond, &body] { conditional(type, cond, body); });
+}
+
+MUDA_INLINE void ComputeGraph::conditional(ComputeGraphConditionalType type,
+                                           ComputeGraphVar<VarView<int>>& cond,
+                                           ComputeGraph& body)
+{
+    auto c = cond.ceval().data();
+
+    switch(current_graph_phase())
+    {
+        case ComputeGraphPhase::SerialLaunching: {
+            MUDA_ASSERT(!m_is_serial_capturing,
+                        "ComputeGraph[%s]: nested conditional nodes are not supported",
+                        m_name.c_str());
+            auto s         = m_current_single_stream;
+            auto read_cond = [&]
+            {
+                int h_cond = 0;
+                checkCudaErrors(cudaMemcpyAsync(&h_cond, c, sizeof(int), cudaMemcpyDeviceToHost, s));
+                checkCudaErrors(cudaStreamSynchronize(s));
+                return h_cond;
+            };
+            body.m_current_single_stream = s;
+            if(type == ComputeGraphConditionalType::If)
+            {
+                if(read_cond())
+                    body.serial_launch();
+            }
+            else
+            {
+                while(read_cond())
+                    body.serial_launch();
+            }
+        }
+        break;
+        case ComputeGraphPhase::TopoBuilding:
+        case ComputeGraphPhase::Building: {
+#if !MUDA_WITH_GRAPH_CONDITIONAL_NODE && defined(__CUDACC__) && !defined(__CUDACC_RDC__)
+            // the body is tail launched from device, see ComputeGraphConditionalNode
+            MUDA_ERROR_WITH_LOCATION(
+                "ComputeGraph[%s]: conditional nodes need -rdc=true (MUDA_WITH_RDC) "
+                "before cuda 12.4, only serial launch is supported without it",
+                m_name.c_str());
+#endif
+            body.topo_build();
+            inherit_var_usages(body);
+            details::ComputeGraphAccessor(this).set_conditional_node(type, c, body);
+        }
+        break;
+        case ComputeGraphPhase::Updating: {
+            details::ComputeGraphAccessor(this).set_conditional_node(type, c, body);
+        }
+        break;
+        default:
+            MUDA_ERROR_WITH_LOCATION("invoking conditional() outside Graph Closure is not allowed");
+            break;
+    }
+}
+
+MUDA_INLINE void ComputeGraph::inherit_var_usages(ComputeGraph& body)
+{
+    for(auto& [name, closure] : body.m_closures)
+    {
+        for(auto&& [var_id, usage] : closure->var_usages())
+        {
+            auto local_id = body.m_global_to_local_var_id.at(var_id);
+            body.m_related_vars[local_id.value()].var->_building_eval(usage);
+        }
+    }
+}
+
+MUDA_INLINE void ComputeGraph::check_conditional_nodes() const
+{
+#if !MUDA_WITH_GRAPH_CONDITIONAL_NODE
+    // the body of a conditional node is tail launched, which happens after this graph
+    for(auto dep : m_deps)
+    {
+        auto& [name, closure] = m_closures[dep.from.value()];
+        for(auto node : closure->m_graph_nodes)
+        {
+            if(node->type() == ComputeGraphNodeType::ConditionalNode)
+                MUDA_ERROR_WITH_LOCATION(
+                    "ComputeGraph[%s]: closure[%s] depends on conditional node[%s], "
+                    "which is not allowed without conditional graph node (cuda 12.4+)",
+                    m_name.c_str(),
+                    m_closures[dep.to.value()].first.c_str(),
+                    name.c_str());
+        }
+    }
+#endif
+}
+
+MUDA_INLINE uint64_t ComputeGraph::topo_signature() const
+{
+    details::ComputeGraphTopoHasher hasher;
+    hasher.add(&details::ComputeGraphTopoVersion, sizeof(details::ComputeGraphTopoVersion));
+    hasher.add(m_name);
+    auto closure_count = static_cast<uint64_t>(m_closures.size());
+    hasher.add(&closure_count, sizeof(closure_count));
+    for(auto& [name, closure] : m_closures)
+        hasher.add(name);
+    return hasher.value();
+}
+
+MUDA_INLINE std::vector<std::byte> ComputeGraph::export_topo()
+{
+    topo_build();
+
+    details::ComputeGraphTopoWriter w;
+    w.write(details::ComputeGraphTopoMagic);
+    w.write(details::ComputeGraphTopoVersion);
+    w.write(topo_signature());
+
+    w.write(static_cast<uint32_t>(m_related_vars.size()));
+    for(auto&& [local_id, var] : m_related_vars)
+        w.write(var->name());
+
+    w.write(static_cast<uint32_t>(m_closures.size()));
+    for(auto& [name, closure] : m_closures)
+    {
+        // refer vars by local id, independent of the var creation order
+        std::vector<std::pair<uint32_t, ComputeGraphVarUsage>> usages;
+        for(auto&& [var_id, usage] : closure->var_usages())
+            usages.emplace_back(
+                static_cast<uint32_t>(m_global_to_local_var_id.at(var_id).value()), usage);
+        std::sort(usages.begin(), usages.end());
+
+        w.write(static_cast<uint32_t>(usages.size()));
+        for(auto&& [local_id, usage] : usages)
+        {
+            w.write(local_id);
+            w.write(usage);
+        }
+
+        w.write(static_cast<uint32_t>(closure->m_graph_nodes.size()));
+        for(auto node : closure->m_graph_nodes)
+        {
+            uint8_t extra = 0;
+            if(auto cond = dynamic_cast<ComputeGraphConditionalNode*>(node))
+                extra = static_cast<uint8_t>(cond->m_cond_type);
+            w.write(node->type());
+            w.write(extra);
+            w.write(node->name());
+        }
+
+        w.write(static_cast<uint64_t>(closure->m_deps_begin));
+        w.write(static_cast<uint64_t>(closure->m_deps_count));
+    }
+
+    w.write(static_cast<uint64_t>(m_deps.size()));
+    for(auto dep : m_deps)
+    {
+        w.write(dep.from.value());
+        w.write(dep.to.value());
+    }
+    return std::move(w).blob();
+}
+
+MUDA_INLINE bool ComputeGraph::import_topo(span<const std::byte> blob, ComputeGraphTopoCacheMode mode)
+{
+    if(mode == ComputeGraphTopoCacheMode::Validate)
+    {
+        auto discovered = export_topo();
+        return discovered.size() == blob.size()
+               && std::equal(discovered.begin(), discovered.end(), blob.begin());
+    }
+
+    MUDA_ASSERT(!m_is_topo_built,
+                "ComputeGraph[%s]: topology is already built, importing is not allowed",
+                m_name.c_str());
+
+    class NodeInfo
+    {
+      public:
+        ComputeGraphNodeType type;
+        uint8_t              extra;
+        std::string          name;
+    };
+    class ClosureInfo
+    {
+      public:
+        std::vector<std::pair<uint32_t, ComputeGraphVarUsage>> usages;
+        std::vector<NodeInfo>                                  nodes;
+        uint64_t                                               deps_begin;
+        uint64_t                                               deps_count;
+    };
+
+    // parse everything first, so a bad blob leaves the graph untouched
+    details::ComputeGraphTopoReader r{blob};
+    if(r.read<uint32_t>() != details::ComputeGraphTopoMagic
+       || r.read<uint32_t>() != details::ComputeGraphTopoVersion
+       || r.read<uint64_t>() != topo_signature())
+        return false;
+
+    std::vector<ComputeGraphVarBase*> vars(r.read<uint32_t>());
+    for(auto& var : vars)
+    {
+        var = m_var_manager->find_var_base(r.read_string());
+        if(!r.ok() || !var)
+            return false;
+    }
+
+    std::vector<ClosureInfo> closures(r.read<uint32_t>());
+    if(!r.ok() || closures.size() != m_closures.size())
+        return false;
+    for(auto& closure : closures)
+    {
+        closure.usages.resize(r.read<uint32_t>());
+        for(auto& [local_id, usage] : closure.usages)
+        {
+            local_id = r.read<uint32_t>();
+            usage    = r.read<ComputeGraphVarUsage>();
+            if(!r.ok() || local_id >= vars.size() || usage >= ComputeGraphVarUsage::Max)
+                return false;
+        }
+        closure.nodes.resize(r.read<uint32_t>());
+        for(auto& node : closure.nodes)
+        {
+            node.type  = r.read<ComputeGraphNodeType>();
+            node.extra = r.read<uint8_t>();
+            node.name  = r.read_string();
+            if(!r.ok() || node.type == ComputeGraphNodeType::None
+               || node.type >= ComputeGraphNodeType::Max)
+                return false;
+        }
+        closure.deps_begin = r.read<uint64_t>();
+        closure.deps_count = r.read<uint64_t>();
+    }
+
+    std::vector<Dependency> deps(r.read<uint64_t>());
+    for(auto& dep : deps)
+    {
+        dep.from = ClosureId{r.read<uint64_t>()};
+        dep.to   = ClosureId{r.read<uint64_t>()};
+        if(!r.ok() || dep.from.value() >= closures.size() || dep.to.value() >= closures.size())
+            return false;
+    }
+    for(auto& closure : closures)
+        if(closure.deps_begin + closure.deps_count > deps.size())
+            return false;
+    if(!r.ok() || !r.at_end())
+        return false;
+
+    // apply
+    for(auto var : vars)
+        emplace_related_var(var);
+
+    for(size_t i = 0; i < m_closures.size(); ++i)
+    {
+        auto& info    = closures[i];
+        auto  closure = m_closures[i].second;
+        for(auto&& [local_id, usage] : info.usages)
+            closure->m_var_usages[vars[local_id]->var_id()] = usage;
+        for(size_t j = 0; j < info.nodes.size(); ++j)
+        {
+            auto& node_info = info.nodes[j];
+            auto  node = create_cached_node(node_info.type, node_info.extra, j);
+            node->m_name = node_info.name;
+            closure->m_graph_nodes.emplace_back(node);
+            m_nodes.emplace_back(node);
+        }
+        closure->set_deps_range(info.deps_begin, info.deps_count);
+    }
+
+    m_deps = std::move(deps);
+    m_closure_need_update.clear();
+    m_closure_need_update.resize(m_closures.size(), false);
+    m_is_topo_built = true;
+    return true;
+}
+
+MUDA_INLINE ComputeGraphNodeBase* ComputeGraph::create_cached_node(ComputeGraphNodeType type,
+                                                                   uint8_t  extra,
+                                                                   uint64_t access_index)
+{
+    auto node_id = NodeId{m_nodes.size()};
+    switch(type)
+    {
+        case ComputeGraphNodeType::KernelNode:
+            return new ComputeGraphKernelNode(node_id, access_index);
+        case ComputeGraphNodeType::MemcpyNode:
+            return new ComputeGraphMemcpyNode(node_id, access_index);
+        case ComputeGraphNodeType::MemsetNode:
+            return new ComputeGraphMemsetNode(node_id, access_index);
+        case ComputeGraphNodeType::CaptureNode:
+            return new ComputeGraphCaptureNode(node_id, access_index);
+        case ComputeGraphNodeType::EventRecordNode:
+            return new ComputeGraphEventRecordNode(node_id, access_index);
+        case ComputeGraphNodeType::EventWaitNode:
+            return new ComputeGraphEventWaitNode(node_id, access_index);
+        case ComputeGraphNodeType::ConditionalNode:
+            return new ComputeGraphConditionalNode(
+                node_id, access_index, static_cast<ComputeGraphConditionalType>(extra));
+        default:
+            MUDA_ERROR_WITH_LOCATION("unknown node type %d", static_cast<int>(type));
+            return nullptr;
+    }
+}
+
 MUDA_INLINE auto ComputeGraph::dep_span(size_t begin, size_t count) const
     -> span<const Dependency>
 {
@@ -317,7 +661,7 @@ MUDA_INLINE ComputeGraph::~ComputeGraph()
     for(auto var_info : m_related_vars)
         var_info.var->remove_related_closure_infos(this);
 
-    m_var_manager->m_graphs.erase(this);
+    m_var_manager->unregister_graph(this);
 
     for(auto node : m_nodes)
         delete node;
@@ -348,7 +692,7 @@ MUDA_INLINE ComputeGraph::ComputeGraph(ComputeGraphVarManager& manager,
     {
         MUDA_ERROR_WITH_LOCATION("ComputeGraph is disabled, please define MUDA_COMPUTE_GRAPH_ON=1 to enable it.");
     }
-    m_var_manager->m_graphs.insert(this);
+    m_var_manager->register_graph(this);
     switch(flag)
     {
         case ComputeGraphFlag::DeviceLaunch:
@@ -486,9 +830,11 @@ namespace details
             }
         }
 
-        // add dependencies to deps
+        // add dependencies to deps, sorted to keep the exported topology stable
+        std::vector<ClosureId> sorted_deps{unique_deps.begin(), unique_deps.end()};
+        std::sort(sorted_deps.begin(), sorted_deps.end());
         dep_begin = deps.size();
-        for(auto dep : unique_deps)
+        for(auto dep : sorted_deps)
             deps.emplace_back(ComputeGraph::Dependency{dep, current_closure_id});
         dep_count = unique_deps.size();
     }
@@ -515,7 +861,7 @@ MUDA_INLINE void ComputeGraph::cuda_graph_add_deps()
         {
             to = closure->m_graph_nodes[i];
             froms.emplace_back(from->handle());
-            tos.emplace_back(to->handle());
+            tos.emplace_back(to->entry_handle());
             from = to;
         }
     }
@@ -526,7 +872,7 @@ MUDA_INLINE void ComputeGraph::cuda_graph_add_deps()
         auto from = m_closures[dep.from.value()].second->m_graph_nodes.back();
         auto to   = m_closures[dep.to.value()].second->m_graph_nodes.front();
         froms.emplace_back(from->handle());
-        tos.emplace_back(to->handle());
+        tos.emplace_back(to->entry_handle());
     };
 
     checkCudaErrors(cudaGraphAddDependencies(
@@ -3,6 +3,7 @@
 #include <muda/compute_graph/nodes/compute_graph_catpure_node.h>
 #include <muda/compute_graph/nodes/compute_graph_memory_node.h>
 #include <muda/compute_graph/nodes/compute_graph_event_node.h>
+#include <muda/compute_graph/nodes/compute_graph_conditional_node.h>
 #include <muda/compute_graph/compute_graph_closure.h>
 #include <muda/compute_graph/compute_graph_builder.h>
 
@@ -443,6 +444,155 @@ namespace details
     }
 
 
+    MUDA_INLINE void ComputeGraphAccessor::set_conditional_node(ComputeGraphConditionalType type,
+                                                                const int*    cond,
+                                                                ComputeGraph& body)
+    {
+        switch(ComputeGraphBuilder::current_phase())
+        {
+            case ComputeGraphPhase::TopoBuilding:
+                // fall through
+            case ComputeGraphPhase::Building:
+                add_conditional_node(type, cond, body);
+                break;
+            case ComputeGraphPhase::Updating:
+                update_conditional_node(cond, body);
+                break;
+            default:
+                MUDA_ERROR_WITH_LOCATION("invalid phase");
+                break;
+        }
+    }
+
+    // a single thread kernel node calling `func(args...)`
+    MUDA_INLINE cudaKernelNodeParams conditional_kernel_parms(void* func, void** args)
+    {
+        cudaKernelNodeParams parms{};
+        parms.func           = func;
+        parms.gridDim        = dim3{1, 1, 1};
+        parms.blockDim       = dim3{1, 1, 1};
+        parms.sharedMemBytes = 0;
+        parms.kernelParams   = args;
+        parms.extra          = nullptr;
+        return parms;
+    }
+
+    MUDA_INLINE void ComputeGraphAccessor::add_conditional_node(ComputeGraphConditionalType type,
+                                                                const int*    cond,
+                                                                ComputeGraph& body)
+    {
+        access_graph(
+            [&](Graph& g)
+            {
+                auto node = get_or_create_node<ComputeGraphConditionalNode>(
+                    [&]
+                    {
+                        return new ComputeGraphConditionalNode{
+                            NodeId{m_cg.m_nodes.size()}, m_cg.current_access_index(), type};
+                    });
+                if(!ComputeGraphBuilder::is_building())
+                    return;
+
+                node->update_sub_graph(body.serial_capture());
+                auto is_while = type == ComputeGraphConditionalType::While;
+
+#if MUDA_WITH_GRAPH_CONDITIONAL_NODE
+                checkCudaErrors(cudaGraphConditionalHandleCreate(&node->m_handle, g.handle(), 0, 0));
+
+                void* args[]     = {&node->m_handle, &cond};
+                auto  set_parms  = conditional_kernel_parms(
+                    (void*)&details::compute_graph_set_conditional<int>, args);
+                checkCudaErrors(cudaGraphAddKernelNode(&node->m_head, g.handle(), nullptr, 0, &set_parms));
+
+                cudaGraphNodeParams cond_parms{};
+                cond_parms.type               = cudaGraphNodeTypeConditional;
+                cond_parms.conditional.handle = node->m_handle;
+                cond_parms.conditional.type =
+                    is_while ? cudaGraphCondTypeWhile : cudaGraphCondTypeIf;
+                cond_parms.conditional.size = 1;
+                cudaGraphNode_t cond_node;
+                checkCudaErrors(cudaGraphAddNode(&cond_node, g.handle(), &node->m_head, 1, &cond_parms));
+
+                auto body_graph = cond_parms.conditional.phGraph_out[0];
+                checkCudaErrors(cudaGraphAddChildGraphNode(
+                    &node->m_body, body_graph, nullptr, 0, node->m_sub_graph));
+                if(is_while)  // re-evaluate the condition after each iteration
+                    checkCudaErrors(cudaGraphAddKernelNode(
+                        &node->m_tail, body_graph, &node->m_body, 1, &set_parms));
+
+                node->set_entry_handle(node->m_head);
+                node->set_handle(cond_node);
+#else
+                MUDA_ASSERT(m_cg.m_flags.has(muda::GraphInstantiateFlagBit::DeviceLaunch),
+                            "Without conditional graph node (cuda 12.4+), the conditional node "
+                            "relaunches its body by tail launch, so the graph should be created "
+                            "with ComputeGraphFlag::DeviceLaunch");
+
+                checkCudaErrors(cudaGraphCreate(&node->m_body_graph, 0));
+                checkCudaErrors(cudaGraphAddChildGraphNode(
+                    &node->m_body, node->m_body_graph, nullptr, 0, node->m_sub_graph));
+                if(is_while)
+                {
+                    void* args[] = {&cond};
+                    auto  parms  = conditional_kernel_parms(
+                        (void*)&details::compute_graph_conditional_relaunch<int>, args);
+                    checkCudaErrors(cudaGraphAddKernelNode(
+                        &node->m_tail, node->m_body_graph, &node->m_body, 1, &parms));
+                }
+                checkCudaErrors(cudaGraphInstantiateWithFlags(
+                    &node->m_body_exec, node->m_body_graph, cudaGraphInstantiateFlagDeviceLaunch));
+                checkCudaErrors(cudaGraphUpload(node->m_body_exec, nullptr));
+
+                void* args[] = {&node->m_body_exec, &cond};
+                auto  parms  = conditional_kernel_parms(
+                    (void*)&details::compute_graph_conditional_launch<int>, args);
+                checkCudaErrors(cudaGraphAddKernelNode(&node->m_head, g.handle(), nullptr, 0, &parms));
+                node->set_handle(node->m_head);
+#endif
+            });
+    }
+
+    MUDA_INLINE void ComputeGraphAccessor::update_conditional_node(const int* cond, ComputeGraph& body)
+    {
+        access_graph_exec(
+            [&](GraphExec& g_exec)
+            {
+                auto node = current_node<ComputeGraphConditionalNode>();
+                node->update_sub_graph(body.serial_capture());
+
+#if MUDA_WITH_GRAPH_CONDITIONAL_NODE
+                void* args[]    = {&node->m_handle, &cond};
+                auto  set_parms = conditional_kernel_parms(
+                    (void*)&details::compute_graph_set_conditional<int>, args);
+                checkCudaErrors(cudaGraphExecKernelNodeSetParams(
+                    g_exec.handle(), node->m_head, &set_parms));
+                checkCudaErrors(cudaGraphExecChildGraphNodeSetParams(
+                    g_exec.handle(), node->m_body, node->m_sub_graph));
+                if(node->m_tail)
+                    checkCudaErrors(cudaGraphExecKernelNodeSetParams(
+                        g_exec.handle(), node->m_tail, &set_parms));
+#else
+                checkCudaErrors(cudaGraphExecChildGraphNodeSetParams(
+                    node->m_body_exec, node->m_body, node->m_sub_graph));
+                if(node->m_tail)
+                {
+                    void* args[] = {&cond};
+                    auto  parms  = conditional_kernel_parms(
+                        (void*)&details::compute_graph_conditional_relaunch<int>, args);
+                    checkCudaErrors(cudaGraphExecKernelNodeSetParams(
+                        node->m_body_exec, node->m_tail, &parms));
+                }
+                checkCudaErrors(cudaGraphUpload(node->m_body_exec, nullptr));
+
+                void* args[] = {&node->m_body_exec, &cond};
+                auto  parms  = conditional_kernel_parms(
+                    (void*)&details::compute_graph_conditional_launch<int>, args);
+                checkCudaErrors(cudaGraphExecKernelNodeSetParams(
+                    g_exec.handle(), node->m_head, &parms));
+#endif
+            });
+    }
+
     template <typename F>
     void ComputeGraphAccessor::access_graph(F&& f)
     {
@@ -470,7 +620,19 @@ namespace details
             return ptr;
         }
         else
-            return current_node<NodeType>();
+        {
+            const auto& [name, closure] = current_closure();
+            MUDA_ASSERT(m_cg.current_access_index() < closure->m_graph_nodes.size(),
+                        "closure[%s] accesses more graph nodes than its topology records, "
+                        "the imported topology may be stale",
+                        name.c_str());
+            auto node = current_node<NodeType>();
+            MUDA_ASSERT(node,
+                        "closure[%s] accesses a graph node of another type than its topology records, "
+                        "the imported topology may be stale",
+                        name.c_str());
+            return node;
+        }
     }
     MUDA_INLINE void ComputeGraphAccessor::set_var_usage(VarId id, ComputeGraphVarUsage usage)
     {
@@ -8,12 +8,11 @@ MUDA_INLINE ComputeGraphNode<NodeT, Type>::ComputeGraphNode(NodeId node_id, uint
 {
     if constexpr(Type == ComputeGraphNodeType::KernelNode)
     {
-        auto n = std::string_view{
-            details::LaunchInfoCache::current_kernel_name().auto_select()};
+        auto n = details::LaunchInfoCache::current_kernel_name().view();
         if(n.empty() || n == "")
             m_name += std::string(":~");
         else
-            m_name += std::string(":") + std::string(n.data());
+            m_name += std::string(":") + std::string(n);
     }
 }
 
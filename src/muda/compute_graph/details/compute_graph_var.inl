@@ -5,6 +5,7 @@ namespace muda
 {
 MUDA_INLINE void ComputeGraphVarBase::base_update()
 {
+    std::lock_guard lock{m_related_closure_infos_mutex};
     for(auto& [graph, info] : m_related_closure_infos)
     {
         graph->m_need_update = true;
@@ -28,13 +29,17 @@ MUDA_INLINE void ComputeGraphVarBase::_building_eval(ComputeGraphVarUsage usage)
 {
     auto acc   = details::ComputeGraphAccessor();
     auto graph = ComputeGraphBuilder::instance().current_graph();
-    m_related_closure_infos[graph].closure_ids.insert(graph->current_closure_id());
+    {
+        std::lock_guard lock{m_related_closure_infos_mutex};
+        m_related_closure_infos[graph].closure_ids.insert(graph->current_closure_id());
+    }
     graph->emplace_related_var(const_cast<ComputeGraphVarBase*>(this));
     acc.set_var_usage(var_id(), usage);
 }
 
 MUDA_INLINE void ComputeGraphVarBase::remove_related_closure_infos(ComputeGraph* graph)
 {
+    std::lock_guard lock{m_related_closure_infos_mutex};
     auto iter = m_related_closure_infos.find(graph);
     if(iter != m_related_closure_infos.end())
     {
@@ -64,9 +69,19 @@ MUDA_INLINE void ComputeGraphVarBase::update()
     this->base_update();
 }
 
-MUDA_INLINE Event::QueryResult ComputeGraphVarBase::query()
+MUDA_INLINE std::vector<ComputeGraph*> ComputeGraphVarBase::related_graphs() const
 {
+    std::lock_guard            lock{m_related_closure_infos_mutex};
+    std::vector<ComputeGraph*> graphs;
+    graphs.reserve(m_related_closure_infos.size());
     for(auto& [graph, info] : m_related_closure_infos)
+        graphs.push_back(graph);
+    return graphs;
+}
+
+MUDA_INLINE Event::QueryResult ComputeGraphVarBase::query()
+{
+    for(auto graph : related_graphs())
     {
         if(graph->query() == Event::QueryResult::eNotReady)
             return Event::QueryResult::eNotReady;
@@ -81,7 +96,7 @@ MUDA_INLINE bool ComputeGraphVarBase::is_using()
 
 MUDA_INLINE void ComputeGraphVarBase::sync()
 {
-    for (auto& [graph, info] : m_related_closure_infos)
+    for(auto graph : related_graphs())
     {
         checkCudaErrors(cudaEventSynchronize(graph->m_event));
     }
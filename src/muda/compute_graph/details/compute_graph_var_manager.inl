@@ -18,30 +18,35 @@ constexpr void check_var_type()
                   "please use cudaEvent_t as a ComputeGraphVar");
 }
 
-template <typename T>
-MUDA_INLINE ComputeGraphVar<T>& ComputeGraphVarManager::create_var(std::string_view name)
+template <typename Var, typename... Args>
+MUDA_INLINE Var& ComputeGraphVarManager::emplace_var(std::string_view name, Args&&... args)
 {
-    check_var_type<T>();
-    auto ptr = new ComputeGraphVar<T>(this, name, VarId{m_vars.size()});
-    m_vars.emplace_back(ptr);
+    std::lock_guard lock{m_mutex};
     if(m_vars_map.find(std::string{name}) != m_vars_map.end())
         MUDA_ERROR_WITH_LOCATION("var[%s] already exists", name.data());
+    auto ptr = new Var(this, name, VarId{m_vars.size()}, std::forward<Args>(args)...);
+    m_vars.emplace_back(ptr);
     m_vars_map.emplace(name, ptr);
     return *ptr;
 }
+
+template <typename T>
+MUDA_INLINE ComputeGraphVar<T>& ComputeGraphVarManager::create_var(std::string_view name)
+{
+    check_var_type<T>();
+    return emplace_var<ComputeGraphVar<T>>(name);
+}
 template <typename T>
 MUDA_INLINE ComputeGraphVar<T>& ComputeGraphVarManager::create_var(std::string_view name,
                                                                    const T& init_value)
 {
     check_var_type<T>();
-    auto ptr = new ComputeGraphVar<T>(this, name, VarId{m_vars.size()}, init_value);
-    m_vars.emplace_back(ptr);
-    m_vars_map.emplace(name, ptr);
-    return *ptr;
+    return emplace_var<ComputeGraphVar<T>>(name, init_value);
 }
 template <typename T>
 MUDA_INLINE ComputeGraphVar<T>* ComputeGraphVarManager::find_var(std::string_view name)
 {
+    std::lock_guard lock{m_mutex};
     auto it = m_vars_map.find(std::string{name});
     if(it == m_vars_map.end())
         return nullptr;
@@ -74,19 +79,41 @@ MUDA_INLINE auto ComputeGraphVarManager::create_graph(std::string_view name, Com
     return std::make_shared<ComputeGraph>(*this, name, flags);
 }
 
+MUDA_INLINE ComputeGraphVarBase* ComputeGraphVarManager::find_var_base(std::string_view name) const
+{
+    std::lock_guard lock{m_mutex};
+    auto            it = m_vars_map.find(std::string{name});
+    return it == m_vars_map.end() ? nullptr : it->second;
+}
+
+MUDA_INLINE void ComputeGraphVarManager::register_graph(ComputeGraph* graph)
+{
+    std::lock_guard lock{m_mutex};
+    m_graphs.insert(graph);
+}
+
+MUDA_INLINE void ComputeGraphVarManager::unregister_graph(ComputeGraph* graph)
+{
+    std::lock_guard lock{m_mutex};
+    m_graphs.erase(graph);
+}
+
 MUDA_INLINE bool ComputeGraphVarManager::is_using() const
 {
-    return is_using(var_span());
+    auto vars = vars_snapshot();
+    return is_using(span<const ComputeGraphVarBase*>{vars});
 }
 
 MUDA_INLINE void ComputeGraphVarManager::sync() const
 {
-    sync(var_span());
+    auto vars = vars_snapshot();
+    sync(span<const ComputeGraphVarBase*>{vars});
 }
 
 MUDA_INLINE void ComputeGraphVarManager::sync_on(cudaStream_t stream) const
 {
-    sync_on(stream, var_span());
+    auto vars = vars_snapshot();
+    sync_on(stream, span<const ComputeGraphVarBase*>{vars});
 }
 
 MUDA_INLINE bool ComputeGraphVarManager::is_using(const span<const ComputeGraphVarBase*> vars) const
@@ -124,6 +151,8 @@ MUDA_INLINE void ComputeGraphVarManager::graphviz(std::ostream& o,
 {
     auto opt = options;
 
+    std::lock_guard lock{m_mutex};
+
     o << "digraph G {\n";
     o << options.graph_font << "\n";
     if(opt.show_vars)
@@ -157,6 +186,7 @@ MUDA_INLINE std::vector<ComputeGraph*> ComputeGraphVarManager::unique_graphs(
     std::vector<ComputeGraph*> graphs;
     for(auto var : vars)
     {
+        std::lock_guard lock{var->m_related_closure_infos_mutex};
         for(auto& [graph, _] : var->m_related_closure_infos)
         {
             graphs.emplace_back(graph);
@@ -168,9 +198,9 @@ MUDA_INLINE std::vector<ComputeGraph*> ComputeGraphVarManager::unique_graphs(
     return graphs;
 }
 
-MUDA_INLINE span<const ComputeGraphVarBase*> ComputeGraphVarManager::var_span() const
+MUDA_INLINE std::vector<const ComputeGraphVarBase*> ComputeGraphVarManager::vars_snapshot() const
 {
-    return span<const ComputeGraphVarBase*>{
-        const_cast<const ComputeGraphVarBase**>(m_vars.data()), m_vars.size()};
+    std::lock_guard lock{m_mutex};
+    return std::vector<const ComputeGraphVarBase*>{m_vars.begin(), m_vars.end()};
 }
 }  // namespace muda
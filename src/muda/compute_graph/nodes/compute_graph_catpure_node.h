@@ -15,12 +15,11 @@ class ComputeGraphCaptureNode : public ComputeGraphNodeBase
                                access_index,
                                ComputeGraphNodeType::CaptureNode)
     {
-        auto n = std::string_view{
-            details::LaunchInfoCache::current_capture_name().auto_select()};
+        auto n = details::LaunchInfoCache::current_capture_name().view();
         if(n.empty() || n == "")
             m_name += std::string(":~");
         else
-            m_name += std::string(":") + std::string(n.data());
+            m_name += std::string(":") + std::string(n);
     }
 
     virtual ~ComputeGraphCaptureNode() override { update_sub_graph(nullptr); }
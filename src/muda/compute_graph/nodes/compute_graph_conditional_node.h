@@ -0,0 +1,106 @@
+#pragma once
+#include <muda/compute_graph/compute_graph_node.h>
+#include <muda/compute_graph/compute_graph_conditional_type.h>
+#include <muda/graph/graph.h>
+#include <muda/graph/graph_viewer.h>
+
+namespace muda
+{
+namespace details
+{
+#if MUDA_WITH_GRAPH_CONDITIONAL_NODE
+    // forward the condition on device to the conditional node
+    template <typename T>
+    MUDA_GLOBAL void compute_graph_set_conditional(cudaGraphConditionalHandle handle,
+                                                   const T* cond)
+    {
+        cudaGraphSetConditional(handle, *cond != 0 ? 1u : 0u);
+    }
+#else
+    // launch the body after the current graph finishes
+    template <typename T>
+    MUDA_GLOBAL void compute_graph_conditional_launch(cudaGraphExec_t body, const T* cond)
+    {
+        if(*cond != 0)
+            GraphViewer{body, GraphInstantiateFlagBit::DeviceLaunch}.tail_launch();
+    }
+
+    // relaunch the graph this kernel belongs to
+    template <typename T>
+    MUDA_GLOBAL void compute_graph_conditional_relaunch(const T* cond)
+    {
+#if defined(__CUDA_ARCH__) && !defined(__CUDACC_RDC__)
+        // cudaGetCurrentGraphExec is part of the device runtime
+        MUDA_KERNEL_ERROR_WITH_LOCATION(
+            "ComputeGraph: relaunching a conditional node body needs -rdc=true (MUDA_WITH_RDC) before cuda 12.4");
+#else
+        if(*cond != 0)
+            GraphViewer{cudaGetCurrentGraphExec(), GraphInstantiateFlagBit::DeviceLaunch}
+                .tail_launch();
+#endif
+    }
+#endif
+}  // namespace details
+
+/**
+ * \brief A node running another ComputeGraph (the body) under a device-side condition.
+ *
+ * With conditional graph nodes (cuda 12.4+), the node expands to:
+ *  head(kernel: set condition) -> conditional(body: child graph [-> tail(kernel: set condition)])
+ *
+ * Otherwise the body is wrapped in a device graph relaunched by tail launch:
+ *  head(kernel: tail launch body if condition) ==> body: child graph [-> tail(kernel: relaunch if condition)]
+ * In this mode the body runs after the whole graph finishes, so no other node
+ * may depend on the conditional node, and the translation unit building the
+ * graph must be compiled with -rdc=true (MUDA_WITH_RDC).
+ */
+class ComputeGraphConditionalNode : public ComputeGraphNodeBase
+{
+  protected:
+    friend class ComputeGraph;
+    friend class details::ComputeGraphAccessor;
+    ComputeGraphConditionalNode(NodeId node_id, uint64_t access_index, ComputeGraphConditionalType type)
+        : ComputeGraphNodeBase(enum_name(ComputeGraphNodeType::ConditionalNode),
+                               node_id,
+                               access_index,
+                               ComputeGraphNodeType::ConditionalNode)
+        , m_cond_type(type)
+    {
+        m_name += type == ComputeGraphConditionalType::While ? ":while" : ":if";
+    }
+
+    virtual ~ComputeGraphConditionalNode() override
+    {
+        update_sub_graph(nullptr);
+#if !MUDA_WITH_GRAPH_CONDITIONAL_NODE
+        if(m_body_exec)
+            checkCudaErrors(cudaGraphExecDestroy(m_body_exec));
+        if(m_body_graph)
+            checkCudaErrors(cudaGraphDestroy(m_body_graph));
+#endif
+    }
+
+    void update_sub_graph(cudaGraph_t sub_graph)
+    {
+        if(m_sub_graph)
+            checkCudaErrors(cudaGraphDestroy(m_sub_graph));
+        m_sub_graph = sub_graph;
+    }
+
+    ComputeGraphConditionalType m_cond_type;
+    // the captured body
+    cudaGraph_t m_sub_graph = nullptr;
+    // the set-condition / launch kernel in front of the conditional node
+    cudaGraphNode_t m_head = nullptr;
+    // the child graph node holding `m_sub_graph`
+    cudaGraphNode_t m_body = nullptr;
+    // the kernel re-evaluating the condition after each iteration (While only)
+    cudaGraphNode_t m_tail = nullptr;
+#if MUDA_WITH_GRAPH_CONDITIONAL_NODE
+    cudaGraphConditionalHandle m_handle{};
+#else
+    cudaGraph_t     m_body_graph = nullptr;
+    cudaGraphExec_t m_body_exec  = nullptr;
+#endif
+};
+}  // namespace muda
@@ -6,9 +6,18 @@
 #include <muda/buffer/buffer_launch.h>
 #include <muda/compute_graph/compute_graph.h>
 #include <muda/launch/stream.h>
+#include <muda/cub/host/host_algorithms.h>
 
 namespace muda
 {
+enum class CubBackend
+{
+    // cub on the stream of the wrapper, the default
+    Device,
+    // multi-threaded host implementation, synchronous, iterators must be host accessible
+    Host,
+};
+
 template <typename Derive>
 class CubWrapper : public LaunchBase<Derive>
 {
@@ -28,6 +37,29 @@ class CubWrapper : public LaunchBase<Derive>
     // meaningless for cub, so we just delete it
     void kernel_name(std::string_view) = delete;
 
+    /**
+     * \brief Select the backend of this wrapper.
+     *
+     * With `CubBackend::Host`, the call runs on `HostThreadPool::global()` before returning,
+     * the stream is not touched. All iterators must be host accessible and user operators
+     * `__host__` callable. Overloads taking `d_temp_storage` and the wrappers without
+     * a host implementation only support `CubBackend::Device`.
+     *
+     * \code
+     *  DeviceRadixSort().backend(CubBackend::Host).SortPairs(keys_in, keys_out, values_in, values_out, n);
+     * \endcode
+     */
+    Derive& backend(CubBackend backend)
+    {
+        m_backend = backend;
+        return static_cast<Derive&>(*this);
+    }
+    CubBackend backend() const { return m_backend; }
+    bool       is_host_backend() const { return m_backend == CubBackend::Host; }
+
     Stream* m_muda_stream = nullptr;
+
+  private:
+    CubBackend m_backend = CubBackend::Device;
 };
 }  // namespace muda
@@ -2,6 +2,9 @@
 // because it should be inserted in multiple files
 
 #define MUDA_CUB_WRAPPER_IMPL(x)                                               \
+    MUDA_ASSERT(!this->is_host_backend(),                                      \
+                "%s has no host implementation, use CubBackend::Device",      \
+                __func__);                                                     \
     cudaStream_t _stream            = this->stream();                          \
     size_t       temp_storage_bytes = 0;                                       \
     void*        d_temp_storage     = nullptr;                                 \
@@ -15,6 +18,9 @@
     return *this;
 
 #define MUDA_CUB_WRAPPER_FOR_COMPUTE_GRAPH_IMPL(x)                                                        \
+    MUDA_ASSERT(!this->is_host_backend(),                                                                 \
+                "%s with d_temp_storage only supports CubBackend::Device",                                \
+                __func__);                                                                                \
     std::string_view name{__func__};                                                                      \
     ComputeGraphBuilder::invoke_phase_actions(                                                            \
         [&]                                                                                               \
@@ -32,3 +38,11 @@
                 name, [&](cudaStream_t _stream) { checkCudaErrors(x); });                                 \
         });                                                                                               \
     return *this;
+
+// run the host implementation `x` and return, when the host backend is selected
+#define MUDA_CUB_WRAPPER_HOST_IMPL(x)                                          \
+    if(this->is_host_backend())                                                \
+    {                                                                          \
+        x;                                                                     \
+        return *this;                                                          \
+    }
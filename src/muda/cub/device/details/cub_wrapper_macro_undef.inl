@@ -1,4 +1,5 @@
 // don't place #pragma once at the beginning of this file
 // because it should be inserted in multiple files
 #undef MUDA_CUB_WRAPPER_FOR_COMPUTE_GRAPH_IMPL
-#undef MUDA_CUB_WRAPPER_IMPL
\ No newline at end of file
+#undef MUDA_CUB_WRAPPER_IMPL
+#undef MUDA_CUB_WRAPPER_HOST_IMPL
@@ -27,6 +27,8 @@ class DeviceHistogram : public CubWrapper<DeviceHistogram>
                                    LevelT          upper_level,
                                    OffsetT         num_samples)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::histogram_even(
+            d_samples, d_histogram, num_levels, lower_level, upper_level, num_samples));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceHistogram::HistogramEven(d_temp_storage,
                                                                   temp_storage_bytes,
                                                                   d_samples,
@@ -119,6 +121,8 @@ class DeviceHistogram : public CubWrapper<DeviceHistogram>
                                     LevelT*         d_levels,
                                     OffsetT         num_samples)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::histogram_range(
+            d_samples, d_histogram, num_levels, d_levels, num_samples));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceHistogram::HistogramRange(
             d_temp_storage, temp_storage_bytes, d_samples, d_histogram, num_levels, d_levels, num_samples, _stream, false));
     }
@@ -18,6 +18,8 @@ class DeviceMergeSort : public CubWrapper<DeviceMergeSort>
     template <typename KeyIteratorT, typename ValueIteratorT, typename OffsetT, typename CompareOpT>
     DeviceMergeSort& SortPairs(KeyIteratorT d_keys, ValueIteratorT d_items, OffsetT num_items, CompareOpT compare_op)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::merge_sort<true>(
+            d_keys, d_items, d_keys, d_items, num_items, compare_op));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceMergeSort::SortPairs(
             d_temp_storage, temp_storage_bytes, d_keys, d_items, num_items, compare_op, _stream, false));
     }
@@ -30,6 +32,8 @@ class DeviceMergeSort : public CubWrapper<DeviceMergeSort>
                                    OffsetT             num_items,
                                    CompareOpT          compare_op)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::merge_sort<true>(
+            d_input_keys, d_input_items, d_output_keys, d_output_items, num_items, compare_op));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceMergeSort::SortPairsCopy(d_temp_storage,
                                                                   temp_storage_bytes,
                                                                   d_input_keys,
@@ -45,6 +49,8 @@ class DeviceMergeSort : public CubWrapper<DeviceMergeSort>
     template <typename KeyIteratorT, typename OffsetT, typename CompareOpT>
     DeviceMergeSort& SortKeys(KeyIteratorT d_keys, OffsetT num_items, CompareOpT compare_op)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::merge_sort<false>(
+            d_keys, d_keys, d_keys, d_keys, num_items, compare_op));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceMergeSort::SortKeys(
             d_temp_storage, temp_storage_bytes, d_keys, num_items, compare_op, _stream, false));
     }
@@ -55,6 +61,8 @@ class DeviceMergeSort : public CubWrapper<DeviceMergeSort>
                                   OffsetT           num_items,
                                   CompareOpT        compare_op)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::merge_sort<false>(
+            d_input_keys, d_input_keys, d_output_keys, d_output_keys, num_items, compare_op));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceMergeSort::SortKeysCopy(
             d_temp_storage, temp_storage_bytes, d_input_keys, d_output_keys, num_items, compare_op, _stream, false));
     }
@@ -65,6 +73,8 @@ class DeviceMergeSort : public CubWrapper<DeviceMergeSort>
                                      OffsetT        num_items,
                                      CompareOpT     compare_op)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::merge_sort<true>(
+            d_keys, d_items, d_keys, d_items, num_items, compare_op));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceMergeSort::StableSortPairs(
             d_temp_storage, temp_storage_bytes, d_keys, d_items, num_items, compare_op, _stream, false));
     }
@@ -72,6 +82,8 @@ class DeviceMergeSort : public CubWrapper<DeviceMergeSort>
     template <typename KeyIteratorT, typename OffsetT, typename CompareOpT>
     DeviceMergeSort& StableSortKeys(KeyIteratorT d_keys, OffsetT num_items, CompareOpT compare_op)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::merge_sort<false>(
+            d_keys, d_keys, d_keys, d_keys, num_items, compare_op));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceMergeSort::StableSortKeys(
             d_temp_storage, temp_storage_bytes, d_keys, num_items, compare_op, _stream, false));
     }
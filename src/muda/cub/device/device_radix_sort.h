@@ -30,6 +30,8 @@ class DeviceRadixSort : public CubWrapper<DeviceRadixSort>
                                int           begin_bit = 0,
                                int           end_bit   = sizeof(KeyT) * 8)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::radix_sort(
+            d_keys_in, d_keys_out, d_values_in, d_values_out, num_items, begin_bit, end_bit, false));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceRadixSort::SortPairs(d_temp_storage,
                                                               temp_storage_bytes,
                                                               d_keys_in,
@@ -50,6 +52,8 @@ class DeviceRadixSort : public CubWrapper<DeviceRadixSort>
                                int                        begin_bit = 0,
                                int end_bit = sizeof(KeyT) * 8)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::radix_sort(
+            d_keys, d_values, num_items, begin_bit, end_bit, false));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceRadixSort::SortPairs(
             d_temp_storage, temp_storage_bytes, d_keys, d_values, num_items, begin_bit, end_bit, _stream));
     }
@@ -63,6 +67,8 @@ class DeviceRadixSort : public CubWrapper<DeviceRadixSort>
                                          int           begin_bit = 0,
                                          int end_bit = sizeof(KeyT) * 8)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::radix_sort(
+            d_keys_in, d_keys_out, d_values_in, d_values_out, num_items, begin_bit, end_bit, true));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceRadixSort::SortPairsDescending(
             d_temp_storage, temp_storage_bytes, d_keys_in, d_keys_out, d_values_in, d_values_out, num_items, begin_bit, end_bit, _stream));
     }
@@ -74,6 +80,8 @@ class DeviceRadixSort : public CubWrapper<DeviceRadixSort>
                                          int begin_bit = 0,
                                          int end_bit   = sizeof(KeyT) * 8)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::radix_sort(
+            d_keys, d_values, num_items, begin_bit, end_bit, true));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceRadixSort::SortPairsDescending(
             d_temp_storage, temp_storage_bytes, d_keys, d_values, num_items, begin_bit, end_bit, _stream));
     }
@@ -85,6 +93,8 @@ class DeviceRadixSort : public CubWrapper<DeviceRadixSort>
                               int         begin_bit = 0,
                               int         end_bit   = sizeof(KeyT) * 8)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::radix_sort_keys(
+            d_keys_in, d_keys_out, num_items, begin_bit, end_bit, false));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceRadixSort::SortKeys(
             d_temp_storage, temp_storage_bytes, d_keys_in, d_keys_out, num_items, begin_bit, end_bit, _stream));
     }
@@ -95,6 +105,8 @@ class DeviceRadixSort : public CubWrapper<DeviceRadixSort>
                               int                      begin_bit = 0,
                               int end_bit = sizeof(KeyT) * 8)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::radix_sort_keys(
+            d_keys, num_items, begin_bit, end_bit, false));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceRadixSort::SortKeys(
             d_temp_storage, temp_storage_bytes, d_keys, num_items, begin_bit, end_bit, _stream));
     }
@@ -106,6 +118,8 @@ class DeviceRadixSort : public CubWrapper<DeviceRadixSort>
                                         int         begin_bit = 0,
                                         int         end_bit = sizeof(KeyT) * 8)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::radix_sort_keys(
+            d_keys_in, d_keys_out, num_items, begin_bit, end_bit, true));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceRadixSort::SortKeysDescending(
             d_temp_storage, temp_storage_bytes, d_keys_in, d_keys_out, num_items, begin_bit, end_bit, _stream));
     }
@@ -116,6 +130,8 @@ class DeviceRadixSort : public CubWrapper<DeviceRadixSort>
                                         int                      begin_bit = 0,
                                         int end_bit = sizeof(KeyT) * 8)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::radix_sort_keys(
+            d_keys, num_items, begin_bit, end_bit, true));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceRadixSort::SortKeysDescending(
             d_temp_storage, temp_storage_bytes, d_keys, num_items, begin_bit, end_bit, _stream));
     }
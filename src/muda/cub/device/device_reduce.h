@@ -24,6 +24,8 @@ class DeviceReduce : public CubWrapper<DeviceReduce>
                          ReductionOpT    reduction_op,
                          T               init)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::reduce(
+            d_in, d_out, num_items, reduction_op, init));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceReduce::Reduce(
             d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, reduction_op, init, _stream, false));
     }
@@ -31,6 +33,7 @@ class DeviceReduce : public CubWrapper<DeviceReduce>
     template <typename InputIteratorT, typename OutputIteratorT>
     DeviceReduce& Sum(InputIteratorT d_in, OutputIteratorT d_out, int num_items)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::sum(d_in, d_out, num_items));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceReduce::Sum(
             d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false));
     }
@@ -39,6 +42,7 @@ class DeviceReduce : public CubWrapper<DeviceReduce>
     template <typename InputIteratorT, typename OutputIteratorT>
     DeviceReduce& Min(InputIteratorT d_in, OutputIteratorT d_out, int num_items)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::reduce_min(d_in, d_out, num_items));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceReduce::Min(
             d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false));
     }
@@ -47,6 +51,7 @@ class DeviceReduce : public CubWrapper<DeviceReduce>
     template <typename InputIteratorT, typename OutputIteratorT>
     DeviceReduce& ArgMin(InputIteratorT d_in, OutputIteratorT d_out, int num_items)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::arg_min(d_in, d_out, num_items));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceReduce::ArgMin(
             d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false));
     }
@@ -56,6 +61,7 @@ class DeviceReduce : public CubWrapper<DeviceReduce>
     DeviceReduce& Max(InputIteratorT d_in, OutputIteratorT d_out, int num_items)
     {
 
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::reduce_max(d_in, d_out, num_items));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceReduce::Max(
             d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false));
     }
@@ -64,6 +70,7 @@ class DeviceReduce : public CubWrapper<DeviceReduce>
     template <typename InputIteratorT, typename OutputIteratorT>
     DeviceReduce& ArgMax(InputIteratorT d_in, OutputIteratorT d_out, int num_items)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::arg_max(d_in, d_out, num_items));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceReduce::ArgMax(
             d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false));
     }
@@ -77,6 +84,8 @@ class DeviceReduce : public CubWrapper<DeviceReduce>
                               ReductionOpT              reduction_op,
                               int                       num_items)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::reduce_by_key(
+            d_keys_in, d_unique_out, d_values_in, d_aggregates_out, d_num_runs_out, reduction_op, num_items));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceReduce::ReduceByKey(d_temp_storage,
                                                              temp_storage_bytes,
                                                              d_keys_in,
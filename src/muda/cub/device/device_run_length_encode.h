@@ -22,6 +22,8 @@ class DeviceRunLengthEncode : public CubWrapper<DeviceRunLengthEncode>
                                   NumRunsOutputIteratorT d_num_runs_out,
                                   int                    num_items)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::run_length_encode(
+            d_in, d_unique_out, d_counts_out, d_num_runs_out, num_items));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceRunLengthEncode::Encode(
             d_temp_storage, temp_storage_bytes, d_in, d_unique_out, d_counts_out, d_num_runs_out, num_items, _stream, false));
     }
@@ -33,6 +35,8 @@ class DeviceRunLengthEncode : public CubWrapper<DeviceRunLengthEncode>
                                           NumRunsOutputIteratorT d_num_runs_out,
                                           int                    num_items)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::non_trivial_runs(
+            d_in, d_offsets_out, d_lengths_out, d_num_runs_out, num_items));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceRunLengthEncode::NonTrivialRuns(
             d_temp_storage, temp_storage_bytes, d_in, d_offsets_out, d_lengths_out, d_num_runs_out, num_items, _stream, false));
     }
@@ -27,6 +27,7 @@ class DeviceScan : public CubWrapper<DeviceScan>
     template <typename InputIteratorT, typename OutputIteratorT>
     DeviceScan& ExclusiveSum(InputIteratorT d_in, OutputIteratorT d_out, int num_items)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::exclusive_sum(d_in, d_out, num_items));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceScan::ExclusiveSum(
             d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false));
     }
@@ -39,6 +40,8 @@ class DeviceScan : public CubWrapper<DeviceScan>
                               InitValueT      init_value,
                               int             num_items)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::exclusive_scan(
+            d_in, d_out, scan_op, init_value, num_items));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceScan::ExclusiveScan(
             d_temp_storage, temp_storage_bytes, d_in, d_out, scan_op, init_value, num_items, _stream, false));
     }
@@ -47,6 +50,7 @@ class DeviceScan : public CubWrapper<DeviceScan>
     template <typename InputIteratorT, typename OutputIteratorT>
     DeviceScan& InclusiveSum(InputIteratorT d_in, OutputIteratorT d_out, int num_items)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::inclusive_sum(d_in, d_out, num_items));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceScan::InclusiveSum(
             d_temp_storage, temp_storage_bytes, d_in, d_out, num_items, _stream, false));
     }
@@ -54,6 +58,8 @@ class DeviceScan : public CubWrapper<DeviceScan>
     template <typename InputIteratorT, typename OutputIteratorT, typename ScanOpT>
     DeviceScan& InclusiveScan(InputIteratorT d_in, OutputIteratorT d_out, ScanOpT scan_op, int num_items)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::inclusive_scan<details::host_cub::value_t<InputIteratorT>>(
+            d_in, d_out, scan_op, num_items));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceScan::InclusiveScan(
             d_temp_storage, temp_storage_bytes, d_in, d_out, scan_op, num_items, _stream, false));
     }
@@ -65,6 +71,8 @@ class DeviceScan : public CubWrapper<DeviceScan>
                                   int                   num_items,
                                   EqualityOpT equality_op = EqualityOpT())
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::exclusive_sum_by_key(
+            d_keys_in, d_values_in, d_values_out, num_items, equality_op));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceScan::ExclusiveSumByKey(
             d_temp_storage, temp_storage_bytes, d_keys_in, d_values_in, d_values_out, num_items, equality_op, _stream, false));
     }
@@ -78,6 +86,8 @@ class DeviceScan : public CubWrapper<DeviceScan>
                                    int                   num_items,
                                    EqualityOpT equality_op = EqualityOpT())
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::exclusive_scan_by_key(
+            d_keys_in, d_values_in, d_values_out, scan_op, init_value, num_items, equality_op));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceScan::ExclusiveScanByKey(d_temp_storage,
                                                                   temp_storage_bytes,
                                                                   d_keys_in,
@@ -98,6 +108,8 @@ class DeviceScan : public CubWrapper<DeviceScan>
                                   int                   num_items,
                                   EqualityOpT equality_op = EqualityOpT())
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::inclusive_sum_by_key(
+            d_keys_in, d_values_in, d_values_out, num_items, equality_op));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceScan::InclusiveSumByKey(
             d_temp_storage, temp_storage_bytes, d_keys_in, d_values_in, d_values_out, num_items, equality_op, _stream, false));
     }
@@ -110,6 +122,8 @@ class DeviceScan : public CubWrapper<DeviceScan>
                                    int                   num_items,
                                    EqualityOpT equality_op = EqualityOpT())
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::inclusive_scan_by_key<details::host_cub::value_t<ValuesInputIteratorT>>(
+            d_keys_in, d_values_in, d_values_out, scan_op, num_items, equality_op));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceScan::InclusiveScanByKey(d_temp_storage,
                                                                   temp_storage_bytes,
                                                                   d_keys_in,
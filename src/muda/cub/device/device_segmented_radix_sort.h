@@ -27,6 +27,8 @@ class DeviceSegmentedRadixSort : public CubWrapper<DeviceSegmentedRadixSort>
                                         int                  begin_bit,
                                         int                  end_bit)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::segmented_radix_sort(
+            d_keys_in, d_keys_out, d_values_in, d_values_out, num_segments, d_begin_offsets, d_end_offsets, begin_bit, end_bit, false));
         MUDA_CUB_WRAPPER_IMPL(
             cub::DeviceSegmentedRadixSort::SortPairs(d_temp_storage,
                                                      temp_storage_bytes,
@@ -55,6 +57,8 @@ class DeviceSegmentedRadixSort : public CubWrapper<DeviceSegmentedRadixSort>
                                         int                  begin_bit,
                                         int                  end_bit)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::segmented_radix_sort(
+            d_keys, d_values, num_segments, d_begin_offsets, d_end_offsets, begin_bit, end_bit, false));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceSegmentedRadixSort::SortPairs(d_temp_storage,
                                                                        temp_storage_bytes,
                                                                        d_keys,
@@ -82,6 +86,8 @@ class DeviceSegmentedRadixSort : public CubWrapper<DeviceSegmentedRadixSort>
                                                   int begin_bit,
                                                   int end_bit)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::segmented_radix_sort(
+            d_keys_in, d_keys_out, d_values_in, d_values_out, num_segments, d_begin_offsets, d_end_offsets, begin_bit, end_bit, true));
         MUDA_CUB_WRAPPER_IMPL(
             cub::DeviceSegmentedRadixSort::SortPairsDescending(d_temp_storage,
                                                                temp_storage_bytes,
@@ -110,6 +116,8 @@ class DeviceSegmentedRadixSort : public CubWrapper<DeviceSegmentedRadixSort>
                                                   int begin_bit,
                                                   int end_bit)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::segmented_radix_sort(
+            d_keys, d_values, num_segments, d_begin_offsets, d_end_offsets, begin_bit, end_bit, true));
         MUDA_CUB_WRAPPER_IMPL(
             cub::DeviceSegmentedRadixSort::SortPairsDescending(d_temp_storage,
                                                                temp_storage_bytes,
@@ -136,6 +144,8 @@ class DeviceSegmentedRadixSort : public CubWrapper<DeviceSegmentedRadixSort>
                                        int                  begin_bit,
                                        int                  end_bit)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::segmented_radix_sort_keys(
+            d_keys_in, d_keys_out, num_segments, d_begin_offsets, d_end_offsets, begin_bit, end_bit, false));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceSegmentedRadixSort::SortKeys(d_temp_storage,
                                                                       temp_storage_bytes,
                                                                       d_keys_in,
@@ -160,6 +170,8 @@ class DeviceSegmentedRadixSort : public CubWrapper<DeviceSegmentedRadixSort>
                                        int                      begin_bit,
                                        int                      end_bit)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::segmented_radix_sort_keys(
+            d_keys, num_segments, d_begin_offsets, d_end_offsets, begin_bit, end_bit, false));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceSegmentedRadixSort::SortKeys(d_temp_storage,
                                                                       temp_storage_bytes,
                                                                       d_keys,
@@ -184,6 +196,8 @@ class DeviceSegmentedRadixSort : public CubWrapper<DeviceSegmentedRadixSort>
                                                  int begin_bit,
                                                  int end_bit)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::segmented_radix_sort_keys(
+            d_keys_in, d_keys_out, num_segments, d_begin_offsets, d_end_offsets, begin_bit, end_bit, true));
         MUDA_CUB_WRAPPER_IMPL(
             cub::DeviceSegmentedRadixSort::SortKeysDescending(d_temp_storage,
                                                               temp_storage_bytes,
@@ -209,6 +223,8 @@ class DeviceSegmentedRadixSort : public CubWrapper<DeviceSegmentedRadixSort>
                                                  int begin_bit,
                                                  int end_bit)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::segmented_radix_sort_keys(
+            d_keys, num_segments, d_begin_offsets, d_end_offsets, begin_bit, end_bit, true));
         MUDA_CUB_WRAPPER_IMPL(
             cub::DeviceSegmentedRadixSort::SortKeysDescending(d_temp_storage,
                                                               temp_storage_bytes,
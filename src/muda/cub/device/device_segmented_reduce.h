@@ -26,6 +26,8 @@ class DeviceSegmentedReduce : public CubWrapper<DeviceSegmentedReduce>
     {
 
 
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::segmented_reduce(
+            d_in, d_out, num_segments, d_begin_offsets, d_end_offsets, reduction_op, initial_value));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceSegmentedReduce::Reduce(d_temp_storage,
                                                                  temp_storage_bytes,
                                                                  d_in,
@@ -46,6 +48,8 @@ class DeviceSegmentedReduce : public CubWrapper<DeviceSegmentedReduce>
                                BeginOffsetIteratorT d_begin_offsets,
                                EndOffsetIteratorT   d_end_offsets)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::segmented_sum(
+            d_in, d_out, num_segments, d_begin_offsets, d_end_offsets));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceSegmentedReduce::Sum(
             d_temp_storage, temp_storage_bytes, d_in, d_out, num_segments, d_begin_offsets, d_end_offsets, _stream, false));
     }
@@ -57,6 +61,8 @@ class DeviceSegmentedReduce : public CubWrapper<DeviceSegmentedReduce>
                                BeginOffsetIteratorT d_begin_offsets,
                                EndOffsetIteratorT   d_end_offsets)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::segmented_min(
+            d_in, d_out, num_segments, d_begin_offsets, d_end_offsets));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceSegmentedReduce::Min(
             d_temp_storage, temp_storage_bytes, d_in, d_out, num_segments, d_begin_offsets, d_end_offsets, _stream, false));
     }
@@ -68,6 +74,8 @@ class DeviceSegmentedReduce : public CubWrapper<DeviceSegmentedReduce>
                                   BeginOffsetIteratorT d_begin_offsets,
                                   EndOffsetIteratorT   d_end_offsets)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::segmented_arg_extreme<false>(
+            d_in, d_out, num_segments, d_begin_offsets, d_end_offsets));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceSegmentedReduce::ArgMin(
             d_temp_storage, temp_storage_bytes, d_in, d_out, num_segments, d_begin_offsets, d_end_offsets, _stream, false));
     }
@@ -79,6 +87,8 @@ class DeviceSegmentedReduce : public CubWrapper<DeviceSegmentedReduce>
                                BeginOffsetIteratorT d_begin_offsets,
                                EndOffsetIteratorT   d_end_offsets)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::segmented_max(
+            d_in, d_out, num_segments, d_begin_offsets, d_end_offsets));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceSegmentedReduce::Max(
             d_temp_storage, temp_storage_bytes, d_in, d_out, num_segments, d_begin_offsets, d_end_offsets, _stream, false));
     }
@@ -90,6 +100,8 @@ class DeviceSegmentedReduce : public CubWrapper<DeviceSegmentedReduce>
                                   BeginOffsetIteratorT d_begin_offsets,
                                   EndOffsetIteratorT   d_end_offsets)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::segmented_arg_extreme<true>(
+            d_in, d_out, num_segments, d_begin_offsets, d_end_offsets));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceSegmentedReduce::ArgMax(
             d_temp_storage, temp_storage_bytes, d_in, d_out, num_segments, d_begin_offsets, d_end_offsets, _stream, false));
     }
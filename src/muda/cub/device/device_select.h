@@ -22,6 +22,8 @@ class DeviceSelect : public CubWrapper<DeviceSelect>
                           NumSelectedIteratorT d_num_selected_out,
                           int                  num_items)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::select_flagged(
+            d_in, d_flags, d_out, d_num_selected_out, num_items));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceSelect::Flagged(
             d_temp_storage, temp_storage_bytes, d_in, d_flags, d_out, d_num_selected_out, num_items, _stream, false));
     }
@@ -33,6 +35,8 @@ class DeviceSelect : public CubWrapper<DeviceSelect>
                      int                  num_items,
                      SelectOp             select_op)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::select_if(
+            d_in, d_out, d_num_selected_out, num_items, select_op));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceSelect::If(
             d_temp_storage, temp_storage_bytes, d_in, d_out, d_num_selected_out, num_items, select_op, _stream, false));
     }
@@ -43,6 +47,8 @@ class DeviceSelect : public CubWrapper<DeviceSelect>
                          NumSelectedIteratorT d_num_selected_out,
                          int                  num_items)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::select_unique(
+            d_in, d_out, d_num_selected_out, num_items));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceSelect::Unique(
             d_temp_storage, temp_storage_bytes, d_in, d_out, d_num_selected_out, num_items, _stream, false));
     }
@@ -55,6 +61,8 @@ class DeviceSelect : public CubWrapper<DeviceSelect>
                               NumSelectedIteratorT d_num_selected_out,
                               int                  num_items)
     {
+        MUDA_CUB_WRAPPER_HOST_IMPL(details::host_cub::select_unique_by_key(
+            d_keys_in, d_values_in, d_keys_out, d_values_out, d_num_selected_out, num_items));
         MUDA_CUB_WRAPPER_IMPL(cub::DeviceSelect::UniqueByKey(d_temp_storage,
                                                              temp_storage_bytes,
                                                              d_keys_in,
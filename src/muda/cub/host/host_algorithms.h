@@ -0,0 +1,1010 @@
+/*****************************************************************/ /**
+ * \file   host_algorithms.h
+ * \brief  Host (multi-threaded) implementations behind the `CubBackend::Host`
+ * backend of the cub wrappers.
+ *
+ * All iterators/pointers must be accessible from the host (host memory, or managed
+ * memory with the device idle), and user operators must be `__host__` callable.
+ * Like cub, the outputs must not alias the inputs unless cub allows it.
+ *********************************************************************/
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <muda/cub/util_type.h>
+#include <muda/cub/host/host_thread_pool.h>
+
+namespace muda::details::host_cub
+{
+template <typename It>
+using value_t = typename std::iterator_traits<It>::value_type;
+
+// the value type of an output iterator, `Fallback` for output iterators without one
+template <typename It, typename Fallback>
+using output_t =
+    std::conditional_t<std::is_void_v<value_t<It>>, Fallback, value_t<It>>;
+
+inline HostThreadPool& pool()
+{
+    return HostThreadPool::global();
+}
+
+// no chunk smaller than this (except the last one), tiny inputs run on one thread
+inline constexpr size_t grain_size = 4096;
+
+// a few chunks per thread to balance the load, never more chunks than items
+inline size_t chunk_count(size_t n)
+{
+    if(n == 0)
+        return 0;
+    auto by_grain = (n + grain_size - 1) / grain_size;
+    return std::min(by_grain, pool().thread_count() * 4);
+}
+
+inline size_t chunk_begin(size_t n, size_t chunks, size_t c)
+{
+    return n * c / chunks;
+}
+
+// f(chunk, begin, end)
+template <typename F>
+void for_each_chunk(size_t n, size_t chunks, F&& f)
+{
+    pool().run(chunks,
+               [&](size_t c)
+               { f(c, chunk_begin(n, chunks, c), chunk_begin(n, chunks, c + 1)); });
+}
+
+template <typename F>
+void parallel_for(size_t n, F&& f)
+{
+    for_each_chunk(n,
+                   chunk_count(n),
+                   [&](size_t, size_t b, size_t e)
+                   {
+                       for(size_t i = b; i < e; ++i)
+                           f(i);
+                   });
+}
+
+struct Plus
+{
+    template <typename T, typename U>
+    auto operator()(const T& a, const U& b) const
+    {
+        return a + b;
+    }
+};
+
+struct Equal
+{
+    template <typename T>
+    bool operator()(const T& a, const T& b) const
+    {
+        return a == b;
+    }
+};
+
+/*****************************************************************************
+ * Reduce
+ *****************************************************************************/
+
+// fold [b, e) from the left, b < e
+template <typename Acc, typename InIt, typename Op>
+Acc fold(InIt in, size_t b, size_t e, Op& op)
+{
+    Acc acc = in[b];
+    for(size_t i = b + 1; i < e; ++i)
+        acc = op(acc, in[i]);
+    return acc;
+}
+
+template <typename Acc, typename InIt, typename Op>
+Acc reduce_value(InIt in, size_t n, Op op, Acc init)
+{
+    auto             chunks = chunk_count(n);
+    std::vector<Acc> partial(chunks);
+    for_each_chunk(n,
+                   chunks,
+                   [&](size_t c, size_t b, size_t e)
+                   { partial[c] = fold<Acc>(in, b, e, op); });
+
+    for(auto& p : partial)
+        init = op(init, p);
+    return init;
+}
+
+template <typename InIt, typename OutIt, typename Op, typename T>
+void reduce(InIt in, OutIt out, size_t n, Op op, T init)
+{
+    *out = reduce_value<T>(in, n, op, init);
+}
+
+template <typename InIt, typename OutIt>
+void sum(InIt in, OutIt out, size_t n)
+{
+    using T = value_t<InIt>;
+    *out    = reduce_value<T>(in, n, Plus{}, T{});
+}
+
+template <typename InIt, typename OutIt>
+void reduce_min(InIt in, OutIt out, size_t n)
+{
+    using T = value_t<InIt>;
+    *out    = reduce_value<T>(in,
+                           n,
+                           [](const T& a, const T& b) { return b < a ? b : a; },
+                           std::numeric_limits<T>::max());
+}
+
+template <typename InIt, typename OutIt>
+void reduce_max(InIt in, OutIt out, size_t n)
+{
+    using T = value_t<InIt>;
+    *out    = reduce_value<T>(in,
+                           n,
+                           [](const T& a, const T& b) { return a < b ? b : a; },
+                           std::numeric_limits<T>::lowest());
+}
+
+// (index relative to b, value) of the first min/max in [b, e)
+template <bool IsMax, typename InIt>
+cub::KeyValuePair<int, value_t<InIt>> arg_extreme_seq(InIt in, size_t b, size_t e)
+{
+    using T    = value_t<InIt>;
+    using Pair = cub::KeyValuePair<int, T>;
+
+    // same as cub for empty ranges
+    if(b >= e)
+        return Pair{1, IsMax ? std::numeric_limits<T>::lowest() : std::numeric_limits<T>::max()};
+
+    Pair best{0, in[b]};
+    for(size_t i = b + 1; i < e; ++i)
+    {
+        T v = in[i];
+        if(IsMax ? best.value < v : v < best.value)
+            best = Pair{static_cast<int>(i - b), v};
+    }
+    return best;
+}
+
+template <bool IsMax, typename InIt, typename OutIt>
+void arg_extreme(InIt in, OutIt out, size_t n)
+{
+    using T    = value_t<InIt>;
+    using Pair = cub::KeyValuePair<int, T>;
+
+    auto              chunks = chunk_count(n);
+    std::vector<Pair> partial(chunks);
+    for_each_chunk(n,
+                   chunks,
+                   [&](size_t c, size_t b, size_t e)
+                   {
+                       auto p     = arg_extreme_seq<IsMax>(in, b, e);
+                       p.key      = static_cast<int>(p.key + b);
+                       partial[c] = p;
+                   });
+
+    if(chunks == 0)
+    {
+        *out = arg_extreme_seq<IsMax>(in, 0, 0);
+        return;
+    }
+
+    // strict comparison, the earliest chunk wins ties
+    Pair best = partial[0];
+    for(size_t c = 1; c < chunks; ++c)
+    {
+        auto& p = partial[c];
+        if(IsMax ? best.value < p.value : p.value < best.value)
+            best = p;
+    }
+    *out = best;
+}
+
+template <typename InIt, typename OutIt>
+void arg_min(InIt in, OutIt out, size_t n)
+{
+    arg_extreme<false>(in, out, n);
+}
+
+template <typename InIt, typename OutIt>
+void arg_max(InIt in, OutIt out, size_t n)
+{
+    arg_extreme<true>(in, out, n);
+}
+
+/*****************************************************************************
+ * Select
+ *****************************************************************************/
+
+// emit(rank, i) for every i in [0, n) with pred(i), ranks follow the input order.
+// returns the number of selected items.
+template <typename Pred, typename Emit>
+size_t select_indices(size_t n, Pred pred, Emit emit)
+{
+    auto                chunks = chunk_count(n);
+    std::vector<size_t> offsets(chunks + 1, 0);
+
+    // 1. count per chunk
+    for_each_chunk(n,
+                   chunks,
+                   [&](size_t c, size_t b, size_t e)
+                   {
+                       size_t count = 0;
+                       for(size_t i = b; i < e; ++i)
+                           count += pred(i) ? 1 : 0;
+                       offsets[c + 1] = count;
+                   });
+
+    // 2. where each chunk starts writing
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    // 3. scatter
+    for_each_chunk(n,
+                   chunks,
+                   [&](size_t c, size_t b, size_t e)
+                   {
+                       size_t rank = offsets[c];
+                       for(size_t i = b; i < e; ++i)
+                           if(pred(i))
+                               emit(rank++, i);
+                   });
+
+    return offsets[chunks];
+}
+
+// first index of every run of equal keys, followed by n
+template <typename KeyIt, typename EqualOp = Equal>
+std::vector<size_t> run_heads(KeyIt keys, size_t n, EqualOp eq = {})
+{
+    auto is_head = [&](size_t i) { return i == 0 || !eq(keys[i - 1], keys[i]); };
+
+    std::vector<size_t> heads(n + 1);
+    auto count = select_indices(n, is_head, [&](size_t r, size_t i) { heads[r] = i; });
+    heads.resize(count + 1);
+    heads[count] = n;
+    return heads;
+}
+
+template <typename InIt, typename FlagIt, typename OutIt, typename NumIt>
+void select_flagged(InIt in, FlagIt flags, OutIt out, NumIt num_selected_out, size_t n)
+{
+    auto count = select_indices(
+        n, [&](size_t i) { return static_cast<bool>(flags[i]); }, [&](size_t r, size_t i) { out[r] = in[i]; });
+    *num_selected_out = static_cast<output_t<NumIt, int>>(count);
+}
+
+template <typename InIt, typename OutIt, typename NumIt, typename SelectOp>
+void select_if(InIt in, OutIt out, NumIt num_selected_out, size_t n, SelectOp select_op)
+{
+    auto count = select_indices(
+        n, [&](size_t i) { return static_cast<bool>(select_op(in[i])); }, [&](size_t r, size_t i) { out[r] = in[i]; });
+    *num_selected_out = static_cast<output_t<NumIt, int>>(count);
+}
+
+template <typename InIt, typename OutIt, typename NumIt>
+void select_unique(InIt in, OutIt out, NumIt num_selected_out, size_t n)
+{
+    Equal eq;
+    auto  count = select_indices(
+        n,
+        [&](size_t i) { return i == 0 || !eq(in[i - 1], in[i]); },
+        [&](size_t r, size_t i) { out[r] = in[i]; });
+    *num_selected_out = static_cast<output_t<NumIt, int>>(count);
+}
+
+template <typename KeyInIt, typename ValueInIt, typename KeyOutIt, typename ValueOutIt, typename NumIt>
+void select_unique_by_key(KeyInIt    keys_in,
+                          ValueInIt  values_in,
+                          KeyOutIt   keys_out,
+                          ValueOutIt values_out,
+                          NumIt      num_selected_out,
+                          size_t     n)
+{
+    Equal eq;
+    auto  count = select_indices(
+        n,
+        [&](size_t i) { return i == 0 || !eq(keys_in[i - 1], keys_in[i]); },
+        [&](size_t r, size_t i)
+        {
+            keys_out[r]   = keys_in[i];
+            values_out[r] = values_in[i];
+        });
+    *num_selected_out = static_cast<output_t<NumIt, int>>(count);
+}
+
+/*****************************************************************************
+ * Run Length Encode / Reduce By Key
+ *****************************************************************************/
+
+template <typename InIt, typename UniqueOutIt, typename LengthOutIt, typename NumIt>
+void run_length_encode(InIt in, UniqueOutIt unique_out, LengthOutIt counts_out, NumIt num_runs_out, size_t n)
+{
+    using Length = output_t<LengthOutIt, int>;
+
+    auto heads = run_heads(in, n);
+    auto runs  = heads.size() - 1;
+    parallel_for(runs,
+                 [&](size_t r)
+                 {
+                     unique_out[r] = in[heads[r]];
+                     counts_out[r] = static_cast<Length>(heads[r + 1] - heads[r]);
+                 });
+    *num_runs_out = static_cast<output_t<NumIt, int>>(runs);
+}
+
+template <typename InIt, typename OffsetOutIt, typename LengthOutIt, typename NumIt>
+void non_trivial_runs(InIt in, OffsetOutIt offsets_out, LengthOutIt lengths_out, NumIt num_runs_out, size_t n)
+{
+    using Offset = output_t<OffsetOutIt, int>;
+    using Length = output_t<LengthOutIt, int>;
+
+    auto heads = run_heads(in, n);
+    auto count = select_indices(
+        heads.size() - 1,
+        [&](size_t r) { return heads[r + 1] - heads[r] > 1; },
+        [&](size_t k, size_t r)
+        {
+            offsets_out[k] = static_cast<Offset>(heads[r]);
+            lengths_out[k] = static_cast<Length>(heads[r + 1] - heads[r]);
+        });
+    *num_runs_out = static_cast<output_t<NumIt, int>>(count);
+}
+
+template <typename KeyInIt, typename UniqueOutIt, typename ValueInIt, typename AggregateOutIt, typename NumIt, typename Op>
+void reduce_by_key(KeyInIt        keys_in,
+                   UniqueOutIt    unique_out,
+                   ValueInIt      values_in,
+                   AggregateOutIt aggregates_out,
+                   NumIt          num_runs_out,
+                   Op             op,
+                   size_t         n)
+{
+    using Acc = value_t<ValueInIt>;
+
+    auto heads = run_heads(keys_in, n);
+    auto runs  = heads.size() - 1;
+    parallel_for(runs,
+                 [&](size_t r)
+                 {
+                     unique_out[r] = keys_in[heads[r]];
+                     aggregates_out[r] = fold<Acc>(values_in, heads[r], heads[r + 1], op);
+                 });
+    *num_runs_out = static_cast<output_t<NumIt, int>>(runs);
+}
+
+/*****************************************************************************
+ * Scan
+ *****************************************************************************/
+
+// decoupled in three phases: chunk aggregates, prefix of the aggregates, rescan.
+// in == out is allowed.
+template <typename Acc, typename InIt, typename OutIt, typename Op>
+void exclusive_scan(InIt in, OutIt out, Op op, Acc init, size_t n)
+{
+    auto             chunks = chunk_count(n);
+    std::vector<Acc> carry(chunks);
+
+    if(chunks > 1)
+    {
+        for_each_chunk(n,
+                       chunks,
+                       [&](size_t c, size_t b, size_t e)
+                       { carry[c] = fold<Acc>(in, b, e, op); });
+    }
+
+    Acc running = init;
+    for(size_t c = 0; c < chunks; ++c)
+    {
+        Acc aggregate = carry[c];
+        carry[c]      = running;
+        running       = op(running, aggregate);
+    }
+
+    for_each_chunk(n,
+                   chunks,
+                   [&](size_t c, size_t b, size_t e)
+                   {
+                       Acc acc = carry[c];
+                       for(size_t i = b; i < e; ++i)
+                       {
+                           Acc v  = in[i];
+                           out[i] = acc;
+                           acc    = op(acc, v);
+                       }
+                   });
+}
+
+template <typename Acc, typename InIt, typename OutIt, typename Op>
+void inclusive_scan(InIt in, OutIt out, Op op, size_t n)
+{
+    auto             chunks = chunk_count(n);
+    std::vector<Acc> carry(chunks);
+
+    if(chunks > 1)
+    {
+        for_each_chunk(n,
+                       chunks,
+                       [&](size_t c, size_t b, size_t e)
+                       { carry[c] = fold<Acc>(in, b, e, op); });
+
+        Acc running = carry[0];
+        for(size_t c = 1; c < chunks; ++c)
+        {
+            Acc aggregate = carry[c];
+            carry[c]      = running;
+            running       = op(running, aggregate);
+        }
+    }
+
+    for_each_chunk(n,
+                   chunks,
+                   [&](size_t c, size_t b, size_t e)
+                   {
+                       Acc acc = in[b];
+                       if(c > 0)
+                           acc = op(carry[c], acc);
+                       out[b] = acc;
+                       for(size_t i = b + 1; i < e; ++i)
+                       {
+                           acc    = op(acc, in[i]);
+                           out[i] = acc;
+                       }
+                   });
+}
+
+template <typename InIt, typename OutIt>
+void exclusive_sum(InIt in, OutIt out, size_t n)
+{
+    using T = value_t<InIt>;
+    exclusive_scan(in, out, Plus{}, T{}, n);
+}
+
+template <typename InIt, typename OutIt>
+void inclusive_sum(InIt in, OutIt out, size_t n)
+{
+    inclusive_scan<value_t<InIt>>(in, out, Plus{}, n);
+}
+
+// by key: every run of equal keys is scanned on its own, runs in parallel
+template <typename Acc, typename KeyInIt, typename ValueInIt, typename ValueOutIt, typename Op, typename EqualOp>
+void exclusive_scan_by_key(
+    KeyInIt keys_in, ValueInIt values_in, ValueOutIt values_out, Op op, Acc init, size_t n, EqualOp eq)
+{
+    auto heads = run_heads(keys_in, n, eq);
+    parallel_for(heads.size() - 1,
+                 [&](size_t r)
+                 {
+                     Acc acc = init;
+                     for(size_t i = heads[r]; i < heads[r + 1]; ++i)
+                     {
+                         Acc v         = values_in[i];
+                         values_out[i] = acc;
+                         acc           = op(acc, v);
+                     }
+                 });
+}
+
+template <typename Acc, typename KeyInIt, typename ValueInIt, typename ValueOutIt, typename Op, typename EqualOp>
+void inclusive_scan_by_key(KeyInIt keys_in, ValueInIt values_in, ValueOutIt values_out, Op op, size_t n, EqualOp eq)
+{
+    auto heads = run_heads(keys_in, n, eq);
+    parallel_for(heads.size() - 1,
+                 [&](size_t r)
+                 {
+                     auto b        = heads[r];
+                     Acc  acc      = values_in[b];
+                     values_out[b] = acc;
+                     for(size_t i = b + 1; i < heads[r + 1]; ++i)
+                     {
+                         acc           = op(acc, values_in[i]);
+                         values_out[i] = acc;
+                     }
+                 });
+}
+
+template <typename KeyInIt, typename ValueInIt, typename ValueOutIt, typename EqualOp>
+void exclusive_sum_by_key(KeyInIt keys_in, ValueInIt values_in, ValueOutIt values_out, size_t n, EqualOp eq)
+{
+    using T = value_t<ValueInIt>;
+    exclusive_scan_by_key(keys_in, values_in, values_out, Plus{}, T{}, n, eq);
+}
+
+template <typename KeyInIt, typename ValueInIt, typename ValueOutIt, typename EqualOp>
+void inclusive_sum_by_key(KeyInIt keys_in, ValueInIt values_in, ValueOutIt values_out, size_t n, EqualOp eq)
+{
+    inclusive_scan_by_key<value_t<ValueInIt>>(keys_in, values_in, values_out, Plus{}, n, eq);
+}
+
+/*****************************************************************************
+ * Radix Sort
+ *****************************************************************************/
+
+// maps a key to unsigned bits with the same ordering, as cub does
+template <typename KeyT>
+struct RadixKey
+{
+    static_assert(std::is_arithmetic_v<KeyT>, "the host radix sort only supports arithmetic keys");
+
+    using Bits = std::conditional_t<
+        sizeof(KeyT) == 1,
+        std::uint8_t,
+        std::conditional_t<sizeof(KeyT) == 2, std::uint16_t, std::conditional_t<sizeof(KeyT) == 4, std::uint32_t, std::uint64_t>>>;
+
+    static constexpr int  bit_count = sizeof(KeyT) * 8;
+    static constexpr Bits sign_bit  = Bits(Bits(1) << (bit_count - 1));
+
+    static Bits twiddle_in(KeyT key, bool descending)
+    {
+        if constexpr(std::is_floating_point_v<KeyT>)
+        {
+            // -0.0 sorts as +0.0
+            if(key == KeyT(0))
+                key = KeyT(0);
+        }
+
+        Bits bits;
+        std::memcpy(&bits, &key, sizeof(KeyT));
+
+        if constexpr(std::is_floating_point_v<KeyT>)
+            bits = (bits & sign_bit) ? Bits(~bits) : Bits(bits ^ sign_bit);
+        else if constexpr(std::is_signed_v<KeyT>)
+            bits = Bits(bits ^ sign_bit);
+
+        return descending ? Bits(~bits) : bits;
+    }
+
+    // the bits of [begin_bit, end_bit), shifted down
+    static std::uint64_t digits(Bits bits, int begin_bit, int end_bit)
+    {
+        auto width = end_bit - begin_bit;
+        auto mask  = width >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << width) - 1;
+        return (std::uint64_t(bits) >> begin_bit) & mask;
+    }
+};
+
+// LSD radix sort, 8 bits per pass: per-chunk digit histograms, a (digit, chunk)
+// ordered scan and a stable scatter. `values_in == nullptr` sorts keys only.
+template <typename KeyT, typename ValueT>
+void radix_sort(const KeyT*   keys_in,
+                KeyT*         keys_out,
+                const ValueT* values_in,
+                ValueT*       values_out,
+                size_t        n,
+                int           begin_bit,
+                int           end_bit,
+                bool          descending)
+{
+    using Radix = RadixKey<KeyT>;
+    using Bits  = typename Radix::Bits;
+
+    constexpr int    radix_bits = 8;
+    constexpr size_t radix      = size_t(1) << radix_bits;
+
+    if(n == 0)
+        return;
+
+    end_bit   = std::min(end_bit, Radix::bit_count);
+    begin_bit = std::max(begin_bit, 0);
+
+    std::vector<Bits>   bits(n), bits_alt(n);
+    std::vector<size_t> ids(n), ids_alt(n);
+    parallel_for(n,
+                 [&](size_t i)
+                 {
+                     bits[i] = Radix::twiddle_in(keys_in[i], descending);
+                     ids[i]  = i;
+                 });
+
+    auto                chunks = chunk_count(n);
+    std::vector<size_t> offsets(chunks * radix);
+
+    for(int shift = begin_bit; shift < end_bit; shift += radix_bits)
+    {
+        auto pass_end = std::min(shift + radix_bits, end_bit);
+        auto digit = [&](Bits b) { return size_t(Radix::digits(b, shift, pass_end)); };
+
+        // 1. digit histogram of each chunk
+        for_each_chunk(n,
+                       chunks,
+                       [&](size_t c, size_t b, size_t e)
+                       {
+                           auto count = offsets.data() + c * radix;
+                           std::fill(count, count + radix, 0);
+                           for(size_t i = b; i < e; ++i)
+                               ++count[digit(bits[i])];
+                       });
+
+        // 2. exclusive scan in (digit, chunk) order, which keeps the sort stable
+        bool   trivial = false;
+        size_t offset  = 0;
+        for(size_t d = 0; d < radix; ++d)
+        {
+            size_t digit_total = 0;
+            for(size_t c = 0; c < chunks; ++c)
+            {
+                auto& o     = offsets[c * radix + d];
+                auto  count = o;
+                o           = offset;
+                offset += count;
+                digit_total += count;
+            }
+            trivial |= digit_total == n;
+        }
+
+        // all keys share this digit, the scatter would be an identity
+        if(trivial)
+            continue;
+
+        // 3. scatter
+        for_each_chunk(n,
+                       chunks,
+                       [&](size_t c, size_t b, size_t e)
+                       {
+                           auto offset = offsets.data() + c * radix;
+                           for(size_t i = b; i < e; ++i)
+                           {
+                               auto& o     = offset[digit(bits[i])];
+                               bits_alt[o] = bits[i];
+                               ids_alt[o]  = ids[i];
+                               ++o;
+                           }
+                       });
+
+        bits.swap(bits_alt);
+        ids.swap(ids_alt);
+    }
+
+    parallel_for(n,
+                 [&](size_t i)
+                 {
+                     keys_out[i] = keys_in[ids[i]];
+                     if(values_in)
+                         values_out[i] = values_in[ids[i]];
+                 });
+}
+
+template <typename KeyT>
+void radix_sort_keys(const KeyT* keys_in, KeyT* keys_out, size_t n, int begin_bit, int end_bit, bool descending)
+{
+    radix_sort(keys_in, keys_out, (const KeyT*)nullptr, (KeyT*)nullptr, n, begin_bit, end_bit, descending);
+}
+
+// sorts Current() into Alternate() and flips the selectors, as cub does
+template <typename KeyT, typename ValueT>
+void radix_sort(cub::DoubleBuffer<KeyT>&   keys,
+                cub::DoubleBuffer<ValueT>& values,
+                size_t                     n,
+                int                        begin_bit,
+                int                        end_bit,
+                bool                       descending)
+{
+    radix_sort(keys.Current(), keys.Alternate(), values.Current(), values.Alternate(), n, begin_bit, end_bit, descending);
+    keys.selector ^= 1;
+    values.selector ^= 1;
+}
+
+template <typename KeyT>
+void radix_sort_keys(cub::DoubleBuffer<KeyT>& keys, size_t n, int begin_bit, int end_bit, bool descending)
+{
+    radix_sort_keys(keys.Current(), keys.Alternate(), n, begin_bit, end_bit, descending);
+    keys.selector ^= 1;
+}
+
+// each segment is sorted on its own, segments in parallel
+template <typename KeyT, typename ValueT, typename BeginIt, typename EndIt>
+void segmented_radix_sort(const KeyT*   keys_in,
+                          KeyT*         keys_out,
+                          const ValueT* values_in,
+                          ValueT*       values_out,
+                          size_t        num_segments,
+                          BeginIt       begin_offsets,
+                          EndIt         end_offsets,
+                          int           begin_bit,
+                          int           end_bit,
+                          bool          descending)
+{
+    using Radix = RadixKey<KeyT>;
+    using Item  = std::pair<std::uint64_t, size_t>;
+
+    end_bit   = std::min(end_bit, Radix::bit_count);
+    begin_bit = std::max(begin_bit, 0);
+
+    pool().run(num_segments,
+               [&](size_t s)
+               {
+                   size_t b = begin_offsets[s];
+                   size_t e = end_offsets[s];
+                   if(e <= b)
+                       return;
+
+                   static thread_local std::vector<Item> items;
+                   items.resize(e - b);
+                   for(size_t i = b; i < e; ++i)
+                       items[i - b] = Item{Radix::digits(Radix::twiddle_in(keys_in[i], descending),
+                                                         begin_bit,
+                                                         end_bit),
+                                           i};
+
+                   std::stable_sort(items.begin(),
+                                    items.end(),
+                                    [](const Item& l, const Item& r)
+                                    { return l.first < r.first; });
+
+                   for(size_t k = 0; k < items.size(); ++k)
+                   {
+                       auto src        = items[k].second;
+                       keys_out[b + k] = keys_in[src];
+                       if(values_in)
+                           values_out[b + k] = values_in[src];
+                   }
+               });
+}
+
+template <typename KeyT, typename BeginIt, typename EndIt>
+void segmented_radix_sort_keys(const KeyT* keys_in,
+                               KeyT*       keys_out,
+                               size_t      num_segments,
+                               BeginIt     begin_offsets,
+                               EndIt       end_offsets,
+                               int         begin_bit,
+                               int         end_bit,
+                               bool        descending)
+{
+    segmented_radix_sort(
+        keys_in, keys_out, (const KeyT*)nullptr, (KeyT*)nullptr, num_segments, begin_offsets, end_offsets, begin_bit, end_bit, descending);
+}
+
+template <typename KeyT, typename ValueT, typename BeginIt, typename EndIt>
+void segmented_radix_sort(cub::DoubleBuffer<KeyT>&   keys,
+                          cub::DoubleBuffer<ValueT>& values,
+                          size_t                     num_segments,
+                          BeginIt                    begin_offsets,
+                          EndIt                      end_offsets,
+                          int                        begin_bit,
+                          int                        end_bit,
+                          bool                       descending)
+{
+    segmented_radix_sort(keys.Current(),
+                         keys.Alternate(),
+                         values.Current(),
+                         values.Alternate(),
+                         num_segments,
+                         begin_offsets,
+                         end_offsets,
+                         begin_bit,
+                         end_bit,
+                         descending);
+    keys.selector ^= 1;
+    values.selector ^= 1;
+}
+
+template <typename KeyT, typename BeginIt, typename EndIt>
+void segmented_radix_sort_keys(cub::DoubleBuffer<KeyT>& keys,
+                               size_t                   num_segments,
+                               BeginIt                  begin_offsets,
+                               EndIt                    end_offsets,
+                               int                      begin_bit,
+                               int                      end_bit,
+                               bool                     descending)
+{
+    segmented_radix_sort_keys(
+        keys.Current(), keys.Alternate(), num_segments, begin_offsets, end_offsets, begin_bit, end_bit, descending);
+    keys.selector ^= 1;
+}
+
+/*****************************************************************************
+ * Segmented Reduce
+ *****************************************************************************/
+
+// empty segments get `init`
+template <typename InIt, typename OutIt, typename BeginIt, typename EndIt, typename Op, typename T>
+void segmented_reduce(InIt    in,
+                      OutIt   out,
+                      size_t  num_segments,
+                      BeginIt begin_offsets,
+                      EndIt   end_offsets,
+                      Op      op,
+                      T       init)
+{
+    pool().run(num_segments,
+               [&](size_t s)
+               {
+                   size_t b   = begin_offsets[s];
+                   size_t e   = end_offsets[s];
+                   T      acc = init;
+                   for(size_t i = b; i < e; ++i)
+                       acc = op(acc, in[i]);
+                   out[s] = acc;
+               });
+}
+
+template <typename InIt, typename OutIt, typename BeginIt, typename EndIt>
+void segmented_sum(InIt in, OutIt out, size_t num_segments, BeginIt begin_offsets, EndIt end_offsets)
+{
+    using T = value_t<InIt>;
+    segmented_reduce(in, out, num_segments, begin_offsets, end_offsets, Plus{}, T{});
+}
+
+template <typename InIt, typename OutIt, typename BeginIt, typename EndIt>
+void segmented_min(InIt in, OutIt out, size_t num_segments, BeginIt begin_offsets, EndIt end_offsets)
+{
+    using T = value_t<InIt>;
+    segmented_reduce(in,
+                     out,
+                     num_segments,
+                     begin_offsets,
+                     end_offsets,
+                     [](const T& a, const T& b) { return b < a ? b : a; },
+                     std::numeric_limits<T>::max());
+}
+
+template <typename InIt, typename OutIt, typename BeginIt, typename EndIt>
+void segmented_max(InIt in, OutIt out, size_t num_segments, BeginIt begin_offsets, EndIt end_offsets)
+{
+    using T = value_t<InIt>;
+    segmented_reduce(in,
+                     out,
+                     num_segments,
+                     begin_offsets,
+                     end_offsets,
+                     [](const T& a, const T& b) { return a < b ? b : a; },
+                     std::numeric_limits<T>::lowest());
+}
+
+template <bool IsMax, typename InIt, typename OutIt, typename BeginIt, typename EndIt>
+void segmented_arg_extreme(InIt in, OutIt out, size_t num_segments, BeginIt begin_offsets, EndIt end_offsets)
+{
+    pool().run(num_segments,
+               [&](size_t s) {
+                   out[s] = arg_extreme_seq<IsMax>(in, begin_offsets[s], end_offsets[s]);
+               });
+}
+
+/*****************************************************************************
+ * Histogram
+ *****************************************************************************/
+
+// per-chunk private histograms, summed at the end. bin(sample) < 0 drops the sample.
+template <typename SampleIt, typename CounterT, typename BinOp>
+void histogram(SampleIt samples, CounterT* histogram, size_t num_bins, size_t n, BinOp bin)
+{
+    auto                chunks = chunk_count(n);
+    std::vector<size_t> counts(chunks * num_bins, 0);
+
+    for_each_chunk(n,
+                   chunks,
+                   [&](size_t c, size_t b, size_t e)
+                   {
+                       auto count = counts.data() + c * num_bins;
+                       for(size_t i = b; i < e; ++i)
+                       {
+                           auto k = bin(samples[i]);
+                           if(k >= 0 && size_t(k) < num_bins)
+                               ++count[k];
+                       }
+                   });
+
+    parallel_for(num_bins,
+                 [&](size_t k)
+                 {
+                     size_t total = 0;
+                     for(size_t c = 0; c < chunks; ++c)
+                         total += counts[c * num_bins + k];
+                     histogram[k] = static_cast<CounterT>(total);
+                 });
+}
+
+template <typename SampleIt, typename CounterT, typename LevelT>
+void histogram_even(SampleIt samples, CounterT* hist, int num_levels, LevelT lower_level, LevelT upper_level, size_t n)
+{
+    if(num_levels < 2)
+        return;
+    auto num_bins = static_cast<size_t>(num_levels - 1);
+
+    histogram(samples,
+              hist,
+              num_bins,
+              n,
+              [&](const auto& sample) -> std::int64_t
+              {
+                  LevelT s = static_cast<LevelT>(sample);
+                  if(!(s >= lower_level && s < upper_level))
+                      return -1;
+                  if constexpr(std::is_integral_v<LevelT>)
+                      return std::int64_t(s - lower_level) * std::int64_t(num_bins)
+                             / std::int64_t(upper_level - lower_level);
+                  else
+                      return static_cast<std::int64_t>((double(s) - double(lower_level))
+                                                       * double(num_bins)
+                                                       / (double(upper_level) - double(lower_level)));
+              });
+}
+
+template <typename SampleIt, typename CounterT, typename LevelT>
+void histogram_range(SampleIt samples, CounterT* hist, int num_levels, const LevelT* levels, size_t n)
+{
+    if(num_levels < 2)
+        return;
+
+    histogram(samples,
+              hist,
+              static_cast<size_t>(num_levels - 1),
+              n,
+              [&](const auto& sample) -> std::int64_t
+              {
+                  LevelT s = static_cast<LevelT>(sample);
+                  if(!(s >= levels[0] && s < levels[num_levels - 1]))
+                      return -1;
+                  return std::upper_bound(levels, levels + num_levels, s) - levels - 1;
+              });
+}
+
+/*****************************************************************************
+ * Merge Sort
+ *****************************************************************************/
+
+// stable: chunks are sorted in parallel, then merged pairwise in log(chunks) rounds
+template <bool WithValues, typename KeyInIt, typename ValueInIt, typename KeyOutIt, typename ValueOutIt, typename CompareOp>
+void merge_sort(KeyInIt    keys_in,
+                ValueInIt  values_in,
+                KeyOutIt   keys_out,
+                ValueOutIt values_out,
+                size_t     n,
+                CompareOp  compare_op)
+{
+    using Key  = value_t<KeyInIt>;
+    using Item = std::pair<Key, size_t>;
+
+    if(n == 0)
+        return;
+
+    std::vector<Item> items(n), merged(n);
+    parallel_for(n, [&](size_t i) { items[i] = Item{keys_in[i], i}; });
+
+    auto less = [&](const Item& l, const Item& r)
+    { return compare_op(l.first, r.first); };
+
+    auto chunks = chunk_count(n);
+    for_each_chunk(n,
+                   chunks,
+                   [&](size_t, size_t b, size_t e)
+                   { std::stable_sort(items.begin() + b, items.begin() + e, less); });
+
+    for(size_t width = 1; width < chunks; width *= 2)
+    {
+        auto pairs = (chunks + 2 * width - 1) / (2 * width);
+        pool().run(pairs,
+                   [&](size_t p)
+                   {
+                       auto lo = chunk_begin(n, chunks, 2 * p * width);
+                       auto mid = chunk_begin(n, chunks, std::min(chunks, 2 * p * width + width));
+                       auto hi = chunk_begin(n, chunks, std::min(chunks, 2 * p * width + 2 * width));
+                       std::merge(items.begin() + lo,
+                                  items.begin() + mid,
+                                  items.begin() + mid,
+                                  items.begin() + hi,
+                                  merged.begin() + lo,
+                                  less);
+                   });
+        items.swap(merged);
+    }
+
+    // gather through a copy, the in-place overloads pass the same iterators as in/out
+    if constexpr(WithValues)
+    {
+        using Value = value_t<ValueInIt>;
+        std::vector<Value> values(n);
+        parallel_for(n, [&](size_t i) { values[i] = values_in[items[i].second]; });
+        parallel_for(n, [&](size_t i) { values_out[i] = values[i]; });
+    }
+    parallel_for(n, [&](size_t i) { keys_out[i] = items[i].first; });
+}
+}  // namespace muda::details::host_cub
@@ -0,0 +1,149 @@
+/*****************************************************************/ /**
+ * \file   host_thread_pool.h
+ * \brief  A small persistent thread pool driving the host backend of
+ * the cub wrappers.
+ *********************************************************************/
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace muda
+{
+/**
+ * \class HostThreadPool
+ *
+ * \brief Runs `f(i)` for `i` in `[0, n)` on a fixed set of worker threads.
+ *
+ * The calling thread joins the work, so a pool of `thread_count()` threads only
+ * spawns `thread_count() - 1` workers. Calls to `run()` from inside a job run
+ * sequentially on the current thread, so algorithms may be nested freely.
+ *
+ * \code
+ *  HostThreadPool::global().run(chunks, [&](size_t c) { ... });
+ * \endcode
+ */
+class HostThreadPool
+{
+    std::vector<std::thread> m_threads;
+
+    std::mutex              m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    // only one job in flight, concurrent callers queue up here
+    std::mutex m_run_mutex;
+
+    const std::function<void(size_t)>* m_job      = nullptr;
+    size_t                             m_job_size = 0;
+    std::atomic<size_t>                m_next{0};
+    size_t                             m_working    = 0;
+    size_t                             m_generation = 0;
+    bool                               m_stop       = false;
+
+    static bool& in_job()
+    {
+        static thread_local bool flag = false;
+        return flag;
+    }
+
+    void work()
+    {
+        for(size_t i = m_next.fetch_add(1); i < m_job_size; i = m_next.fetch_add(1))
+            (*m_job)(i);
+    }
+
+    void worker_loop()
+    {
+        in_job() = true;
+
+        size_t                       seen = 0;
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while(true)
+        {
+            m_wake.wait(lock, [&] { return m_stop || m_generation != seen; });
+            if(m_stop)
+                return;
+            seen = m_generation;
+
+            lock.unlock();
+            work();
+            lock.lock();
+
+            if(--m_working == 0)
+                m_done.notify_one();
+        }
+    }
+
+  public:
+    explicit HostThreadPool(size_t thread_count = std::thread::hardware_concurrency())
+    {
+        auto workers = thread_count > 1 ? thread_count - 1 : 0;
+        m_threads.reserve(workers);
+        for(size_t i = 0; i < workers; ++i)
+            m_threads.emplace_back([this] { worker_loop(); });
+    }
+
+    HostThreadPool(const HostThreadPool&)            = delete;
+    HostThreadPool& operator=(const HostThreadPool&) = delete;
+
+    ~HostThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for(auto& t : m_threads)
+            t.join();
+    }
+
+    // the pool shared by all host backend calls, one thread per hardware thread
+    static HostThreadPool& global()
+    {
+        static HostThreadPool pool;
+        return pool;
+    }
+
+    // worker threads + the calling thread
+    size_t thread_count() const { return m_threads.size() + 1; }
+
+    // call f(i) for i in [0, n), blocks until all calls return
+    template <typename F>
+    void run(size_t n, F&& f)
+    {
+        if(n == 0)
+            return;
+
+        if(n == 1 || m_threads.empty() || in_job())
+        {
+            for(size_t i = 0; i < n; ++i)
+                f(i);
+            return;
+        }
+
+        std::function<void(size_t)> job{std::ref(f)};
+
+        std::lock_guard<std::mutex> run_lock(m_run_mutex);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_job      = &job;
+            m_job_size = n;
+            m_next.store(0);
+            m_working = m_threads.size();
+            ++m_generation;
+        }
+        m_wake.notify_all();
+
+        in_job() = true;
+        work();
+        in_job() = false;
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [&] { return m_working == 0; });
+        m_job = nullptr;
+    }
+};
+}  // namespace muda
@@ -0,0 +1,185 @@
+#include <limits>
+
+namespace muda::eigen
+{
+namespace details::psd
+{
+    // the position of (i, j) in a packed upper triangle, row by row
+    template <int N>
+    MUDA_GENERIC constexpr int packed(int i, int j)
+    {
+        return i <= j ? i * N - i * (i - 1) / 2 + (j - i) : j * N - j * (j - 1) / 2 + (i - j);
+    }
+
+    // trial Cholesky factorization, only the upper triangle of M is read
+    template <typename T, int N>
+    MUDA_INLINE MUDA_GENERIC bool positive_definite(const Eigen::Matrix<T, N, N>& M)
+    {
+        T L[N * (N + 1) / 2];  // L(i, j), i >= j, at packed(j, i)
+
+#pragma unroll
+        for(int j = 0; j < N; j++)
+        {
+            T d = M(j, j);
+#pragma unroll
+            for(int k = 0; k < j; k++)
+                d -= L[packed<N>(k, j)] * L[packed<N>(k, j)];
+            if(!(d > T{0}))  // also catches NaN
+                return false;
+            d                 = sqrt(d);
+            L[packed<N>(j, j)] = d;
+
+#pragma unroll
+            for(int i = j + 1; i < N; i++)
+            {
+                T s = M(j, i);
+#pragma unroll
+                for(int k = 0; k < j; k++)
+                    s -= L[packed<N>(k, i)] * L[packed<N>(k, j)];
+                L[packed<N>(j, i)] = s / d;
+            }
+        }
+        return true;
+    }
+}  // namespace details::psd
+
+template <typename T, int N>
+MUDA_INLINE MUDA_GENERIC int jacobi_evd(const Eigen::Matrix<T, N, N>& M,
+                                        Eigen::Vector<T, N>&          eigen_values,
+                                        Eigen::Matrix<T, N, N>&       eigen_vectors,
+                                        int                           max_sweeps)
+{
+    using details::psd::packed;
+    constexpr T eps = std::numeric_limits<T>::epsilon();
+
+    T a[N * (N + 1) / 2];
+    T v[N][N];
+#pragma unroll
+    for(int i = 0; i < N; i++)
+    {
+#pragma unroll
+        for(int j = 0; j < N; j++)
+        {
+            if(j >= i)
+                a[packed<N>(i, j)] = M(i, j);
+            v[i][j] = i == j ? T{1} : T{0};
+        }
+    }
+
+    int sweep = 0;
+    for(; sweep < max_sweeps; sweep++)
+    {
+        T off = 0, diag = 0;
+#pragma unroll
+        for(int i = 0; i < N; i++)
+        {
+            diag += a[packed<N>(i, i)] * a[packed<N>(i, i)];
+#pragma unroll
+            for(int j = i + 1; j < N; j++)
+                off += a[packed<N>(i, j)] * a[packed<N>(i, j)];
+        }
+        // the off diagonal part is below the rounding of the diagonal
+        if(!(off > eps * eps * diag))
+            break;
+
+#pragma unroll
+        for(int p = 0; p < N; p++)
+        {
+#pragma unroll
+            for(int q = p + 1; q < N; q++)
+            {
+                T apq = a[packed<N>(p, q)];
+                if(apq == T{0})
+                    continue;
+
+                // the rotation zeroing a(p, q), Numerical Recipes 11.1
+                T app   = a[packed<N>(p, p)];
+                T aqq   = a[packed<N>(q, q)];
+                T theta = (aqq - app) / (2 * apq);
+                T t     = theta >= T{0} ? T{1} / (theta + sqrt(T{1} + theta * theta)) :
+                                          T{-1} / (-theta + sqrt(T{1} + theta * theta));
+                T c = T{1} / sqrt(T{1} + t * t);
+                T s = t * c;
+
+                a[packed<N>(p, p)] = app - t * apq;
+                a[packed<N>(q, q)] = aqq + t * apq;
+                a[packed<N>(p, q)] = T{0};
+#pragma unroll
+                for(int k = 0; k < N; k++)
+                {
+                    if(k == p || k == q)
+                        continue;
+                    T akp              = a[packed<N>(k, p)];
+                    T akq              = a[packed<N>(k, q)];
+                    a[packed<N>(k, p)] = c * akp - s * akq;
+                    a[packed<N>(k, q)] = s * akp + c * akq;
+                }
+#pragma unroll
+                for(int k = 0; k < N; k++)
+                {
+                    T vkp   = v[k][p];
+                    T vkq   = v[k][q];
+                    v[k][p] = c * vkp - s * vkq;
+                    v[k][q] = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+
+#pragma unroll
+    for(int i = 0; i < N; i++)
+    {
+        eigen_values(i) = a[packed<N>(i, i)];
+#pragma unroll
+        for(int j = 0; j < N; j++)
+            eigen_vectors(i, j) = v[i][j];
+    }
+    return sweep;
+}
+
+template <typename T, int N>
+MUDA_INLINE MUDA_GENERIC bool project_psd(Eigen::Matrix<T, N, N>& M)
+{
+    if(details::psd::positive_definite(M))
+        return false;
+
+    Eigen::Vector<T, N>    lambda;
+    Eigen::Matrix<T, N, N> V;
+    jacobi_evd<T, N>(M, lambda, V);
+#pragma unroll
+    for(int k = 0; k < N; k++)
+        lambda(k) = lambda(k) > T{0} ? lambda(k) : T{0};
+
+    // M = V * diag(lambda) * V^T
+#pragma unroll
+    for(int i = 0; i < N; i++)
+    {
+#pragma unroll
+        for(int j = i; j < N; j++)
+        {
+            T s = 0;
+#pragma unroll
+            for(int k = 0; k < N; k++)
+                s += V(i, k) * lambda(k) * V(j, k);
+            M(i, j) = s;
+            M(j, i) = s;
+        }
+    }
+    return true;
+}
+
+template <typename T, int N>
+void project_psd(BufferView<Eigen::Matrix<T, N, N>> matrices, cudaStream_t stream)
+{
+    // a thread holds the packed matrix and the eigen vectors, keep the blocks small
+    ParallelFor(128, 0, stream)
+        .kernel_name("project_psd")
+        .apply(static_cast<int>(matrices.size()),
+               [matrices = matrices.viewer().name("matrices")] __device__(int i) mutable
+               {
+                   Eigen::Matrix<T, N, N> H = matrices(i);
+                   if(project_psd<T, N>(H))
+                       matrices(i) = H;
+               });
+}
+}  // namespace muda::eigen
@@ -1,6 +1,7 @@
 #pragma once
 #include <muda/ext/eigen/inverse/gauss_elimination.h>
 #include <muda/ext/eigen/inverse/analytic_inverse.h>
+#include <muda/ext/eigen/inverse/cholesky.h>
 
 namespace muda::eigen
 {
@@ -27,4 +28,13 @@ MUDA_INLINE MUDA_GENERIC Eigen::Matrix<T, 4, 4> inverse(const Eigen::Matrix<T, 4
 {
     return InverseAlgorithm{}(m);
 }
+
+// solve A * x = b, return 0 on success, otherwise the (1-based) index of the failing pivot
+template <typename T, int N, typename SolveAlgorithm = muda::eigen::GaussEliminationSolve>
+MUDA_INLINE MUDA_GENERIC int solve(const Eigen::Matrix<T, N, N>& A,
+                                   const Eigen::Matrix<T, N, 1>& b,
+                                   Eigen::Matrix<T, N, 1>&       x)
+{
+    return SolveAlgorithm{}(A, b, x);
+}
 }  // namespace muda::eigen
@@ -0,0 +1,63 @@
+#pragma once
+#include <muda/muda_def.h>
+#include <Eigen/Core>
+
+namespace muda::eigen
+{
+/**
+ * \brief Solve A * x = b for a symmetric positive definite A by Cholesky
+ * factorization (A = L * L^T), all in registers. Only the lower triangle of A is read.
+ *
+ * \return 0 on success, otherwise the (1-based) index of the first non-positive pivot, like LAPACK `info`.
+ */
+struct CholeskySolve
+{
+    template <typename T, int N>
+    MUDA_INLINE MUDA_GENERIC int operator()(const Eigen::Matrix<T, N, N>& input,
+                                            const Eigen::Matrix<T, N, 1>& b,
+                                            Eigen::Matrix<T, N, 1>&       x)
+    {
+        constexpr int dim = N;
+        T             L[dim][dim];
+
+        for(int j = 0; j < dim; j++)
+        {
+            T d = input(j, j);
+            for(int k = 0; k < j; k++)
+                d -= L[j][k] * L[j][k];
+            if(!(d > T{0}))  // also catches NaN
+                return j + 1;
+            d       = sqrt(d);
+            L[j][j] = d;
+
+            for(int i = j + 1; i < dim; i++)
+            {
+                T s = input(i, j);
+                for(int k = 0; k < j; k++)
+                    s -= L[i][k] * L[j][k];
+                L[i][j] = s / d;
+            }
+        }
+
+        // L * y = b
+        for(int i = 0; i < dim; i++)
+        {
+            T s = b(i);
+            for(int k = 0; k < i; k++)
+                s -= L[i][k] * x(k);
+            x(i) = s / L[i][i];
+        }
+
+        // L^T * x = y
+        for(int i = dim - 1; i >= 0; i--)
+        {
+            T s = x(i);
+            for(int k = i + 1; k < dim; k++)
+                s -= L[k][i] * x(k);
+            x(i) = s / L[i][i];
+        }
+
+        return 0;
+    }
+};
+}  // namespace muda::eigen
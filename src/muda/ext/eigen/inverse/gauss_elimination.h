@@ -86,4 +86,73 @@ struct GaussEliminationInverse
         return result;
     }
 };
+
+/**
+ * \brief Solve A * x = b by Gauss elimination with partial pivoting, all in registers.
+ *
+ * Same sweep as `GaussEliminationInverse`, but only the right hand side is
+ * carried along, so it costs O(N^3/3) instead of O(N^3).
+ *
+ * \return 0 on success, otherwise the (1-based) index of the zero pivot, like LAPACK `info`.
+ */
+struct GaussEliminationSolve
+{
+    template <typename T, int N>
+    MUDA_INLINE MUDA_GENERIC int operator()(const Eigen::Matrix<T, N, N>& input,
+                                            const Eigen::Matrix<T, N, 1>& b,
+                                            Eigen::Matrix<T, N, 1>&       x)
+    {
+        constexpr int dim = N;
+        T             mat[dim][dim + 1];
+        for(int i = 0; i < dim; i++)
+        {
+            for(int j = 0; j < dim; j++)
+                mat[i][j] = input(i, j);
+            mat[i][dim] = b(i);
+        }
+
+        auto abs_of = [](T v) { return v < 0 ? -v : v; };
+
+        for(int i = 0; i < dim; i++)
+        {
+            // pick the largest pivot in column i
+            int p = i;
+            for(int j = i + 1; j < dim; j++)
+            {
+                if(abs_of(mat[j][i]) > abs_of(mat[p][i]))
+                    p = j;
+            }
+            if(mat[p][i] == T{0})
+                return i + 1;
+            if(p != i)
+            {
+                for(int r = i; r < dim + 1; r++)
+                {
+                    T t       = mat[i][r];
+                    mat[i][r] = mat[p][r];
+                    mat[p][r] = t;
+                }
+            }
+
+            for(int j = i + 1; j < dim; j++)
+            {
+                T e = -1 * (mat[j][i] / mat[i][i]);
+                for(int r = i; r < dim + 1; r++)
+                {
+                    mat[j][r] += e * mat[i][r];
+                }
+            }
+        }
+
+        for(int i = dim - 1; i >= 0; i--)
+        {
+            T sum = mat[i][dim];
+            for(int j = i + 1; j < dim; j++)
+                sum -= mat[i][j] * x(j);
+            x(i) = sum / mat[i][i];
+        }
+
+        return 0;
+    }
+};
 }  // namespace muda::eigen
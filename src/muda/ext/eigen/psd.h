@@ -0,0 +1,58 @@
+/*****************************************************************/ /**
+ * \file   psd.h
+ * \brief  Projection of small symmetric matrices (e.g. element Hessian
+ * blocks) onto the positive semi-definite cone.
+ *
+ * `evd` uses Eigen's `SelfAdjointEigenSolver::compute` for N > 3, which is
+ * slow and spills heavily on the device. `jacobi_evd` is a cyclic Jacobi
+ * solver on a packed upper triangle, all loops have compile time bounds and
+ * are unrolled so the matrix stays in registers (as far as the register file
+ * allows, 12x12 in double spills). `project_psd` first tries a Cholesky
+ * factorization and leaves positive definite matrices untouched.
+ *********************************************************************/
+#pragma once
+#include <muda/muda_def.h>
+#include <muda/buffer/buffer_view.h>
+#include <muda/launch/parallel_for.h>
+#include <Eigen/Core>
+
+namespace muda
+{
+namespace eigen
+{
+    /**
+     * \brief Eigen decomposition of a symmetric matrix by cyclic Jacobi rotations,
+     * M = V * diag(eigen_values) * V^T. Only the upper triangle of M is read,
+     * the eigen values are not sorted.
+     *
+     * \return the sweeps taken, `max_sweeps` if it didn't converge
+     */
+    template <typename T, int N>
+    MUDA_GENERIC int jacobi_evd(const Eigen::Matrix<T, N, N>& M,
+                                Eigen::Vector<T, N>&          eigen_values,
+                                Eigen::Matrix<T, N, N>&       eigen_vectors,
+                                int                           max_sweeps = 16);
+
+    /**
+     * \brief Project a symmetric matrix onto the PSD cone in place, negative
+     * eigen values are clamped to 0.
+     *
+     * \return false if M is positive definite (M is not touched), true if it is projected
+     */
+    template <typename T, int N>
+    MUDA_GENERIC bool project_psd(Eigen::Matrix<T, N, N>& M);
+
+    /**
+     * \brief Project every matrix of `matrices` onto the PSD cone, one thread per matrix.
+     *
+     * \code
+     *  DeviceBuffer<Eigen::Matrix<float, 12, 12>> hessians;
+     *  eigen::project_psd<float, 12>(hessians.view());
+     * \endcode
+     */
+    template <typename T, int N>
+    void project_psd(BufferView<Eigen::Matrix<T, N, N>> matrices, cudaStream_t stream = nullptr);
+}  // namespace eigen
+}  // namespace muda
+
+#include "details/psd.inl"
@@ -189,4 +189,51 @@ MUDA_HOST FieldEntryLaunch& FieldEntryLaunch::copy(
 
     return *this;
 }
+
+template <typename T, FieldEntryLayout DstLayout, FieldEntryLayout SrcLayout, int M, int N>
+MUDA_HOST FieldEntryLaunch& FieldEntryLaunch::gather(FieldEntryView<T, DstLayout, M, N>  dst,
+                                                     CFieldEntryView<T, SrcLayout, M, N> src,
+                                                     CBufferView<int> indices)
+{
+    MUDA_ASSERT(dst.size() == indices.size(),
+                "FieldEntry size mismatching: dst.size() = %d, indices.size() = %d",
+                dst.size(),
+                (int)indices.size());
+
+    ParallelFor()  //
+        .apply(dst.size(),
+               [dst, src, indices = indices.data()] __device__(int i) mutable
+               {
+                   int s = indices[i];
+                   if constexpr(M == 1 && N == 1)
+                   {
+                       *dst.data(i) = *src.data(s);
+                   }
+                   else if constexpr(M > 1 && N == 1)
+                   {
+#pragma unroll
+                       for(int j = 0; j < M; ++j)
+                       {
+                           *dst.data(i, j) = *src.data(s, j);
+                       }
+                   }
+                   else if constexpr(M > 1 && N > 1)
+                   {
+#pragma unroll
+                       for(int j = 0; j < M; ++j)
+                       {
+#pragma unroll
+                           for(int k = 0; k < N; ++k)
+                           {
+                               *dst.data(i, j, k) = *src.data(s, j, k);
+                           }
+                       }
+                   }
+                   else
+                   {
+                       static_assert("Invalid");
+                   }
+               });
+    return *this;
+}
 }  // namespace muda
\ No newline at end of file
@@ -50,6 +50,17 @@ class FieldEntryLaunch : public LaunchBase<FieldEntryLaunch>
     MUDA_HOST FieldEntryLaunch& copy(
         FieldEntryView<T, DstLayout, M, N> dst,
         CBufferView<typename FieldEntryView<T, DstLayout, M, N>::ElementType> src);
+
+    /**********************************************************************************************
+    *   
+    * EntryView <- EntryView[indices]
+    *   
+    * *********************************************************************************************/
+    // dst(i) = src(indices(i)), e.g. reorder an entry with `LinearSystemPermutation::perm()`
+    template <typename T, FieldEntryLayout DstLayout, FieldEntryLayout SrcLayout, int M, int N>
+    MUDA_HOST FieldEntryLaunch& gather(FieldEntryView<T, DstLayout, M, N>  dst,
+                                       CFieldEntryView<T, SrcLayout, M, N> src,
+                                       CBufferView<int>                    indices);
 };
 }  // namespace muda
 
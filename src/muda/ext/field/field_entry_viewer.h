@@ -68,7 +68,7 @@ class FieldEntryViewerCore : protected ViewerBase<IsConst>
     {
         Base::name(core->name_string_pointer());
 
-        MUDA_KERNEL_ASSERT(m_offset >= 0 && m_size >= 0 && m_offset + m_size <= total_count(),
+        MUDA_VIEWER_ASSERT(m_offset >= 0 && m_size >= 0 && m_offset + m_size <= total_count(),
                            "FieldEntryViewer[%s:%s]: offset/size indexing out of range, size=%d, offset=%d, size=%d",
                            this->name(),
                            this->kernel_name(),
@@ -93,7 +93,7 @@ class FieldEntryViewerCore : protected ViewerBase<IsConst>
     {
         check_index(i);
 
-        MUDA_KERNEL_ASSERT(j < shape().x,
+        MUDA_VIEWER_ASSERT(j < shape().x,
                            "FieldEntry[%s:%s]: vector component indexing out of range, shape=(%d, %d), index=%d",
                            this->name(),
                            this->kernel_name(),
@@ -107,7 +107,7 @@ class FieldEntryViewerCore : protected ViewerBase<IsConst>
     {
         check_index(i);
 
-        MUDA_KERNEL_ASSERT(row_index < shape().x && col_index < shape().y,
+        MUDA_VIEWER_ASSERT(row_index < shape().x && col_index < shape().y,
                            "FieldEntry[%s:%s]: vector component indexing out of range, shape=(%d,%d), index=(%d,%d)",
                            this->name(),
                            this->kernel_name(),
@@ -135,7 +135,7 @@ class FieldEntryViewerCore : protected ViewerBase<IsConst>
   private:
     MUDA_INLINE MUDA_GENERIC void check_index(int i) const
     {
-        MUDA_KERNEL_ASSERT(i < m_size,
+        MUDA_VIEWER_ASSERT(i < m_size,
                            "FieldEntryViewer[%s:%s]: indexing out of range, index=%d, size=%d, offset=%d, entry_total_count=%d",
                            this->name(),
                            this->kernel_name(),
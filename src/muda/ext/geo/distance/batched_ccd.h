@@ -0,0 +1,188 @@
+/*****************************************************************/ /**
+ * \file   batched_ccd.h
+ * \brief  Load-balanced batched additive CCD.
+ *
+ * The additive CCD loop of `point_triangle_ccd` / `edge_edge_ccd` needs from
+ * a few to thousands of iterations per pair, so one slow pair stalls its whole
+ * warp. The batched driver runs at most `iterations_per_round` iterations per
+ * pair in a round, compacts the unfinished pairs together with their loop state
+ * and relaunches until no pair is left.
+ *********************************************************************/
+#pragma once
+#include <vector>
+#include <muda/buffer/device_buffer.h>
+#include <muda/buffer/device_append_buffer.h>
+#include <muda/launch/parallel_for.h>
+#include <muda/ext/geo/distance/ccd.h>
+
+namespace muda::distance
+{
+enum class CCDStatus : int
+{
+    Running = 0,
+    Hit     = 1,  // toc is found (or max_iter is reached)
+    Miss    = 2   // no collision before the input toc
+};
+
+/**
+ * \brief The loop state of the additive CCD, enough to resume the loop.
+ */
+struct AdditiveCCDState
+{
+    Eigen::Vector3f x[4];   // current positions
+    Eigen::Vector3f dx[4];  // displacements, with the mean removed
+    float           max_disp_mag;
+    float           dist_cur;
+    float           d_func;  // dist^2 - thickness^2
+    float           gap;
+    float           toc;
+    float           toc_prev;
+    int             max_iter;
+    int             pair;  // index of the pair in the batch
+};
+
+/**
+ * \brief Resumable form of `point_triangle_ccd`, x = {p, t0, t1, t2}.
+ */
+struct PointTriangleAdditiveCCD
+{
+    MUDA_GENERIC static CCDStatus init(AdditiveCCDState& s, float eta, float thickness, int max_iter, float toc);
+    MUDA_GENERIC static CCDStatus advance(AdditiveCCDState& s, float eta, float thickness, int iterations);
+};
+
+/**
+ * \brief Resumable form of `edge_edge_ccd`, x = {ea0, ea1, eb0, eb1}.
+ */
+struct EdgeEdgeAdditiveCCD
+{
+    MUDA_GENERIC static CCDStatus init(AdditiveCCDState& s, float eta, float thickness, int max_iter, float toc);
+    MUDA_GENERIC static CCDStatus advance(AdditiveCCDState& s, float eta, float thickness, int iterations);
+};
+
+/**
+ * \brief Parameters shared by `BatchedCCD` and `HostBatchedCCD`.
+ *
+ * `eta`, `thickness` and `max_iter` have the same meaning as in `point_triangle_ccd`.
+ */
+struct BatchedCCDConfig
+{
+    float eta                  = 0.1f;
+    float thickness            = 0.0f;
+    int   max_iter             = -1;  // < 0: unlimited
+    int   iterations_per_round = 16;
+};
+
+/**
+ * \class BatchedCCD
+ *
+ * \brief Batched additive CCD on the device.
+ *
+ * Every primitive is 4 vertex indices into `x` (positions) and `dx` (displacements):
+ * (p, t0, t1, t2) for point-triangle, (ea0, ea1, eb0, eb1) for edge-edge.
+ *
+ * \code
+ *  BatchedCCD ccd;
+ *  ccd.config().eta = 0.1f;
+ *  float alpha = ccd.point_triangle(pts, x, dx, tois);  // min toc, 1.0 if no collision
+ * \endcode
+ */
+class BatchedCCD
+{
+  public:
+    BatchedCCD(muda::Stream& stream = muda::Stream::Default())
+        : m_stream(stream)
+    {
+    }
+
+    BatchedCCDConfig&       config() MUDA_NOEXCEPT { return m_config; }
+    const BatchedCCDConfig& config() const MUDA_NOEXCEPT { return m_config; }
+
+    /**
+     * \brief Per-pair tocs are written to `tois` (`toc_upper` if no collision).
+     *
+     * \return the minimum toc of all pairs (sync)
+     */
+    float point_triangle(CBufferView<Eigen::Vector4i>  pts,
+                         CBufferView<Eigen::Vector3f> x,
+                         CBufferView<Eigen::Vector3f> dx,
+                         BufferView<float>            tois,
+                         float                        toc_upper = 1.0f)
+    {
+        return run<PointTriangleAdditiveCCD>(pts, x, dx, tois, toc_upper);
+    }
+
+    float edge_edge(CBufferView<Eigen::Vector4i>  ees,
+                    CBufferView<Eigen::Vector3f> x,
+                    CBufferView<Eigen::Vector3f> dx,
+                    BufferView<float>            tois,
+                    float                        toc_upper = 1.0f)
+    {
+        return run<EdgeEdgeAdditiveCCD>(ees, x, dx, tois, toc_upper);
+    }
+
+    // rounds taken by the last run
+    int rounds() const MUDA_NOEXCEPT { return m_rounds; }
+
+    // the generic driver, `Policy` provides `init` and `advance`
+    template <typename Policy>
+    float run(CBufferView<Eigen::Vector4i>  prims,
+              CBufferView<Eigen::Vector3f> x,
+              CBufferView<Eigen::Vector3f> dx,
+              BufferView<float>            tois,
+              float                        toc_upper);
+
+  private:
+    muda::Stream&    m_stream;
+    BatchedCCDConfig m_config;
+    int              m_rounds = 0;
+
+    DeviceAppendBuffer<AdditiveCCDState> m_active;
+    DeviceAppendBuffer<AdditiveCCDState> m_next;
+    DeviceVar<float>                     m_min_toi;
+};
+
+/**
+ * \class HostBatchedCCD
+ *
+ * \brief Host backend of `BatchedCCD`, running the same rounds sequentially.
+ */
+class HostBatchedCCD
+{
+  public:
+    BatchedCCDConfig&       config() MUDA_NOEXCEPT { return m_config; }
+    const BatchedCCDConfig& config() const MUDA_NOEXCEPT { return m_config; }
+
+    float point_triangle(const std::vector<Eigen::Vector4i>& pts,
+                         const std::vector<Eigen::Vector3f>& x,
+                         const std::vector<Eigen::Vector3f>& dx,
+                         std::vector<float>&                 tois,
+                         float                               toc_upper = 1.0f)
+    {
+        return run<PointTriangleAdditiveCCD>(pts, x, dx, tois, toc_upper);
+    }
+
+    float edge_edge(const std::vector<Eigen::Vector4i>& ees,
+                    const std::vector<Eigen::Vector3f>& x,
+                    const std::vector<Eigen::Vector3f>& dx,
+                    std::vector<float>&                 tois,
+                    float                               toc_upper = 1.0f)
+    {
+        return run<EdgeEdgeAdditiveCCD>(ees, x, dx, tois, toc_upper);
+    }
+
+    int rounds() const MUDA_NOEXCEPT { return m_rounds; }
+
+    template <typename Policy>
+    float run(const std::vector<Eigen::Vector4i>& prims,
+              const std::vector<Eigen::Vector3f>& x,
+              const std::vector<Eigen::Vector3f>& dx,
+              std::vector<float>&                 tois,
+              float                               toc_upper);
+
+  private:
+    BatchedCCDConfig m_config;
+    int              m_rounds = 0;
+};
+}  // namespace muda::distance
+
+#include "details/batched_ccd.inl"
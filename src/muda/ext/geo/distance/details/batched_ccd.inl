@@ -0,0 +1,301 @@
+#include <algorithm>
+#include <muda/buffer/buffer_launch.h>
+#include <muda/cub/device/device_reduce.h>
+
+namespace muda::distance
+{
+namespace details
+{
+    // the loop body of the additive CCD, `dist2` returns the squared distance of `s.x`
+    template <typename Dist2>
+    MUDA_INLINE MUDA_GENERIC CCDStatus additive_ccd_advance(
+        AdditiveCCDState& s, float eta, float thickness, int iterations, Dist2&& dist2)
+    {
+        using T = float;
+        for(int it = 0; it < iterations; ++it)
+        {
+            if(s.max_iter >= 0)
+            {
+                if(--s.max_iter < 0)
+                    return CCDStatus::Hit;
+            }
+
+            T tocLowerBound =
+                (1 - eta) * s.d_func / ((s.dist_cur + thickness) * s.max_disp_mag);
+
+            for(int k = 0; k < 4; ++k)
+                s.x[k] += tocLowerBound * s.dx[k];
+
+            T dist2_cur = dist2(s.x);
+            s.d_func    = dist2_cur - thickness * thickness;
+            s.dist_cur  = sqrt(dist2_cur);
+            if(s.toc && (s.d_func / (s.dist_cur + thickness) < s.gap))
+                return CCDStatus::Hit;
+
+            s.toc += tocLowerBound;
+            if(s.toc > s.toc_prev)
+                return CCDStatus::Miss;
+        }
+        return CCDStatus::Running;
+    }
+
+    MUDA_INLINE MUDA_GENERIC float point_triangle_ccd_dist2(const Eigen::Vector3f* x)
+    {
+        float dist2;
+        point_triangle_distance_unclassified(x[0], x[1], x[2], x[3], dist2);
+        return dist2;
+    }
+
+    MUDA_INLINE MUDA_GENERIC float edge_edge_ccd_dist2(const Eigen::Vector3f* x, float thickness)
+    {
+        using T = float;
+        T dist2_cur;
+        edge_edge_distance_unclassified(x[0], x[1], x[2], x[3], dist2_cur);
+        if(dist2_cur - thickness * thickness <= 0)
+        {
+            // same as edge_edge_ccd: far away nearly parallel edges
+            Eigen::Array4<T> dists{(x[0] - x[2]).squaredNorm(),
+                                   (x[0] - x[3]).squaredNorm(),
+                                   (x[1] - x[2]).squaredNorm(),
+                                   (x[1] - x[3]).squaredNorm()};
+            dist2_cur = dists.minCoeff();
+        }
+        return dist2_cur;
+    }
+
+    MUDA_INLINE MUDA_GENERIC void additive_ccd_start(
+        AdditiveCCDState& s, float eta, float thickness, int max_iter, float toc, float dist2_cur)
+    {
+        s.d_func   = dist2_cur - thickness * thickness;
+        s.dist_cur = sqrt(dist2_cur);
+        s.gap      = eta * s.d_func / (s.dist_cur + thickness);
+        s.toc_prev = toc;
+        s.toc      = 0;
+        s.max_iter = max_iter;
+    }
+
+    // finish a pair or keep it for the next round
+    template <typename Tois, typename Active>
+    MUDA_INLINE MUDA_GENERIC void batched_ccd_commit(
+        CCDStatus status, const AdditiveCCDState& s, float toc_upper, Tois& tois, Active& active)
+    {
+        if(status == CCDStatus::Running)
+            active.push_back(s);
+        else
+            tois(s.pair) = status == CCDStatus::Hit ? s.toc : toc_upper;
+    }
+}  // namespace details
+
+MUDA_INLINE MUDA_GENERIC CCDStatus PointTriangleAdditiveCCD::init(
+    AdditiveCCDState& s, float eta, float thickness, int max_iter, float toc)
+{
+    using T = float;
+    // same as point_triangle_ccd
+    Eigen::Matrix<T, 3, 1> mov = (s.dx[1] + s.dx[2] + s.dx[3] + s.dx[0]) / 4;
+    for(int k = 0; k < 4; ++k)
+        s.dx[k] -= mov;
+    Eigen::Array3<T> dispMag2Vec{
+        s.dx[1].squaredNorm(), s.dx[2].squaredNorm(), s.dx[3].squaredNorm()};
+    s.max_disp_mag = s.dx[0].norm() + sqrt(dispMag2Vec.maxCoeff());
+    if(s.max_disp_mag <= T(0))
+        return CCDStatus::Miss;
+
+    details::additive_ccd_start(
+        s, eta, thickness, max_iter, toc, details::point_triangle_ccd_dist2(s.x));
+    return CCDStatus::Running;
+}
+
+MUDA_INLINE MUDA_GENERIC CCDStatus PointTriangleAdditiveCCD::advance(AdditiveCCDState& s,
+                                                                     float eta,
+                                                                     float thickness,
+                                                                     int iterations)
+{
+    return details::additive_ccd_advance(s,
+                                         eta,
+                                         thickness,
+                                         iterations,
+                                         [](const Eigen::Vector3f* x)
+                                         { return details::point_triangle_ccd_dist2(x); });
+}
+
+MUDA_INLINE MUDA_GENERIC CCDStatus EdgeEdgeAdditiveCCD::init(
+    AdditiveCCDState& s, float eta, float thickness, int max_iter, float toc)
+{
+    using T = float;
+    // same as edge_edge_ccd
+    Eigen::Matrix<T, 3, 1> mov = (s.dx[0] + s.dx[1] + s.dx[2] + s.dx[3]) / 4;
+    for(int k = 0; k < 4; ++k)
+        s.dx[k] -= mov;
+    s.max_disp_mag = sqrt(std::max(s.dx[0].squaredNorm(), s.dx[1].squaredNorm()))
+                     + sqrt(std::max(s.dx[2].squaredNorm(), s.dx[3].squaredNorm()));
+    if(s.max_disp_mag == 0)
+        return CCDStatus::Miss;
+
+    details::additive_ccd_start(
+        s, eta, thickness, max_iter, toc, details::edge_edge_ccd_dist2(s.x, thickness));
+    return CCDStatus::Running;
+}
+
+MUDA_INLINE MUDA_GENERIC CCDStatus EdgeEdgeAdditiveCCD::advance(AdditiveCCDState& s,
+                                                                float eta,
+                                                                float thickness,
+                                                                int   iterations)
+{
+    return details::additive_ccd_advance(
+        s,
+        eta,
+        thickness,
+        iterations,
+        [thickness](const Eigen::Vector3f* x)
+        { return details::edge_edge_ccd_dist2(x, thickness); });
+}
+
+template <typename Policy>
+float BatchedCCD::run(CBufferView<Eigen::Vector4i>  prims,
+                      CBufferView<Eigen::Vector3f> x,
+                      CBufferView<Eigen::Vector3f> dx,
+                      BufferView<float>            tois,
+                      float                        toc_upper)
+{
+    MUDA_ASSERT(prims.size() == tois.size(),
+                "prims.size()=%lld, tois.size()=%lld",
+                (long long)prims.size(),
+                (long long)tois.size());
+    MUDA_ASSERT(m_config.iterations_per_round > 0,
+                "iterations_per_round(%d) should be positive",
+                m_config.iterations_per_round);
+
+    m_rounds = 0;
+    int n    = static_cast<int>(prims.size());
+    if(n == 0)
+        return toc_upper;
+
+    // unfinished pairs never exceed n, so the appending never overflows
+    m_active.reserve(n);
+    m_next.reserve(n);
+    m_active.clear();
+
+    // the first round: load, init and advance
+    ParallelFor(0, m_stream)
+        .kernel_name("batched_ccd_init")
+        .apply(n,
+               [prims  = prims.viewer().name("prims"),
+                x      = x.viewer().name("x"),
+                dx     = dx.viewer().name("dx"),
+                tois   = tois.viewer().name("tois"),
+                active = m_active.viewer().name("active"),
+                config = m_config,
+                toc_upper] __device__(int i) mutable
+               {
+                   AdditiveCCDState s;
+                   auto             prim = prims(i);
+                   for(int k = 0; k < 4; ++k)
+                   {
+                       s.x[k]  = x(prim[k]);
+                       s.dx[k] = dx(prim[k]);
+                   }
+                   s.pair = i;
+
+                   auto status = Policy::init(
+                       s, config.eta, config.thickness, config.max_iter, toc_upper);
+                   if(status == CCDStatus::Running)
+                       status = Policy::advance(
+                           s, config.eta, config.thickness, config.iterations_per_round);
+                   details::batched_ccd_commit(status, s, toc_upper, tois, active);
+               });
+    ++m_rounds;
+
+    // the following rounds only touch the compacted unfinished pairs
+    int active_count;
+    while((active_count = static_cast<int>(m_active.size())) > 0)
+    {
+        m_next.clear();
+        ParallelFor(0, m_stream)
+            .kernel_name("batched_ccd_advance")
+            .apply(active_count,
+                   [states = m_active.view().cviewer().name("states"),
+                    tois   = tois.viewer().name("tois"),
+                    next   = m_next.viewer().name("next"),
+                    config = m_config,
+                    toc_upper] __device__(int i) mutable
+                   {
+                       auto s      = states(i);
+                       auto status = Policy::advance(
+                           s, config.eta, config.thickness, config.iterations_per_round);
+                       details::batched_ccd_commit(status, s, toc_upper, tois, next);
+                   });
+        std::swap(m_active, m_next);
+        ++m_rounds;
+    }
+
+    float min_toi = toc_upper;
+    DeviceReduce(m_stream).Min(tois.data(), m_min_toi.data(), n);
+    BufferLaunch(m_stream).copy(&min_toi, m_min_toi.view()).wait();
+    return min_toi;
+}
+
+template <typename Policy>
+float HostBatchedCCD::run(const std::vector<Eigen::Vector4i>& prims,
+                          const std::vector<Eigen::Vector3f>& x,
+                          const std::vector<Eigen::Vector3f>& dx,
+                          std::vector<float>&                 tois,
+                          float                               toc_upper)
+{
+    MUDA_ASSERT(m_config.iterations_per_round > 0,
+                "iterations_per_round(%d) should be positive",
+                m_config.iterations_per_round);
+
+    m_rounds = 0;
+    int n    = static_cast<int>(prims.size());
+    tois.resize(n);
+    if(n == 0)
+        return toc_upper;
+
+    auto& config = m_config;
+
+    // same as details::batched_ccd_commit
+    auto commit = [&](CCDStatus status, const AdditiveCCDState& s, std::vector<AdditiveCCDState>& out)
+    {
+        if(status == CCDStatus::Running)
+            out.push_back(s);
+        else
+            tois[s.pair] = status == CCDStatus::Hit ? s.toc : toc_upper;
+    };
+
+    std::vector<AdditiveCCDState> active, next;
+    active.reserve(n);
+    next.reserve(n);
+
+    for(int i = 0; i < n; ++i)
+    {
+        AdditiveCCDState s;
+        for(int k = 0; k < 4; ++k)
+        {
+            s.x[k]  = x[prims[i][k]];
+            s.dx[k] = dx[prims[i][k]];
+        }
+        s.pair = i;
+
+        auto status = Policy::init(s, config.eta, config.thickness, config.max_iter, toc_upper);
+        if(status == CCDStatus::Running)
+            status = Policy::advance(s, config.eta, config.thickness, config.iterations_per_round);
+        commit(status, s, active);
+    }
+    ++m_rounds;
+
+    while(!active.empty())
+    {
+        next.clear();
+        for(auto s : active)
+        {
+            auto status = Policy::advance(
+                s, config.eta, config.thickness, config.iterations_per_round);
+            commit(status, s, next);
+        }
+        std::swap(active, next);
+        ++m_rounds;
+    }
+
+    return *std::min_element(tois.begin(), tois.end());
+}
+}  // namespace muda::distance
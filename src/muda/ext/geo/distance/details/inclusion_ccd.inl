@@ -0,0 +1,405 @@
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <muda/buffer/buffer_launch.h>
+#include <muda/cub/device/device_reduce.h>
+
+namespace muda::distance
+{
+namespace details
+{
+    // the boxes waiting for a check, if it's full the latest one is dropped
+    constexpr int InclusionCCDQueueSize = 128;
+
+    // a box of the parameter domain, dimension 0 is t, 1 is u, 2 is v, the
+    // interval of dimension k is [n[k], n[k] + 1] / 2^l[k] (t scaled by the upper bound)
+    struct InclusionCCDBox
+    {
+        uint32_t n[3];
+        uint8_t  l[3];
+    };
+
+    // the deepest level of a dimension, n / 2^l must be exact in T
+    template <typename T>
+    MUDA_GENERIC constexpr int inclusion_ccd_max_level()
+    {
+        return std::numeric_limits<T>::digits < 31 ? std::numeric_limits<T>::digits : 31;
+    }
+
+    // the earliest box first, the deepest one among the same t
+    MUDA_INLINE MUDA_GENERIC bool inclusion_ccd_before(const InclusionCCDBox& a,
+                                                       const InclusionCCDBox& b)
+    {
+        uint64_t ta = uint64_t(a.n[0]) << (31 - a.l[0]);
+        uint64_t tb = uint64_t(b.n[0]) << (31 - b.l[0]);
+        return ta < tb
+               || (ta == tb && a.l[0] + a.l[1] + a.l[2] > b.l[0] + b.l[1] + b.l[2]);
+    }
+
+    // a binary heap of boxes ordered by `inclusion_ccd_before`
+    class InclusionCCDQueue
+    {
+        InclusionCCDBox m_boxes[InclusionCCDQueueSize];
+        int             m_size = 0;
+
+        MUDA_GENERIC void sift_up(int i, const InclusionCCDBox& b)
+        {
+            while(i > 0)
+            {
+                int parent = (i - 1) / 2;
+                if(!inclusion_ccd_before(b, m_boxes[parent]))
+                    break;
+                m_boxes[i] = m_boxes[parent];
+                i          = parent;
+            }
+            m_boxes[i] = b;
+        }
+
+      public:
+        MUDA_GENERIC bool empty() const { return m_size == 0; }
+
+        // push `b`, if the queue is full the latest box (maybe `b`) is dropped
+        MUDA_GENERIC bool push(const InclusionCCDBox& b, InclusionCCDBox& dropped)
+        {
+            if(m_size < InclusionCCDQueueSize)
+            {
+                sift_up(m_size++, b);
+                return false;
+            }
+            // the latest box is a leaf
+            int latest = m_size / 2;
+            for(int i = latest + 1; i < m_size; ++i)
+                if(inclusion_ccd_before(m_boxes[latest], m_boxes[i]))
+                    latest = i;
+            if(!inclusion_ccd_before(b, m_boxes[latest]))
+            {
+                dropped = b;
+                return true;
+            }
+            dropped = m_boxes[latest];
+            sift_up(latest, b);
+            return true;
+        }
+
+        MUDA_GENERIC InclusionCCDBox pop()
+        {
+            InclusionCCDBox top  = m_boxes[0];
+            InclusionCCDBox last = m_boxes[--m_size];
+            int             i    = 0;
+            while(true)
+            {
+                int child = 2 * i + 1;
+                if(child >= m_size)
+                    break;
+                if(child + 1 < m_size && inclusion_ccd_before(m_boxes[child + 1], m_boxes[child]))
+                    ++child;
+                if(!inclusion_ccd_before(m_boxes[child], last))
+                    break;
+                m_boxes[i] = m_boxes[child];
+                i          = child;
+            }
+            m_boxes[i] = last;
+            return top;
+        }
+    };
+
+    // the bounds of a box, `t_max` is the upper bound of t
+    template <typename T>
+    MUDA_INLINE MUDA_GENERIC void inclusion_ccd_interval(const InclusionCCDBox& b, T t_max, T* lo, T* hi)
+    {
+        for(int k = 0; k < 3; ++k)
+        {
+            T scale = T(1) / T(uint64_t(1) << b.l[k]);
+            lo[k]   = T(b.n[k]) * scale;
+            hi[k]   = T(b.n[k] + 1) * scale;
+        }
+        lo[0] *= t_max;
+        hi[0] *= t_max;
+    }
+
+    // F at the 8 corners of the box, bit 0 of the corner index is t, bit 1 is u, bit 2 is v
+    template <typename Policy, typename T>
+    MUDA_INLINE MUDA_GENERIC void inclusion_ccd_corners(const Eigen::Matrix<T, 3, 1>* x,
+                                                        const Eigen::Matrix<T, 3, 1>* dx,
+                                                        const T*                      lo,
+                                                        const T*                      hi,
+                                                        Eigen::Matrix<T, 3, 1>*       f)
+    {
+        for(int i = 0; i < 2; ++i)
+        {
+            T                      t = i ? hi[0] : lo[0];
+            Eigen::Matrix<T, 3, 1> y[4];
+            for(int k = 0; k < 4; ++k)
+                y[k] = x[k] + t * dx[k];
+            for(int j = 0; j < 4; ++j)
+                f[i | (j << 1)] =
+                    Policy::eval(y, (j & 1) ? hi[1] : lo[1], (j & 2) ? hi[2] : lo[2]);
+        }
+    }
+}  // namespace details
+
+template <typename T>
+MUDA_INLINE MUDA_GENERIC Eigen::Matrix<T, 3, 1> PointTriangleInclusionCCD::eval(
+    const Eigen::Matrix<T, 3, 1>* x, T u, T v)
+{
+    return x[0] - x[1] - u * (x[2] - x[1]) - v * (x[3] - x[1]);
+}
+
+template <typename T>
+MUDA_INLINE MUDA_GENERIC bool PointTriangleInclusionCCD::valid(const T* lo, const T* hi)
+{
+    return lo[1] + lo[2] <= T(1);
+}
+
+template <typename T>
+MUDA_INLINE MUDA_GENERIC Eigen::Matrix<T, 3, 1> EdgeEdgeInclusionCCD::eval(
+    const Eigen::Matrix<T, 3, 1>* x, T u, T v)
+{
+    return x[0] + u * (x[1] - x[0]) - x[2] - v * (x[3] - x[2]);
+}
+
+template <typename T>
+MUDA_INLINE MUDA_GENERIC bool EdgeEdgeInclusionCCD::valid(const T* lo, const T* hi)
+{
+    return true;
+}
+
+template <typename Policy, typename T>
+MUDA_INLINE MUDA_GENERIC bool inclusion_ccd(const Eigen::Matrix<T, 3, 1>* x,
+                                            const Eigen::Matrix<T, 3, 1>* dx,
+                                            T   min_separation,
+                                            T   tolerance,
+                                            int max_iter,
+                                            T&  toi)
+{
+    using Vector3 = Eigen::Matrix<T, 3, 1>;
+    using Box     = details::InclusionCCDBox;
+
+    // the vertices stay in the box spanned by their start and end positions,
+    // so a corner of F is off by at most ~19 eps * m (first order), rounded up
+    Vector3 m = Vector3::Zero();
+    for(int k = 0; k < 4; ++k)
+        m = m.cwiseMax(x[k].cwiseAbs()).cwiseMax((x[k] + dx[k]).cwiseAbs());
+    Vector3 inflate =
+        m * (T(32) * std::numeric_limits<T>::epsilon()) + Vector3::Constant(min_separation);
+
+    // best first: the earliest box is checked first, so the first accepted one is the root
+    T                          t_max = toi;
+    details::InclusionCCDQueue queue;
+    Box                        dropped;
+    queue.push(Box{{0, 0, 0}, {0, 0, 0}}, dropped);
+
+    bool hit  = false;
+    int  iter = 0;
+    while(!queue.empty())
+    {
+        Box b = queue.pop();
+        T   lo_t[3], hi_t[3];
+        details::inclusion_ccd_interval(b, t_max, lo_t, hi_t);
+        if(lo_t[0] >= toi)
+            break;
+        if(!Policy::valid(lo_t, hi_t))
+            continue;
+
+        if(max_iter >= 0 && iter++ >= max_iter)
+        {
+            // give up, nothing before the earliest pending box is excluded
+            toi = lo_t[0];
+            return true;
+        }
+
+        // F is multilinear, its range over the box is spanned by the corners
+        Vector3 f[8];
+        details::inclusion_ccd_corners<Policy>(x, dx, lo_t, hi_t, f);
+        Vector3 lo = f[0], hi = f[0];
+        for(int c = 1; c < 8; ++c)
+        {
+            lo = lo.cwiseMin(f[c]);
+            hi = hi.cwiseMax(f[c]);
+        }
+        if(((lo - inflate).array() > T(0)).any() || ((hi + inflate).array() < T(0)).any())
+            continue;  // 0 is excluded on some axis
+
+        // an axis is open if some point of the box may violate it
+        Eigen::Array<bool, 3, 1> open =
+            (lo + inflate).array() < T(0) || (hi - inflate).array() > T(0);
+        bool small = (!open || (hi - lo).array() <= tolerance).all();
+
+        // split the dimension changing the open axes the most, t is preferred
+        // since narrowing it resolves the earliest boxes before the queue grows
+        int d     = 0;
+        T   delta = T(-1);
+        for(int k = 0; k < 3; ++k)
+        {
+            T change = T(0);
+            for(int c = 0; c < 8; ++c)
+                if(!(c & (1 << k)))
+                    change = std::max(change,
+                                      open.select((f[c | (1 << k)] - f[c]).array().abs(), T(0))
+                                          .maxCoeff());
+            if(k == 0)
+                change *= T(4);
+            if(change > delta)
+            {
+                delta = change;
+                d     = k;
+            }
+        }
+        bool leaf = b.l[d] >= details::inclusion_ccd_max_level<T>();
+
+        // the earliest box that may hold a root, or can't be refined any further
+        if(small || leaf)
+        {
+            toi = lo_t[0];
+            return true;
+        }
+
+        for(uint32_t half = 0; half < 2; ++half)
+        {
+            Box c  = b;
+            c.n[d] = 2 * b.n[d] + half;
+            c.l[d] = b.l[d] + 1;
+            if(queue.push(c, dropped))
+            {
+                // nothing after the dropped box is checked any more
+                T dropped_lo[3], dropped_hi[3];
+                details::inclusion_ccd_interval(dropped, t_max, dropped_lo, dropped_hi);
+                toi = std::min(toi, dropped_lo[0]);
+                hit = true;
+            }
+        }
+    }
+
+    return hit;
+}
+
+template <typename T>
+MUDA_INLINE MUDA_GENERIC bool point_triangle_inclusion_ccd(const Eigen::Matrix<T, 3, 1>& p,
+                                                           const Eigen::Matrix<T, 3, 1>& t0,
+                                                           const Eigen::Matrix<T, 3, 1>& t1,
+                                                           const Eigen::Matrix<T, 3, 1>& t2,
+                                                           const Eigen::Matrix<T, 3, 1>& dp,
+                                                           const Eigen::Matrix<T, 3, 1>& dt0,
+                                                           const Eigen::Matrix<T, 3, 1>& dt1,
+                                                           const Eigen::Matrix<T, 3, 1>& dt2,
+                                                           T   min_separation,
+                                                           T   tolerance,
+                                                           int max_iter,
+                                                           T&  toi)
+{
+    Eigen::Matrix<T, 3, 1> x[4]  = {p, t0, t1, t2};
+    Eigen::Matrix<T, 3, 1> dx[4] = {dp, dt0, dt1, dt2};
+    return inclusion_ccd<PointTriangleInclusionCCD>(
+        x, dx, min_separation, tolerance, max_iter, toi);
+}
+
+template <typename T>
+MUDA_INLINE MUDA_GENERIC bool edge_edge_inclusion_ccd(const Eigen::Matrix<T, 3, 1>& ea0,
+                                                      const Eigen::Matrix<T, 3, 1>& ea1,
+                                                      const Eigen::Matrix<T, 3, 1>& eb0,
+                                                      const Eigen::Matrix<T, 3, 1>& eb1,
+                                                      const Eigen::Matrix<T, 3, 1>& dea0,
+                                                      const Eigen::Matrix<T, 3, 1>& dea1,
+                                                      const Eigen::Matrix<T, 3, 1>& deb0,
+                                                      const Eigen::Matrix<T, 3, 1>& deb1,
+                                                      T   min_separation,
+                                                      T   tolerance,
+                                                      int max_iter,
+                                                      T&  toi)
+{
+    Eigen::Matrix<T, 3, 1> x[4]  = {ea0, ea1, eb0, eb1};
+    Eigen::Matrix<T, 3, 1> dx[4] = {dea0, dea1, deb0, deb1};
+    return inclusion_ccd<EdgeEdgeInclusionCCD>(x, dx, min_separation, tolerance, max_iter, toi);
+}
+
+template <typename T>
+template <typename Policy>
+T BatchedInclusionCCD<T>::run(CBufferView<Eigen::Vector4i> prims,
+                              CBufferView<Vector3>         x,
+                              CBufferView<Vector3>         dx,
+                              BufferView<T>                tois,
+                              T                            toi_upper)
+{
+    MUDA_ASSERT(prims.size() == tois.size(),
+                "prims.size()=%lld, tois.size()=%lld",
+                (long long)prims.size(),
+                (long long)tois.size());
+
+    int n = static_cast<int>(prims.size());
+    if(n == 0)
+        return toi_upper;
+
+    ParallelFor(0, m_stream)
+        .kernel_name("batched_inclusion_ccd")
+        .apply(n,
+               [prims  = prims.viewer().name("prims"),
+                x      = x.viewer().name("x"),
+                dx     = dx.viewer().name("dx"),
+                tois   = tois.viewer().name("tois"),
+                config = m_config,
+                toi_upper] __device__(int i) mutable
+               {
+                   Vector3 px[4], pdx[4];
+                   auto    prim = prims(i);
+                   for(int k = 0; k < 4; ++k)
+                   {
+                       px[k]  = x(prim[k]);
+                       pdx[k] = dx(prim[k]);
+                   }
+                   T toi = toi_upper;
+                   tois(i) = inclusion_ccd<Policy>(
+                                 px, pdx, config.min_separation, config.tolerance, config.max_iter, toi) ?
+                                 toi :
+                                 toi_upper;
+               });
+
+    T min_toi = toi_upper;
+    DeviceReduce(m_stream).Min(tois.data(), m_min_toi.data(), n);
+    BufferLaunch(m_stream).copy(&min_toi, m_min_toi.view()).wait();
+    return min_toi;
+}
+
+template <typename T>
+template <typename Policy>
+T HostBatchedInclusionCCD<T>::run(const std::vector<Eigen::Vector4i>& prims,
+                                  const std::vector<Vector3>&         x,
+                                  const std::vector<Vector3>&         dx,
+                                  std::vector<T>&                     tois,
+                                  T                                   toi_upper)
+{
+    size_t n = prims.size();
+    tois.resize(n);
+    if(n == 0)
+        return toi_upper;
+
+    auto& pool = HostThreadPool::global();
+    // a few chunks per thread, the cost of a pair varies a lot
+    size_t chunk_count = std::min(n, pool.thread_count() * 8);
+    size_t chunk_size  = (n + chunk_count - 1) / chunk_count;
+    pool.run(chunk_count,
+             [&](size_t c)
+             {
+                 size_t end = std::min(n, (c + 1) * chunk_size);
+                 for(size_t i = c * chunk_size; i < end; ++i)
+                 {
+                     Vector3 px[4], pdx[4];
+                     for(int k = 0; k < 4; ++k)
+                     {
+                         px[k]  = x[prims[i][k]];
+                         pdx[k] = dx[prims[i][k]];
+                     }
+                     T toi   = toi_upper;
+                     tois[i] = inclusion_ccd<Policy>(px,
+                                                     pdx,
+                                                     m_config.min_separation,
+                                                     m_config.tolerance,
+                                                     m_config.max_iter,
+                                                     toi) ?
+                                   toi :
+                                   toi_upper;
+                 }
+             });
+
+    return *std::min_element(tois.begin(), tois.end());
+}
+}  // namespace muda::distance
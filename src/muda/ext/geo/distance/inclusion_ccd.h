@@ -0,0 +1,224 @@
+/*****************************************************************/ /**
+ * \file   inclusion_ccd.h
+ * \brief  Conservative inclusion based CCD with a guaranteed minimal separation.
+ *
+ * The additive CCD of `point_triangle_ccd` / `edge_edge_ccd` steps along the
+ * distance with an `eta` gap and stops at `max_iter`, it may stop far before
+ * the contact or miss a grazing one. The inclusion CCD (Wang et al. 2021,
+ * "A Large-Scale Benchmark and an Inclusion-Based Algorithm for Continuous
+ * Collision Detection") instead bisects the parameter box (t, u, v) of the
+ * root finding problem F(t, u, v) = 0, e.g. for point-triangle
+ *
+ *   F(t, u, v) = p(t) - t0(t) - u (t1(t) - t0(t)) - v (t2(t) - t0(t)),
+ *
+ * F is multilinear, so the range of F over a box is bounded by its 8 corners.
+ * A box is rejected if the bound (inflated by the rounding error and the
+ * minimal separation) excludes 0 on some axis, and accepted once its bound is
+ * smaller than `tolerance`. The boxes are checked earliest first, so the
+ * returned toi is the lowest t of the first accepted box: for every t in
+ * [0, toi) the primitives are farther than `min_separation` apart (measured in
+ * the infinity norm, which is conservative for the euclidean distance).
+ *
+ * The pending boxes live in a fixed size queue, so the function runs on the
+ * device as is. If the queue overflows or `max_iter` is reached the toi is
+ * lowered to the unchecked part, never raised.
+ *********************************************************************/
+#pragma once
+#include <vector>
+#include <muda/buffer/device_buffer.h>
+#include <muda/buffer/device_var.h>
+#include <muda/launch/parallel_for.h>
+#include <muda/cub/host/host_thread_pool.h>
+#include <muda/ext/geo/distance/ccd.h>
+
+namespace muda::distance
+{
+/**
+ * \brief Parameters of the inclusion CCD.
+ */
+template <typename T>
+struct InclusionCCDConfig
+{
+    // the size of an accepted root box in the distance space (not in t)
+    T tolerance = T(1e-6);
+    // primitives closer than this (infinity norm) are in contact
+    T min_separation = T(0);
+    // boxes to check before giving up (conservatively), < 0: unlimited
+    int max_iter = 1000000;
+};
+
+/**
+ * \brief F of point-triangle, x = {p, t0, t1, t2}.
+ */
+struct PointTriangleInclusionCCD
+{
+    template <typename T>
+    MUDA_GENERIC static Eigen::Matrix<T, 3, 1> eval(const Eigen::Matrix<T, 3, 1>* x, T u, T v);
+    // the box touches the triangle, u + v <= 1
+    template <typename T>
+    MUDA_GENERIC static bool valid(const T* lo, const T* hi);
+};
+
+/**
+ * \brief F of edge-edge, x = {ea0, ea1, eb0, eb1}.
+ */
+struct EdgeEdgeInclusionCCD
+{
+    template <typename T>
+    MUDA_GENERIC static Eigen::Matrix<T, 3, 1> eval(const Eigen::Matrix<T, 3, 1>* x, T u, T v);
+    template <typename T>
+    MUDA_GENERIC static bool valid(const T* lo, const T* hi);
+};
+
+/**
+ * \brief The generic inclusion CCD, `Policy` provides `eval` and `valid`.
+ *
+ * \param toi in: the upper bound of t, out: the time of impact if a collision is found
+ * \return a collision before the input `toi` may exist
+ */
+template <typename Policy, typename T>
+MUDA_GENERIC bool inclusion_ccd(const Eigen::Matrix<T, 3, 1>* x,
+                                const Eigen::Matrix<T, 3, 1>* dx,
+                                T                             min_separation,
+                                T                             tolerance,
+                                int                           max_iter,
+                                T&                            toi);
+
+template <typename T>
+MUDA_GENERIC bool point_triangle_inclusion_ccd(const Eigen::Matrix<T, 3, 1>& p,
+                                               const Eigen::Matrix<T, 3, 1>& t0,
+                                               const Eigen::Matrix<T, 3, 1>& t1,
+                                               const Eigen::Matrix<T, 3, 1>& t2,
+                                               const Eigen::Matrix<T, 3, 1>& dp,
+                                               const Eigen::Matrix<T, 3, 1>& dt0,
+                                               const Eigen::Matrix<T, 3, 1>& dt1,
+                                               const Eigen::Matrix<T, 3, 1>& dt2,
+                                               T  min_separation,
+                                               T  tolerance,
+                                               int max_iter,
+                                               T& toi);
+
+template <typename T>
+MUDA_GENERIC bool edge_edge_inclusion_ccd(const Eigen::Matrix<T, 3, 1>& ea0,
+                                          const Eigen::Matrix<T, 3, 1>& ea1,
+                                          const Eigen::Matrix<T, 3, 1>& eb0,
+                                          const Eigen::Matrix<T, 3, 1>& eb1,
+                                          const Eigen::Matrix<T, 3, 1>& dea0,
+                                          const Eigen::Matrix<T, 3, 1>& dea1,
+                                          const Eigen::Matrix<T, 3, 1>& deb0,
+                                          const Eigen::Matrix<T, 3, 1>& deb1,
+                                          T   min_separation,
+                                          T   tolerance,
+                                          int max_iter,
+                                          T&  toi);
+
+/**
+ * \class BatchedInclusionCCD
+ *
+ * \brief Batched inclusion CCD on the device, one thread per pair.
+ *
+ * The primitives are given like in `BatchedCCD`: 4 vertex indices into `x`
+ * (positions) and `dx` (displacements).
+ *
+ * \code
+ *  BatchedInclusionCCD<double> ccd;
+ *  ccd.config().min_separation = 1e-4;
+ *  double alpha = ccd.edge_edge(ees, x, dx, tois);  // min toi, 1.0 if no collision
+ * \endcode
+ */
+template <typename T>
+class BatchedInclusionCCD
+{
+  public:
+    using Vector3 = Eigen::Matrix<T, 3, 1>;
+
+    BatchedInclusionCCD(muda::Stream& stream = muda::Stream::Default())
+        : m_stream(stream)
+    {
+    }
+
+    InclusionCCDConfig<T>&       config() MUDA_NOEXCEPT { return m_config; }
+    const InclusionCCDConfig<T>& config() const MUDA_NOEXCEPT { return m_config; }
+
+    /**
+     * \brief Per-pair tois are written to `tois` (`toi_upper` if no collision).
+     *
+     * \return the minimum toi of all pairs (sync)
+     */
+    T point_triangle(CBufferView<Eigen::Vector4i> pts,
+                     CBufferView<Vector3>         x,
+                     CBufferView<Vector3>         dx,
+                     BufferView<T>                tois,
+                     T                            toi_upper = T(1))
+    {
+        return run<PointTriangleInclusionCCD>(pts, x, dx, tois, toi_upper);
+    }
+
+    T edge_edge(CBufferView<Eigen::Vector4i> ees,
+                CBufferView<Vector3>         x,
+                CBufferView<Vector3>         dx,
+                BufferView<T>                tois,
+                T                            toi_upper = T(1))
+    {
+        return run<EdgeEdgeInclusionCCD>(ees, x, dx, tois, toi_upper);
+    }
+
+    template <typename Policy>
+    T run(CBufferView<Eigen::Vector4i> prims,
+          CBufferView<Vector3>         x,
+          CBufferView<Vector3>         dx,
+          BufferView<T>                tois,
+          T                            toi_upper);
+
+  private:
+    muda::Stream&         m_stream;
+    InclusionCCDConfig<T> m_config;
+    DeviceVar<T>          m_min_toi;
+};
+
+/**
+ * \class HostBatchedInclusionCCD
+ *
+ * \brief Host backend of `BatchedInclusionCCD`, the pairs are spread over
+ * `HostThreadPool::global()`.
+ */
+template <typename T>
+class HostBatchedInclusionCCD
+{
+  public:
+    using Vector3 = Eigen::Matrix<T, 3, 1>;
+
+    InclusionCCDConfig<T>&       config() MUDA_NOEXCEPT { return m_config; }
+    const InclusionCCDConfig<T>& config() const MUDA_NOEXCEPT { return m_config; }
+
+    T point_triangle(const std::vector<Eigen::Vector4i>& pts,
+                     const std::vector<Vector3>&         x,
+                     const std::vector<Vector3>&         dx,
+                     std::vector<T>&                     tois,
+                     T                                   toi_upper = T(1))
+    {
+        return run<PointTriangleInclusionCCD>(pts, x, dx, tois, toi_upper);
+    }
+
+    T edge_edge(const std::vector<Eigen::Vector4i>& ees,
+                const std::vector<Vector3>&         x,
+                const std::vector<Vector3>&         dx,
+                std::vector<T>&                     tois,
+                T                                   toi_upper = T(1))
+    {
+        return run<EdgeEdgeInclusionCCD>(ees, x, dx, tois, toi_upper);
+    }
+
+    template <typename Policy>
+    T run(const std::vector<Eigen::Vector4i>& prims,
+          const std::vector<Vector3>&         x,
+          const std::vector<Vector3>&         dx,
+          std::vector<T>&                     tois,
+          T                                   toi_upper);
+
+  private:
+    InclusionCCDConfig<T> m_config;
+};
+}  // namespace muda::distance
+
+#include "details/inclusion_ccd.inl"
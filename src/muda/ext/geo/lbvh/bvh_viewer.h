@@ -155,7 +155,7 @@ namespace details
             , m_aabbs(aabbs)
             , m_objects(objects)
         {
-            MUDA_KERNEL_ASSERT(m_nodes && m_aabbs && m_objects,
+            MUDA_VIEWER_ASSERT(m_nodes && m_aabbs && m_objects,
                                "BVHViewerBase[%s:%s]: nullptr is passed,"
                                "nodes=%p,"
                                "aabbs=%p,"
@@ -232,7 +232,7 @@ namespace details
                         *stack_ptr++ = R_idx;
                     }
                 }
-                MUDA_KERNEL_ASSERT(stack_ptr < stack_end,
+                MUDA_VIEWER_ASSERT(stack_ptr < stack_end,
                                    "LBVHQuery[%s:%s]: stack overflow, try use a larger StackNum.",
                                    this->name(),
                                    this->kernel_name());
@@ -316,7 +316,7 @@ namespace details
                         *stack_ptr++ = thrust::make_pair(R_idx, R_mindist);
                     }
                 }
-                MUDA_KERNEL_ASSERT(stack_ptr < stack_end,
+                MUDA_VIEWER_ASSERT(stack_ptr < stack_end,
                                    "LBVHQuery[%s:%s]: stack overflow, try use a larger StackNum.",
                                    this->name(),
                                    this->kernel_name());
@@ -346,7 +346,7 @@ namespace details
 
         MUDA_INLINE MUDA_GENERIC void check_index(const uint32_t idx) const noexcept
         {
-            MUDA_KERNEL_ASSERT(idx < m_num_objects,
+            MUDA_VIEWER_ASSERT(idx < m_num_objects,
                                "BVHViewer[%s:%s]: index out of range, idx=%u, num_objects=%u",
                                this->name(),
                                this->kernel_name(),
@@ -1,2 +1,3 @@
 #pragma once
-#include <muda/ext/geo/spatial_hash/sparse_spatial_hash.h>
\ No newline at end of file
+#include <muda/ext/geo/spatial_hash/sparse_spatial_hash.h>
+#include <muda/ext/geo/spatial_hash/collision_pair_cache.h>
\ No newline at end of file
@@ -0,0 +1,85 @@
+#pragma once
+#include <muda/buffer/device_buffer.h>
+#include <muda/buffer/device_var.h>
+#include <muda/launch/stream.h>
+#include <muda/ext/geo/spatial_hash/collision_pair.h>
+
+namespace muda::spatial_hash
+{
+/**
+ * \brief A persistent collision pair list, sorted and diffed frame to frame.
+ *
+ * After `update()` with the pairs detected in this frame:
+ * - `pairs()` are the current pairs, sorted and unique.
+ * - `new_indices()` / `kept_indices()` are the (ascending) indices into
+ *   `pairs()` of the pairs that appear / persist in this frame.
+ * - `removed_indices()` are the (ascending) indices into `old_pairs()` of the
+ *   pairs that disappear in this frame.
+ * - `old_to_new()` / `new_to_old()` map a slot of one frame to the slot of the
+ *   same pair in the other frame, -1 if the pair is absent.
+ *
+ * Typical usage (warm starting the Lagrange multipliers of the contacts):
+ * \code{.cpp}
+ *  DeviceBuffer<CollisionPair> detected;
+ *  sh.detect(spheres, detected);
+ *  cache.update(detected);
+ *
+ *  ParallelFor().apply(cache.pairs().size(),
+ *      [new_to_old = cache.new_to_old().cviewer(),
+ *       old_lambda = old_lambda.cviewer(),
+ *       lambda     = lambda.viewer()] __device__(int i) mutable
+ *      {
+ *          auto o    = new_to_old(i);
+ *          lambda(i) = o >= 0 ? old_lambda(o) : 0.0f;
+ *      });
+ * \endcode
+ */
+class CollisionPairCache
+{
+  public:
+    CollisionPairCache(muda::Stream& stream = muda::Stream::Default())
+        : m_stream(stream)
+    {
+    }
+
+    // replace the current pairs with `detected` (unsorted, may have duplicates) and diff
+    void update(CBufferView<CollisionPair> detected);
+    // drop both frames, the next update reports all pairs as new
+    void clear();
+
+    CBufferView<CollisionPair> pairs() const { return m_pairs.view(); }
+    CBufferView<CollisionPair> old_pairs() const { return m_old_pairs.view(); }
+
+    CBufferView<int> new_indices() const { return m_new_indices.view(); }
+    CBufferView<int> kept_indices() const { return m_kept_indices.view(); }
+    CBufferView<int> removed_indices() const { return m_removed_indices.view(); }
+
+    CBufferView<int> old_to_new() const { return m_old_to_new.view(); }
+    CBufferView<int> new_to_old() const { return m_new_to_old.view(); }
+
+  private:
+    muda::Stream& m_stream;
+
+    DeviceBuffer<CollisionPair> m_pairs;
+    DeviceBuffer<CollisionPair> m_old_pairs;
+    DeviceBuffer<uint64_t>      m_keys;  // packed m_pairs, for searching
+    DeviceBuffer<uint64_t>      m_old_keys;
+
+    DeviceBuffer<int> m_new_indices;
+    DeviceBuffer<int> m_kept_indices;
+    DeviceBuffer<int> m_removed_indices;
+    DeviceBuffer<int> m_old_to_new;
+    DeviceBuffer<int> m_new_to_old;
+
+    // temporaries
+    DeviceBuffer<uint64_t> m_unsorted_keys;
+    DeviceBuffer<uint64_t> m_sorted_keys;
+    DeviceBuffer<int>      m_flags;
+    DeviceVar<int>         m_selected_count;
+
+    // out = indices i where m_flags(i) != 0
+    void select_flagged(DeviceBuffer<int>& out, int n);
+};
+}  // namespace muda::spatial_hash
+
+#include "details/collision_pair_cache.inl"
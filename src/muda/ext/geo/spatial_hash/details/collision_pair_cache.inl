@@ -0,0 +1,174 @@
+#include <cub/iterator/counting_input_iterator.cuh>
+#include <muda/launch/parallel_for.h>
+#include <muda/buffer/buffer_launch.h>
+#include <muda/cub/device/device_radix_sort.h>
+#include <muda/cub/device/device_select.h>
+
+namespace muda::spatial_hash
+{
+namespace details
+{
+    // i < j for a valid pair, so the packed keys sort like the pairs
+    MUDA_INLINE MUDA_GENERIC uint64_t pack_collision_pair(const CollisionPair& p)
+    {
+        auto ids = p.IDs();
+        return (static_cast<uint64_t>(static_cast<uint32_t>(ids[0])) << 32)
+               | static_cast<uint32_t>(ids[1]);
+    }
+
+    MUDA_INLINE MUDA_GENERIC CollisionPair unpack_collision_pair(uint64_t key)
+    {
+        return CollisionPair{static_cast<int>(key >> 32),
+                             static_cast<int>(key & 0xffffffffu)};
+    }
+
+    // index of `key` in the sorted `keys`, -1 if absent
+    template <typename View>
+    MUDA_INLINE MUDA_GENERIC int binary_search_collision_pair(const View& keys, int n, uint64_t key)
+    {
+        int lo = 0, hi = n;
+        while(lo < hi)
+        {
+            int mid = (lo + hi) / 2;
+            if(keys(mid) < key)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo < n && keys(lo) == key ? lo : -1;
+    }
+}  // namespace details
+
+MUDA_INLINE void CollisionPairCache::update(CBufferView<CollisionPair> detected)
+{
+    // the current frame becomes the old frame
+    std::swap(m_pairs, m_old_pairs);
+    std::swap(m_keys, m_old_keys);
+
+    // 1) sort and unique the packed keys
+    int n = static_cast<int>(detected.size());
+    m_unsorted_keys.resize(n);
+    m_sorted_keys.resize(n);
+    m_keys.resize(n);
+    if(n > 0)
+    {
+        ParallelFor(0, m_stream)
+            .kernel_name("collision_pair_cache_pack")
+            .apply(n,
+                   [detected = detected.viewer(),
+                    keys     = m_unsorted_keys.viewer()] __device__(int i) mutable
+                   { keys(i) = details::pack_collision_pair(detected(i)); });
+
+        DeviceRadixSort(m_stream).SortKeys(
+            m_unsorted_keys.data(), m_sorted_keys.data(), n);
+        DeviceSelect(m_stream).Unique(
+            m_sorted_keys.data(), m_keys.data(), m_selected_count.data(), n);
+
+        BufferLaunch(m_stream).copy(&n, m_selected_count.view()).wait();
+    }
+    m_keys.resize(n);
+    m_pairs.resize(n);
+    m_new_to_old.resize(n);
+
+    // 2) match the two frames, both sorted, so a binary search is enough
+    int old_n = static_cast<int>(m_old_keys.size());
+    m_old_to_new.resize(old_n);
+
+    if(n > 0)
+    {
+        ParallelFor(0, m_stream)
+            .kernel_name("collision_pair_cache_match_new")
+            .apply(n,
+                   [keys       = m_keys.cviewer(),
+                    old_keys   = m_old_keys.cviewer(),
+                    pairs      = m_pairs.viewer(),
+                    new_to_old = m_new_to_old.viewer(),
+                    old_n] __device__(int i) mutable
+                   {
+                       auto key      = keys(i);
+                       pairs(i)      = details::unpack_collision_pair(key);
+                       new_to_old(i) = details::binary_search_collision_pair(old_keys, old_n, key);
+                   });
+    }
+
+    if(old_n > 0)
+    {
+        ParallelFor(0, m_stream)
+            .kernel_name("collision_pair_cache_match_old")
+            .apply(old_n,
+                   [keys       = m_keys.cviewer(),
+                    old_keys   = m_old_keys.cviewer(),
+                    old_to_new = m_old_to_new.viewer(),
+                    n] __device__(int i) mutable
+                   {
+                       old_to_new(i) =
+                           details::binary_search_collision_pair(keys, n, old_keys(i));
+                   });
+    }
+
+    // 3) index sets
+    m_flags.resize(std::max(n, old_n));
+
+    if(n > 0)
+    {
+        ParallelFor(0, m_stream)
+            .kernel_name("collision_pair_cache_flag_new")
+            .apply(n,
+                   [new_to_old = m_new_to_old.cviewer(),
+                    flags      = m_flags.viewer()] __device__(int i) mutable
+                   { flags(i) = new_to_old(i) < 0 ? 1 : 0; });
+    }
+    select_flagged(m_new_indices, n);
+
+    if(n > 0)
+    {
+        ParallelFor(0, m_stream)
+            .kernel_name("collision_pair_cache_flag_kept")
+            .apply(n,
+                   [new_to_old = m_new_to_old.cviewer(),
+                    flags      = m_flags.viewer()] __device__(int i) mutable
+                   { flags(i) = new_to_old(i) >= 0 ? 1 : 0; });
+    }
+    select_flagged(m_kept_indices, n);
+
+    if(old_n > 0)
+    {
+        ParallelFor(0, m_stream)
+            .kernel_name("collision_pair_cache_flag_removed")
+            .apply(old_n,
+                   [old_to_new = m_old_to_new.cviewer(),
+                    flags      = m_flags.viewer()] __device__(int i) mutable
+                   { flags(i) = old_to_new(i) < 0 ? 1 : 0; });
+    }
+    select_flagged(m_removed_indices, old_n);
+}
+
+MUDA_INLINE void CollisionPairCache::clear()
+{
+    m_pairs.clear();
+    m_old_pairs.clear();
+    m_keys.clear();
+    m_old_keys.clear();
+    m_new_indices.clear();
+    m_kept_indices.clear();
+    m_removed_indices.clear();
+    m_old_to_new.clear();
+    m_new_to_old.clear();
+}
+
+MUDA_INLINE void CollisionPairCache::select_flagged(DeviceBuffer<int>& out, int n)
+{
+    out.resize(n);
+    if(n == 0)
+        return;
+
+    DeviceSelect(m_stream).Flagged(cub::CountingInputIterator<int>(0),
+                                   m_flags.data(),
+                                   out.data(),
+                                   m_selected_count.data(),
+                                   n);
+    int count = 0;
+    BufferLaunch(m_stream).copy(&count, m_selected_count.view()).wait();
+    out.resize(count);
+}
+}  // namespace muda::spatial_hash
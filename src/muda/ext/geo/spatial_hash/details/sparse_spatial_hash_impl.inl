@@ -455,10 +455,11 @@ void SparseSpatialHashImpl<Hash>::balanced_setup_collision_pairs(
                         .viewer()] __device__(int cell) mutable
                {
                    int size = objCountInCell(cell);
-                   MUDA_KERNEL_ASSERT(size > 0,
-                                      "Fatal Algo Error: objCountInCell(%d)=%d, an empty cell shouldn't be recorded, something goes wrong!",
-                                      cell,
-                                      size);
+                   MUDA_CHECKED_ASSERT(objCountInCell,
+                                       size > 0,
+                                       "Fatal Algo Error: objCountInCell(%d)=%d, an empty cell shouldn't be recorded, something goes wrong!",
+                                       cell,
+                                       size);
                    int start = cellToCollisionPairUpperBoundPrefixSum(cell);
                    int upper_bound = cellToCollisionPairUpperBound(cell);
                    potentialCollisionPairIdToCellIndexBuffer(start + upper_bound - 1) = 1;
@@ -536,16 +537,20 @@ void SparseSpatialHashImpl<Hash>::balanced_setup_collision_pairs(
 
                 // printf("CellLocalId=%d, i=%d, j=%d,objCount=%d\n", cellLocalIndex, i, j, objCount);
 
-                MUDA_KERNEL_ASSERT(
-                    i >= 0 && j >= 0 && i < objCount && j < objCount, "i=%d, j=%d", i, j);
-
-                MUDA_KERNEL_ASSERT(ij_to_cell_local_index(i, j, objCount) == cellLocalIndex,
-                                   "numerical error happen!"
-                                   "i=%d, j=%d, objCount=%d, cellLocalIndex=%d",
-                                   i,
-                                   j,
-                                   objCount,
-                                   cellLocalIndex);
+                MUDA_CHECKED_ASSERT(objCountInCell,
+                                    i >= 0 && j >= 0 && i < objCount && j < objCount,
+                                    "i=%d, j=%d",
+                                    i,
+                                    j);
+
+                MUDA_CHECKED_ASSERT(objCountInCell,
+                                    ij_to_cell_local_index(i, j, objCount) == cellLocalIndex,
+                                    "numerical error happen!"
+                                    "i=%d, j=%d, objCount=%d, cellLocalIndex=%d",
+                                    i,
+                                    j,
+                                    objCount,
+                                    cellLocalIndex);
 
                 Cell cell0 = cellArrayValueSorted(cellOffset + i);
                 Cell cell1 = cellArrayValueSorted(cellOffset + j);
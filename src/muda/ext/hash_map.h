@@ -0,0 +1,4 @@
+#pragma once
+#include <muda/ext/hash_map/device_hash_map.h>
+#include <muda/ext/hash_map/device_hash_set.h>
+#include <muda/ext/hash_map/host_hash_map.h>
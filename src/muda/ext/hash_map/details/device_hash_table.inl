@@ -0,0 +1,302 @@
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <muda/buffer/device_var.h>
+#include <muda/buffer/buffer_launch.h>
+#include <muda/cub/device/device_select.h>
+
+namespace muda::details
+{
+template <typename Key, typename Value, typename Hash>
+DeviceHashTable<Key, Value, Hash>::DeviceHashTable(size_t capacity, float max_load_factor)
+    : m_max_load_factor(max_load_factor)
+{
+    MUDA_ASSERT(max_load_factor > 0.0f && max_load_factor < 1.0f,
+                "max_load_factor(%f) should be in (0, 1)",
+                max_load_factor);
+    m_counts.resize(2, 0);
+    if(capacity > 0)
+        rehash(capacity);
+}
+
+template <typename Key, typename Value, typename Hash>
+void DeviceHashTable<Key, Value, Hash>::reserve(size_t n)
+{
+    auto required = static_cast<size_t>(std::ceil(n / m_max_load_factor)) + 1;
+    if(required > capacity())
+        rehash(required);
+}
+
+template <typename Key, typename Value, typename Hash>
+void DeviceHashTable<Key, Value, Hash>::rehash(size_t capacity)
+{
+    auto n       = size();
+    auto min_cap = static_cast<size_t>(std::ceil(n / m_max_load_factor)) + 1;
+    auto new_cap = hash_table_round_up_pow2(
+        static_cast<uint32_t>(std::max({capacity, min_cap, size_t{16}})));
+
+    DeviceBuffer<Key>   keys(new_cap);
+    DeviceBuffer<Value> values(IsSet ? 0 : new_cap);
+    DeviceBuffer<int>   counts(2);
+    keys.fill(EmptyKey);
+    counts.fill(0);
+
+    auto old_cap = static_cast<int>(this->capacity());
+    if(old_cap > 0 && n > 0)
+    {
+        ParallelFor(BlockSize)
+            .kernel_name("hash_table_rehash")
+            .apply(old_cap,
+                   [src = cviewer().name("src"),
+                    dst = make_viewer(keys, values, counts).name("dst")] __device__(int i) mutable
+                   {
+                       if(!src.is_filled(i))
+                           return;
+                       if constexpr(IsSet)
+                           dst.insert(src.key(i));
+                       else
+                           dst.insert(src.key(i), src.value(i));
+                   });
+    }
+
+    m_keys           = std::move(keys);
+    m_values         = std::move(values);
+    m_counts         = std::move(counts);
+    m_occupied_bound = n;
+}
+
+template <typename Key, typename Value, typename Hash>
+void DeviceHashTable<Key, Value, Hash>::clear()
+{
+    if(capacity() > 0)
+        m_keys.fill(EmptyKey);
+    m_counts.fill(0);
+    m_occupied_bound = 0;
+}
+
+template <typename Key, typename Value, typename Hash>
+size_t DeviceHashTable<Key, Value, Hash>::size() const
+{
+    int h_size = 0;
+    BufferLaunch().copy(&h_size, m_counts.view(0, 1)).wait();
+    return static_cast<size_t>(h_size);
+}
+
+template <typename Key, typename Value, typename Hash>
+auto DeviceHashTable<Key, Value, Hash>::viewer() MUDA_NOEXCEPT -> Viewer
+{
+    return make_viewer(m_keys, m_values, m_counts);
+}
+
+template <typename Key, typename Value, typename Hash>
+auto DeviceHashTable<Key, Value, Hash>::cviewer() const MUDA_NOEXCEPT -> CViewer
+{
+    return CViewer{m_keys.data(),
+                   IsSet ? nullptr : m_values.data(),
+                   m_counts.data(),
+                   static_cast<int>(m_keys.size())};
+}
+
+template <typename Key, typename Value, typename Hash>
+auto DeviceHashTable<Key, Value, Hash>::make_viewer(DeviceBuffer<Key>&   keys,
+                                                    DeviceBuffer<Value>& values,
+                                                    DeviceBuffer<int>& counts) MUDA_NOEXCEPT -> Viewer
+{
+    return Viewer{keys.data(),
+                  IsSet ? nullptr : values.data(),
+                  counts.data(),
+                  static_cast<int>(keys.size())};
+}
+
+template <typename Key, typename Value, typename Hash>
+void DeviceHashTable<Key, Value, Hash>::ensure_capacity(size_t n)
+{
+    auto limit = static_cast<size_t>(capacity() * m_max_load_factor);
+    if(m_occupied_bound + n <= limit)
+        return;
+
+    // the bound is too loose, read back the real occupied slot count
+    int h_occupied = 0;
+    BufferLaunch().copy(&h_occupied, m_counts.view(1, 1)).wait();
+    m_occupied_bound = static_cast<size_t>(h_occupied);
+
+    if(m_occupied_bound + n > limit)
+        rehash(static_cast<size_t>(std::ceil((size() + n) / m_max_load_factor)) + 1);
+}
+
+template <typename Key, typename Value, typename Hash>
+int DeviceHashTable<Key, Value, Hash>::probe_threads(size_t n)
+{
+    auto threads = n * static_cast<size_t>(ProbeTileSize);
+    MUDA_ASSERT(threads <= static_cast<size_t>(std::numeric_limits<int>::max()),
+                "too many keys for one bulk operation, n=%lld, max=%d",
+                (long long)n,
+                std::numeric_limits<int>::max() / ProbeTileSize);
+    return static_cast<int>(threads);
+}
+
+template <typename Key, typename Value, typename Hash>
+void DeviceHashTable<Key, Value, Hash>::bulk_insert(CBufferView<Key> keys, CBufferView<Value> values)
+{
+    static_assert(!IsSet, "a hash set has no value");
+    MUDA_ASSERT(keys.size() == values.size(),
+                "keys.size()=%lld, values.size()=%lld",
+                (long long)keys.size(),
+                (long long)values.size());
+    auto n = keys.size();
+    if(n == 0)
+        return;
+    ensure_capacity(n);
+
+    ParallelFor(BlockSize)
+        .kernel_name("hash_table_insert")
+        .apply(probe_threads(n),
+               [table  = viewer().name("table"),
+                keys   = keys.cviewer().name("keys"),
+                values = values.cviewer().name("values")] __device__(int i) mutable
+               {
+                   namespace cg = cooperative_groups;
+                   auto tile = cg::tiled_partition<ProbeTileSize>(cg::this_thread_block());
+                   auto k    = i / ProbeTileSize;
+                   table.insert(tile, keys(k), values(k));
+               });
+    m_occupied_bound += n;
+}
+
+template <typename Key, typename Value, typename Hash>
+void DeviceHashTable<Key, Value, Hash>::bulk_insert(CBufferView<Key> keys)
+{
+    static_assert(IsSet, "a hash map needs values to insert");
+    auto n = keys.size();
+    if(n == 0)
+        return;
+    ensure_capacity(n);
+
+    ParallelFor(BlockSize)
+        .kernel_name("hash_table_insert")
+        .apply(probe_threads(n),
+               [table = viewer().name("table"),
+                keys  = keys.cviewer().name("keys")] __device__(int i) mutable
+               {
+                   namespace cg = cooperative_groups;
+                   auto tile = cg::tiled_partition<ProbeTileSize>(cg::this_thread_block());
+                   table.insert(tile, keys(i / ProbeTileSize));
+               });
+    m_occupied_bound += n;
+}
+
+template <typename Key, typename Value, typename Hash>
+void DeviceHashTable<Key, Value, Hash>::bulk_find(CBufferView<Key>  keys,
+                                                  BufferView<Value> values,
+                                                  const Value&      not_found) const
+{
+    static_assert(!IsSet, "a hash set has no value");
+    MUDA_ASSERT(keys.size() == values.size(),
+                "keys.size()=%lld, values.size()=%lld",
+                (long long)keys.size(),
+                (long long)values.size());
+    auto n = keys.size();
+    if(n == 0)
+        return;
+    if(capacity() == 0)
+    {
+        BufferLaunch().fill(values, not_found);
+        return;
+    }
+
+    ParallelFor(BlockSize)
+        .kernel_name("hash_table_find")
+        .apply(probe_threads(n),
+               [table  = cviewer().name("table"),
+                keys   = keys.cviewer().name("keys"),
+                values = values.viewer().name("values"),
+                not_found] __device__(int i) mutable
+               {
+                   namespace cg = cooperative_groups;
+                   auto tile = cg::tiled_partition<ProbeTileSize>(cg::this_thread_block());
+                   auto k    = i / ProbeTileSize;
+                   auto slot = table.find_slot(tile, keys(k));
+                   if(tile.thread_rank() == 0)
+                       values(k) = slot >= 0 ? table.value(slot) : not_found;
+               });
+}
+
+template <typename Key, typename Value, typename Hash>
+void DeviceHashTable<Key, Value, Hash>::bulk_contains(CBufferView<Key> keys,
+                                                      BufferView<int>  found) const
+{
+    MUDA_ASSERT(keys.size() == found.size(),
+                "keys.size()=%lld, found.size()=%lld",
+                (long long)keys.size(),
+                (long long)found.size());
+    auto n = keys.size();
+    if(n == 0)
+        return;
+    if(capacity() == 0)
+    {
+        BufferLaunch().fill(found, 0);
+        return;
+    }
+
+    ParallelFor(BlockSize)
+        .kernel_name("hash_table_contains")
+        .apply(probe_threads(n),
+               [table = cviewer().name("table"),
+                keys  = keys.cviewer().name("keys"),
+                found = found.viewer().name("found")] __device__(int i) mutable
+               {
+                   namespace cg = cooperative_groups;
+                   auto tile = cg::tiled_partition<ProbeTileSize>(cg::this_thread_block());
+                   auto k    = i / ProbeTileSize;
+                   auto hit  = table.contains(tile, keys(k));
+                   if(tile.thread_rank() == 0)
+                       found(k) = hit ? 1 : 0;
+               });
+}
+
+template <typename Key, typename Value, typename Hash>
+void DeviceHashTable<Key, Value, Hash>::bulk_erase(CBufferView<Key> keys)
+{
+    auto n = keys.size();
+    if(n == 0 || capacity() == 0)
+        return;
+
+    ParallelFor(BlockSize)
+        .kernel_name("hash_table_erase")
+        .apply(probe_threads(n),
+               [table = viewer().name("table"),
+                keys  = keys.cviewer().name("keys")] __device__(int i) mutable
+               {
+                   namespace cg = cooperative_groups;
+                   auto tile = cg::tiled_partition<ProbeTileSize>(cg::this_thread_block());
+                   table.erase(tile, keys(i / ProbeTileSize));
+               });
+}
+
+template <typename Key, typename Value, typename Hash>
+void DeviceHashTable<Key, Value, Hash>::bulk_retrieve(DeviceBuffer<Key>&   keys,
+                                                      DeviceBuffer<Value>* values) const
+{
+    auto n   = size();
+    auto cap = static_cast<int>(capacity());
+    keys.resize(n);
+    if(values)
+        values->resize(n);
+    if(n == 0)
+        return;
+
+    m_flags.resize(cap);
+    ParallelFor(BlockSize)
+        .kernel_name("hash_table_flag_filled")
+        .apply(cap,
+               [table = cviewer().name("table"),
+                flags = m_flags.viewer().name("flags")] __device__(int i) mutable
+               { flags(i) = table.is_filled(i) ? 1 : 0; });
+
+    DeviceSelect().Flagged(
+        m_keys.data(), m_flags.data(), keys.data(), m_selected_count.data(), cap);
+    if(values)
+        DeviceSelect().Flagged(
+            m_values.data(), m_flags.data(), values->data(), m_selected_count.data(), cap);
+}
+}  // namespace muda::details
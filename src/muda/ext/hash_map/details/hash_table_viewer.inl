@@ -0,0 +1,165 @@
+namespace muda
+{
+template <bool IsConst, typename Key, typename Value, typename Hash>
+MUDA_GENERIC bool HashTableViewerBase<IsConst, Key, Value, Hash>::insert_impl(
+    const Key& key, const Value* value) MUDA_NOEXCEPT
+{
+    check_key(key);
+    auto mask  = static_cast<uint32_t>(m_capacity - 1);
+    auto start = home_slot(key);
+    for(int probe = 0; probe < m_capacity; ++probe)
+    {
+        int  slot     = static_cast<int>((start + probe) & mask);
+        auto existing = m_keys[slot];
+        if(existing == key)
+            return false;
+        if(existing != EmptyKey)  // filled or tombstone
+            continue;
+
+        auto old = details::hash_table_cas(m_keys + slot, EmptyKey, key);
+        if(old == EmptyKey)
+        {
+            on_inserted(slot, value);
+            return true;
+        }
+        if(old == key)  // inserted by another thread
+            return false;
+    }
+    MUDA_KERNEL_ERROR("HashTable[%s:%s]: table is full, capacity=%d",
+                      this->name(),
+                      this->kernel_name(),
+                      m_capacity);
+    return false;
+}
+
+template <bool IsConst, typename Key, typename Value, typename Hash>
+MUDA_GENERIC int HashTableViewerBase<IsConst, Key, Value, Hash>::find_slot(const Key& key) const MUDA_NOEXCEPT
+{
+    check_key(key);
+    auto mask  = static_cast<uint32_t>(m_capacity - 1);
+    auto start = home_slot(key);
+    for(int probe = 0; probe < m_capacity; ++probe)
+    {
+        int  slot     = static_cast<int>((start + probe) & mask);
+        auto existing = m_keys[slot];
+        if(existing == key)
+            return slot;
+        if(existing == EmptyKey)
+            return -1;
+    }
+    return -1;
+}
+
+template <bool IsConst, typename Key, typename Value, typename Hash>
+MUDA_GENERIC bool HashTableViewerBase<IsConst, Key, Value, Hash>::erase(const Key& key) MUDA_NOEXCEPT
+{
+    auto slot = find_slot(key);
+    if(slot < 0)
+        return false;
+    auto old = details::hash_table_cas(m_keys + slot, key, ErasedKey);
+    if(old != key)  // erased by another thread
+        return false;
+    details::hash_table_add(m_counts + 0, -1);
+    return true;
+}
+
+template <bool IsConst, typename Key, typename Value, typename Hash>
+template <typename Tile>
+MUDA_DEVICE bool HashTableViewerBase<IsConst, Key, Value, Hash>::insert_impl(
+    const Tile& tile, const Key& key, const Value* value) MUDA_NOEXCEPT
+{
+    check_key(key);
+    const int tile_size = static_cast<int>(tile.size());
+    const int lane      = static_cast<int>(tile.thread_rank());
+    auto      mask      = static_cast<uint32_t>(m_capacity - 1);
+    auto      start     = home_slot(key);
+
+    // every round the tile inspects `tile_size` consecutive slots, lane i
+    // holds the i-th one, so lower lanes always come first in probing order
+    for(int probe = 0; probe < m_capacity; probe += tile_size)
+    {
+        int  slot     = static_cast<int>((start + probe + lane) & mask);
+        auto existing = m_keys[slot];
+
+        if(tile.ballot(existing == key))
+            return false;
+
+        auto empty_lanes = tile.ballot(existing == EmptyKey);
+        while(empty_lanes)
+        {
+            int leader = __ffs(empty_lanes) - 1;
+            // 0: taken by another key, 1: inserted, 2: inserted by another thread
+            int status = 0;
+            if(lane == leader)
+            {
+                auto old = details::hash_table_cas(m_keys + slot, EmptyKey, key);
+                if(old == EmptyKey)
+                {
+                    on_inserted(slot, value);
+                    status = 1;
+                }
+                else if(old == key)
+                {
+                    status = 2;
+                }
+            }
+            status = tile.shfl(status, leader);
+            if(status != 0)
+                return status == 1;
+            empty_lanes &= empty_lanes - 1;  // try the next empty slot
+        }
+    }
+    if(lane == 0)
+        MUDA_KERNEL_ERROR("HashTable[%s:%s]: table is full, capacity=%d",
+                          this->name(),
+                          this->kernel_name(),
+                          m_capacity);
+    return false;
+}
+
+template <bool IsConst, typename Key, typename Value, typename Hash>
+template <typename Tile>
+MUDA_DEVICE int HashTableViewerBase<IsConst, Key, Value, Hash>::find_slot(const Tile& tile,
+                                                                            const Key& key) const MUDA_NOEXCEPT
+{
+    check_key(key);
+    const int tile_size = static_cast<int>(tile.size());
+    const int lane      = static_cast<int>(tile.thread_rank());
+    auto      mask      = static_cast<uint32_t>(m_capacity - 1);
+    auto      start     = home_slot(key);
+
+    for(int probe = 0; probe < m_capacity; probe += tile_size)
+    {
+        int  slot     = static_cast<int>((start + probe + lane) & mask);
+        auto existing = m_keys[slot];
+
+        auto found = tile.ballot(existing == key);
+        if(found)
+            return tile.shfl(slot, __ffs(found) - 1);
+        if(tile.ballot(existing == EmptyKey))
+            return -1;
+    }
+    return -1;
+}
+
+template <bool IsConst, typename Key, typename Value, typename Hash>
+template <typename Tile>
+MUDA_DEVICE bool HashTableViewerBase<IsConst, Key, Value, Hash>::erase(const Tile& tile,
+                                                                         const Key& key) MUDA_NOEXCEPT
+{
+    auto slot = find_slot(tile, key);
+    if(slot < 0)
+        return false;
+    int erased = 0;
+    if(tile.thread_rank() == 0)
+    {
+        auto old = details::hash_table_cas(m_keys + slot, key, ErasedKey);
+        if(old == key)
+        {
+            details::hash_table_add(m_counts + 0, -1);
+            erased = 1;
+        }
+    }
+    return tile.shfl(erased, 0) != 0;
+}
+}  // namespace muda
@@ -0,0 +1,72 @@
+/*****************************************************************/ /**
+ * \file   device_hash_map.h
+ * \brief  A GPU hash map with open addressing, for dedupe, sparse (row, col)
+ * to slot lookup, active cell tables, etc.
+ *********************************************************************/
+#pragma once
+#include <muda/ext/hash_map/device_hash_table.h>
+
+namespace muda
+{
+/**
+ * \class DeviceHashMap
+ *
+ * \brief A `Key -> Value` hash map in device memory.
+ *
+ * - Keys are 32-bit or 64-bit integers, `HashTableSentinel<Key>` values are reserved.
+ * - Bulk operations run one key per tile of threads (warp-cooperative probing).
+ * - The table grows automatically on bulk insert, in-kernel insert through
+ *   `viewer()` never grows, call `reserve()` before.
+ *
+ * \code
+ *  DeviceHashMap<uint64_t, int> map;
+ *  map.insert(keys, values);
+ *  map.find(query, result, -1);
+ *
+ *  ParallelFor()
+ *      .apply(N,
+ *          [map = map.viewer()] __device__(int i) mutable
+ *          {
+ *              if(auto v = map.find(key(i)))
+ *                  *v += 1;
+ *          });
+ * \endcode
+ */
+template <typename Key, typename Value, typename Hash = HashTableDefaultHash<Key>>
+class DeviceHashMap : public details::DeviceHashTable<Key, Value, Hash>
+{
+    using Base = details::DeviceHashTable<Key, Value, Hash>;
+
+  public:
+    using key_type   = Key;
+    using value_type = Value;
+
+    using Base::Base;
+
+    // insert pairs, existing keys keep their values
+    void insert(CBufferView<Key> keys, CBufferView<Value> values)
+    {
+        Base::bulk_insert(keys, values);
+    }
+
+    // values(i) = map[keys(i)] or `not_found` if keys(i) is absent
+    void find(CBufferView<Key> keys, BufferView<Value> values, const Value& not_found) const
+    {
+        Base::bulk_find(keys, values, not_found);
+    }
+
+    // found(i) = 1 if keys(i) is in the map else 0
+    void contains(CBufferView<Key> keys, BufferView<int> found) const
+    {
+        Base::bulk_contains(keys, found);
+    }
+
+    void erase(CBufferView<Key> keys) { Base::bulk_erase(keys); }
+
+    // copy out all pairs, the order is unspecified
+    void retrieve(DeviceBuffer<Key>& keys, DeviceBuffer<Value>& values) const
+    {
+        Base::bulk_retrieve(keys, &values);
+    }
+};
+}  // namespace muda
@@ -0,0 +1,50 @@
+/*****************************************************************/ /**
+ * \file   device_hash_set.h
+ * \brief  A GPU hash set with open addressing, see `DeviceHashMap`.
+ *********************************************************************/
+#pragma once
+#include <muda/ext/hash_map/device_hash_table.h>
+
+namespace muda
+{
+/**
+ * \class DeviceHashSet
+ *
+ * \brief A hash set of 32-bit or 64-bit integer keys in device memory.
+ *
+ * \code
+ *  // dedupe collision pairs
+ *  DeviceHashSet<uint64_t> set;
+ *  set.insert(packed_pairs);
+ *  DeviceBuffer<uint64_t> unique_pairs;
+ *  set.retrieve(unique_pairs);
+ * \endcode
+ */
+template <typename Key, typename Hash = HashTableDefaultHash<Key>>
+class DeviceHashSet
+    : public details::DeviceHashTable<Key, details::HashTableNoValue, Hash>
+{
+    using Base = details::DeviceHashTable<Key, details::HashTableNoValue, Hash>;
+
+  public:
+    using key_type = Key;
+
+    using Base::Base;
+
+    void insert(CBufferView<Key> keys) { Base::bulk_insert(keys); }
+
+    // found(i) = 1 if keys(i) is in the set else 0
+    void contains(CBufferView<Key> keys, BufferView<int> found) const
+    {
+        Base::bulk_contains(keys, found);
+    }
+
+    void erase(CBufferView<Key> keys) { Base::bulk_erase(keys); }
+
+    // copy out all keys, the order is unspecified
+    void retrieve(DeviceBuffer<Key>& keys) const
+    {
+        Base::bulk_retrieve(keys, nullptr);
+    }
+};
+}  // namespace muda
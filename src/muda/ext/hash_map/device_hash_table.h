@@ -0,0 +1,73 @@
+#pragma once
+#include <muda/buffer/device_buffer.h>
+#include <muda/launch/parallel_for.h>
+#include <muda/ext/hash_map/hash_table_viewer.h>
+
+namespace muda::details
+{
+/**
+ * \brief Device storage and bulk operations shared by `DeviceHashMap` and `DeviceHashSet`.
+ *
+ * Bulk operations let a tile of `ProbeTileSize` threads cooperate on one key.
+ * The host keeps an upper bound of the occupied slots, so the table only reads
+ * back the real count (a sync) when the bound exceeds the max load factor.
+ */
+template <typename Key, typename Value, typename Hash>
+class DeviceHashTable
+{
+  public:
+    using Viewer  = HashTableViewerBase<false, Key, Value, Hash>;
+    using CViewer = HashTableViewerBase<true, Key, Value, Hash>;
+
+    constexpr static bool IsSet         = Viewer::IsSet;
+    constexpr static Key  EmptyKey      = Viewer::EmptyKey;
+    constexpr static int  ProbeTileSize = 4;
+    constexpr static int  BlockSize     = LIGHT_WORKLOAD_BLOCK_SIZE;
+    static_assert(BlockSize % ProbeTileSize == 0, "tiles must not cross blocks");
+
+  protected:
+    DeviceBuffer<Key>   m_keys;
+    DeviceBuffer<Value> m_values;
+    DeviceBuffer<int>   m_counts;  // [size, occupied]
+    size_t              m_occupied_bound  = 0;
+    float               m_max_load_factor = 0.5f;
+
+  public:
+    DeviceHashTable(size_t capacity = 0, float max_load_factor = 0.5f);
+
+    // make sure `n` elements can be held without rehashing
+    void reserve(size_t n);
+    // rebuild the table with at least `capacity` slots, tombstones are dropped
+    void rehash(size_t capacity);
+    void clear();
+
+    // read back from device (sync)
+    size_t size() const;
+    size_t capacity() const MUDA_NOEXCEPT { return m_keys.size(); }
+    float  max_load_factor() const MUDA_NOEXCEPT { return m_max_load_factor; }
+
+    Viewer  viewer() MUDA_NOEXCEPT;
+    CViewer cviewer() const MUDA_NOEXCEPT;
+
+    void bulk_insert(CBufferView<Key> keys, CBufferView<Value> values);
+    void bulk_insert(CBufferView<Key> keys);
+    void bulk_find(CBufferView<Key> keys, BufferView<Value> values, const Value& not_found) const;
+    void bulk_contains(CBufferView<Key> keys, BufferView<int> found) const;
+    void bulk_erase(CBufferView<Key> keys);
+    void bulk_retrieve(DeviceBuffer<Key>& keys, DeviceBuffer<Value>* values) const;
+
+  protected:
+    void ensure_capacity(size_t n);
+    // threads of a bulk operation on `n` keys, one tile per key
+    static int probe_threads(size_t n);
+    static Viewer make_viewer(DeviceBuffer<Key>&   keys,
+                              DeviceBuffer<Value>& values,
+                              DeviceBuffer<int>&   counts) MUDA_NOEXCEPT;
+
+  private:
+    mutable DeviceBuffer<int> m_flags;
+    mutable DeviceVar<int>    m_selected_count;
+};
+}  // namespace muda::details
+
+#include "details/device_hash_table.inl"
@@ -0,0 +1,101 @@
+#pragma once
+#include <limits>
+#include <cinttypes>
+#include <type_traits>
+#include <muda/muda_def.h>
+#include <muda/atomic.h>
+
+namespace muda
+{
+/**
+ * \brief Default hasher of the hash tables (the finalizer of MurmurHash3).
+ */
+template <typename Key>
+struct HashTableDefaultHash
+{
+    MUDA_GENERIC uint32_t operator()(const Key& key) const MUDA_NOEXCEPT
+    {
+        if constexpr(sizeof(Key) == 4)
+        {
+            uint32_t h = static_cast<uint32_t>(key);
+            h ^= h >> 16;
+            h *= 0x85ebca6bu;
+            h ^= h >> 13;
+            h *= 0xc2b2ae35u;
+            h ^= h >> 16;
+            return h;
+        }
+        else
+        {
+            uint64_t h = static_cast<uint64_t>(key);
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdull;
+            h ^= h >> 33;
+            h *= 0xc4ceb9fe1a85ec53ull;
+            h ^= h >> 33;
+            return static_cast<uint32_t>(h);
+        }
+    }
+};
+
+/**
+ * \brief Reserved key values of the hash tables, they can't be inserted.
+ */
+template <typename Key>
+struct HashTableSentinel
+{
+    constexpr static Key empty  = std::numeric_limits<Key>::max();
+    constexpr static Key erased = std::numeric_limits<Key>::max() - 1;
+};
+
+namespace details
+{
+    // value type of a hash set
+    struct HashTableNoValue
+    {
+    };
+
+    template <typename Key>
+    constexpr void hash_table_check_key() MUDA_NOEXCEPT
+    {
+        static_assert(std::is_integral_v<Key> && (sizeof(Key) == 4 || sizeof(Key) == 8),
+                      "hash table key must be a 32-bit or 64-bit integer, "
+                      "pack composite keys (e.g. (row, col)) into uint64_t");
+    }
+
+    template <typename T>
+    MUDA_INLINE MUDA_GENERIC T hash_table_cas(T* address, T compare, T val) MUDA_NOEXCEPT
+    {
+#ifdef __CUDA_ARCH__
+        using U = std::conditional_t<sizeof(T) == 4, unsigned int, unsigned long long>;
+        auto old = atomic_cas(reinterpret_cast<U*>(address),
+                              static_cast<U>(compare),
+                              static_cast<U>(val));
+        return static_cast<T>(old);
+#else
+        // the host backend is single-threaded
+        T old = *address;
+        if(old == compare)
+            *address = val;
+        return old;
+#endif
+    }
+
+    MUDA_INLINE MUDA_GENERIC void hash_table_add(int* address, int val) MUDA_NOEXCEPT
+    {
+#ifdef __CUDA_ARCH__
+        atomic_add(address, val);
+#else
+        *address += val;
+#endif
+    }
+
+    MUDA_INLINE MUDA_GENERIC uint32_t hash_table_round_up_pow2(uint32_t x) MUDA_NOEXCEPT
+    {
+        uint32_t p = 1;
+        while(p < x)
+            p <<= 1;
+        return p;
+    }
+}  // namespace details
+}  // namespace muda
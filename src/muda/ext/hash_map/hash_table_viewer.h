@@ -0,0 +1,266 @@
+/*****************************************************************/ /**
+ * \file   hash_table_viewer.h
+ * \brief  In-kernel access to an open addressing (linear probing) hash table.
+ *
+ * Every operation has a per-thread form and a cooperative form taking a
+ * `cooperative_groups::thread_block_tile`, where the tile probes `tile.size()`
+ * consecutive slots at once.
+ *
+ * Erased slots are kept as tombstones until the next rehash.
+ *
+ * An insert publishes the key (by CAS) before it writes the value, so within
+ * one launch a thread finding a key inserted by another thread of the same
+ * launch may read the value before it's written. Don't mix `insert` with
+ * `find`/`value` of the same keys in one kernel: insert in one launch and look
+ * up in a later one (as `DeviceHashTable::bulk_insert`/`bulk_find` do). Sets
+ * and `contains`/`find_slot` only look at the keys and are not affected.
+ *********************************************************************/
+#pragma once
+#include <muda/viewer/viewer_base.h>
+#include <muda/cuda/cooperative_groups.h>
+#include <muda/ext/hash_map/hash_table_common.h>
+
+namespace muda
+{
+template <bool IsConst, typename Key, typename Value, typename Hash>
+class HashTableViewerBase : public ViewerBase<IsConst>
+{
+    using Base = ViewerBase<IsConst>;
+    template <typename U>
+    using auto_const_t = typename Base::template auto_const_t<U>;
+
+    MUDA_VIEWER_COMMON_NAME(HashTableViewerBase);
+
+  public:
+    using ConstViewer    = HashTableViewerBase<true, Key, Value, Hash>;
+    using NonConstViewer = HashTableViewerBase<false, Key, Value, Hash>;
+    using ThisViewer     = HashTableViewerBase<IsConst, Key, Value, Hash>;
+
+    using key_type   = Key;
+    using value_type = Value;
+
+    constexpr static bool IsSet = std::is_same_v<Value, details::HashTableNoValue>;
+    constexpr static Key  EmptyKey  = HashTableSentinel<Key>::empty;
+    constexpr static Key  ErasedKey = HashTableSentinel<Key>::erased;
+
+  protected:
+    auto_const_t<Key>*   m_keys     = nullptr;
+    auto_const_t<Value>* m_values   = nullptr;
+    // m_counts[0] = size, m_counts[1] = occupied slots (size + tombstones)
+    auto_const_t<int>* m_counts   = nullptr;
+    int                m_capacity = 0;  // power of 2
+
+  public:
+    MUDA_GENERIC HashTableViewerBase() MUDA_NOEXCEPT = default;
+
+    MUDA_GENERIC HashTableViewerBase(auto_const_t<Key>*   keys,
+                                     auto_const_t<Value>* values,
+                                     auto_const_t<int>*   counts,
+                                     int                  capacity) MUDA_NOEXCEPT
+        : m_keys(keys),
+          m_values(values),
+          m_counts(counts),
+          m_capacity(capacity)
+    {
+        details::hash_table_check_key<Key>();
+        MUDA_VIEWER_ASSERT((capacity & (capacity - 1)) == 0,
+                           "HashTable[%s:%s]: capacity(%d) must be power of 2",
+                           this->name(),
+                           this->kernel_name(),
+                           capacity);
+    }
+
+    MUDA_GENERIC auto as_const() const MUDA_NOEXCEPT
+    {
+        return ConstViewer{m_keys, m_values, m_counts, m_capacity};
+    }
+
+    MUDA_GENERIC operator ConstViewer() const MUDA_NOEXCEPT
+    {
+        return as_const();
+    }
+
+    MUDA_GENERIC int capacity() const MUDA_NOEXCEPT { return m_capacity; }
+
+    // the size when the kernel starts is only accurate before any modification
+    MUDA_GENERIC int size() const MUDA_NOEXCEPT { return m_counts[0]; }
+
+    /**********************************************************************
+    * slot access
+    ***********************************************************************/
+
+    MUDA_GENERIC bool is_filled(int slot) const MUDA_NOEXCEPT
+    {
+        check_slot(slot);
+        auto k = m_keys[slot];
+        return k != EmptyKey && k != ErasedKey;
+    }
+
+    MUDA_GENERIC const Key& key(int slot) const MUDA_NOEXCEPT
+    {
+        check_slot(slot);
+        return m_keys[slot];
+    }
+
+    template <bool Set = IsSet>
+    MUDA_GENERIC std::enable_if_t<!Set, auto_const_t<Value>&> value(int slot) MUDA_NOEXCEPT
+    {
+        check_slot(slot);
+        return m_values[slot];
+    }
+
+    template <bool Set = IsSet>
+    MUDA_GENERIC std::enable_if_t<!Set, const Value&> value(int slot) const MUDA_NOEXCEPT
+    {
+        check_slot(slot);
+        return m_values[slot];
+    }
+
+    /**********************************************************************
+    * per-thread operations
+    ***********************************************************************/
+
+    /**
+     * \brief Insert a key-value pair, if the key exists, the value is not changed.
+     *
+     * The value is written after the key is visible, it's only safe to read in
+     * a later launch, see the file comment.
+     *
+     * \return true if the key is newly inserted.
+     */
+    template <bool Set = IsSet>
+    MUDA_GENERIC std::enable_if_t<!Set, bool> insert(const Key& key, const Value& value) MUDA_NOEXCEPT
+    {
+        return insert_impl(key, &value);
+    }
+
+    template <bool Set = IsSet>
+    MUDA_GENERIC std::enable_if_t<Set, bool> insert(const Key& key) MUDA_NOEXCEPT
+    {
+        return insert_impl(key, nullptr);
+    }
+
+    // return the slot index of the key, -1 if not found
+    MUDA_GENERIC int find_slot(const Key& key) const MUDA_NOEXCEPT;
+
+    MUDA_GENERIC bool contains(const Key& key) const MUDA_NOEXCEPT
+    {
+        return find_slot(key) >= 0;
+    }
+
+    // return the pointer to the value of the key, nullptr if not found
+    template <bool Set = IsSet>
+    MUDA_GENERIC std::enable_if_t<!Set, auto_const_t<Value>*> find(const Key& key) MUDA_NOEXCEPT
+    {
+        auto slot = find_slot(key);
+        return slot >= 0 ? m_values + slot : nullptr;
+    }
+
+    template <bool Set = IsSet>
+    MUDA_GENERIC std::enable_if_t<!Set, const Value*> find(const Key& key) const MUDA_NOEXCEPT
+    {
+        auto slot = find_slot(key);
+        return slot >= 0 ? m_values + slot : nullptr;
+    }
+
+    // return true if the key is erased by this call
+    MUDA_GENERIC bool erase(const Key& key) MUDA_NOEXCEPT;
+
+    /**********************************************************************
+    * cooperative operations, all threads in the tile must call with the same key
+    ***********************************************************************/
+
+    template <typename Tile, bool Set = IsSet>
+    MUDA_DEVICE std::enable_if_t<!Set, bool> insert(const Tile&  tile,
+                                                    const Key&   key,
+                                                    const Value& value) MUDA_NOEXCEPT
+    {
+        return insert_impl(tile, key, &value);
+    }
+
+    template <typename Tile, bool Set = IsSet>
+    MUDA_DEVICE std::enable_if_t<Set, bool> insert(const Tile& tile, const Key& key) MUDA_NOEXCEPT
+    {
+        return insert_impl(tile, key, nullptr);
+    }
+
+    template <typename Tile>
+    MUDA_DEVICE int find_slot(const Tile& tile, const Key& key) const MUDA_NOEXCEPT;
+
+    template <typename Tile>
+    MUDA_DEVICE bool contains(const Tile& tile, const Key& key) const MUDA_NOEXCEPT
+    {
+        return find_slot(tile, key) >= 0;
+    }
+
+    template <typename Tile>
+    MUDA_DEVICE bool erase(const Tile& tile, const Key& key) MUDA_NOEXCEPT;
+
+  private:
+    MUDA_GENERIC uint32_t home_slot(const Key& key) const MUDA_NOEXCEPT
+    {
+        return Hash{}(key) & static_cast<uint32_t>(m_capacity - 1);
+    }
+
+    MUDA_GENERIC bool insert_impl(const Key& key, const Value* value) MUDA_NOEXCEPT;
+
+    template <typename Tile>
+    MUDA_DEVICE bool insert_impl(const Tile& tile, const Key& key, const Value* value) MUDA_NOEXCEPT;
+
+    // the key is already published here, see the file comment
+    MUDA_GENERIC void on_inserted(int slot, const Value* value) MUDA_NOEXCEPT
+    {
+        if constexpr(!IsSet)
+            m_values[slot] = *value;
+        details::hash_table_add(m_counts + 0, 1);
+        details::hash_table_add(m_counts + 1, 1);
+    }
+
+    MUDA_INLINE MUDA_GENERIC void check_key(const Key& key) const MUDA_NOEXCEPT
+    {
+        if(this->checked())
+            if(key == EmptyKey || key == ErasedKey)
+                MUDA_KERNEL_ERROR("HashTable[%s:%s]: key is a reserved sentinel value",
+                                  this->name(),
+                                  this->kernel_name());
+    }
+
+    MUDA_INLINE MUDA_GENERIC void check_slot(int slot) const MUDA_NOEXCEPT
+    {
+        if(this->checked())
+            if(!(slot >= 0 && slot < m_capacity))
+                MUDA_KERNEL_ERROR("HashTable[%s:%s]: slot out of range, slot=(%d) capacity=(%d)",
+                                  this->name(),
+                                  this->kernel_name(),
+                                  slot,
+                                  m_capacity);
+    }
+};
+
+template <typename Key, typename Value, typename Hash = HashTableDefaultHash<Key>>
+using HashMapViewer = HashTableViewerBase<false, Key, Value, Hash>;
+
+template <typename Key, typename Value, typename Hash = HashTableDefaultHash<Key>>
+using CHashMapViewer = HashTableViewerBase<true, Key, Value, Hash>;
+
+template <typename Key, typename Hash = HashTableDefaultHash<Key>>
+using HashSetViewer = HashTableViewerBase<false, Key, details::HashTableNoValue, Hash>;
+
+template <typename Key, typename Hash = HashTableDefaultHash<Key>>
+using CHashSetViewer = HashTableViewerBase<true, Key, details::HashTableNoValue, Hash>;
+
+// viewer traits
+template <typename Key, typename Value, typename Hash>
+struct read_only_viewer<HashTableViewerBase<false, Key, Value, Hash>>
+{
+    using type = HashTableViewerBase<true, Key, Value, Hash>;
+};
+
+template <typename Key, typename Value, typename Hash>
+struct read_write_viewer<HashTableViewerBase<true, Key, Value, Hash>>
+{
+    using type = HashTableViewerBase<false, Key, Value, Hash>;
+};
+}  // namespace muda
+
+#include "details/hash_table_viewer.inl"
@@ -0,0 +1,252 @@
+/*****************************************************************/ /**
+ * \file   host_hash_map.h
+ * \brief  Host backend of `DeviceHashMap` / `DeviceHashSet`.
+ *
+ * The host tables run the same viewer code (probing, sentinels, tombstones)
+ * on `std::vector` storage in a single thread, so the layout and the results
+ * can be checked without a GPU.
+ *********************************************************************/
+#pragma once
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <muda/ext/hash_map/hash_table_viewer.h>
+
+namespace muda
+{
+namespace details
+{
+    template <typename Key, typename Value, typename Hash>
+    class HostHashTable
+    {
+      public:
+        using Viewer  = HashTableViewerBase<false, Key, Value, Hash>;
+        using CViewer = HashTableViewerBase<true, Key, Value, Hash>;
+
+        constexpr static bool IsSet    = Viewer::IsSet;
+        constexpr static Key  EmptyKey = Viewer::EmptyKey;
+
+      protected:
+        std::vector<Key>   m_keys;
+        std::vector<Value> m_values;
+        std::vector<int>   m_counts          = {0, 0};  // [size, occupied]
+        float              m_max_load_factor = 0.5f;
+
+      public:
+        HostHashTable(size_t capacity = 0, float max_load_factor = 0.5f)
+            : m_max_load_factor(max_load_factor)
+        {
+            MUDA_ASSERT(max_load_factor > 0.0f && max_load_factor < 1.0f,
+                        "max_load_factor(%f) should be in (0, 1)",
+                        max_load_factor);
+            if(capacity > 0)
+                rehash(capacity);
+        }
+
+        void reserve(size_t n)
+        {
+            auto required = static_cast<size_t>(std::ceil(n / m_max_load_factor)) + 1;
+            if(required > capacity())
+                rehash(required);
+        }
+
+        void rehash(size_t capacity)
+        {
+            auto n       = size();
+            auto min_cap = static_cast<size_t>(std::ceil(n / m_max_load_factor)) + 1;
+            auto new_cap = hash_table_round_up_pow2(
+                static_cast<uint32_t>(std::max({capacity, min_cap, size_t{16}})));
+
+            std::vector<Key>   keys(new_cap, EmptyKey);
+            std::vector<Value> values(IsSet ? 0 : new_cap);
+            std::vector<int>   counts = {0, 0};
+
+            auto src = cviewer();
+            auto dst = make_viewer(keys, values, counts);
+            for(int i = 0; i < src.capacity(); ++i)
+            {
+                if(!src.is_filled(i))
+                    continue;
+                if constexpr(IsSet)
+                    dst.insert(src.key(i));
+                else
+                    dst.insert(src.key(i), src.value(i));
+            }
+
+            m_keys   = std::move(keys);
+            m_values = std::move(values);
+            m_counts = std::move(counts);
+        }
+
+        void clear()
+        {
+            std::fill(m_keys.begin(), m_keys.end(), EmptyKey);
+            m_counts = {0, 0};
+        }
+
+        size_t size() const MUDA_NOEXCEPT { return m_counts[0]; }
+        size_t capacity() const MUDA_NOEXCEPT { return m_keys.size(); }
+        float  max_load_factor() const MUDA_NOEXCEPT
+        {
+            return m_max_load_factor;
+        }
+
+        Viewer  viewer() MUDA_NOEXCEPT { return make_viewer(m_keys, m_values, m_counts); }
+        CViewer cviewer() const MUDA_NOEXCEPT
+        {
+            return CViewer{m_keys.data(),
+                           IsSet ? nullptr : m_values.data(),
+                           m_counts.data(),
+                           static_cast<int>(m_keys.size())};
+        }
+
+      protected:
+        void ensure_capacity(size_t n)
+        {
+            auto limit = static_cast<size_t>(capacity() * m_max_load_factor);
+            if(static_cast<size_t>(m_counts[1]) + n > limit)
+                rehash(static_cast<size_t>(std::ceil((size() + n) / m_max_load_factor)) + 1);
+        }
+
+        static Viewer make_viewer(std::vector<Key>&   keys,
+                                  std::vector<Value>& values,
+                                  std::vector<int>&   counts) MUDA_NOEXCEPT
+        {
+            return Viewer{keys.data(),
+                          IsSet ? nullptr : values.data(),
+                          counts.data(),
+                          static_cast<int>(keys.size())};
+        }
+
+        void retrieve_impl(std::vector<Key>& keys, std::vector<Value>* values) const
+        {
+            keys.clear();
+            if(values)
+                values->clear();
+            auto table = cviewer();
+            for(int i = 0; i < table.capacity(); ++i)
+            {
+                if(!table.is_filled(i))
+                    continue;
+                keys.push_back(table.key(i));
+                if constexpr(!IsSet)
+                    if(values)
+                        values->push_back(table.value(i));
+            }
+        }
+    };
+}  // namespace details
+
+/**
+ * \brief Host counterpart of `DeviceHashMap`, with the same interface on `std::vector`.
+ */
+template <typename Key, typename Value, typename Hash = HashTableDefaultHash<Key>>
+class HostHashMap : public details::HostHashTable<Key, Value, Hash>
+{
+    using Base = details::HostHashTable<Key, Value, Hash>;
+
+  public:
+    using key_type   = Key;
+    using value_type = Value;
+
+    using Base::Base;
+
+    void insert(const std::vector<Key>& keys, const std::vector<Value>& values)
+    {
+        MUDA_ASSERT(keys.size() == values.size(),
+                    "keys.size()=%lld, values.size()=%lld",
+                    (long long)keys.size(),
+                    (long long)values.size());
+        if(keys.empty())
+            return;
+        Base::ensure_capacity(keys.size());
+        auto table = Base::viewer();
+        for(size_t i = 0; i < keys.size(); ++i)
+            table.insert(keys[i], values[i]);
+    }
+
+    void find(const std::vector<Key>& keys, std::vector<Value>& values, const Value& not_found) const
+    {
+        values.resize(keys.size());
+        if(Base::capacity() == 0)
+        {
+            std::fill(values.begin(), values.end(), not_found);
+            return;
+        }
+        auto table = Base::cviewer();
+        for(size_t i = 0; i < keys.size(); ++i)
+        {
+            auto v    = table.find(keys[i]);
+            values[i] = v ? *v : not_found;
+        }
+    }
+
+    void contains(const std::vector<Key>& keys, std::vector<int>& found) const
+    {
+        found.resize(keys.size());
+        auto table = Base::cviewer();
+        for(size_t i = 0; i < keys.size(); ++i)
+            found[i] = Base::capacity() > 0 && table.contains(keys[i]) ? 1 : 0;
+    }
+
+    void erase(const std::vector<Key>& keys)
+    {
+        if(Base::capacity() == 0)
+            return;
+        auto table = Base::viewer();
+        for(auto& key : keys)
+            table.erase(key);
+    }
+
+    void retrieve(std::vector<Key>& keys, std::vector<Value>& values) const
+    {
+        Base::retrieve_impl(keys, &values);
+    }
+};
+
+/**
+ * \brief Host counterpart of `DeviceHashSet`, with the same interface on `std::vector`.
+ */
+template <typename Key, typename Hash = HashTableDefaultHash<Key>>
+class HostHashSet : public details::HostHashTable<Key, details::HashTableNoValue, Hash>
+{
+    using Base = details::HostHashTable<Key, details::HashTableNoValue, Hash>;
+
+  public:
+    using key_type = Key;
+
+    using Base::Base;
+
+    void insert(const std::vector<Key>& keys)
+    {
+        if(keys.empty())
+            return;
+        Base::ensure_capacity(keys.size());
+        auto table = Base::viewer();
+        for(auto& key : keys)
+            table.insert(key);
+    }
+
+    void contains(const std::vector<Key>& keys, std::vector<int>& found) const
+    {
+        found.resize(keys.size());
+        auto table = Base::cviewer();
+        for(size_t i = 0; i < keys.size(); ++i)
+            found[i] = Base::capacity() > 0 && table.contains(keys[i]) ? 1 : 0;
+    }
+
+    void erase(const std::vector<Key>& keys)
+    {
+        if(Base::capacity() == 0)
+            return;
+        auto table = Base::viewer();
+        for(auto& key : keys)
+            table.erase(key);
+    }
+
+    void retrieve(std::vector<Key>& keys) const
+    {
+        Base::retrieve_impl(keys, nullptr);
+    }
+};
+}  // namespace muda
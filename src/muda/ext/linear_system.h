@@ -23,4 +23,5 @@
 #include <muda/ext/linear_system/csr_matrix_view.h>
 #include <muda/ext/linear_system/matrix_format_converter.h>
 #include <muda/ext/linear_system/linear_system_context.h>
+#include <muda/ext/linear_system/host_linear_system_context.h>
 
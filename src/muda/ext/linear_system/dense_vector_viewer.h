@@ -121,7 +121,7 @@ class DenseVectorViewerBase : public ViewerBase<IsConst>
   protected:
     MUDA_INLINE MUDA_GENERIC void check_size_matching(int N)
     {
-        MUDA_KERNEL_ASSERT(m_size == N,
+        MUDA_VIEWER_ASSERT(m_size == N,
                            "DenseVectorViewerBase [%s:%s]: size not match, yours size=%d, expected size=%d",
                            this->name(),
                            this->kernel_name(),
@@ -131,11 +131,11 @@ class DenseVectorViewerBase : public ViewerBase<IsConst>
 
     MUDA_INLINE MUDA_GENERIC int index(int i) const
     {
-        MUDA_KERNEL_ASSERT(origin_data(),
+        MUDA_VIEWER_ASSERT(origin_data(),
                            "DenseVectorViewerBase [%s:%s]: data is null",
                            this->name(),
                            this->kernel_name());
-        MUDA_KERNEL_ASSERT(i < m_size,
+        MUDA_VIEWER_ASSERT(i < m_size,
                            "DenseVectorViewerBase [%s:%s]: index out of range, size=%d, yours index=%d",
                            this->name(),
                            this->kernel_name(),
@@ -146,7 +146,7 @@ class DenseVectorViewerBase : public ViewerBase<IsConst>
 
     MUDA_INLINE MUDA_GENERIC void check_data() const
     {
-        MUDA_KERNEL_ASSERT(origin_data(),
+        MUDA_VIEWER_ASSERT(origin_data(),
                            "DenseVectorViewerBase [%s:%s]: data is null",
                            this->name(),
                            this->kernel_name());
@@ -154,7 +154,7 @@ class DenseVectorViewerBase : public ViewerBase<IsConst>
 
     MUDA_INLINE MUDA_GENERIC void check_segment(int offset, int size) const
     {
-        MUDA_KERNEL_ASSERT(offset + size <= m_size,
+        MUDA_VIEWER_ASSERT(offset + size <= m_size,
                            "DenseVectorViewerBase [%s:%s]: segment out of range, m_size=%d, offset=%d, size=%d",
                            this->name(),
                            this->kernel_name(),
@@ -9,7 +9,7 @@ MUDA_GENERIC auto DenseMatrixViewerBase<IsConst, T>::block(size_t row_offset,
                                                            size_t row_size,
                                                            size_t col_size) -> ThisViewer
 {
-    MUDA_KERNEL_ASSERT(row_offset + row_size <= m_row_size && col_offset + col_size <= m_col_size,
+    MUDA_VIEWER_ASSERT(row_offset + row_size <= m_row_size && col_offset + col_size <= m_col_size,
                        "DenseMatrixViewerBase [%s:%s]: block index out of range, shape=(%lld,%lld), yours index=(%lld,%lld)",
                        this->name(),
                        this->kernel_name(),
@@ -41,15 +41,15 @@ template <bool IsConst, typename T>
 MUDA_GENERIC auto DenseMatrixViewerBase<IsConst, T>::operator()(size_t i, size_t j)
     -> auto_const_t<T>&
 {
-    if constexpr(DEBUG_VIEWER)
+    if(this->checked())
     {
-        MUDA_KERNEL_ASSERT(m_view.data(0),
+        MUDA_VIEWER_ASSERT(m_view.data(0),
                            "DenseMatrixViewer [%s:%s]: data is null",
                            this->name(),
                            this->kernel_name());
         if(m_row_offset == 0 && m_col_offset == 0)
         {
-            MUDA_KERNEL_ASSERT(i < m_row_size && j < m_col_size,
+            MUDA_VIEWER_ASSERT(i < m_row_size && j < m_col_size,
                                "DenseMatrixViewer [%s:%s]: index out of range, shape=(%lld,%lld), yours index=(%lld,%lld)",
                                this->name(),
                                this->kernel_name(),
@@ -60,7 +60,7 @@ MUDA_GENERIC auto DenseMatrixViewerBase<IsConst, T>::operator()(size_t i, size_t
         }
         else
         {
-            MUDA_KERNEL_ASSERT(i < m_row_size && j < m_col_size,
+            MUDA_VIEWER_ASSERT(i < m_row_size && j < m_col_size,
                                "DenseMatrixViewer [%s:%s]:index out of range, block shape=(%lld,%lld), your index=(%lld,%lld)",
                                this->name(),
                                this->kernel_name(),
@@ -167,7 +167,7 @@ MUDA_DEVICE T DenseMatrixViewer<T>::atomic_add(size_t i, size_t j, T val)
 template <typename T>
 MUDA_INLINE MUDA_GENERIC void DenseMatrixViewer<T>::check_size_matching(int M, int N) const
 {
-    MUDA_KERNEL_ASSERT(this->m_row_size == M && this->m_col_size == N,
+    MUDA_VIEWER_ASSERT(this->m_row_size == M && this->m_col_size == N,
                        "DenseMatrixViewer [%s:%s] shape mismatching, Viewer=(%lld,%lld), yours=(%lld,%lld)",
                        this->name(),
                        this->kernel_name(),
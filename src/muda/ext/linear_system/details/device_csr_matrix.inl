@@ -94,6 +94,14 @@ void DeviceCSRMatrix<Ty>::reserve(int non_zeros)
     m_values.reserve(non_zeros);
 }
 
+template <typename Ty>
+void DeviceCSRMatrix<Ty>::resize(int non_zeros)
+{
+    m_col_indices.resize(non_zeros);
+    m_values.resize(non_zeros);
+    destroy_all_descr();
+}
+
 template <typename Ty>
 cusparseSpMatDescr_t DeviceCSRMatrix<Ty>::descr() const
 {
@@ -0,0 +1,834 @@
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <muda/cub/host/host_thread_pool.h>
+#include <muda/exception.h>
+#include "mapped_file.inl"
+
+namespace muda
+{
+namespace details::linear_system_io
+{
+    constexpr char     BinaryMagic[8]  = {'M', 'U', 'D', 'A', 'S', 'P', 'M', '\0'};
+    constexpr uint32_t BinaryVersion   = 1;
+    constexpr size_t   BinaryAlignment = 64;
+    // the smallest piece of a Matrix Market body worth a pool job
+    constexpr size_t ParseChunkBytes = 1 << 20;
+    // lines formatted per pool job by the writers
+    constexpr size_t WriteChunkLines = 1 << 16;
+    constexpr size_t StagingBytes    = 16 << 20;
+    // block rows grouped per pool job when reading block triplets
+    constexpr size_t BlockRowChunk = 1 << 10;
+
+    MUDA_INLINE size_t align_up(size_t bytes)
+    {
+        return (bytes + BinaryAlignment - 1) / BinaryAlignment * BinaryAlignment;
+    }
+
+    class FileWriter
+    {
+        std::FILE*  m_file;
+        std::string m_path;
+
+      public:
+        explicit FileWriter(std::string_view path)
+            : m_path(path)
+        {
+            m_file = std::fopen(m_path.c_str(), "wb");
+            if(!m_file)
+                throw runtime_error("LinearSystemIO: can't create " + m_path);
+        }
+        FileWriter(const FileWriter&)            = delete;
+        FileWriter& operator=(const FileWriter&) = delete;
+        ~FileWriter() { std::fclose(m_file); }
+
+        void write(const void* data, size_t bytes)
+        {
+            if(bytes > 0 && std::fwrite(data, 1, bytes, m_file) != bytes)
+                throw runtime_error("LinearSystemIO: can't write " + m_path);
+        }
+        void write(std::string_view s) { write(s.data(), s.size()); }
+        void pad_to(size_t offset)
+        {
+            static const char zeros[BinaryAlignment] = {};
+            auto              pos = static_cast<size_t>(std::ftell(m_file));
+            write(zeros, offset - pos);
+        }
+    };
+
+    MUDA_INLINE const char* next_line(const char* p, const char* end)
+    {
+        auto n = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        return n ? n + 1 : end;
+    }
+
+    MUDA_INLINE const char* skip_blank(const char* p, const char* end)
+    {
+        while(p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+            ++p;
+        return p;
+    }
+
+    // not empty and not a comment
+    MUDA_INLINE bool is_data_line(const char* p, const char* end)
+    {
+        p = skip_blank(p, end);
+        return p < end && *p != '\n' && *p != '%';
+    }
+
+    // [begin, end) cut into about `count` pieces, each starting at a line
+    MUDA_INLINE std::vector<const char*> split_lines(const char* begin, const char* end, size_t count)
+    {
+        std::vector<const char*> cuts{begin};
+        size_t                   bytes = end - begin;
+        for(size_t k = 1; k < count; ++k)
+        {
+            const char* p = std::max(begin + bytes * k / count, cuts.back());
+            cuts.push_back(p == begin ? p : next_line(p - 1, end));
+        }
+        cuts.push_back(end);
+        return cuts;
+    }
+
+    // f(line, line_end) for every data line of [begin, end)
+    template <typename F>
+    void for_each_data_line(const char* begin, const char* end, F&& f)
+    {
+        for(const char* p = begin; p < end;)
+        {
+            const char* n        = next_line(p, end);
+            const char* line_end = n > p && n[-1] == '\n' ? n - 1 : n;
+            if(is_data_line(p, line_end))
+                f(p, line_end);
+            p = n;
+        }
+    }
+
+    MUDA_INLINE bool parse_int(const char*& p, const char* end, long long& v)
+    {
+        p         = skip_blank(p, end);
+        bool neg  = p < end && *p == '-';
+        p        += (p < end && (*p == '-' || *p == '+'));
+        auto from = p;
+        v         = 0;
+        while(p < end && *p >= '0' && *p <= '9')
+            v = v * 10 + (*p++ - '0');
+        if(neg)
+            v = -v;
+        return p != from;
+    }
+
+    // the token is copied out, a mapped file is not null terminated
+    template <typename T>
+    bool parse_real(const char*& p, const char* end, T& v)
+    {
+        p = skip_blank(p, end);
+        char   token[64];
+        size_t n = 0;
+        while(p + n < end && n < sizeof(token) - 1 && !std::isspace(static_cast<unsigned char>(p[n])))
+        {
+            token[n] = p[n];
+            ++n;
+        }
+        token[n] = '\0';
+
+        char* stop;
+        auto  d = std::strtod(token, &stop);
+        if(n == 0 || stop != token + n)
+            return false;
+        v = static_cast<T>(d);
+        p += n;
+        return true;
+    }
+
+    MUDA_INLINE std::string lower(std::string_view s)
+    {
+        std::string r{s};
+        for(auto& c : r)
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        return r;
+    }
+
+    // the next whitespace separated word of the line
+    MUDA_INLINE std::string_view next_word(const char*& p, const char* end)
+    {
+        p         = skip_blank(p, end);
+        auto from = p;
+        while(p < end && !std::isspace(static_cast<unsigned char>(*p)))
+            ++p;
+        return std::string_view{from, static_cast<size_t>(p - from)};
+    }
+
+    // chunks of a Matrix Market body, and the data lines before each of them
+    class LineChunks
+    {
+      public:
+        std::vector<const char*> cuts;
+        std::vector<int64_t>     offsets;
+
+        size_t  size() const { return cuts.size() - 1; }
+        int64_t lines() const { return offsets.back(); }
+    };
+
+    MUDA_INLINE LineChunks chunk_lines(const char* begin, const char* end)
+    {
+        auto&  pool   = HostThreadPool::global();
+        size_t bytes  = end - begin;
+        size_t chunks = std::clamp<size_t>(bytes / ParseChunkBytes, 1, 4 * pool.thread_count());
+
+        LineChunks c;
+        c.cuts = split_lines(begin, end, chunks);
+        c.offsets.assign(c.size() + 1, 0);
+        pool.run(c.size(),
+                 [&](size_t k)
+                 {
+                     int64_t n = 0;
+                     for_each_data_line(c.cuts[k],
+                                        c.cuts[k + 1],
+                                        [&](const char*, const char*) { ++n; });
+                     c.offsets[k + 1] = n;
+                 });
+        std::partial_sum(c.offsets.begin(), c.offsets.end(), c.offsets.begin());
+        return c;
+    }
+
+    MUDA_INLINE void throw_first_error(std::string_view path, const std::vector<std::string>& errors)
+    {
+        for(auto& e : errors)
+            if(!e.empty())
+                throw invalid_argument("LinearSystemIO: " + std::string{path} + ": " + e);
+    }
+
+    // write `count` lines formatted by f(i, buffer) -> length, in parallel chunks, in order
+    template <typename F>
+    void write_lines(FileWriter& out, int64_t count, F&& f)
+    {
+        auto&  pool  = HostThreadPool::global();
+        size_t batch = 4 * pool.thread_count();
+        std::vector<std::string> texts(batch);
+
+        for(int64_t first = 0; first < count; first += batch * WriteChunkLines)
+        {
+            size_t jobs = std::min<size_t>(
+                batch, (count - first + WriteChunkLines - 1) / WriteChunkLines);
+            pool.run(jobs,
+                     [&](size_t k)
+                     {
+                         auto& text = texts[k];
+                         text.clear();
+                         int64_t begin = first + k * WriteChunkLines;
+                         int64_t end   = std::min<int64_t>(begin + WriteChunkLines, count);
+                         char    line[128];
+                         for(int64_t i = begin; i < end; ++i)
+                             text.append(line, f(i, line, sizeof(line)));
+                     });
+            for(size_t k = 0; k < jobs; ++k)
+                out.write(texts[k]);
+        }
+    }
+
+    template <typename T>
+    constexpr int digits()
+    {
+        return std::numeric_limits<T>::max_digits10;
+    }
+}  // namespace details::linear_system_io
+
+MUDA_INLINE MatrixMarketInfo LinearSystemIO::read_mtx_header(std::string_view path,
+                                                             const details::linear_system_io::MappedFile& file,
+                                                             const char*& body)
+{
+    using namespace details::linear_system_io;
+
+    auto fail = [&](const std::string& what)
+    { throw invalid_argument("LinearSystemIO: " + std::string{path} + ": " + what); };
+
+    const char* p   = file.data();
+    const char* end = p + file.size();
+    if(file.size() == 0)
+        fail("empty file");
+
+    // %%MatrixMarket matrix <format> <field> <symmetry>
+    const char* line_end = next_line(p, end);
+    const char* q        = p;
+    if(next_word(q, line_end) != "%%MatrixMarket" || lower(next_word(q, line_end)) != "matrix")
+        fail("not a Matrix Market matrix");
+
+    MatrixMarketInfo info;
+    auto             format   = lower(next_word(q, line_end));
+    auto             field    = lower(next_word(q, line_end));
+    auto             symmetry = lower(next_word(q, line_end));
+
+    if(format == "coordinate")
+        info.format = MatrixMarketFormat::Coordinate;
+    else if(format == "array")
+        info.format = MatrixMarketFormat::Array;
+    else
+        fail("unknown format " + format);
+
+    if(field == "real" || field == "double")
+        info.field = MatrixMarketField::Real;
+    else if(field == "integer")
+        info.field = MatrixMarketField::Integer;
+    else if(field == "pattern" && info.format == MatrixMarketFormat::Coordinate)
+        info.field = MatrixMarketField::Pattern;
+    else if(field == "complex")
+        throw not_implemented("LinearSystemIO: complex Matrix Market files are not supported");
+    else
+        fail("unknown field " + field);
+
+    if(symmetry == "general")
+        info.symmetry = MatrixMarketSymmetry::General;
+    else if(symmetry == "symmetric")
+        info.symmetry = MatrixMarketSymmetry::Symmetric;
+    else if(symmetry == "skew-symmetric")
+        info.symmetry = MatrixMarketSymmetry::SkewSymmetric;
+    else if(symmetry == "hermitian")
+        throw not_implemented("LinearSystemIO: hermitian Matrix Market files are not supported");
+    else
+        fail("unknown symmetry " + symmetry);
+
+    // the size line is the first data line after the comments
+    p = line_end;
+    while(p < end && !is_data_line(p, next_line(p, end)))
+        p = next_line(p, end);
+    line_end = next_line(p, end);
+
+    long long rows = 0, cols = 0, entries = 0;
+    if(!parse_int(p, line_end, rows) || !parse_int(p, line_end, cols))
+        fail("bad size line");
+    if(info.format == MatrixMarketFormat::Coordinate)
+    {
+        if(!parse_int(p, line_end, entries))
+            fail("bad size line");
+    }
+    else
+    {
+        entries = rows * cols;
+    }
+    if(rows < 0 || cols < 0 || entries < 0 || rows > INT_MAX || cols > INT_MAX)
+        fail("bad size line");
+    if(info.symmetry != MatrixMarketSymmetry::General && rows != cols)
+        fail("a symmetric matrix must be square");
+
+    info.rows    = static_cast<int>(rows);
+    info.cols    = static_cast<int>(cols);
+    info.entries = entries;
+    body         = line_end;
+    return info;
+}
+
+template <typename T>
+MatrixMarketInfo LinearSystemIO::read_mtx(std::string_view  path,
+                                          std::vector<int>& row_indices,
+                                          std::vector<int>& col_indices,
+                                          std::vector<T>&   values)
+{
+    using namespace details::linear_system_io;
+
+    MappedFile  file{path};
+    const char* body;
+    auto        info = read_mtx_header(path, file, body);
+    if(info.format != MatrixMarketFormat::Coordinate)
+        throw invalid_argument("LinearSystemIO: " + std::string{path} + ": not a coordinate matrix");
+
+    auto chunks = chunk_lines(body, file.data() + file.size());
+    if(chunks.lines() != info.entries)
+        throw invalid_argument("LinearSystemIO: " + std::string{path} + ": expected "
+                               + std::to_string(info.entries) + " entries, found "
+                               + std::to_string(chunks.lines()));
+
+    row_indices.resize(info.entries);
+    col_indices.resize(info.entries);
+    values.resize(info.entries);
+
+    auto&                    pool = HostThreadPool::global();
+    std::vector<std::string> errors(chunks.size());
+    // the off diagonal entries of each chunk, mirrored for symmetric files
+    std::vector<int64_t> mirrored(chunks.size() + 1, 0);
+    bool                 pattern = info.field == MatrixMarketField::Pattern;
+    bool symmetric = info.symmetry != MatrixMarketSymmetry::General;
+
+    pool.run(chunks.size(),
+             [&](size_t c)
+             {
+                 int64_t e   = chunks.offsets[c];
+                 int64_t off = 0;
+                 for_each_data_line(
+                     chunks.cuts[c],
+                     chunks.cuts[c + 1],
+                     [&](const char* p, const char* end)
+                     {
+                         if(!errors[c].empty())
+                             return;
+                         const char* line = p;
+                         long long   i, j;
+                         T         v  = T{1};
+                         bool      ok = parse_int(p, end, i) && parse_int(p, end, j)
+                                   && (pattern || parse_real(p, end, v));
+                         if(!ok || i < 1 || i > info.rows || j < 1 || j > info.cols)
+                         {
+                             errors[c] = "bad entry " + std::to_string(e + 1) + ": "
+                                         + std::string{line, static_cast<size_t>(end - line)};
+                             return;
+                         }
+                         row_indices[e] = static_cast<int>(i - 1);
+                         col_indices[e] = static_cast<int>(j - 1);
+                         values[e]      = v;
+                         off += symmetric && i != j;
+                         ++e;
+                     });
+                 mirrored[c + 1] = off;
+             });
+    throw_first_error(path, errors);
+
+    if(symmetric)
+    {
+        std::partial_sum(mirrored.begin(), mirrored.end(), mirrored.begin());
+        auto total = info.entries + mirrored.back();
+        row_indices.resize(total);
+        col_indices.resize(total);
+        values.resize(total);
+
+        T sign = info.symmetry == MatrixMarketSymmetry::SkewSymmetric ? T{-1} : T{1};
+        pool.run(chunks.size(),
+                 [&](size_t c)
+                 {
+                     int64_t m = info.entries + mirrored[c];
+                     for(int64_t e = chunks.offsets[c]; e < chunks.offsets[c + 1]; ++e)
+                     {
+                         if(row_indices[e] == col_indices[e])
+                             continue;
+                         row_indices[m] = col_indices[e];
+                         col_indices[m] = row_indices[e];
+                         values[m]      = sign * values[e];
+                         ++m;
+                     }
+                 });
+    }
+    return info;
+}
+
+template <typename T>
+MatrixMarketInfo LinearSystemIO::read_mtx(std::string_view path, DeviceTripletMatrix<T, 1>& A)
+{
+    std::vector<int> row_indices, col_indices;
+    std::vector<T>   values;
+    auto             info = read_mtx(path, row_indices, col_indices, values);
+
+    A.resize(info.rows, info.cols, values.size());
+    A.row_indices().copy_from(row_indices.data());
+    A.col_indices().copy_from(col_indices.data());
+    A.values().copy_from(values.data());
+    return info;
+}
+
+template <typename T, int N>
+MatrixMarketInfo LinearSystemIO::read_mtx(std::string_view path, DeviceTripletMatrix<T, N>& A)
+{
+    using namespace details::linear_system_io;
+    using BlockMatrix = Eigen::Matrix<T, N, N>;
+
+    std::vector<int> row_indices, col_indices;
+    std::vector<T>   values;
+    auto             info = read_mtx(path, row_indices, col_indices, values);
+    if(info.rows % N != 0 || info.cols % N != 0)
+        throw invalid_argument("LinearSystemIO: " + std::string{path} + ": the size ("
+                               + std::to_string(info.rows) + ", " + std::to_string(info.cols)
+                               + ") is not a multiple of the block size "
+                               + std::to_string(N));
+
+    // bucket the entries by block row, then sort each row by block column and
+    // merge the entries of a block (duplicates are summed)
+    int  block_rows = info.rows / N;
+    auto block_col  = [&](int e) { return col_indices[e] / N; };
+
+    std::vector<int> entry_offsets(block_rows + 1, 0);
+    for(auto r : row_indices)
+        ++entry_offsets[r / N + 1];
+    std::partial_sum(entry_offsets.begin(), entry_offsets.end(), entry_offsets.begin());
+    std::vector<int> order(values.size());
+    {
+        std::vector<int> next(entry_offsets.begin(), entry_offsets.end() - 1);
+        for(int e = 0; e < static_cast<int>(values.size()); ++e)
+            order[next[row_indices[e] / N]++] = e;
+    }
+
+    auto&  pool    = HostThreadPool::global();
+    size_t chunks  = (block_rows + BlockRowChunk - 1) / BlockRowChunk;
+    auto   rows_of = [&](size_t c)
+    {
+        return std::pair{static_cast<int>(c * BlockRowChunk),
+                         std::min(static_cast<int>((c + 1) * BlockRowChunk), block_rows)};
+    };
+
+    std::vector<int> block_offsets(block_rows + 1, 0);
+    pool.run(chunks,
+             [&](size_t c)
+             {
+                 auto [first, last] = rows_of(c);
+                 for(int r = first; r < last; ++r)
+                 {
+                     auto begin = order.begin() + entry_offsets[r];
+                     auto end   = order.begin() + entry_offsets[r + 1];
+                     std::sort(begin, end, [&](int a, int b) { return block_col(a) < block_col(b); });
+                     int count = 0;
+                     for(auto it = begin; it != end; ++it)
+                         if(it == begin || block_col(*it) != block_col(*(it - 1)))
+                             ++count;
+                     block_offsets[r + 1] = count;
+                 }
+             });
+    std::partial_sum(block_offsets.begin(), block_offsets.end(), block_offsets.begin());
+
+    std::vector<int>         block_row_indices(block_offsets.back());
+    std::vector<int>         block_col_indices(block_offsets.back());
+    std::vector<BlockMatrix> blocks(block_offsets.back());
+    pool.run(chunks,
+             [&](size_t c)
+             {
+                 auto [first, last] = rows_of(c);
+                 for(int r = first; r < last; ++r)
+                 {
+                     int b = block_offsets[r] - 1;
+                     for(int k = entry_offsets[r]; k < entry_offsets[r + 1]; ++k)
+                     {
+                         int e = order[k];
+                         if(k == entry_offsets[r] || block_col(e) != block_col(order[k - 1]))
+                         {
+                             ++b;
+                             block_row_indices[b] = r;
+                             block_col_indices[b] = block_col(e);
+                             blocks[b].setZero();
+                         }
+                         blocks[b](row_indices[e] % N, col_indices[e] % N) += values[e];
+                     }
+                 }
+             });
+
+    A.resize(block_rows, info.cols / N, blocks.size());
+    A.block_row_indices().copy_from(block_row_indices.data());
+    A.block_col_indices().copy_from(block_col_indices.data());
+    A.block_values().copy_from(blocks.data());
+    return info;
+}
+
+template <typename T>
+MatrixMarketInfo LinearSystemIO::read_mtx(std::string_view path, DeviceDenseVector<T>& b)
+{
+    using namespace details::linear_system_io;
+
+    MappedFile  file{path};
+    const char* body;
+    auto        info = read_mtx_header(path, file, body);
+    if(info.format != MatrixMarketFormat::Array || info.cols != 1)
+        throw invalid_argument("LinearSystemIO: " + std::string{path} + ": not a single column array");
+
+    auto chunks = chunk_lines(body, file.data() + file.size());
+    if(chunks.lines() != info.entries)
+        throw invalid_argument("LinearSystemIO: " + std::string{path} + ": expected "
+                               + std::to_string(info.entries) + " entries, found "
+                               + std::to_string(chunks.lines()));
+
+    Eigen::VectorX<T>        values(info.rows);
+    std::vector<std::string> errors(chunks.size());
+    HostThreadPool::global().run(chunks.size(),
+                                 [&](size_t c)
+                                 {
+                                     int64_t e = chunks.offsets[c];
+                                     for_each_data_line(chunks.cuts[c],
+                                                        chunks.cuts[c + 1],
+                                                        [&](const char* p, const char* end)
+                                                        {
+                                                            if(!errors[c].empty())
+                                                                return;
+                                                            if(!parse_real(p, end, values(e)))
+                                                                errors[c] = "bad entry "
+                                                                            + std::to_string(e + 1);
+                                                            ++e;
+                                                        });
+                                 });
+    throw_first_error(path, errors);
+
+    b = values;
+    return info;
+}
+
+template <typename T>
+void LinearSystemIO::write_mtx(std::string_view        path,
+                               int                     rows,
+                               int                     cols,
+                               const std::vector<int>& row_indices,
+                               const std::vector<int>& col_indices,
+                               const std::vector<T>&   values)
+{
+    using namespace details::linear_system_io;
+    MUDA_ASSERT(row_indices.size() == values.size() && col_indices.size() == values.size(),
+                "Triplet size mismatching: rows=%lld, cols=%lld, values=%lld",
+                (long long)row_indices.size(),
+                (long long)col_indices.size(),
+                (long long)values.size());
+
+    FileWriter out{path};
+    out.write("%%MatrixMarket matrix coordinate real general\n");
+    out.write(std::to_string(rows) + " " + std::to_string(cols) + " "
+              + std::to_string(values.size()) + "\n");
+    write_lines(out,
+                values.size(),
+                [&](int64_t e, char* line, size_t size)
+                {
+                    return std::snprintf(line,
+                                         size,
+                                         "%d %d %.*g\n",
+                                         row_indices[e] + 1,
+                                         col_indices[e] + 1,
+                                         digits<T>(),
+                                         static_cast<double>(values[e]));
+                });
+}
+
+template <typename T>
+void LinearSystemIO::write_mtx(std::string_view path, const DeviceCSRMatrix<T>& A)
+{
+    std::vector<int> row_offsets, row_indices, col_indices;
+    std::vector<T>   values;
+    A.m_row_offsets.copy_to(row_offsets);
+    A.m_col_indices.copy_to(col_indices);
+    A.m_values.copy_to(values);
+
+    row_indices.resize(values.size());
+    for(int i = 0; i < A.rows(); ++i)
+        std::fill(row_indices.begin() + row_offsets[i], row_indices.begin() + row_offsets[i + 1], i);
+    write_mtx(path, A.rows(), A.cols(), row_indices, col_indices, values);
+}
+
+template <typename T, int N>
+void LinearSystemIO::write_mtx(std::string_view path, const DeviceBSRMatrix<T, N>& A)
+{
+    using BlockMatrix = Eigen::Matrix<T, N, N>;
+
+    int                      nnzb = A.non_zero_blocks();
+    std::vector<int>         row_offsets(A.block_rows() + 1), block_cols(nnzb);
+    std::vector<BlockMatrix> blocks(nnzb);
+    A.block_row_offsets().copy_to(row_offsets.data());
+    A.block_col_indices().copy_to(block_cols.data());
+    A.block_values().copy_to(blocks.data());
+
+    std::vector<int> row_indices(nnzb * N * N), col_indices(nnzb * N * N);
+    std::vector<T>   values(nnzb * N * N);
+    for(int i = 0; i < A.block_rows(); ++i)
+        for(int b = row_offsets[i]; b < row_offsets[i + 1]; ++b)
+            for(int r = 0; r < N; ++r)
+                for(int c = 0; c < N; ++c)
+                {
+                    auto e         = (b * N + r) * N + c;
+                    row_indices[e] = i * N + r;
+                    col_indices[e] = block_cols[b] * N + c;
+                    values[e]      = blocks[b](r, c);
+                }
+    write_mtx(path, A.block_rows() * N, A.block_cols() * N, row_indices, col_indices, values);
+}
+
+template <typename T>
+void LinearSystemIO::write_mtx(std::string_view path, const DeviceDenseVector<T>& b)
+{
+    using namespace details::linear_system_io;
+
+    std::vector<T> values;
+    b.copy_to(values);
+
+    FileWriter out{path};
+    out.write("%%MatrixMarket matrix array real general\n");
+    out.write(std::to_string(values.size()) + " 1\n");
+    write_lines(out,
+                values.size(),
+                [&](int64_t e, char* line, size_t size) {
+                    return std::snprintf(
+                        line, size, "%.*g\n", digits<T>(), static_cast<double>(values[e]));
+                });
+}
+
+template <typename T>
+void LinearSystemIO::write_binary(std::string_view path,
+                                  int              rows,
+                                  int              cols,
+                                  int              block_dim,
+                                  const int*       row_offsets,
+                                  const int*       col_indices,
+                                  const T*         values,
+                                  int64_t          non_zeros)
+{
+    using namespace details::linear_system_io;
+
+    BinaryHeader header{};
+    std::memcpy(header.magic, BinaryMagic, sizeof(BinaryMagic));
+    header.version     = BinaryVersion;
+    header.value_bytes = sizeof(T);
+    header.block_dim   = block_dim;
+    header.rows        = rows;
+    header.cols        = cols;
+    header.non_zeros   = non_zeros;
+
+    size_t offset_bytes = sizeof(int) * (rows + 1);
+    size_t index_bytes  = sizeof(int) * non_zeros;
+    size_t offset_at    = align_up(sizeof(BinaryHeader));
+    size_t index_at     = offset_at + align_up(offset_bytes);
+    size_t value_at     = index_at + align_up(index_bytes);
+
+    FileWriter out{path};
+    out.write(&header, sizeof(header));
+    out.pad_to(offset_at);
+    out.write(row_offsets, offset_bytes);
+    out.pad_to(index_at);
+    out.write(col_indices, index_bytes);
+    out.pad_to(value_at);
+    out.write(values, sizeof(T) * block_dim * block_dim * non_zeros);
+}
+
+template <typename T>
+void LinearSystemIO::write_binary(std::string_view path, const DeviceCSRMatrix<T>& A)
+{
+    std::vector<int> row_offsets, col_indices;
+    std::vector<T>   values;
+    A.m_row_offsets.copy_to(row_offsets);
+    A.m_col_indices.copy_to(col_indices);
+    A.m_values.copy_to(values);
+    if(row_offsets.size() != static_cast<size_t>(A.rows()) + 1)  // never reshaped
+        row_offsets.assign(A.rows() + 1, 0);
+    write_binary(path, A.rows(), A.cols(), 1, row_offsets.data(), col_indices.data(), values.data(), values.size());
+}
+
+template <typename T, int N>
+void LinearSystemIO::write_binary(std::string_view path, const DeviceBSRMatrix<T, N>& A)
+{
+    using BlockMatrix = Eigen::Matrix<T, N, N>;
+
+    int                      nnzb = A.non_zero_blocks();
+    std::vector<int>         row_offsets(A.block_rows() + 1, 0), col_indices(nnzb);
+    std::vector<BlockMatrix> blocks(nnzb);
+    if(A.block_row_offsets().size() > 0)
+        A.block_row_offsets().copy_to(row_offsets.data());
+    A.block_col_indices().copy_to(col_indices.data());
+    A.block_values().copy_to(blocks.data());
+    write_binary(path,
+                 A.block_rows(),
+                 A.block_cols(),
+                 N,
+                 row_offsets.data(),
+                 col_indices.data(),
+                 reinterpret_cast<const T*>(blocks.data()),
+                 nnzb);
+}
+
+MUDA_INLINE details::linear_system_io::BinaryHeader LinearSystemIO::read_binary_header(
+    std::string_view path, const details::linear_system_io::MappedFile& file, size_t value_bytes, int block_dim)
+{
+    using namespace details::linear_system_io;
+
+    auto fail = [&](const std::string& what)
+    { throw invalid_argument("LinearSystemIO: " + std::string{path} + ": " + what); };
+
+    BinaryHeader header;
+    if(file.size() < sizeof(header))
+        fail("not a muda sparse matrix");
+    std::memcpy(&header, file.data(), sizeof(header));
+    if(std::memcmp(header.magic, BinaryMagic, sizeof(BinaryMagic)) != 0)
+        fail("not a muda sparse matrix");
+    if(header.version != BinaryVersion)
+        fail("unsupported version " + std::to_string(header.version));
+    if(header.value_bytes != value_bytes)
+        fail("the values have " + std::to_string(header.value_bytes) + " bytes, expected "
+             + std::to_string(value_bytes));
+    if(header.block_dim != static_cast<uint32_t>(block_dim))
+        fail("the block size is " + std::to_string(header.block_dim) + ", expected "
+             + std::to_string(block_dim));
+    if(header.rows < 0 || header.cols < 0 || header.non_zeros < 0 || header.rows > INT_MAX
+       || header.cols > INT_MAX || header.non_zeros > INT_MAX)
+        fail("bad size");
+
+    size_t value_end = align_up(sizeof(BinaryHeader)) + align_up(sizeof(int) * (header.rows + 1))
+                       + align_up(sizeof(int) * header.non_zeros)
+                       + value_bytes * block_dim * block_dim * header.non_zeros;
+    if(file.size() < value_end)
+        fail("truncated file");
+    return header;
+}
+
+MUDA_INLINE void LinearSystemIO::upload(const void* src, size_t bytes, void* dst)
+{
+    using namespace details::linear_system_io;
+
+    if(!m_staging)
+        m_staging = std::make_unique<Staging>();
+    auto& s    = *m_staging;
+    auto& pool = HostThreadPool::global();
+
+    auto from = static_cast<const std::byte*>(src);
+    auto to   = static_cast<std::byte*>(dst);
+    for(size_t offset = 0, k = 0; offset < bytes; offset += StagingBytes, ++k)
+    {
+        auto   slot = k % 2;
+        size_t n    = std::min(StagingBytes, bytes - offset);
+        // the copy of chunk k - 2 is done with this buffer
+        if(k >= 2)
+            checkCudaErrors(cudaEventSynchronize(s.copied[slot]));
+
+        // all threads take the page faults of the mapped file
+        constexpr size_t Grain   = 1 << 20;
+        std::byte*       staging = s.buffers[slot].reserve(StagingBytes);
+        pool.run((n + Grain - 1) / Grain,
+                 [&](size_t g)
+                 {
+                     size_t b = g * Grain;
+                     std::memcpy(staging + b, from + offset + b, std::min(Grain, n - b));
+                 });
+
+        checkCudaErrors(cudaMemcpyAsync(to + offset, staging, n, cudaMemcpyHostToDevice, m_stream));
+        checkCudaErrors(cudaEventRecord(s.copied[slot], m_stream));
+    }
+    checkCudaErrors(cudaStreamSynchronize(m_stream));
+}
+
+template <typename T>
+void LinearSystemIO::read_binary(std::string_view path, DeviceCSRMatrix<T>& A)
+{
+    using namespace details::linear_system_io;
+
+    MappedFile file{path};
+    auto       header = read_binary_header(path, file, sizeof(T), 1);
+    size_t     offset_at = align_up(sizeof(BinaryHeader));
+    size_t     index_at  = offset_at + align_up(sizeof(int) * (header.rows + 1));
+    size_t     value_at  = index_at + align_up(sizeof(int) * header.non_zeros);
+
+    A.reshape(header.rows, header.cols);
+    A.resize(header.non_zeros);
+    upload(file.data() + offset_at, sizeof(int) * (header.rows + 1), A.m_row_offsets.data());
+    upload(file.data() + index_at, sizeof(int) * header.non_zeros, A.m_col_indices.data());
+    upload(file.data() + value_at, sizeof(T) * header.non_zeros, A.m_values.data());
+}
+
+template <typename T, int N>
+void LinearSystemIO::read_binary(std::string_view path, DeviceBSRMatrix<T, N>& A)
+{
+    using namespace details::linear_system_io;
+
+    MappedFile file{path};
+    auto       header = read_binary_header(path, file, sizeof(T), N);
+    size_t     offset_at = align_up(sizeof(BinaryHeader));
+    size_t     index_at  = offset_at + align_up(sizeof(int) * (header.rows + 1));
+    size_t     value_at  = index_at + align_up(sizeof(int) * header.non_zeros);
+
+    A.reshape(header.rows, header.cols);
+    A.resize(header.non_zeros);
+    upload(file.data() + offset_at, sizeof(int) * (header.rows + 1), A.block_row_offsets().data());
+    upload(file.data() + index_at, sizeof(int) * header.non_zeros, A.block_col_indices().data());
+    upload(file.data() + value_at,
+           sizeof(T) * N * N * header.non_zeros,
+           A.block_values().data());
+}
+}  // namespace muda
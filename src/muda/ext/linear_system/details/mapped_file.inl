@@ -0,0 +1,92 @@
+// the file mapping of LinearSystemIO, kept apart so the OS headers are only
+// pulled in by <muda/ext/linear_system/linear_system_io.h>
+#include <string>
+#include <muda/exception.h>
+
+#ifdef MUDA_PLATFORM_WINDOWS
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace muda::details::linear_system_io
+{
+    MUDA_INLINE MappedFile::MappedFile(std::string_view path)
+    {
+        std::string p{path};
+#ifdef MUDA_PLATFORM_WINDOWS
+        auto file = CreateFileA(
+            p.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if(file == INVALID_HANDLE_VALUE)
+            throw runtime_error("LinearSystemIO: can't open " + p);
+        m_file = file;
+
+        LARGE_INTEGER size;
+        GetFileSizeEx(file, &size);
+        m_size = static_cast<size_t>(size.QuadPart);
+        if(m_size == 0)
+            return;
+
+        m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if(m_mapping)
+            m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+        if(!m_data)
+        {
+            // the destructor doesn't run for a throwing constructor
+            if(m_mapping)
+                CloseHandle(m_mapping);
+            CloseHandle(file);
+            throw runtime_error("LinearSystemIO: can't map " + p);
+        }
+#else
+        int fd = ::open(p.c_str(), O_RDONLY);
+        if(fd < 0)
+            throw runtime_error("LinearSystemIO: can't open " + p);
+
+        struct stat st;
+        if(::fstat(fd, &st) != 0)
+        {
+            ::close(fd);
+            throw runtime_error("LinearSystemIO: can't stat " + p);
+        }
+        m_size = static_cast<size_t>(st.st_size);
+        if(m_size > 0)
+        {
+            void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(data == MAP_FAILED)
+            {
+                ::close(fd);
+                throw runtime_error("LinearSystemIO: can't map " + p);
+            }
+            // the file is read once, front to back, by all pool threads
+            ::madvise(data, m_size, MADV_WILLNEED);
+            m_data = static_cast<const char*>(data);
+        }
+        ::close(fd);
+#endif
+    }
+
+    MUDA_INLINE MappedFile::~MappedFile()
+    {
+#ifdef MUDA_PLATFORM_WINDOWS
+        if(m_data)
+            UnmapViewOfFile(m_data);
+        if(m_mapping)
+            CloseHandle(m_mapping);
+        if(m_file)
+            CloseHandle(m_file);
+#else
+        if(m_data)
+            ::munmap(const_cast<char*>(m_data), m_size);
+#endif
+    }
+}  // namespace muda::details::linear_system_io
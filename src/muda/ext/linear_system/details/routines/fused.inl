@@ -0,0 +1,197 @@
+#include <muda/ext/linear_system/linear_system_fused_blas.h>
+#include <muda/launch/memory.h>
+
+namespace muda
+{
+namespace details::linear_system
+{
+    template <typename T>
+    MUDA_INLINE FusedVector<T> fused_vector(CDenseVectorView<T> v)
+    {
+        return FusedVector<T>{const_cast<T*>(v.data()), v.inc()};
+    }
+
+    template <typename T>
+    MUDA_INLINE void fused_common_check(std::initializer_list<CDenseVectorView<T>> vs)
+    {
+        auto first = *vs.begin();
+        for(auto& v : vs)
+        {
+            MUDA_ASSERT(v.data(), "Vector is empty");
+            MUDA_ASSERT(v.size() / v.inc() == first.size() / first.inc(),
+                        "Vectors have different size, (size=%lld, inc=%d) vs (size=%lld, inc=%d)",
+                        v.size(),
+                        v.inc(),
+                        first.size(),
+                        first.inc());
+        }
+    }
+
+    // result = sum op(i), the vectors are updated on the way
+    template <typename T, typename Op>
+    void fused_reduce(cudaStream_t stream, int size, const Op& op, VarView<T> result)
+    {
+        ParallelFor(256, 0, stream).reduce(size, T{0}, parallel_for_fused::Plus<T>{}, op, result);
+    }
+
+    // result = norm of the values returned by op(i), the last block to finish
+    // merges the partials of all blocks and takes the root
+    template <typename T, typename Op>
+    MUDA_GLOBAL void fused_norm_kernel(Op op, int count, ScaledSquares<T>* partials, unsigned int* done, T* result)
+    {
+        using namespace parallel_for_fused;
+        __shared__ bool s_last;
+
+        ScaledSquaresPlus<T> plus;
+        int                  tid       = blockIdx.x * blockDim.x + threadIdx.x;
+        int                  grid_size = gridDim.x * blockDim.x;
+
+        ScaledSquares<T> value;
+        for(int i = tid; i < count; i += grid_size)
+            value = plus(value, op(i));
+        value = block_reduce(value, blockDim.x, plus);
+
+        if(threadIdx.x == 0)
+        {
+            partials[blockIdx.x] = value;
+            __threadfence();
+            s_last = atomicAdd(done, 1u) == gridDim.x - 1;
+        }
+        __syncthreads();
+        if(!s_last)
+            return;
+
+        value = ScaledSquares<T>{};
+        for(int b = threadIdx.x; b < gridDim.x; b += blockDim.x)
+            value = plus(value, load_volatile(partials + b));
+        value = block_reduce(value, blockDim.x, plus);
+
+        if(threadIdx.x == 0)
+            *result = value.norm();
+    }
+
+    template <typename T, typename Op>
+    void fused_norm(cudaStream_t stream, int size, const Op& op, VarView<T> result)
+    {
+        using namespace parallel_for_fused;
+        MUDA_ASSERT(!ComputeGraphBuilder::is_building(),
+                    "fused norm can't be captured by a compute graph");
+        if(size == 0)
+        {
+            Memory(stream).set(result.data(), sizeof(T), 0);
+            return;
+        }
+
+        constexpr int block_dim = 256;
+        auto          kernel    = fused_norm_kernel<T, Op>;
+        int grid_dim = std::min(resident_grid_dim((const void*)kernel, block_dim),
+                                ParallelFor::round_up_blocks(size, block_dim));
+
+        // [done counter | partials]
+        size_t t_offset = (sizeof(unsigned int) + alignof(T) - 1) / alignof(T) * alignof(T);
+        size_t bytes    = t_offset + grid_dim * sizeof(ScaledSquares<T>);
+
+        std::byte* temp = nullptr;
+        Memory(stream).alloc(&temp, bytes).set(temp, sizeof(unsigned int), 0);
+
+        auto done     = reinterpret_cast<unsigned int*>(temp);
+        auto partials = reinterpret_cast<ScaledSquares<T>*>(temp + t_offset);
+        kernel<<<grid_dim, block_dim, 0, stream>>>(op, size, partials, done, result.data());
+
+        Memory(stream).free(temp);
+    }
+}  // namespace details::linear_system
+
+template <typename T>
+void LinearSystemContext::axpy_dot(const T&            alpha,
+                                   CDenseVectorView<T> x,
+                                   DenseVectorView<T>  y,
+                                   CDenseVectorView<T> z,
+                                   VarView<T>          result)
+{
+    using namespace details::linear_system;
+    fused_common_check<T>({x, y, z});
+    AxpyDotOp<T> op{{alpha, nullptr}, fused_vector(x), fused_vector<T>(y), fused_vector(z)};
+    fused_reduce(stream(), x.size() / x.inc(), op, result);
+}
+
+template <typename T>
+void LinearSystemContext::axpy_dot(CVarView<T>         alpha,
+                                   CDenseVectorView<T> x,
+                                   DenseVectorView<T>  y,
+                                   CDenseVectorView<T> z,
+                                   VarView<T>          result)
+{
+    using namespace details::linear_system;
+    fused_common_check<T>({x, y, z});
+    AxpyDotOp<T> op{{T{0}, alpha.data()}, fused_vector(x), fused_vector<T>(y), fused_vector(z)};
+    fused_reduce(stream(), x.size() / x.inc(), op, result);
+}
+
+template <typename T>
+void LinearSystemContext::axpby_norm(const T&            alpha,
+                                     CDenseVectorView<T> x,
+                                     const T&            beta,
+                                     DenseVectorView<T>  y,
+                                     VarView<T>          result)
+{
+    using namespace details::linear_system;
+    fused_common_check<T>({x, y});
+    AxpbyNormOp<T> op{{alpha, nullptr}, fused_vector(x), {beta, nullptr}, fused_vector<T>(y)};
+    fused_norm(stream(), x.size() / x.inc(), op, result);
+}
+
+template <typename T>
+void LinearSystemContext::axpby_norm(CVarView<T>         alpha,
+                                     CDenseVectorView<T> x,
+                                     CVarView<T>         beta,
+                                     DenseVectorView<T>  y,
+                                     VarView<T>          result)
+{
+    using namespace details::linear_system;
+    fused_common_check<T>({x, y});
+    AxpbyNormOp<T> op{
+        {T{0}, alpha.data()}, fused_vector(x), {T{0}, beta.data()}, fused_vector<T>(y)};
+    fused_norm(stream(), x.size() / x.inc(), op, result);
+}
+
+template <typename T>
+void LinearSystemContext::cg_update(const T&            alpha,
+                                    CDenseVectorView<T> p,
+                                    CDenseVectorView<T> q,
+                                    DenseVectorView<T>  x,
+                                    DenseVectorView<T>  r,
+                                    CDenseVectorView<T> z,
+                                    VarView<T>          result)
+{
+    using namespace details::linear_system;
+    fused_common_check<T>({p, q, x, r, z});
+    CGUpdateOp<T> op{{alpha, nullptr},
+                     fused_vector(p),
+                     fused_vector(q),
+                     fused_vector<T>(x),
+                     fused_vector<T>(r),
+                     fused_vector(z)};
+    fused_reduce(stream(), p.size() / p.inc(), op, result);
+}
+
+template <typename T>
+void LinearSystemContext::cg_update(CVarView<T>         alpha,
+                                    CDenseVectorView<T> p,
+                                    CDenseVectorView<T> q,
+                                    DenseVectorView<T>  x,
+                                    DenseVectorView<T>  r,
+                                    CDenseVectorView<T> z,
+                                    VarView<T>          result)
+{
+    using namespace details::linear_system;
+    fused_common_check<T>({p, q, x, r, z});
+    CGUpdateOp<T> op{{T{0}, alpha.data()},
+                     fused_vector(p),
+                     fused_vector(q),
+                     fused_vector<T>(x),
+                     fused_vector<T>(r),
+                     fused_vector(z)};
+    fused_reduce(stream(), p.size() / p.inc(), op, result);
+}
+}  // namespace muda
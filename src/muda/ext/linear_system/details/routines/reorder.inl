@@ -0,0 +1,298 @@
+#include <limits>
+#include <muda/cub/device/device_radix_sort.h>
+
+namespace muda
+{
+// everything below runs on the stream of the context: cub is called directly,
+// the wrappers would take the workspace of the default muda stream
+namespace details::linear_system
+{
+    // the offset of the sort storage behind `bytes` of data in a temp buffer
+    MUDA_INLINE size_t radix_sort_temp_offset(size_t bytes)
+    {
+        constexpr size_t Alignment = 256;
+        return (bytes + Alignment - 1) / Alignment * Alignment;
+    }
+
+    template <typename Key, typename Value>
+    size_t radix_sort_pairs_bytes(int n, int end_bit)
+    {
+        size_t bytes = 0;
+        checkCudaErrors(cub::DeviceRadixSort::SortPairs<Key, Value>(
+            nullptr, bytes, nullptr, nullptr, nullptr, nullptr, n, 0, end_bit));
+        return bytes;
+    }
+}  // namespace details::linear_system
+
+MUDA_INLINE void LinearSystemContext::sparse_rcm(int                      rows,
+                                                 int                      cols,
+                                                 const int*               row_offsets,
+                                                 const int*               col_indices,
+                                                 int                      nnz,
+                                                 LinearSystemPermutation& P)
+{
+    MUDA_ASSERT(rows == cols, "RCM needs a square matrix, yours=(%d, %d)", rows, cols);
+
+    std::vector<int> h_row_offsets(rows + 1);
+    std::vector<int> h_col_indices(nnz);
+    sync();
+    CBufferView<int>{row_offsets, 0, (size_t)rows + 1}.copy_to(h_row_offsets.data());
+    if(nnz > 0)
+        CBufferView<int>{col_indices, 0, (size_t)nnz}.copy_to(h_col_indices.data());
+
+    std::vector<int> perm;
+    details::linear_system::rcm_order(rows, h_row_offsets, h_col_indices, perm);
+    P.copy_from(perm);
+}
+
+template <typename T>
+void LinearSystemContext::rcm(CCSRMatrixView<T> A, LinearSystemPermutation& P)
+{
+    MUDA_ASSERT(!A.is_trans(), "RCM of a transposed view, use the matrix itself");
+    sparse_rcm(A.rows(), A.cols(), A.row_offsets(), A.col_indices(), A.non_zeros(), P);
+}
+
+template <typename T, int N>
+void LinearSystemContext::rcm(CBSRMatrixView<T, N> A, LinearSystemPermutation& P)
+{
+    MUDA_ASSERT(!A.is_trans(), "RCM of a transposed view, use the matrix itself");
+    sparse_rcm(A.block_rows(),
+               A.block_cols(),
+               A.block_row_offsets(),
+               A.block_col_indices(),
+               A.non_zero_blocks(),
+               P);
+}
+
+template <typename T>
+void LinearSystemContext::morton(CBufferView<Eigen::Vector3<T>> positions, LinearSystemPermutation& P)
+{
+    using namespace details::linear_system;
+
+    int n = static_cast<int>(positions.size());
+    P.m_perm.resize(n);
+    P.m_inverse.resize(n);
+    if(n == 0)
+        return;
+
+    // one temp buffer: the bounding box lo(0..2), hi(0..2), the keys and ids,
+    // then the storage of the sort
+    constexpr int BoxSlots = 8;  // in unsigned long long, keeps the keys aligned
+    static_assert(6 * sizeof(T) <= BoxSlots * sizeof(unsigned long long));
+    auto data_bytes =
+        radix_sort_temp_offset((BoxSlots + 2 * n) * sizeof(unsigned long long) + n * sizeof(int));
+    auto sort_bytes = radix_sort_pairs_bytes<unsigned long long, int>(n, 63);
+    auto buffer     = temp_buffer(data_bytes + sort_bytes);
+    auto box        = reinterpret_cast<T*>(buffer.data());
+    auto codes      = reinterpret_cast<unsigned long long*>(buffer.data()) + BoxSlots;
+    auto ids        = reinterpret_cast<int*>(codes + 2 * n);
+
+    for(int k = 0; k < 3; ++k)
+    {
+        ParallelFor(256, 0, stream()).reduce(
+            n,
+            std::numeric_limits<T>::max(),
+            [] __device__(T a, T b) { return a < b ? a : b; },
+            [p = positions.data(), k] __device__(int i) { return p[i](k); },
+            VarView<T>{box + k});
+        ParallelFor(256, 0, stream()).reduce(
+            n,
+            std::numeric_limits<T>::lowest(),
+            [] __device__(T a, T b) { return a > b ? a : b; },
+            [p = positions.data(), k] __device__(int i) { return p[i](k); },
+            VarView<T>{box + 3 + k});
+    }
+
+    ParallelFor(256, 0, stream())
+        .kernel_name(__FUNCTION__)
+        .apply(n,
+               [p = positions.data(), box, codes, ids] __device__(int i) mutable
+               {
+                   Eigen::Vector3<T> lo{box[0], box[1], box[2]};
+                   Eigen::Vector3<T> hi{box[3], box[4], box[5]};
+                   codes[i] = morton_code(p[i], lo, hi);
+                   ids[i]   = i;
+               });
+
+    // stable, equal codes keep their original order
+    checkCudaErrors(cub::DeviceRadixSort::SortPairs(buffer.data() + data_bytes,
+                                                    sort_bytes,
+                                                    codes,
+                                                    codes + n,
+                                                    ids,
+                                                    P.m_perm.data(),
+                                                    n,
+                                                    0,
+                                                    63,
+                                                    stream()));
+
+    ParallelFor(256, 0, stream())
+        .kernel_name(__FUNCTION__)
+        .apply(n,
+               [perm = P.m_perm.data(), inverse = P.m_inverse.data()] __device__(int i) mutable
+               { inverse[perm[i]] = i; });
+}
+
+template <typename Value>
+void LinearSystemContext::sparse_permute(int          rows,
+                                         const int*   row_offsets,
+                                         const int*   col_indices,
+                                         const Value* values,
+                                         int          nnz,
+                                         const int*   inverse,
+                                         int*         P_row_offsets,
+                                         int*         P_col_indices,
+                                         Value*       P_values)
+{
+    using namespace details::linear_system;
+
+    if(nnz == 0)
+    {
+        BufferLaunch(stream()).fill(BufferView<int>{P_row_offsets, 0, (size_t)rows + 1}, 0);
+        return;
+    }
+
+    // radix sort the entries by their permuted (row, col) key, the storage
+    // of the sort goes after the keys and ids
+    auto end_bit    = sparse_key_bits((unsigned long long)rows * rows);
+    auto data_bytes = radix_sort_temp_offset(nnz * (2 * sizeof(unsigned long long) + 3 * sizeof(int)));
+    auto sort_bytes = radix_sort_pairs_bytes<unsigned long long, int>(nnz, end_bit);
+    auto buffer     = temp_buffer(data_bytes + sort_bytes);
+    auto keys       = reinterpret_cast<unsigned long long*>(buffer.data());
+    auto A_rows     = reinterpret_cast<int*>(keys + 2 * nnz);
+    auto src_id     = A_rows + nnz;
+    auto dst_id     = src_id + nnz;
+
+    sparse_expand_rows(rows, row_offsets, A_rows, stream());
+
+    ParallelFor(256, 0, stream())
+        .kernel_name(__FUNCTION__)
+        .apply(nnz,
+               [rows, col_indices, inverse, A_rows, keys, src_id] __device__(int e) mutable
+               {
+                   keys[e] = (unsigned long long)inverse[A_rows[e]] * rows
+                             + inverse[col_indices[e]];
+                   src_id[e] = e;
+               });
+
+    checkCudaErrors(cub::DeviceRadixSort::SortPairs(buffer.data() + data_bytes,
+                                                    sort_bytes,
+                                                    keys,
+                                                    keys + nnz,
+                                                    src_id,
+                                                    dst_id,
+                                                    nnz,
+                                                    0,
+                                                    end_bit,
+                                                    stream()));
+
+    sparse_row_offsets_from_keys(rows, rows, keys + nnz, nnz, P_row_offsets, stream());
+
+    ParallelFor(256, 0, stream())
+        .kernel_name(__FUNCTION__)
+        .apply(nnz,
+               [rows, values, keys = keys + nnz, dst_id, P_col_indices, P_values] __device__(int i) mutable
+               {
+                   P_col_indices[i] = static_cast<int>(keys[i] % rows);
+                   P_values[i]      = values[dst_id[i]];
+               });
+}
+
+template <typename T>
+void LinearSystemContext::permute(CCSRMatrixView<T> A, const LinearSystemPermutation& P, DeviceCSRMatrix<T>& PA)
+{
+    MUDA_ASSERT(!A.is_trans(), "permute of a transposed view, use the matrix itself");
+    MUDA_ASSERT(A.rows() == A.cols() && A.rows() == P.size(),
+                "A must be square and match the permutation, A=(%d, %d), P=%d",
+                A.rows(),
+                A.cols(),
+                P.size());
+
+    PA.reshape(A.rows(), A.cols());
+    PA.resize(A.non_zeros());
+    sparse_permute<T>(A.rows(),
+                      A.row_offsets(),
+                      A.col_indices(),
+                      A.values(),
+                      A.non_zeros(),
+                      P.m_inverse.data(),
+                      PA.m_row_offsets.data(),
+                      PA.m_col_indices.data(),
+                      PA.m_values.data());
+}
+
+template <typename T, int N>
+void LinearSystemContext::permute(CBSRMatrixView<T, N>           A,
+                                  const LinearSystemPermutation& P,
+                                  DeviceBSRMatrix<T, N>&         PA)
+{
+    MUDA_ASSERT(!A.is_trans(), "permute of a transposed view, use the matrix itself");
+    MUDA_ASSERT(A.block_rows() == A.block_cols() && A.block_rows() == P.size(),
+                "A must be square and match the permutation, A=(%d, %d), P=%d",
+                A.block_rows(),
+                A.block_cols(),
+                P.size());
+
+    PA.reshape(A.block_rows(), A.block_cols());
+    PA.resize(A.non_zero_blocks());
+    sparse_permute<Eigen::Matrix<T, N, N>>(A.block_rows(),
+                                           A.block_row_offsets(),
+                                           A.block_col_indices(),
+                                           A.block_values(),
+                                           A.non_zero_blocks(),
+                                           P.m_inverse.data(),
+                                           PA.block_row_offsets().data(),
+                                           PA.block_col_indices().data(),
+                                           PA.block_values().data());
+}
+
+template <typename T>
+void LinearSystemContext::vector_permute(CDenseVectorView<T> x,
+                                         const int*          map,
+                                         int                 count,
+                                         DenseVectorView<T>  y,
+                                         int                 block_size,
+                                         bool                gather)
+{
+    MUDA_ASSERT(block_size > 0, "block size must be > 0, yours=%d", block_size);
+    MUDA_ASSERT(x.size() / x.inc() == count * block_size && y.size() / y.inc() == count * block_size,
+                "Vector size doesn't match the permutation, x=%lld, y=%lld, P=%d x %d",
+                x.size() / x.inc(),
+                y.size() / y.inc(),
+                count,
+                block_size);
+    MUDA_ASSERT(x.data() != y.data(), "x and y must not share storage");
+
+    ParallelFor(256, 0, stream())
+        .kernel_name(__FUNCTION__)
+        .apply(count * block_size,
+               [x = x.data(), x_inc = x.inc(), y = y.data(), y_inc = y.inc(), map, block_size, gather] __device__(
+                   int i) mutable
+               {
+                   int b = i / block_size;
+                   int k = i % block_size;
+                   // gather: y[b] = x[map[b]], scatter: y[map[b]] = x[b]
+                   int from = gather ? map[b] : b;
+                   int to   = gather ? b : map[b];
+                   y[(to * block_size + k) * y_inc] = x[(from * block_size + k) * x_inc];
+               });
+}
+
+template <typename T>
+void LinearSystemContext::permute(CDenseVectorView<T>            x,
+                                  const LinearSystemPermutation& P,
+                                  DenseVectorView<T>             y,
+                                  int                            block_size)
+{
+    vector_permute<T>(x, P.m_perm.data(), P.size(), y, block_size, true);
+}
+
+template <typename T>
+void LinearSystemContext::inverse_permute(CDenseVectorView<T>            x,
+                                          const LinearSystemPermutation& P,
+                                          DenseVectorView<T>             y,
+                                          int                            block_size)
+{
+    vector_permute<T>(x, P.m_perm.data(), P.size(), y, block_size, false);
+}
+}  // namespace muda
@@ -1,2 +1,3 @@
 #include "solve/solve_dense.inl"
-#include "solve/solve_sparse.inl"
\ No newline at end of file
+#include "solve/solve_sparse.inl"
+#include "solve/solve_batched.inl"
\ No newline at end of file
@@ -0,0 +1,184 @@
+#include <muda/check/check_cublas.h>
+#include <muda/check/check_cusolver.h>
+#include <muda/atomic.h>
+namespace muda
+{
+// using T         = float;
+// constexpr int N = 3;
+namespace details::linear_system
+{
+    // LU factorize A and overwrite b with the solution, for every system
+    template <typename T>
+    void getrf_getrs_batched(cublasHandle_t handle, int n, T** A, T** b, int* piv, int* info, int batch)
+    {
+        int param_info = 0;
+        if constexpr(std::is_same_v<T, float>)
+        {
+            checkCudaErrors(cublasSgetrfBatched(handle, n, A, n, piv, info, batch));
+            checkCudaErrors(cublasSgetrsBatched(
+                handle, CUBLAS_OP_N, n, 1, A, n, piv, b, n, &param_info, batch));
+        }
+        else if constexpr(std::is_same_v<T, double>)
+        {
+            checkCudaErrors(cublasDgetrfBatched(handle, n, A, n, piv, info, batch));
+            checkCudaErrors(cublasDgetrsBatched(
+                handle, CUBLAS_OP_N, n, 1, A, n, piv, b, n, &param_info, batch));
+        }
+        else
+        {
+            static_assert(always_false_v<T>, "Unsupported type");
+        }
+        MUDA_ASSERT(param_info == 0,
+                    "getrsBatched: the %d-th parameter is wrong",
+                    -param_info);
+    }
+
+    // Cholesky factorize A and overwrite b with the solution, for every system
+    template <typename T>
+    void potrf_potrs_batched(cusolverDnHandle_t handle, int n, T** A, T** b, int* info, int batch)
+    {
+        constexpr auto uplo = CUBLAS_FILL_MODE_LOWER;
+        // potrsBatched reports a single parameter error, the per-system info comes from potrf
+        int* param_info = info + batch;
+        if constexpr(std::is_same_v<T, float>)
+        {
+            checkCudaErrors(cusolverDnSpotrfBatched(handle, uplo, n, A, n, info, batch));
+            checkCudaErrors(cusolverDnSpotrsBatched(handle, uplo, n, 1, A, n, b, n, param_info, batch));
+        }
+        else if constexpr(std::is_same_v<T, double>)
+        {
+            checkCudaErrors(cusolverDnDpotrfBatched(handle, uplo, n, A, n, info, batch));
+            checkCudaErrors(cusolverDnDpotrsBatched(handle, uplo, n, 1, A, n, b, n, param_info, batch));
+        }
+        else
+        {
+            static_assert(always_false_v<T>, "Unsupported type");
+        }
+    }
+
+    MUDA_INLINE size_t batched_solve_align(size_t offset)
+    {
+        constexpr size_t alignment = 256;
+        return (offset + alignment - 1) / alignment * alignment;
+    }
+}  // namespace details::linear_system
+
+template <typename T, int N>
+void LinearSystemContext::solve(BufferView<Eigen::Vector<T, N>>     x,
+                                CBufferView<Eigen::Matrix<T, N, N>> A,
+                                CBufferView<Eigen::Vector<T, N>>    b,
+                                LinearSystemBatchedSolveMethod      method,
+                                BufferView<int>                     info)
+{
+    MUDA_ASSERT(A.size() == x.size() && A.size() == b.size(),
+                "Dimension mismatch in batched solve: A.size()=%lld, x.size()=%lld, b.size()=%lld",
+                (long long)A.size(),
+                (long long)x.size(),
+                (long long)b.size());
+    MUDA_ASSERT(!info.data() || info.size() == A.size(),
+                "info.size()=%lld should be the same as A.size()=%lld",
+                (long long)info.size(),
+                (long long)A.size());
+
+    auto batch = static_cast<int>(A.size());
+    if(batch == 0)
+        return;
+
+    auto failed = std::make_shared<DeviceVar<int>>(0);
+
+    if constexpr(N <= details::linear_system::batched_solve_register_max_dim)
+    {
+        // one thread per system, factorization stays in registers
+        ParallelFor(0, stream())
+            .kernel_name(__FUNCTION__)
+            .apply(batch,
+                   [method,
+                    x      = x.viewer().name("x"),
+                    A      = A.cviewer().name("A"),
+                    b      = b.cviewer().name("b"),
+                    info   = info.viewer().name("info"),
+                    failed = failed->data()] __device__(int i) mutable
+                   {
+                       Eigen::Vector<T, N> xi;
+                       auto r = details::linear_system::batched_solve_one<T, N>(
+                           method, A(i), b(i), xi);
+                       x(i) = xi;
+                       if(info.data())
+                           info(i) = r;
+                       if(r != 0)
+                           atomic_add(failed, 1);
+                   });
+    }
+    else
+    {
+        // the library routines factorize in place, so A is copied and b is solved in x
+        using Matrix = Eigen::Matrix<T, N, N>;
+        using details::linear_system::batched_solve_align;
+
+        size_t A_offset    = 0;
+        size_t ptr_offset  = batched_solve_align(A_offset + batch * sizeof(Matrix));
+        size_t piv_offset  = batched_solve_align(ptr_offset + 2 * batch * sizeof(T*));
+        size_t info_offset = batched_solve_align(piv_offset + batch * N * sizeof(int));
+        size_t total       = info_offset + (batch + 1) * sizeof(int);
+
+        auto buffer = temp_buffer(total);
+        auto bytes  = buffer.data();
+
+        auto A_fact = BufferView<Matrix>{reinterpret_cast<Matrix*>(bytes + A_offset), 0, (size_t)batch};
+        auto A_ptrs = reinterpret_cast<T**>(bytes + ptr_offset);
+        auto x_ptrs = A_ptrs + batch;
+        auto piv    = reinterpret_cast<int*>(bytes + piv_offset);
+        auto infos  = reinterpret_cast<int*>(bytes + info_offset);
+
+        BufferLaunch(stream()).copy(A_fact, A).copy(x, b);
+
+        ParallelFor(0, stream())
+            .kernel_name(__FUNCTION__)
+            .apply(batch,
+                   [A_fact = A_fact.data(), x = x.data(), A_ptrs, x_ptrs] __device__(int i) mutable
+                   {
+                       A_ptrs[i] = A_fact[i].data();
+                       x_ptrs[i] = x[i].data();
+                   });
+
+        if(method == LinearSystemBatchedSolveMethod::Cholesky)
+            details::linear_system::potrf_potrs_batched<T>(
+                cusolver_dn(), N, A_ptrs, x_ptrs, infos, batch);
+        else
+            details::linear_system::getrf_getrs_batched<T>(
+                cublas(), N, A_ptrs, x_ptrs, piv, infos, batch);
+
+        ParallelFor(0, stream())
+            .kernel_name(__FUNCTION__)
+            .apply(batch,
+                   [x      = x.viewer().name("x"),
+                    infos  = infos,
+                    info   = info.viewer().name("info"),
+                    failed = failed->data()] __device__(int i) mutable
+                   {
+                       auto r = infos[i];
+                       if(info.data())
+                           info(i) = r;
+                       if(r != 0)
+                       {
+                           x(i).setZero();
+                           atomic_add(failed, 1);
+                       }
+                   });
+    }
+
+    std::string label{this->label()};
+    this->label("");  // remove label because we consume it here
+
+    add_sync_callback(
+        [failed = std::move(failed), label = std::move(label), batch]() mutable
+        {
+            int result = *failed;
+            if(result > 0)
+                MUDA_KERNEL_WARN_WITH_LOCATION("In calling label %s: batched A*x=b solving failed for %d of %d systems (singular or not positive definite).",
+                                               label.c_str(),
+                                               result,
+                                               batch);
+        });
+}
+}  // namespace muda
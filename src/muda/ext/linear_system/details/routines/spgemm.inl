@@ -0,0 +1,368 @@
+#include <muda/cub/device/device_scan.h>
+#include <muda/cub/device/device_radix_sort.h>
+#include <muda/cub/device/device_run_length_encode.h>
+
+namespace muda
+{
+namespace details::linear_system
+{
+    // the smallest bit count to hold every key in [0, max_key]
+    MUDA_INLINE int sparse_key_bits(unsigned long long max_key)
+    {
+        int bits = 1;
+        while(bits < 64 && (max_key >> bits) != 0)
+            ++bits;
+        return bits;
+    }
+
+    // first position in [0, size) with keys[pos] >= key
+    template <typename Key>
+    MUDA_INLINE MUDA_DEVICE int sparse_lower_bound(const Key* keys, int size, Key key)
+    {
+        int lo = 0;
+        int hi = size;
+        while(lo < hi)
+        {
+            int mid = (lo + hi) / 2;
+            if(keys[mid] < key)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+    // fill the row index of every non-zero of a CSR/BSR structure
+    MUDA_INLINE void sparse_expand_rows(int          rows,
+                                        const int*   row_offsets,
+                                        int*         row_indices,
+                                        cudaStream_t stream = nullptr)
+    {
+        ParallelFor(256, 0, stream)
+            .kernel_name(__FUNCTION__)
+            .apply(rows,
+                   [row_offsets, row_indices] __device__(int i) mutable
+                   {
+                       for(int e = row_offsets[i]; e < row_offsets[i + 1]; ++e)
+                           row_indices[e] = i;
+                   });
+    }
+
+    // row_offsets[r] = first sorted key of row r, for r in [0, rows]
+    MUDA_INLINE void sparse_row_offsets_from_keys(int                       rows,
+                                                  int                       cols,
+                                                  const unsigned long long* keys,
+                                                  int                       nnz,
+                                                  int*                      row_offsets,
+                                                  cudaStream_t              stream = nullptr)
+    {
+        ParallelFor(256, 0, stream)
+            .kernel_name(__FUNCTION__)
+            .apply(rows + 1,
+                   [rows, cols, keys, nnz, row_offsets] __device__(int r) mutable
+                   {
+                       row_offsets[r] =
+                           r == rows ? nnz :
+                                       sparse_lower_bound(keys,
+                                                          nnz,
+                                                          (unsigned long long)r * cols);
+                   });
+    }
+}  // namespace details::linear_system
+
+MUDA_INLINE int LinearSystemContext::spgemm_plan(int        rows,
+                                                 int        inner,
+                                                 int        cols,
+                                                 const int* A_row_offsets,
+                                                 const int* A_col_indices,
+                                                 int        A_nnz,
+                                                 const int* B_row_offsets,
+                                                 const int* B_col_indices,
+                                                 int        B_nnz,
+                                                 int        block_size,
+                                                 LinearSystemSpGEMMPlan& plan)
+{
+    using namespace details::linear_system;
+
+    plan.m_rows       = rows;
+    plan.m_inner      = inner;
+    plan.m_cols       = cols;
+    plan.m_A_nnz      = A_nnz;
+    plan.m_B_nnz      = B_nnz;
+    plan.m_block_size = block_size;
+
+    // 1) expand: every (A entry, B entry) pair with A.col == B.row makes one product
+    plan.m_A_rows.resize(A_nnz);
+    sparse_expand_rows(rows, A_row_offsets, plan.m_A_rows.data());
+
+    auto& product_counts = plan.m_unique_counts;  // reuse as scratch
+    product_counts.resize(A_nnz + 1);
+    plan.m_product_offsets.resize(A_nnz + 1);
+
+    ParallelFor(256)
+        .kernel_name(__FUNCTION__)
+        .apply(A_nnz + 1,
+               [A_nnz,
+                A_col_indices,
+                B_row_offsets,
+                counts = product_counts.viewer().name("product_counts")] __device__(int e) mutable
+               {
+                   if(e == A_nnz)
+                   {
+                       counts(e) = 0;
+                       return;
+                   }
+                   auto k    = A_col_indices[e];
+                   counts(e) = B_row_offsets[k + 1] - B_row_offsets[k];
+               });
+
+    DeviceScan().ExclusiveSum(
+        product_counts.data(), plan.m_product_offsets.data(), A_nnz + 1);
+
+    int products = 0;
+    BufferLaunch().copy(&products, plan.m_product_offsets.view(A_nnz, 1)).wait();
+
+    plan.m_keys.resize(products);
+    plan.m_sorted_keys.resize(products);
+    plan.m_product_ids.resize(products);
+    plan.m_sorted_product_ids.resize(products);
+    plan.m_pair_A.resize(products);
+    plan.m_pair_B.resize(products);
+
+    if(products == 0)
+    {
+        plan.m_unique_keys.resize(0);
+        plan.m_pair_offsets.resize(1, 0);
+        return 0;
+    }
+
+    ParallelFor(256)
+        .kernel_name(__FUNCTION__)
+        .apply(A_nnz,
+               [cols,
+                A_col_indices,
+                B_row_offsets,
+                B_col_indices,
+                A_rows  = plan.m_A_rows.cviewer().name("A_rows"),
+                offsets = plan.m_product_offsets.cviewer().name("product_offsets"),
+                keys    = plan.m_keys.viewer().name("keys"),
+                ids = plan.m_product_ids.viewer().name("product_ids")] __device__(int e) mutable
+               {
+                   auto i = A_rows(e);
+                   auto k = A_col_indices[e];
+                   auto p = offsets(e);
+                   for(int b = B_row_offsets[k]; b < B_row_offsets[k + 1]; ++b, ++p)
+                   {
+                       keys(p) = (unsigned long long)i * cols + B_col_indices[b];
+                       ids(p)  = p;
+                   }
+               });
+
+    // 2) sort: group the products by the (row, col) of C they contribute to,
+    // radix sort is stable, so the summation order is fixed (deterministic result)
+    auto end_bit = sparse_key_bits((unsigned long long)rows * cols);
+    DeviceRadixSort().SortPairs(plan.m_keys.data(),
+                                plan.m_sorted_keys.data(),
+                                plan.m_product_ids.data(),
+                                plan.m_sorted_product_ids.data(),
+                                products,
+                                0,
+                                end_bit);
+
+    // 3) compress: one non-zero of C per unique key
+    DeviceVar<int> count;
+    plan.m_unique_keys.resize(products);
+    plan.m_unique_counts.resize(products + 1);
+    DeviceRunLengthEncode().Encode(plan.m_sorted_keys.data(),
+                                   plan.m_unique_keys.data(),
+                                   plan.m_unique_counts.data(),
+                                   count.data(),
+                                   products);
+    int nnz = count;
+    plan.m_unique_keys.resize(nnz);
+    plan.m_unique_counts.resize(nnz + 1);
+    plan.m_unique_counts.view(nnz, 1).fill(0);
+
+    plan.m_pair_offsets.resize(nnz + 1);
+    DeviceScan().ExclusiveSum(
+        plan.m_unique_counts.data(), plan.m_pair_offsets.data(), nnz + 1);
+
+    // recover the (A entry, B entry) pair of every sorted product
+    ParallelFor(256)
+        .kernel_name(__FUNCTION__)
+        .apply(products,
+               [A_nnz,
+                A_col_indices,
+                B_row_offsets,
+                offsets = plan.m_product_offsets.cviewer().name("product_offsets"),
+                sorted_ids = plan.m_sorted_product_ids.cviewer().name("sorted_product_ids"),
+                pair_A = plan.m_pair_A.viewer().name("pair_A"),
+                pair_B = plan.m_pair_B.viewer().name("pair_B")] __device__(int s) mutable
+               {
+                   auto p = sorted_ids(s);
+                   // the A entry owning product p: last e with offsets(e) <= p
+                   auto e = sparse_lower_bound(offsets.data(), A_nnz + 1, p + 1) - 1;
+                   auto k = A_col_indices[e];
+                   pair_A(s) = e;
+                   pair_B(s) = B_row_offsets[k] + (p - offsets(e));
+               });
+
+    return nnz;
+}
+
+MUDA_INLINE void LinearSystemContext::spgemm_structure(const LinearSystemSpGEMMPlan& plan,
+                                                       int* C_row_offsets,
+                                                       int* C_col_indices)
+{
+    using namespace details::linear_system;
+
+    auto nnz = plan.non_zeros();
+    sparse_row_offsets_from_keys(
+        plan.m_rows, plan.m_cols, plan.m_unique_keys.data(), nnz, C_row_offsets);
+
+    ParallelFor(256)
+        .kernel_name(__FUNCTION__)
+        .apply(nnz,
+               [cols = plan.m_cols,
+                keys = plan.m_unique_keys.cviewer().name("unique_keys"),
+                C_col_indices] __device__(int i) mutable
+               { C_col_indices[i] = (int)(keys(i) % cols); });
+}
+
+template <typename Value>
+void LinearSystemContext::spgemm_values(const LinearSystemSpGEMMPlan& plan,
+                                        const Value*                  A_values,
+                                        const Value*                  B_values,
+                                        Value*                        C_values)
+{
+    ParallelFor(0, stream())
+        .kernel_name(__FUNCTION__)
+        .apply(plan.non_zeros(),
+               [A_values,
+                B_values,
+                C_values,
+                offsets = plan.m_pair_offsets.cviewer().name("pair_offsets"),
+                pair_A  = plan.m_pair_A.cviewer().name("pair_A"),
+                pair_B = plan.m_pair_B.cviewer().name("pair_B")] __device__(int i) mutable
+               {
+                   Value sum = A_values[pair_A(offsets(i))] * B_values[pair_B(offsets(i))];
+                   for(int p = offsets(i) + 1; p < offsets(i + 1); ++p)
+                       sum += A_values[pair_A(p)] * B_values[pair_B(p)];
+                   C_values[i] = sum;
+               });
+}
+
+/***********************************************************************************************
+                                              CSR
+***********************************************************************************************/
+template <typename T>
+void LinearSystemContext::spgemm_symbolic(CCSRMatrixView<T>       A,
+                                          CCSRMatrixView<T>       B,
+                                          LinearSystemSpGEMMPlan& plan,
+                                          DeviceCSRMatrix<T>&     C)
+{
+    MUDA_ASSERT(!A.is_trans() && !B.is_trans(),
+                "spgemm doesn't support transposed views, call transpose() first");
+    MUDA_ASSERT(A.cols() == B.rows(),
+                "Dimension mismatch in spgemm: A.cols()=%d, B.rows()=%d",
+                A.cols(),
+                B.rows());
+
+    auto nnz = spgemm_plan(A.rows(),
+                           A.cols(),
+                           B.cols(),
+                           A.row_offsets(),
+                           A.col_indices(),
+                           A.non_zeros(),
+                           B.row_offsets(),
+                           B.col_indices(),
+                           B.non_zeros(),
+                           1,
+                           plan);
+
+    C.reshape(A.rows(), B.cols());
+    C.resize(nnz);
+    spgemm_structure(plan, C.m_row_offsets.data(), C.m_col_indices.data());
+}
+
+template <typename T>
+void LinearSystemContext::spgemm_numeric(CCSRMatrixView<T>             A,
+                                         CCSRMatrixView<T>             B,
+                                         const LinearSystemSpGEMMPlan& plan,
+                                         CSRMatrixView<T>              C)
+{
+    MUDA_ASSERT(plan.m_block_size == 1 && plan.m_rows == A.rows()
+                    && plan.m_inner == A.cols() && plan.m_cols == B.cols()
+                    && plan.m_A_nnz == A.non_zeros() && plan.m_B_nnz == B.non_zeros()
+                    && plan.non_zeros() == C.non_zeros(),
+                "spgemm plan doesn't match the matrices, call spgemm_symbolic() again");
+
+    spgemm_values<T>(plan, A.values(), B.values(), C.values());
+}
+
+template <typename T>
+void LinearSystemContext::spgemm(CCSRMatrixView<T> A, CCSRMatrixView<T> B, DeviceCSRMatrix<T>& C)
+{
+    LinearSystemSpGEMMPlan plan;
+    spgemm_symbolic(A, B, plan, C);
+    spgemm_numeric(A, B, plan, C.view());
+}
+
+/***********************************************************************************************
+                                              BSR
+***********************************************************************************************/
+template <typename T, int N>
+void LinearSystemContext::spgemm_symbolic(CBSRMatrixView<T, N>    A,
+                                          CBSRMatrixView<T, N>    B,
+                                          LinearSystemSpGEMMPlan& plan,
+                                          DeviceBSRMatrix<T, N>&  C)
+{
+    MUDA_ASSERT(!A.is_trans() && !B.is_trans(),
+                "spgemm doesn't support transposed views, call transpose() first");
+    MUDA_ASSERT(A.block_cols() == B.block_rows(),
+                "Dimension mismatch in spgemm: A.block_cols()=%d, B.block_rows()=%d",
+                A.block_cols(),
+                B.block_rows());
+
+    auto nnz = spgemm_plan(A.block_rows(),
+                           A.block_cols(),
+                           B.block_cols(),
+                           A.block_row_offsets(),
+                           A.block_col_indices(),
+                           A.non_zero_blocks(),
+                           B.block_row_offsets(),
+                           B.block_col_indices(),
+                           B.non_zero_blocks(),
+                           N,
+                           plan);
+
+    C.reshape(A.block_rows(), B.block_cols());
+    C.resize(nnz);
+    spgemm_structure(plan, C.block_row_offsets().data(), C.block_col_indices().data());
+}
+
+template <typename T, int N>
+void LinearSystemContext::spgemm_numeric(CBSRMatrixView<T, N>          A,
+                                         CBSRMatrixView<T, N>          B,
+                                         const LinearSystemSpGEMMPlan& plan,
+                                         BSRMatrixView<T, N>           C)
+{
+    MUDA_ASSERT(plan.m_block_size == N && plan.m_rows == A.block_rows()
+                    && plan.m_inner == A.block_cols() && plan.m_cols == B.block_cols()
+                    && plan.m_A_nnz == A.non_zero_blocks()
+                    && plan.m_B_nnz == B.non_zero_blocks()
+                    && plan.non_zeros() == C.non_zero_blocks(),
+                "spgemm plan doesn't match the matrices, call spgemm_symbolic() again");
+
+    spgemm_values<Eigen::Matrix<T, N, N>>(
+        plan, A.block_values(), B.block_values(), C.block_values());
+}
+
+template <typename T, int N>
+void LinearSystemContext::spgemm(CBSRMatrixView<T, N> A, CBSRMatrixView<T, N> B, DeviceBSRMatrix<T, N>& C)
+{
+    LinearSystemSpGEMMPlan plan;
+    spgemm_symbolic(A, B, plan, C);
+    spgemm_numeric(A, B, plan, C.view());
+}
+}  // namespace muda
@@ -0,0 +1,110 @@
+#include <muda/cub/device/device_radix_sort.h>
+
+namespace muda
+{
+namespace details::linear_system
+{
+    MUDA_INLINE MUDA_GENERIC float transpose_value(float v) { return v; }
+    MUDA_INLINE MUDA_GENERIC double transpose_value(double v) { return v; }
+    template <typename T, int N>
+    MUDA_INLINE MUDA_GENERIC Eigen::Matrix<T, N, N> transpose_value(const Eigen::Matrix<T, N, N>& v)
+    {
+        return v.transpose();
+    }
+}  // namespace details::linear_system
+
+template <typename Value>
+void LinearSystemContext::sparse_transpose(int          rows,
+                                           int          cols,
+                                           const int*   row_offsets,
+                                           const int*   col_indices,
+                                           const Value* values,
+                                           int          nnz,
+                                           int*         T_row_offsets,
+                                           int*         T_col_indices,
+                                           Value*       T_values)
+{
+    using namespace details::linear_system;
+
+    if(nnz == 0)
+    {
+        BufferLaunch().fill(BufferView<int>{T_row_offsets, 0, (size_t)cols + 1}, 0);
+        return;
+    }
+
+    // radix sort the entries by column: stable, so each row of the transpose stays sorted
+    auto buffer = temp_buffer(nnz * (2 * sizeof(unsigned long long) + 3 * sizeof(int)));
+    auto keys   = reinterpret_cast<unsigned long long*>(buffer.data());
+    auto A_rows = reinterpret_cast<int*>(keys + 2 * nnz);
+    auto src_id = A_rows + nnz;
+    auto dst_id = src_id + nnz;
+
+    sparse_expand_rows(rows, row_offsets, A_rows);
+
+    ParallelFor(256)
+        .kernel_name(__FUNCTION__)
+        .apply(nnz,
+               [col_indices, keys, src_id] __device__(int e) mutable
+               {
+                   keys[e]   = col_indices[e];
+                   src_id[e] = e;
+               });
+
+    DeviceRadixSort().SortPairs(keys,
+                                keys + nnz,
+                                src_id,
+                                dst_id,
+                                nnz,
+                                0,
+                                sparse_key_bits((unsigned long long)cols));
+
+    // the sorted column indices are the row keys of the transpose
+    sparse_row_offsets_from_keys(cols, 1, keys + nnz, nnz, T_row_offsets);
+
+    ParallelFor(256)
+        .kernel_name(__FUNCTION__)
+        .apply(nnz,
+               [values, A_rows, dst_id, T_col_indices, T_values] __device__(int i) mutable
+               {
+                   auto e           = dst_id[i];
+                   T_col_indices[i] = A_rows[e];
+                   T_values[i]      = transpose_value(values[e]);
+               });
+}
+
+template <typename T>
+void LinearSystemContext::transpose(CCSRMatrixView<T> A, DeviceCSRMatrix<T>& AT)
+{
+    MUDA_ASSERT(!A.is_trans(), "A is already a transposed view, use it directly");
+
+    AT.reshape(A.cols(), A.rows());
+    AT.resize(A.non_zeros());
+    sparse_transpose<T>(A.rows(),
+                        A.cols(),
+                        A.row_offsets(),
+                        A.col_indices(),
+                        A.values(),
+                        A.non_zeros(),
+                        AT.m_row_offsets.data(),
+                        AT.m_col_indices.data(),
+                        AT.m_values.data());
+}
+
+template <typename T, int N>
+void LinearSystemContext::transpose(CBSRMatrixView<T, N> A, DeviceBSRMatrix<T, N>& AT)
+{
+    MUDA_ASSERT(!A.is_trans(), "A is already a transposed view, use it directly");
+
+    AT.reshape(A.block_cols(), A.block_rows());
+    AT.resize(A.non_zero_blocks());
+    sparse_transpose<Eigen::Matrix<T, N, N>>(A.block_rows(),
+                                             A.block_cols(),
+                                             A.block_row_offsets(),
+                                             A.block_col_indices(),
+                                             A.block_values(),
+                                             A.non_zero_blocks(),
+                                             AT.block_row_offsets().data(),
+                                             AT.block_col_indices().data(),
+                                             AT.block_values().data());
+}
+}  // namespace muda
@@ -40,6 +40,7 @@ class DeviceCSRMatrix
 
     void reshape(int row, int col);
     void reserve(int non_zeros);
+    void resize(int non_zeros);
 
     auto values() { return m_values.view(); }
     auto values() const { return m_values.view(); }
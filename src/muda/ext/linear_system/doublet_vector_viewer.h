@@ -71,14 +71,14 @@ class DoubletVectorViewerBase : public ViewerBase<IsConst>
         , m_segment_indices(segment_indices)
         , m_segment_values(segment_values)
     {
-        MUDA_KERNEL_ASSERT(doublet_index_offset + doublet_count <= total_doublet_count,
+        MUDA_VIEWER_ASSERT(doublet_index_offset + doublet_count <= total_doublet_count,
                            "DoubletVectorViewer: out of range, m_total_doublet_count=%d, "
                            "your doublet_index_offset=%d, doublet_count=%d",
                            m_total_doublet_count,
                            doublet_index_offset,
                            doublet_count);
 
-        MUDA_KERNEL_ASSERT(subvector_offset + subvector_extent <= total_segment_count,
+        MUDA_VIEWER_ASSERT(subvector_offset + subvector_extent <= total_segment_count,
                            "DoubletVectorViewer: out of range, m_total_segment_count=%d, "
                            "your subvector_offset=%d, subvector_extent=%d",
                            m_total_segment_count,
@@ -122,7 +122,7 @@ class DoubletVectorViewerBase : public ViewerBase<IsConst>
   protected:
     MUDA_INLINE MUDA_GENERIC int get_index(int i) const noexcept
     {
-        MUDA_KERNEL_ASSERT(i >= 0 && i < m_doublet_count,
+        MUDA_VIEWER_ASSERT(i >= 0 && i < m_doublet_count,
                            "DoubletVectorViewer [%s:%s]: index out of range, m_doublet_count=%d, your index=%d",
                            this->name(),
                            this->kernel_name(),
@@ -134,7 +134,7 @@ class DoubletVectorViewerBase : public ViewerBase<IsConst>
 
     MUDA_INLINE MUDA_GENERIC void check_in_subvector(int i) const noexcept
     {
-        MUDA_KERNEL_ASSERT(i >= 0 && i < m_subvector_extent,
+        MUDA_VIEWER_ASSERT(i >= 0 && i < m_subvector_extent,
                            "DoubletVectorViewer [%s:%s]: index out of range, m_subvector_extent=%d, your index=%d",
                            this->name(),
                            this->kernel_name(),
@@ -269,14 +269,14 @@ class DoubletVectorViewerBase<IsConst, T, 1> : public ViewerBase<IsConst>
         , m_indices(indices)
         , m_values(values)
     {
-        MUDA_KERNEL_ASSERT(doublet_index_offset + doublet_count <= total_doublet_count,
+        MUDA_VIEWER_ASSERT(doublet_index_offset + doublet_count <= total_doublet_count,
                            "DoubletVectorViewer: out of range, m_total_doublet_count=%d, "
                            "your doublet_index_offset=%d, doublet_count=%d",
                            m_total_doublet_count,
                            doublet_index_offset,
                            doublet_count);
 
-        MUDA_KERNEL_ASSERT(subvector_offset + subvector_extent <= total_count,
+        MUDA_VIEWER_ASSERT(subvector_offset + subvector_extent <= total_count,
                            "DoubletVectorViewer: out of range, m_total_segment_count=%d, "
                            "your subvector_offset=%d, subvector_extent=%d",
                            m_total_count,
@@ -330,7 +330,7 @@ class DoubletVectorViewerBase<IsConst, T, 1> : public ViewerBase<IsConst>
     MUDA_INLINE MUDA_GENERIC int get_index(int i) const noexcept
     {
 
-        MUDA_KERNEL_ASSERT(i >= 0 && i < m_doublet_count,
+        MUDA_VIEWER_ASSERT(i >= 0 && i < m_doublet_count,
                            "DoubletVectorViewer [%s:%s]: index out of range, m_doublet_count=%d, your index=%d",
                            this->name(),
                            this->kernel_name(),
@@ -342,7 +342,7 @@ class DoubletVectorViewerBase<IsConst, T, 1> : public ViewerBase<IsConst>
 
     MUDA_INLINE MUDA_GENERIC void check_in_subvector(int i) const noexcept
     {
-        MUDA_KERNEL_ASSERT(i >= 0 && i < m_subvector_extent,
+        MUDA_VIEWER_ASSERT(i >= 0 && i < m_subvector_extent,
                            "DoubletVectorViewer [%s:%s]: index out of range, m_subvector_extent=%d, your index=%d",
                            this->name(),
                            this->kernel_name(),
@@ -0,0 +1,264 @@
+#pragma once
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <Eigen/SparseCore>
+#include <muda/tools/debug_log.h>
+#include <muda/ext/linear_system/linear_system_batched_solve.h>
+#include <muda/ext/linear_system/linear_system_fused_blas.h>
+#include <muda/ext/linear_system/linear_system_permutation.h>
+#include <muda/buffer/var_view.h>
+#include <muda/launch/parallel_for.h>
+
+namespace muda
+{
+/**
+ * \class HostLinearSystemContext
+ *
+ * \brief Host backend of `LinearSystemContext` routines, used as reference in tests.
+ *
+ * Batched solves run the same per-element code as the device sequentially, sparse routines
+ * work on row-major `Eigen::SparseMatrix`.
+ */
+class HostLinearSystemContext
+{
+  public:
+    // solve A[i] * x[i] = b[i] for every small system in the batch, return the count of failed systems
+    // info (optional) receives 0 for a solved system, the failing pivot (1-based) otherwise,
+    // x[i] of a failed system is set to zero
+    template <typename T, int N>
+    int solve(std::vector<Eigen::Vector<T, N>>&             x,
+              const std::vector<Eigen::Matrix<T, N, N>>&    A,
+              const std::vector<Eigen::Vector<T, N>>&       b,
+              LinearSystemBatchedSolveMethod method = LinearSystemBatchedSolveMethod::LU,
+              std::vector<int>*              info   = nullptr)
+    {
+        MUDA_ASSERT(A.size() == b.size(),
+                    "Dimension mismatch in batched solve: A.size()=%lld, b.size()=%lld",
+                    (long long)A.size(),
+                    (long long)b.size());
+        x.resize(A.size());
+        if(info)
+            info->resize(A.size());
+
+        int failed = 0;
+        for(size_t i = 0; i < A.size(); ++i)
+        {
+            auto r = details::linear_system::batched_solve_one<T, N>(method, A[i], b[i], x[i]);
+            if(info)
+                (*info)[i] = r;
+            if(r != 0)
+                ++failed;
+        }
+        return failed;
+    }
+
+    // C = A * B, row by row with a dense accumulator (Gustavson),
+    // reference for `LinearSystemContext::spgemm()`
+    template <typename T>
+    void spgemm(const Eigen::SparseMatrix<T, Eigen::RowMajor>& A,
+                const Eigen::SparseMatrix<T, Eigen::RowMajor>& B,
+                Eigen::SparseMatrix<T, Eigen::RowMajor>&       C)
+    {
+        using Sparse = Eigen::SparseMatrix<T, Eigen::RowMajor>;
+        MUDA_ASSERT(A.cols() == B.rows(),
+                    "Dimension mismatch in spgemm: A.cols()=%lld, B.rows()=%lld",
+                    (long long)A.cols(),
+                    (long long)B.rows());
+
+        std::vector<Eigen::Triplet<T>> triplets;
+        std::vector<T>                 acc(B.cols(), T{0});
+        std::vector<char>              used(B.cols(), 0);
+        std::vector<int>               cols;
+        for(int i = 0; i < A.outerSize(); ++i)
+        {
+            cols.clear();
+            for(typename Sparse::InnerIterator a(A, i); a; ++a)
+            {
+                for(typename Sparse::InnerIterator b(B, a.col()); b; ++b)
+                {
+                    if(!used[b.col()])
+                    {
+                        used[b.col()] = 1;
+                        cols.push_back(b.col());
+                    }
+                    acc[b.col()] += a.value() * b.value();
+                }
+            }
+            std::sort(cols.begin(), cols.end());
+            for(auto j : cols)
+            {
+                // keep structural zeros, like the device version
+                triplets.emplace_back(i, j, acc[j]);
+                acc[j]  = T{0};
+                used[j] = 0;
+            }
+        }
+
+        C.resize(A.rows(), B.cols());
+        C.setFromTriplets(triplets.begin(), triplets.end());
+    }
+
+    // y = alpha * x + y, return dot(y, z), reference for `LinearSystemContext::axpy_dot()`
+    template <typename T>
+    T axpy_dot(const T& alpha, const Eigen::VectorX<T>& x, Eigen::VectorX<T>& y, const Eigen::VectorX<T>& z)
+    {
+        using namespace details::linear_system;
+        check_size(x, y);
+        check_size(x, z);
+        AxpyDotOp<T> op{{alpha, nullptr}, vector(x), vector(y), vector(z)};
+        return reduce<T>(x.size(), op);
+    }
+
+    // y = alpha * x + beta * y, return norm(y), reference for `LinearSystemContext::axpby_norm()`
+    template <typename T>
+    T axpby_norm(const T& alpha, const Eigen::VectorX<T>& x, const T& beta, Eigen::VectorX<T>& y)
+    {
+        using namespace details::linear_system;
+        check_size(x, y);
+        AxpbyNormOp<T> op{{alpha, nullptr}, vector(x), {beta, nullptr}, vector(y)};
+        // the pair is too wide for the block merge of `ParallelFor::reduce`,
+        // call its host backend directly
+        int                  count = static_cast<int>(x.size());
+        ScaledSquaresPlus<T> plus;
+        ScaledSquares<T>     ssq;
+        if(count > 0)
+            ssq = details::parallel_for_fused::host_map_reduce(count, ssq, plus, op);
+        return ssq.norm();
+    }
+
+    // x = x + alpha * p, r = r - alpha * q, return dot(r, z),
+    // reference for `LinearSystemContext::cg_update()`
+    template <typename T>
+    T cg_update(const T&                 alpha,
+                const Eigen::VectorX<T>& p,
+                const Eigen::VectorX<T>& q,
+                Eigen::VectorX<T>&       x,
+                Eigen::VectorX<T>&       r,
+                const Eigen::VectorX<T>& z)
+    {
+        using namespace details::linear_system;
+        check_size(p, q);
+        check_size(p, x);
+        check_size(p, r);
+        check_size(p, z);
+        CGUpdateOp<T> op{{alpha, nullptr}, vector(p), vector(q), vector(x), vector(r), vector(z)};
+        return reduce<T>(p.size(), op);
+    }
+
+    // AT = A^T, reference for `LinearSystemContext::transpose()`
+    template <typename T>
+    void transpose(const Eigen::SparseMatrix<T, Eigen::RowMajor>& A,
+                   Eigen::SparseMatrix<T, Eigen::RowMajor>&       AT)
+    {
+        using Sparse = Eigen::SparseMatrix<T, Eigen::RowMajor>;
+        std::vector<Eigen::Triplet<T>> triplets;
+        triplets.reserve(A.nonZeros());
+        for(int i = 0; i < A.outerSize(); ++i)
+            for(typename Sparse::InnerIterator a(A, i); a; ++a)
+                triplets.emplace_back(a.col(), i, a.value());
+
+        AT.resize(A.cols(), A.rows());
+        AT.setFromTriplets(triplets.begin(), triplets.end());
+    }
+
+    // perm[new] = old, reference for `LinearSystemContext::rcm()`
+    template <typename T>
+    void rcm(const Eigen::SparseMatrix<T, Eigen::RowMajor>& A, std::vector<int>& perm)
+    {
+        using Sparse = Eigen::SparseMatrix<T, Eigen::RowMajor>;
+        MUDA_ASSERT(A.rows() == A.cols(),
+                    "RCM needs a square matrix, yours=(%lld, %lld)",
+                    (long long)A.rows(),
+                    (long long)A.cols());
+
+        std::vector<int> row_offsets(A.outerSize() + 1, 0);
+        std::vector<int> col_indices;
+        col_indices.reserve(A.nonZeros());
+        for(int i = 0; i < A.outerSize(); ++i)
+        {
+            for(typename Sparse::InnerIterator a(A, i); a; ++a)
+                col_indices.push_back(a.col());
+            row_offsets[i + 1] = static_cast<int>(col_indices.size());
+        }
+        details::linear_system::rcm_order(A.outerSize(), row_offsets, col_indices, perm);
+    }
+
+    // perm[new] = old, reference for `LinearSystemContext::morton()`
+    template <typename T>
+    void morton(const std::vector<Eigen::Vector3<T>>& positions, std::vector<int>& perm)
+    {
+        perm.resize(positions.size());
+        if(positions.empty())
+            return;
+
+        Eigen::Vector3<T> lo = positions.front();
+        Eigen::Vector3<T> hi = positions.front();
+        for(auto& p : positions)
+        {
+            lo = lo.cwiseMin(p);
+            hi = hi.cwiseMax(p);
+        }
+
+        std::vector<unsigned long long> codes(positions.size());
+        for(size_t i = 0; i < positions.size(); ++i)
+        {
+            codes[i] = details::linear_system::morton_code(positions[i], lo, hi);
+            perm[i]  = static_cast<int>(i);
+        }
+        std::stable_sort(perm.begin(), perm.end(), [&](int a, int b) { return codes[a] < codes[b]; });
+    }
+
+    // PA = P * A * P^T, reference for `LinearSystemContext::permute()`
+    template <typename T>
+    void permute(const Eigen::SparseMatrix<T, Eigen::RowMajor>& A,
+                 const std::vector<int>&                        perm,
+                 Eigen::SparseMatrix<T, Eigen::RowMajor>&       PA)
+    {
+        using Sparse = Eigen::SparseMatrix<T, Eigen::RowMajor>;
+        std::vector<int> inverse(perm.size());
+        for(int i = 0; i < static_cast<int>(perm.size()); ++i)
+            inverse[perm[i]] = i;
+
+        std::vector<Eigen::Triplet<T>> triplets;
+        triplets.reserve(A.nonZeros());
+        for(int i = 0; i < A.outerSize(); ++i)
+            for(typename Sparse::InnerIterator a(A, i); a; ++a)
+                triplets.emplace_back(inverse[i], inverse[a.col()], a.value());
+
+        PA.resize(A.rows(), A.cols());
+        PA.setFromTriplets(triplets.begin(), triplets.end());
+    }
+
+  private:
+    template <typename T>
+    static details::linear_system::FusedVector<T> vector(const Eigen::VectorX<T>& v)
+    {
+        return {const_cast<T*>(v.data()), 1};
+    }
+
+    template <typename T>
+    static void check_size(const Eigen::VectorX<T>& a, const Eigen::VectorX<T>& b)
+    {
+        MUDA_ASSERT(a.size() == b.size(),
+                    "Vectors have different size: %lld vs %lld",
+                    (long long)a.size(),
+                    (long long)b.size());
+    }
+
+    // the same chunked reduction as ParallelFor::reduce on the host backend
+    template <typename T, typename Op>
+    static T reduce(Eigen::Index size, const Op& op)
+    {
+        T result;
+        ParallelFor()
+            .backend(ParallelForBackend::Host)
+            .reduce(static_cast<int>(size),
+                    T{0},
+                    details::parallel_for_fused::Plus<T>{},
+                    op,
+                    VarView<T>{&result});
+        return result;
+    }
+};
+}  // namespace muda
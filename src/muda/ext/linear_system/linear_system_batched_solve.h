@@ -0,0 +1,36 @@
+#pragma once
+#include <muda/muda_def.h>
+#include <muda/ext/eigen/inverse.h>
+
+namespace muda
+{
+enum class LinearSystemBatchedSolveMethod
+{
+    // Gauss elimination / LU with partial pivoting
+    LU       = 0,
+    // A must be symmetric positive definite, only the lower triangle is read
+    Cholesky = 1,
+};
+
+namespace details::linear_system
+{
+    // systems up to this size are solved per-thread in registers,
+    // larger ones go to the batched cublas/cusolver routines
+    constexpr int batched_solve_register_max_dim = 12;
+
+    // solve one small system, return 0 on success, LAPACK-like `info` otherwise
+    template <typename T, int N>
+    MUDA_INLINE MUDA_GENERIC int batched_solve_one(LinearSystemBatchedSolveMethod method,
+                                                   const Eigen::Matrix<T, N, N>& A,
+                                                   const Eigen::Matrix<T, N, 1>& b,
+                                                   Eigen::Matrix<T, N, 1>&       x)
+    {
+        int info = method == LinearSystemBatchedSolveMethod::Cholesky ?
+                       eigen::solve<T, N, eigen::CholeskySolve>(A, b, x) :
+                       eigen::solve<T, N, eigen::GaussEliminationSolve>(A, b, x);
+        if(info != 0)
+            x.setZero();
+        return info;
+    }
+}  // namespace details::linear_system
+}  // namespace muda
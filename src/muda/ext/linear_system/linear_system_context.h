@@ -13,6 +13,9 @@
 #include <muda/ext/linear_system/linear_system_handles.h>
 #include <muda/ext/linear_system/linear_system_solve_tolerance.h>
 #include <muda/ext/linear_system/linear_system_solve_reorder.h>
+#include <muda/ext/linear_system/linear_system_batched_solve.h>
+#include <muda/ext/linear_system/linear_system_spgemm_plan.h>
+#include <muda/ext/linear_system/linear_system_permutation.h>
 namespace muda
 {
 class LinearSystemContextCreateInfo
@@ -200,6 +203,55 @@ class LinearSystemContext
     template <typename T>
     void plus(CDenseVectorView<T> x, CDenseVectorView<T> y, DenseVectorView<T> z);
 
+    /***********************************************************************************************
+                                            Fused BLAS-1
+                          one pass over the vectors, the scalar result stays on
+                          the device (no pointer mode switch, no sync)
+    ***********************************************************************************************/
+    // y = alpha * x + y, result = dot(y, z), z may be y
+    template <typename T>
+    void axpy_dot(const T&            alpha,
+                  CDenseVectorView<T> x,
+                  DenseVectorView<T>  y,
+                  CDenseVectorView<T> z,
+                  VarView<T>          result);
+    template <typename T>
+    void axpy_dot(CVarView<T>         alpha,
+                  CDenseVectorView<T> x,
+                  DenseVectorView<T>  y,
+                  CDenseVectorView<T> z,
+                  VarView<T>          result);
+    // y = alpha * x + beta * y, result = norm(y)
+    template <typename T>
+    void axpby_norm(const T&            alpha,
+                    CDenseVectorView<T> x,
+                    const T&            beta,
+                    DenseVectorView<T>  y,
+                    VarView<T>          result);
+    template <typename T>
+    void axpby_norm(CVarView<T>         alpha,
+                    CDenseVectorView<T> x,
+                    CVarView<T>         beta,
+                    DenseVectorView<T>  y,
+                    VarView<T>          result);
+    // the (P)CG update: x = x + alpha * p, r = r - alpha * q, result = dot(r, z), z may be r
+    template <typename T>
+    void cg_update(const T&            alpha,
+                   CDenseVectorView<T> p,
+                   CDenseVectorView<T> q,
+                   DenseVectorView<T>  x,
+                   DenseVectorView<T>  r,
+                   CDenseVectorView<T> z,
+                   VarView<T>          result);
+    template <typename T>
+    void cg_update(CVarView<T>         alpha,
+                   CDenseVectorView<T> p,
+                   CDenseVectorView<T> q,
+                   DenseVectorView<T>  x,
+                   DenseVectorView<T>  r,
+                   CDenseVectorView<T> z,
+                   VarView<T>          result);
+
     /***********************************************************************************************
                                                 Spmv
                                         y = a * A * x + b * y
@@ -265,8 +317,145 @@ class LinearSystemContext
     // A is the CSR Matrix
     template <typename T>
     void solve(DenseVectorView<T> x, CCSRMatrixView<T> A, CDenseVectorView<T> b);
+    // solve A[i] * x[i] = b[i] for every small system in the batch
+    // info (optional) receives 0 for a solved system, the failing pivot (1-based) otherwise,
+    // x[i] of a failed system is set to zero
+    template <typename T, int N>
+    void solve(BufferView<Eigen::Vector<T, N>>     x,
+               CBufferView<Eigen::Matrix<T, N, N>> A,
+               CBufferView<Eigen::Vector<T, N>>    b,
+               LinearSystemBatchedSolveMethod method = LinearSystemBatchedSolveMethod::LU,
+               BufferView<int>                info   = {});
+
+    /***********************************************************************************************
+                                               SpGEMM
+                                              C = A * B
+    ***********************************************************************************************/
+    // symbolic phase: build the structure of C and the plan to compute its values,
+    // C is reshaped and resized, its values are left uninitialized
+    template <typename T>
+    void spgemm_symbolic(CCSRMatrixView<T>       A,
+                         CCSRMatrixView<T>       B,
+                         LinearSystemSpGEMMPlan& plan,
+                         DeviceCSRMatrix<T>&     C);
+    // numeric phase: compute the values of C, the structures of A, B and C must
+    // be the same as in spgemm_symbolic(), only the values may change
+    template <typename T>
+    void spgemm_numeric(CCSRMatrixView<T>             A,
+                        CCSRMatrixView<T>             B,
+                        const LinearSystemSpGEMMPlan& plan,
+                        CSRMatrixView<T>              C);
+    // both phases, the plan is dropped
+    template <typename T>
+    void spgemm(CCSRMatrixView<T> A, CCSRMatrixView<T> B, DeviceCSRMatrix<T>& C);
+
+    template <typename T, int N>
+    void spgemm_symbolic(CBSRMatrixView<T, N>    A,
+                         CBSRMatrixView<T, N>    B,
+                         LinearSystemSpGEMMPlan& plan,
+                         DeviceBSRMatrix<T, N>&  C);
+    template <typename T, int N>
+    void spgemm_numeric(CBSRMatrixView<T, N>          A,
+                        CBSRMatrixView<T, N>          B,
+                        const LinearSystemSpGEMMPlan& plan,
+                        BSRMatrixView<T, N>           C);
+    template <typename T, int N>
+    void spgemm(CBSRMatrixView<T, N> A, CBSRMatrixView<T, N> B, DeviceBSRMatrix<T, N>& C);
+
+    /***********************************************************************************************
+                                              Transpose
+                                               AT = A^T
+    ***********************************************************************************************/
+    // AT must not share storage with A
+    template <typename T>
+    void transpose(CCSRMatrixView<T> A, DeviceCSRMatrix<T>& AT);
+    template <typename T, int N>
+    void transpose(CBSRMatrixView<T, N> A, DeviceBSRMatrix<T, N>& AT);
+
+    /***********************************************************************************************
+                                              Reorder
+                        bandwidth reducing symmetric permutations, PA = P * A * P^T
+    ***********************************************************************************************/
+    // Reverse Cuthill-McKee on the pattern of A + A^T, A must be square,
+    // the breadth first search runs on the host (this syncs)
+    template <typename T>
+    void rcm(CCSRMatrixView<T> A, LinearSystemPermutation& P);
+    template <typename T, int N>
+    void rcm(CBSRMatrixView<T, N> A, LinearSystemPermutation& P);
+    // order by the Morton code of the positions (e.g. the vertices owning the block rows)
+    template <typename T>
+    void morton(CBufferView<Eigen::Vector3<T>> positions, LinearSystemPermutation& P);
+    // PA must not share storage with A
+    template <typename T>
+    void permute(CCSRMatrixView<T> A, const LinearSystemPermutation& P, DeviceCSRMatrix<T>& PA);
+    template <typename T, int N>
+    void permute(CBSRMatrixView<T, N> A, const LinearSystemPermutation& P, DeviceBSRMatrix<T, N>& PA);
+    // y = P * x, a block of `block_size` entries per permuted index
+    template <typename T>
+    void permute(CDenseVectorView<T>            x,
+                 const LinearSystemPermutation& P,
+                 DenseVectorView<T>             y,
+                 int                            block_size = 1);
+    // y = P^T * x, a block of `block_size` entries per permuted index
+    template <typename T>
+    void inverse_permute(CDenseVectorView<T>            x,
+                         const LinearSystemPermutation& P,
+                         DenseVectorView<T>             y,
+                         int                            block_size = 1);
 
   private:
+    int  spgemm_plan(int                     rows,
+                     int                     inner,
+                     int                     cols,
+                     const int*              A_row_offsets,
+                     const int*              A_col_indices,
+                     int                     A_nnz,
+                     const int*              B_row_offsets,
+                     const int*              B_col_indices,
+                     int                     B_nnz,
+                     int                     block_size,
+                     LinearSystemSpGEMMPlan& plan);
+    void spgemm_structure(const LinearSystemSpGEMMPlan& plan, int* C_row_offsets, int* C_col_indices);
+    template <typename Value>
+    void spgemm_values(const LinearSystemSpGEMMPlan& plan,
+                       const Value*                  A_values,
+                       const Value*                  B_values,
+                       Value*                        C_values);
+    template <typename Value>
+    void sparse_transpose(int          rows,
+                          int          cols,
+                          const int*   row_offsets,
+                          const int*   col_indices,
+                          const Value* values,
+                          int          nnz,
+                          int*         T_row_offsets,
+                          int*         T_col_indices,
+                          Value*       T_values);
+    template <typename Value>
+    void sparse_permute(int          rows,
+                        const int*   row_offsets,
+                        const int*   col_indices,
+                        const Value* values,
+                        int          nnz,
+                        const int*   inverse,
+                        int*         P_row_offsets,
+                        int*         P_col_indices,
+                        Value*       P_values);
+    void sparse_rcm(int                      rows,
+                    int                      cols,
+                    const int*               row_offsets,
+                    const int*               col_indices,
+                    int                      nnz,
+                    LinearSystemPermutation& P);
+    // gather: y[i] = x[map[i]], scatter: y[map[i]] = x[i], per block of `block_size`
+    template <typename T>
+    void vector_permute(CDenseVectorView<T> x,
+                        const int*          map,
+                        int                 count,
+                        DenseVectorView<T>  y,
+                        int                 block_size,
+                        bool                gather);
+
     template <typename T>
     void generic_spmv(const T&                  a,
                       cusparseOperation_t       op,
@@ -286,7 +475,11 @@ class LinearSystemContext
 #include "details/routines/norm.inl"
 #include "details/routines/dot.inl"
 #include "details/routines/axpby.inl"
+#include "details/routines/fused.inl"
 #include "details/routines/spmv.inl"
 #include "details/routines/mv.inl"
 #include "details/routines/solve.inl"
 #include "details/routines/mm.inl"
+#include "details/routines/spgemm.inl"
+#include "details/routines/transpose.inl"
+#include "details/routines/reorder.inl"
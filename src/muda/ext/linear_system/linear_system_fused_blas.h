@@ -0,0 +1,125 @@
+#pragma once
+#include <cmath>
+#include <muda/muda_def.h>
+
+namespace muda::details::linear_system
+{
+// the per element code of the fused BLAS-1 routines, shared by
+// `LinearSystemContext` (device) and `HostLinearSystemContext` (host),
+// each returns the term it contributes to the reduced scalar
+
+// a scalar given by value or by a pointer (e.g. the result of a previous dot on the device)
+template <typename T>
+class FusedScalar
+{
+  public:
+    T        value = T{0};
+    const T* ptr   = nullptr;
+
+    MUDA_GENERIC T get() const { return ptr ? *ptr : value; }
+};
+
+template <typename T>
+class FusedVector
+{
+  public:
+    T*  data;
+    int inc;
+
+    MUDA_GENERIC T& operator()(int i) const { return data[i * inc]; }
+};
+
+// y = alpha * x + y, returns y(i) * z(i)
+template <typename T>
+class AxpyDotOp
+{
+  public:
+    FusedScalar<T> alpha;
+    FusedVector<T> x;
+    FusedVector<T> y;
+    FusedVector<T> z;
+
+    MUDA_GENERIC T operator()(int i) const
+    {
+        y(i) = alpha.get() * x(i) + y(i);
+        // z may alias y, read it after the update
+        return y(i) * z(i);
+    }
+};
+
+// sum of squares kept as scale^2 * ssq with scale = max |v|, so neither
+// the squares of large values overflow nor those of small values underflow
+template <typename T>
+class ScaledSquares
+{
+  public:
+    T scale = T{0};
+    T ssq   = T{0};
+
+    MUDA_GENERIC static ScaledSquares of(const T& v)
+    {
+        T a = v < T{0} ? -v : v;
+        return {a, a == T{0} ? T{0} : T{1}};
+    }
+
+    MUDA_GENERIC T norm() const { return scale * sqrt(ssq); }
+};
+
+// merge two partial sums into the larger scale, the ratio is <= 1
+template <typename T>
+class ScaledSquaresPlus
+{
+  public:
+    MUDA_GENERIC ScaledSquares<T> operator()(const ScaledSquares<T>& a,
+                                             const ScaledSquares<T>& b) const
+    {
+        bool             a_big = a.scale >= b.scale;
+        ScaledSquares<T> big   = a_big ? a : b;
+        ScaledSquares<T> small = a_big ? b : a;
+        if(small.scale == T{0})
+            return big;
+        T r = small.scale / big.scale;
+        return {big.scale, big.ssq + small.ssq * r * r};
+    }
+};
+
+// y = alpha * x + beta * y, returns y(i) as scaled squares
+template <typename T>
+class AxpbyNormOp
+{
+  public:
+    FusedScalar<T> alpha;
+    FusedVector<T> x;
+    FusedScalar<T> beta;
+    FusedVector<T> y;
+
+    MUDA_GENERIC ScaledSquares<T> operator()(int i) const
+    {
+        T v  = alpha.get() * x(i) + beta.get() * y(i);
+        y(i) = v;
+        return ScaledSquares<T>::of(v);
+    }
+};
+
+// x = x + alpha * p, r = r - alpha * q, returns r(i) * z(i)
+template <typename T>
+class CGUpdateOp
+{
+  public:
+    FusedScalar<T> alpha;
+    FusedVector<T> p;
+    FusedVector<T> q;
+    FusedVector<T> x;
+    FusedVector<T> r;
+    FusedVector<T> z;
+
+    MUDA_GENERIC T operator()(int i) const
+    {
+        T a  = alpha.get();
+        x(i) = x(i) + a * p(i);
+        r(i) = r(i) - a * q(i);
+        // z may alias r, read it after the update
+        return r(i) * z(i);
+    }
+};
+}  // namespace muda::details::linear_system
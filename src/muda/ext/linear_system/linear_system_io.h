@@ -0,0 +1,222 @@
+/*****************************************************************/ /**
+ * \file   linear_system_io.h
+ * \brief  Matrix Market and binary readers/writers for the sparse
+ * matrices and dense vectors of the linear system extension.
+ *
+ * Not included by <muda/ext/linear_system.h>: the file mapping needs the OS
+ * headers (<windows.h>, <sys/mman.h>), so only IO users include this file.
+ *********************************************************************/
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <muda/launch/event.h>
+#include <muda/launch/streaming_for.h>
+#include <muda/ext/linear_system/device_triplet_matrix.h>
+#include <muda/ext/linear_system/device_csr_matrix.h>
+#include <muda/ext/linear_system/device_bsr_matrix.h>
+#include <muda/ext/linear_system/device_dense_vector.h>
+
+namespace muda
+{
+enum class MatrixMarketFormat
+{
+    // `row col value` per line, 1-based
+    Coordinate = 0,
+    // one value per line, column major
+    Array = 1,
+};
+
+enum class MatrixMarketField
+{
+    Real    = 0,
+    Integer = 1,
+    // no value, every entry is 1
+    Pattern = 2,
+};
+
+enum class MatrixMarketSymmetry
+{
+    General = 0,
+    // only the lower triangle is stored
+    Symmetric = 1,
+    // only the strict lower triangle is stored, a(j, i) = -a(i, j)
+    SkewSymmetric = 2,
+};
+
+class MatrixMarketInfo
+{
+  public:
+    MatrixMarketFormat   format   = MatrixMarketFormat::Coordinate;
+    MatrixMarketField    field    = MatrixMarketField::Real;
+    MatrixMarketSymmetry symmetry = MatrixMarketSymmetry::General;
+    int                  rows     = 0;
+    int                  cols     = 0;
+    // the data lines of the file, before the symmetric part is expanded
+    int64_t entries = 0;
+};
+
+namespace details::linear_system_io
+{
+    // a read only memory map of a whole file
+    class MappedFile
+    {
+        const char* m_data = nullptr;
+        size_t      m_size = 0;
+#ifdef MUDA_PLATFORM_WINDOWS
+        void* m_file    = nullptr;
+        void* m_mapping = nullptr;
+#endif
+
+      public:
+        explicit MappedFile(std::string_view path);
+        MappedFile(const MappedFile&)            = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        ~MappedFile();
+
+        const char* data() const { return m_data; }
+        size_t      size() const { return m_size; }
+    };
+
+    // the header of the binary format, followed by the row offsets, the
+    // column indices and the values, each section aligned to `BinaryAlignment`
+    class BinaryHeader
+    {
+      public:
+        char     magic[8];
+        uint32_t version;
+        uint32_t value_bytes;
+        uint32_t block_dim;
+        uint32_t reserved;
+        int64_t  rows;
+        int64_t  cols;
+        int64_t  non_zeros;
+    };
+
+    class Staging
+    {
+      public:
+        std::array<streaming::PinnedBuffer, 2> buffers;
+        std::array<Event, 2>                   copied;
+    };
+}  // namespace details::linear_system_io
+
+/**
+ * \class LinearSystemIO
+ *
+ * \brief Load and save sparse systems, e.g. to reproduce a customer system
+ * or to drive a solver benchmark from a saved one.
+ *
+ * \details
+ * Matrix Market files are memory mapped and parsed in line aligned chunks on
+ * `HostThreadPool::global()`. Coordinate matrices (real, integer or pattern;
+ * general, symmetric or skew-symmetric) are returned as 0-based triplets with
+ * the symmetric part expanded, array files with one column as dense vectors.
+ * The writers format the lines in parallel, values are written with full
+ * precision so a saved system reloads bit-exact.
+ *
+ * The binary format stores a CSR/BSR matrix as is (header, row offsets,
+ * column indices, values). It is memory mapped as well and uploaded through
+ * two pinned staging buffers, the copy of one overlapping the fill of the other.
+ *
+ * \code
+ *  LinearSystemIO io;
+ *  DeviceTripletMatrix<float, 3> A;
+ *  io.read_mtx("hessian.mtx", A);
+ *  ctx.convert(A, A_bcoo);
+ *  ctx.convert(A_bcoo, A_bsr);
+ *  io.write_binary("hessian.bin", A_bsr);
+ *  // later, straight into the BSR buffers
+ *  io.read_binary("hessian.bin", A_bsr);
+ * \endcode
+ */
+class LinearSystemIO
+{
+    cudaStream_t m_stream;
+    // created on the first binary read
+    std::unique_ptr<details::linear_system_io::Staging> m_staging;
+
+  public:
+    LinearSystemIO(cudaStream_t stream = nullptr)
+        : m_stream(stream)
+    {
+    }
+
+    /***********************************************************************************************
+                                            Matrix Market
+    ***********************************************************************************************/
+    // a coordinate file as 0-based host triplets, the symmetric part expanded
+    template <typename T>
+    MatrixMarketInfo read_mtx(std::string_view  path,
+                              std::vector<int>& row_indices,
+                              std::vector<int>& col_indices,
+                              std::vector<T>&   values);
+    template <typename T>
+    MatrixMarketInfo read_mtx(std::string_view path, DeviceTripletMatrix<T, 1>& A);
+    // the scalar entries are gathered into one block triplet per (row / N, col / N),
+    // the size must be a multiple of N
+    template <typename T, int N>
+    MatrixMarketInfo read_mtx(std::string_view path, DeviceTripletMatrix<T, N>& A);
+    // an array file with a single column
+    template <typename T>
+    MatrixMarketInfo read_mtx(std::string_view path, DeviceDenseVector<T>& b);
+
+    // coordinate real general, from 0-based host triplets
+    template <typename T>
+    void write_mtx(std::string_view        path,
+                   int                     rows,
+                   int                     cols,
+                   const std::vector<int>& row_indices,
+                   const std::vector<int>& col_indices,
+                   const std::vector<T>&   values);
+    template <typename T>
+    void write_mtx(std::string_view path, const DeviceCSRMatrix<T>& A);
+    // the blocks expanded to scalar entries
+    template <typename T, int N>
+    void write_mtx(std::string_view path, const DeviceBSRMatrix<T, N>& A);
+    // array real general, a single column
+    template <typename T>
+    void write_mtx(std::string_view path, const DeviceDenseVector<T>& b);
+
+    /***********************************************************************************************
+                                               Binary
+    ***********************************************************************************************/
+    template <typename T>
+    void write_binary(std::string_view path, const DeviceCSRMatrix<T>& A);
+    template <typename T, int N>
+    void write_binary(std::string_view path, const DeviceBSRMatrix<T, N>& A);
+    // the value type and block size must match the file
+    template <typename T>
+    void read_binary(std::string_view path, DeviceCSRMatrix<T>& A);
+    template <typename T, int N>
+    void read_binary(std::string_view path, DeviceBSRMatrix<T, N>& A);
+
+  private:
+    // parse the banner and the size line, `body` is set to the first data line
+    MatrixMarketInfo read_mtx_header(std::string_view                             path,
+                                     const details::linear_system_io::MappedFile& file,
+                                     const char*&                                 body);
+    template <typename T>
+    void write_binary(std::string_view path,
+                      int              rows,
+                      int              cols,
+                      int              block_dim,
+                      const int*       row_offsets,
+                      const int*       col_indices,
+                      const T*         values,
+                      int64_t          non_zeros);
+    // check the header against the file size, the value type and the block size
+    details::linear_system_io::BinaryHeader read_binary_header(std::string_view path,
+                                                               const details::linear_system_io::MappedFile& file,
+                                                               size_t value_bytes,
+                                                               int    block_dim);
+    // host -> device through the pinned staging buffers, synchronous
+    void upload(const void* src, size_t bytes, void* dst);
+};
+}  // namespace muda
+
+#include "details/linear_system_io.inl"
@@ -0,0 +1,226 @@
+#pragma once
+#include <algorithm>
+#include <vector>
+#include <Eigen/Core>
+#include <muda/buffer/device_buffer.h>
+
+namespace muda
+{
+class LinearSystemContext;
+
+/**
+ * \class LinearSystemPermutation
+ *
+ * \brief A symmetric reordering of the (block) rows and columns of a matrix,
+ * from `LinearSystemContext::rcm()` or `LinearSystemContext::morton()`.
+ *
+ * `perm()[new] = old` and `inverse()[old] = new`. Apply it with
+ * `LinearSystemContext::permute()` to matrices (P * A * P^T) and vectors,
+ * and with `FieldEntryLaunch().gather(dst, src, P.perm())` to field entries.
+ */
+class LinearSystemPermutation
+{
+    friend class LinearSystemContext;
+
+    DeviceBuffer<int> m_perm;
+    DeviceBuffer<int> m_inverse;
+
+  public:
+    LinearSystemPermutation() = default;
+
+    // from a host permutation, perm[new] = old
+    explicit LinearSystemPermutation(const std::vector<int>& perm) { copy_from(perm); }
+
+    void copy_from(const std::vector<int>& perm)
+    {
+        std::vector<int> inverse(perm.size());
+        for(int i = 0; i < static_cast<int>(perm.size()); ++i)
+            inverse[perm[i]] = i;
+        m_perm    = perm;
+        m_inverse = inverse;
+    }
+
+    void copy_to(std::vector<int>& perm) const { m_perm.copy_to(perm); }
+
+    auto size() const { return static_cast<int>(m_perm.size()); }
+    auto perm() const { return m_perm.view(); }
+    auto inverse() const { return m_inverse.view(); }
+};
+
+namespace details::linear_system
+{
+    // the symmetrized adjacency (A + A^T, without the diagonal) of a square sparse pattern
+    MUDA_INLINE void symmetric_adjacency(int                     n,
+                                         const std::vector<int>& row_offsets,
+                                         const std::vector<int>& col_indices,
+                                         std::vector<int>&       adj_offsets,
+                                         std::vector<int>&       adj)
+    {
+        std::vector<std::vector<int>> lists(n);
+        for(int i = 0; i < n; ++i)
+            for(int e = row_offsets[i]; e < row_offsets[i + 1]; ++e)
+            {
+                int j = col_indices[e];
+                if(i == j)
+                    continue;
+                lists[i].push_back(j);
+                lists[j].push_back(i);
+            }
+
+        adj_offsets.assign(n + 1, 0);
+        adj.clear();
+        for(int i = 0; i < n; ++i)
+        {
+            auto& l = lists[i];
+            std::sort(l.begin(), l.end());
+            l.erase(std::unique(l.begin(), l.end()), l.end());
+            adj.insert(adj.end(), l.begin(), l.end());
+            adj_offsets[i + 1] = static_cast<int>(adj.size());
+        }
+    }
+
+    /*
+    **************************************************************************
+    * Reverse Cuthill-McKee                                                  *
+    **************************************************************************
+    * Every connected component is numbered by a breadth first search from a *
+    * pseudo-peripheral node (George-Liu), visiting the neighbours of a node *
+    * by increasing degree. The whole order is reversed at the end.          *
+    * The search is sequential, it runs on the host for both contexts.       *
+    **************************************************************************
+    */
+
+    // breadth first search from `root`, appends the visited nodes to `order`
+    // (the neighbours of a node by increasing degree), returns the number of
+    // levels, `last_level` is where the last one starts in `order`
+    MUDA_INLINE int rcm_bfs(int                     root,
+                            const std::vector<int>& adj_offsets,
+                            const std::vector<int>& adj,
+                            const std::vector<int>& degree,
+                            std::vector<char>&      visited,
+                            std::vector<int>&       order,
+                            size_t&                 last_level)
+    {
+        std::vector<int> neighbours;
+        size_t           level_begin = order.size();
+        order.push_back(root);
+        visited[root]    = 1;
+        size_t level_end = order.size();
+
+        int levels = 0;
+        while(level_begin < level_end)
+        {
+            ++levels;
+            last_level = level_begin;
+            for(size_t h = level_begin; h < level_end; ++h)
+            {
+                int node = order[h];
+                neighbours.clear();
+                for(int e = adj_offsets[node]; e < adj_offsets[node + 1]; ++e)
+                    if(!visited[adj[e]])
+                    {
+                        visited[adj[e]] = 1;
+                        neighbours.push_back(adj[e]);
+                    }
+                std::stable_sort(neighbours.begin(),
+                                 neighbours.end(),
+                                 [&](int a, int b) { return degree[a] < degree[b]; });
+                order.insert(order.end(), neighbours.begin(), neighbours.end());
+            }
+            level_begin = level_end;
+            level_end   = order.size();
+        }
+        return levels;
+    }
+
+    // perm[new] = old
+    MUDA_INLINE void rcm_order(int                     n,
+                               const std::vector<int>& row_offsets,
+                               const std::vector<int>& col_indices,
+                               std::vector<int>&       perm)
+    {
+        std::vector<int> adj_offsets, adj;
+        symmetric_adjacency(n, row_offsets, col_indices, adj_offsets, adj);
+
+        std::vector<int> degree(n);
+        for(int i = 0; i < n; ++i)
+            degree[i] = adj_offsets[i + 1] - adj_offsets[i];
+
+        // components are started from their lowest degree node
+        std::vector<int> by_degree(n);
+        for(int i = 0; i < n; ++i)
+            by_degree[i] = i;
+        std::stable_sort(by_degree.begin(),
+                         by_degree.end(),
+                         [&](int a, int b) { return degree[a] < degree[b]; });
+
+        perm.clear();
+        perm.reserve(n);
+        std::vector<char> visited(n, 0);
+        std::vector<char> probe_visited(n, 0);
+        std::vector<int>  probe;
+        size_t            last_level = 0;
+
+        for(int start : by_degree)
+        {
+            if(visited[start])
+                continue;
+
+            // pseudo-peripheral root: move to the lowest degree node of the
+            // last level as long as that deepens the level structure
+            int root   = start;
+            int levels = 0;
+            while(true)
+            {
+                probe.clear();
+                int l = rcm_bfs(root, adj_offsets, adj, degree, probe_visited, probe, last_level);
+                for(int v : probe)
+                    probe_visited[v] = 0;
+                if(l <= levels)
+                    break;
+                levels = l;
+
+                int best = probe[last_level];
+                for(size_t k = last_level; k < probe.size(); ++k)
+                    if(degree[probe[k]] < degree[best])
+                        best = probe[k];
+                if(best == root)
+                    break;
+                root = best;
+            }
+
+            rcm_bfs(root, adj_offsets, adj, degree, visited, perm, last_level);
+        }
+        std::reverse(perm.begin(), perm.end());
+    }
+
+    // 21 bits per axis, `p` is mapped into the box [lo, hi]
+    template <typename T>
+    MUDA_INLINE MUDA_GENERIC unsigned long long morton_code(const Eigen::Vector3<T>& p,
+                                                            const Eigen::Vector3<T>& lo,
+                                                            const Eigen::Vector3<T>& hi)
+    {
+        auto spread = [](unsigned long long v)
+        {
+            v &= 0x1fffff;
+            v = (v | v << 32) & 0x1f00000000ffffull;
+            v = (v | v << 16) & 0x1f0000ff0000ffull;
+            v = (v | v << 8) & 0x100f00f00f00f00full;
+            v = (v | v << 4) & 0x10c30c30c30c30c3ull;
+            v = (v | v << 2) & 0x1249249249249249ull;
+            return v;
+        };
+
+        unsigned long long code = 0;
+        for(int k = 0; k < 3; ++k)
+        {
+            T extent = hi(k) - lo(k);
+            T t      = extent > T(0) ? (p(k) - lo(k)) / extent : T(0);
+            t        = t < T(0) ? T(0) : (t > T(1) ? T(1) : t);
+            auto q   = static_cast<unsigned long long>(t * T(0x1fffff));
+            code |= spread(q) << k;
+        }
+        return code;
+    }
+}  // namespace details::linear_system
+}  // namespace muda
@@ -0,0 +1,63 @@
+#pragma once
+#include <muda/buffer/device_buffer.h>
+
+namespace muda
+{
+class LinearSystemContext;
+
+/**
+ * \class LinearSystemSpGEMMPlan
+ *
+ * \brief The symbolic result of a sparse-sparse product C = A * B.
+ *
+ * Built by `LinearSystemContext::spgemm_symbolic()`, it keeps, for every non-zero of C,
+ * the list of (A entry, B entry) pairs contributing to it. `LinearSystemContext::spgemm_numeric()`
+ * then only recomputes the values of C, as long as the structures of A and B stay the same.
+ *
+ * The plan only stores indices, so it works for CSR and BSR matrices of any value type.
+ * Memory cost is O(number of scalar/block products).
+ */
+class LinearSystemSpGEMMPlan
+{
+    friend class LinearSystemContext;
+
+    int m_rows       = 0;  // rows of A
+    int m_inner      = 0;  // cols of A == rows of B
+    int m_cols       = 0;  // cols of B
+    int m_A_nnz      = 0;
+    int m_B_nnz      = 0;
+    int m_block_size = 0;  // 1 for CSR, N for BSR
+
+    // products of C's i-th non-zero are [m_pair_offsets[i], m_pair_offsets[i+1])
+    DeviceBuffer<int> m_pair_offsets;
+    DeviceBuffer<int> m_pair_A;
+    DeviceBuffer<int> m_pair_B;
+
+    // symbolic-phase scratch, kept to avoid reallocation on re-planning
+    DeviceBuffer<int>                m_A_rows;
+    DeviceBuffer<int>                m_product_offsets;
+    DeviceBuffer<unsigned long long> m_keys;
+    DeviceBuffer<unsigned long long> m_sorted_keys;
+    DeviceBuffer<int>                m_product_ids;
+    DeviceBuffer<int>                m_sorted_product_ids;
+    DeviceBuffer<unsigned long long> m_unique_keys;
+    DeviceBuffer<int>                m_unique_counts;
+
+  public:
+    auto rows() const { return m_rows; }
+    auto cols() const { return m_cols; }
+    // non-zeros (blocks for BSR) of C
+    auto non_zeros() const
+    {
+        return m_pair_offsets.size() == 0 ? 0 : (int)m_pair_offsets.size() - 1;
+    }
+    // total count of scalar/block products to compute C
+    auto products() const { return (int)m_pair_A.size(); }
+    bool empty() const { return m_block_size == 0; }
+
+    void clear()
+    {
+        *this = LinearSystemSpGEMMPlan{};
+    }
+};
+}  // namespace muda
@@ -84,7 +84,7 @@ class TripletMatrixViewerBase : public ViewerBase<IsConst>
         , m_block_col_indices(block_col_indices)
         , m_block_values(block_values)
     {
-        MUDA_KERNEL_ASSERT(triplet_index_offset + triplet_count <= total_triplet_count,
+        MUDA_VIEWER_ASSERT(triplet_index_offset + triplet_count <= total_triplet_count,
                            "TripletMatrixViewer [%s:%s]: out of range, m_total_triplet_count=%d, "
                            "your triplet_index_offset=%d, triplet_count=%d",
                            this->name(),
@@ -93,14 +93,14 @@ class TripletMatrixViewerBase : public ViewerBase<IsConst>
                            triplet_index_offset,
                            triplet_count);
 
-        MUDA_KERNEL_ASSERT(submatrix_offset.x >= 0 && submatrix_offset.y >= 0,
+        MUDA_VIEWER_ASSERT(submatrix_offset.x >= 0 && submatrix_offset.y >= 0,
                            "TripletMatrixViewer[%s:%s]: submatrix_offset is out of range, submatrix_offset.x=%d, submatrix_offset.y=%d",
                            this->name(),
                            this->kernel_name(),
                            submatrix_offset.x,
                            submatrix_offset.y);
 
-        MUDA_KERNEL_ASSERT(submatrix_offset.x + submatrix_extent.x <= total_block_rows,
+        MUDA_VIEWER_ASSERT(submatrix_offset.x + submatrix_extent.x <= total_block_rows,
                            "TripletMatrixViewer[%s:%s]: submatrix is out of range, submatrix_offset.x=%d, submatrix_extent.x=%d, total_block_rows=%d",
                            this->name(),
                            this->kernel_name(),
@@ -108,7 +108,7 @@ class TripletMatrixViewerBase : public ViewerBase<IsConst>
                            submatrix_extent.x,
                            total_block_rows);
 
-        MUDA_KERNEL_ASSERT(submatrix_offset.y + submatrix_extent.y <= total_block_cols,
+        MUDA_VIEWER_ASSERT(submatrix_offset.y + submatrix_extent.y <= total_block_cols,
                            "TripletMatrixViewer[%s:%s]: submatrix is out of range, submatrix_offset.y=%d, submatrix_extent.y=%d, total_block_cols=%d",
                            this->name(),
                            this->kernel_name(),
@@ -170,7 +170,7 @@ class TripletMatrixViewerBase : public ViewerBase<IsConst>
     MUDA_INLINE MUDA_GENERIC int get_index(int i) const noexcept
     {
 
-        MUDA_KERNEL_ASSERT(i >= 0 && i < m_triplet_count,
+        MUDA_VIEWER_ASSERT(i >= 0 && i < m_triplet_count,
                            "TripletMatrixViewer [%s:%s]: triplet_index out of range, block_count=%d, your index=%d",
                            this->name(),
                            this->kernel_name(),
@@ -182,14 +182,14 @@ class TripletMatrixViewerBase : public ViewerBase<IsConst>
 
     MUDA_INLINE MUDA_GENERIC void check_in_submatrix(int i, int j) const noexcept
     {
-        MUDA_KERNEL_ASSERT(i >= 0 && i < m_submatrix_extent.x,
+        MUDA_VIEWER_ASSERT(i >= 0 && i < m_submatrix_extent.x,
                            "TripletMatrixViewer [%s:%s]: row index out of submatrix range,  submatrix_extent.x=%d, your i=%d",
                            this->name(),
                            this->kernel_name(),
                            m_submatrix_extent.x,
                            i);
 
-        MUDA_KERNEL_ASSERT(j >= 0 && j < m_submatrix_extent.y,
+        MUDA_VIEWER_ASSERT(j >= 0 && j < m_submatrix_extent.y,
                            "TripletMatrixViewer [%s:%s]: col index out of submatrix range,  submatrix_extent.y=%d, your j=%d",
                            this->name(),
                            this->kernel_name(),
@@ -347,7 +347,7 @@ class TripletMatrixViewerBase<IsConst, T, 1> : public ViewerBase<IsConst>
         , m_col_indices(col_indices)
         , m_values(values)
     {
-        MUDA_KERNEL_ASSERT(triplet_index_offset + triplet_count <= total_triplet_count,
+        MUDA_VIEWER_ASSERT(triplet_index_offset + triplet_count <= total_triplet_count,
                            "TripletMatrixViewer [%s:%s]: out of range, m_total_triplet_count=%d, "
                            "your triplet_index_offset=%d, triplet_count=%d",
                            this->name(),
@@ -356,14 +356,14 @@ class TripletMatrixViewerBase<IsConst, T, 1> : public ViewerBase<IsConst>
                            triplet_index_offset,
                            triplet_count);
 
-        MUDA_KERNEL_ASSERT(submatrix_offset.x >= 0 && submatrix_offset.y >= 0,
+        MUDA_VIEWER_ASSERT(submatrix_offset.x >= 0 && submatrix_offset.y >= 0,
                            "TripletMatrixViewer [%s:%s]: submatrix_offset is out of range, submatrix_offset.x=%d, submatrix_offset.y=%d",
                            this->name(),
                            this->kernel_name(),
                            submatrix_offset.x,
                            submatrix_offset.y);
 
-        MUDA_KERNEL_ASSERT(submatrix_offset.x + submatrix_extent.x <= total_rows,
+        MUDA_VIEWER_ASSERT(submatrix_offset.x + submatrix_extent.x <= total_rows,
                            "TripletMatrixViewer [%s:%s]: submatrix is out of range, submatrix_offset.x=%d, submatrix_extent.x=%d, rows=%d",
                            this->name(),
                            this->kernel_name(),
@@ -371,7 +371,7 @@ class TripletMatrixViewerBase<IsConst, T, 1> : public ViewerBase<IsConst>
                            submatrix_extent.x,
                            total_rows);
 
-        MUDA_KERNEL_ASSERT(submatrix_offset.y + submatrix_extent.y <= total_cols,
+        MUDA_VIEWER_ASSERT(submatrix_offset.y + submatrix_extent.y <= total_cols,
                            "TripletMatrixViewer [%s:%s]: submatrix is out of range, submatrix_offset.y=%d, submatrix_extent.y=%d, cols=%d",
                            this->name(),
                            this->kernel_name(),
@@ -426,7 +426,7 @@ class TripletMatrixViewerBase<IsConst, T, 1> : public ViewerBase<IsConst>
     MUDA_INLINE MUDA_GENERIC int get_index(int i) const noexcept
     {
 
-        MUDA_KERNEL_ASSERT(i >= 0 && i < m_triplet_count,
+        MUDA_VIEWER_ASSERT(i >= 0 && i < m_triplet_count,
                            "TripletMatrixViewer [%s:%s]: triplet_index out of range, block_count=%d, your index=%d",
                            this->name(),
                            this->kernel_name(),
@@ -438,14 +438,14 @@ class TripletMatrixViewerBase<IsConst, T, 1> : public ViewerBase<IsConst>
 
     MUDA_INLINE MUDA_GENERIC void check_in_submatrix(int i, int j) const noexcept
     {
-        MUDA_KERNEL_ASSERT(i >= 0 && i < m_submatrix_extent.x,
+        MUDA_VIEWER_ASSERT(i >= 0 && i < m_submatrix_extent.x,
                            "TripletMatrixViewer [%s:%s]: row index out of submatrix range, submatrix_extent.x=%d, yours=%d",
                            this->name(),
                            this->kernel_name(),
                            m_submatrix_extent.x,
                            i);
 
-        MUDA_KERNEL_ASSERT(j >= 0 && j < m_submatrix_extent.y,
+        MUDA_VIEWER_ASSERT(j >= 0 && j < m_submatrix_extent.y,
                            "TripletMatrixViewer [%s:%s]: col index out of submatrix range, submatrix_extent.y=%d, yours=%d",
                            this->name(),
                            this->kernel_name(),
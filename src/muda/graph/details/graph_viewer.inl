@@ -27,6 +27,11 @@ MUDA_INLINE MUDA_GENERIC void GraphViewer::launch(cudaStream_t stream) const
         __CUDACC_VER_MINOR__);
 #endif
 #endif
+#if defined(__CUDA_ARCH__) && !defined(__CUDACC_RDC__)
+    MUDA_KERNEL_ERROR_WITH_LOCATION("GraphViewer[%s:%s]: graph launch on device needs -rdc=true (MUDA_WITH_RDC)",
+                                    kernel_name(),
+                                    name());
+#else
     auto graph_viewer_error_code = cudaGraphLaunch(m_graph, stream);
     if(graph_viewer_error_code != cudaSuccess)
     {
@@ -38,6 +43,7 @@ MUDA_INLINE MUDA_GENERIC void GraphViewer::launch(cudaStream_t stream) const
                                         (int)graph_viewer_error_code,
                                         m_graph);
     }
+#endif
 }
 
 MUDA_INLINE MUDA_DEVICE void GraphViewer::tail_launch() const
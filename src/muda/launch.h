@@ -3,6 +3,9 @@
 #include <muda/launch/event.h>
 #include <muda/launch/launch.h>
 #include <muda/launch/parallel_for.h>
+#include <muda/launch/persistent_launch.h>
+#include <muda/launch/spawn_launch.h>
+#include <muda/launch/streaming_for.h>
 #include <muda/launch/memory.h>
 #include <muda/launch/host_call.h>
 #include <muda/launch/kernel.h>
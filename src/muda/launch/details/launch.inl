@@ -78,6 +78,7 @@ template <typename F, typename UserTag>
 MUDA_INLINE MUDA_HOST auto Launch::as_node_parms(F&& f) -> S<NodeParms<F>>
 {
     check_input();
+    details::LaunchInfoCache::prepare_launch();
 
     using CallableType = raw_type_t<F>;
     auto parms = std::make_shared<NodeParms<F>>(std::forward<F>(f), dim3{0});
@@ -103,6 +104,7 @@ MUDA_INLINE MUDA_HOST auto Launch::as_node_parms(const dim3& active_dim, F&& f)
     -> S<NodeParms<F>>
 {
     check_input_with_range();
+    details::LaunchInfoCache::prepare_launch();
 
     auto grid_dim = calculate_grid_dim(active_dim);
 
@@ -129,6 +131,7 @@ template <typename F, typename UserTag>
 MUDA_HOST void Launch::invoke(F&& f)
 {
     check_input();
+    details::LaunchInfoCache::prepare_launch();
 
     using CallableType = raw_type_t<F>;
     auto callable = details::LaunchCallable<CallableType>{std::forward<F>(f), dim3{0}};
@@ -140,6 +143,7 @@ template <typename F, typename UserTag>
 MUDA_HOST void Launch::invoke(const dim3& active_dim, F&& f)
 {
     check_input_with_range();
+    details::LaunchInfoCache::prepare_launch();
 
     dim3 grid_dim = calculate_grid_dim(active_dim);
 
@@ -134,21 +134,27 @@ MUDA_INLINE void LaunchCore::wait(const ComputeGraphVar<cudaEvent_t>& e,
 
 MUDA_INLINE void LaunchCore::kernel_name(std::string_view name)
 {
-    if constexpr(muda::RUNTIME_CHECK_ON)
+    if constexpr(muda::CHECK_INFO_ON)
+        details::LaunchInfoCache::current_kernel_name(name);
+}
+
+MUDA_INLINE void LaunchCore::kernel_name(const InternedName& name)
+{
+    if constexpr(muda::CHECK_INFO_ON)
         details::LaunchInfoCache::current_kernel_name(name);
 }
 
 MUDA_INLINE std::string_view muda::LaunchCore::kernel_name()
 {
-    if constexpr(muda::RUNTIME_CHECK_ON)
-        return details::LaunchInfoCache::current_kernel_name().host_string;
+    if constexpr(muda::CHECK_INFO_ON)
+        return details::LaunchInfoCache::current_kernel_name().view();
     else
         return "";
 }
 
 MUDA_INLINE MUDA_HOST void LaunchCore::pop_kernel_name()
 {
-#if MUDA_CHECK_ON
+#if MUDA_CHECK_INFO_ON
     details::LaunchInfoCache::current_kernel_name("");
 #endif
 }
@@ -303,6 +309,21 @@ T& LaunchBase<T>::kernel_name(std::string_view name)
     return derived();
 }
 
+template <typename T>
+T& LaunchBase<T>::kernel_name(const InternedName& name)
+{
+    LaunchCore::kernel_name(name);
+    return derived();
+}
+
+template <typename T>
+template <typename UserTag>
+T& LaunchBase<T>::kernel_name(Tag<UserTag>)
+{
+    LaunchCore::kernel_name(details::tag_kernel_name<UserTag>());
+    return derived();
+}
+
 template <typename T>
 T& LaunchBase<T>::pop_kernel_name()
 {
@@ -129,6 +129,8 @@ MUDA_HOST MUDA_NODISCARD auto ParallelFor::as_node_parms(int count, F&& f)
 
     check_input(count);
 
+    details::LaunchInfoCache::prepare_launch();
+
     auto parms = std::make_shared<NodeParms<F>>(std::forward<F>(f), count);
     if(m_grid_dim <= 0)  // dynamic grid dim
     {
@@ -165,6 +167,8 @@ MUDA_HOST void ParallelFor::invoke(int count, F&& f)
     // check_input(count);
     if(count > 0)
     {
+        details::LaunchInfoCache::prepare_launch();
+
         if(m_grid_dim <= 0)  // parallel for
         {
             // calculate the blocks we need
@@ -0,0 +1,543 @@
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <muda/cuda/cooperative_groups.h>
+#include <muda/cuda/cooperative_groups/reduce.h>
+#include <muda/cuda/cooperative_groups/scan.h>
+#include <muda/launch/memory.h>
+#include <muda/cub/host/host_thread_pool.h>
+#include <muda/type_traits/device_lambda.h>
+#include <muda/exception.h>
+
+namespace muda
+{
+namespace details::parallel_for_fused
+{
+    /*
+    **************************************************************************
+    * Fused map-reduce / map-scan                                            *
+    **************************************************************************
+    * The value f(i) lives in registers only. Blocks reduce (scan) with      *
+    * cooperative groups, then meet in global memory once:                   *
+    * - reduce: one compare-and-swap loop per block into `out`               *
+    * - scan:   decoupled look-back over per-tile aggregates/prefixes        *
+    **************************************************************************
+    */
+
+    constexpr int warp_size             = 32;
+    constexpr int default_block_dim     = 256;
+    constexpr int scan_items_per_thread = 4;
+
+    enum TileFlag : int
+    {
+        TileInvalid   = 0,
+        TileAggregate = 1,
+        TilePrefix    = 2,
+    };
+
+    template <typename T>
+    class TileState
+    {
+      public:
+        int* flags        = nullptr;
+        int* tile_counter = nullptr;
+        T*   aggregates   = nullptr;
+        T*   prefixes     = nullptr;
+    };
+
+    template <typename T, typename Op, typename F>
+    class MapReduceCallable
+    {
+      public:
+        F   callable;
+        Op  op;
+        T*  out;
+        int count;
+    };
+
+    template <typename T, typename Op, typename F>
+    class MapScanCallable
+    {
+      public:
+        F            callable;
+        Op           op;
+        T*           out;
+        int          count;
+        TileState<T> state;
+    };
+
+    // out = op(out, value), atomically
+    template <typename T, typename Op>
+    MUDA_DEVICE void atomic_combine(T* out, const T& value, Op& op)
+    {
+        static_assert(sizeof(T) == 4 || sizeof(T) == 8,
+                      "ParallelFor::reduce merges blocks with atomicCAS, sizeof(T) must be 4 or 8");
+        using Word = std::conditional_t<sizeof(T) == 4, unsigned int, unsigned long long>;
+
+        auto* address = reinterpret_cast<Word*>(out);
+        Word  old     = *reinterpret_cast<volatile Word*>(address);
+        Word  assumed;
+        do
+        {
+            assumed = old;
+            T current;
+            ::memcpy(&current, &assumed, sizeof(T));
+            T    next = op(current, value);
+            Word desired;
+            ::memcpy(&desired, &next, sizeof(T));
+            old = atomicCAS(address, assumed, desired);
+        } while(assumed != old);
+    }
+
+    // bypass L1, the value was written by another block
+    template <typename T>
+    MUDA_DEVICE T load_volatile(const T* ptr)
+    {
+        alignas(T) char buffer[sizeof(T)];
+        auto src = reinterpret_cast<const volatile char*>(ptr);
+        for(size_t i = 0; i < sizeof(T); ++i)
+            buffer[i] = src[i];
+        T value;
+        ::memcpy(&value, buffer, sizeof(T));
+        return value;
+    }
+
+    /**
+     * Reduce `value` over the first `valid_threads` threads of the block,
+     * the result is returned in thread 0. The block dim must be a multiple of 32.
+     */
+    template <typename T, typename Op>
+    MUDA_DEVICE T block_reduce(T value, int valid_threads, Op& op)
+    {
+        namespace cg = cooperative_groups;
+        __shared__ alignas(T) char s_warp_buffer[warp_size * sizeof(T)];
+        T* warp_values = reinterpret_cast<T*>(s_warp_buffer);
+
+        auto block   = cg::this_thread_block();
+        auto warp    = cg::tiled_partition<warp_size>(block);
+        int  rank    = block.thread_rank();
+        int  warp_id = rank / warp_size;
+        int  warps   = (valid_threads + warp_size - 1) / warp_size;
+
+        bool valid  = rank < valid_threads;
+        auto active = cg::binary_partition(warp, valid);
+        if(valid)
+        {
+            value = cg::reduce(active, value, op);
+            if(active.thread_rank() == 0)
+                warp_values[warp_id] = value;
+        }
+        block.sync();
+
+        if(warp_id == 0)
+        {
+            bool lane_valid = rank < warps;
+            auto lanes      = cg::binary_partition(warp, lane_valid);
+            if(lane_valid)
+                value = cg::reduce(lanes, warp_values[rank], op);
+        }
+        return value;
+    }
+
+    /**
+     * Exclusive scan of `value` over the first `valid_threads` threads of the block.
+     * `prefix` is set for the valid threads but thread 0 (`has_prefix`), the block
+     * aggregate is returned to all threads. The block dim must be a multiple of 32.
+     */
+    template <typename T, typename Op>
+    MUDA_DEVICE T block_exclusive_scan(T value, int valid_threads, Op& op, T& prefix, bool& has_prefix)
+    {
+        namespace cg = cooperative_groups;
+        __shared__ alignas(T) char s_warp_buffer[warp_size * sizeof(T)];
+        T* warp_totals = reinterpret_cast<T*>(s_warp_buffer);
+
+        auto block   = cg::this_thread_block();
+        auto warp    = cg::tiled_partition<warp_size>(block);
+        int  rank    = block.thread_rank();
+        int  lane    = warp.thread_rank();
+        int  warp_id = rank / warp_size;
+        int  warps   = (valid_threads + warp_size - 1) / warp_size;
+
+        bool valid     = rank < valid_threads;
+        auto active    = cg::binary_partition(warp, valid);
+        T    inclusive = value;
+        if(valid)
+        {
+            inclusive = cg::inclusive_scan(active, value, op);
+            if(active.thread_rank() == active.num_threads() - 1)
+                warp_totals[warp_id] = inclusive;
+        }
+        T lane_exclusive = warp.shfl_up(inclusive, 1);
+        block.sync();
+
+        if(warp_id == 0)
+        {
+            bool lane_valid = lane < warps;
+            auto lanes      = cg::binary_partition(warp, lane_valid);
+            if(lane_valid)
+                warp_totals[lane] = cg::inclusive_scan(lanes, warp_totals[lane], op);
+        }
+        block.sync();
+
+        has_prefix = false;
+        if(valid)
+        {
+            if(lane > 0)
+            {
+                prefix     = lane_exclusive;
+                has_prefix = true;
+            }
+            if(warp_id > 0)
+            {
+                prefix = has_prefix ? op(warp_totals[warp_id - 1], prefix) :
+                                      warp_totals[warp_id - 1];
+                has_prefix = true;
+            }
+        }
+        return warp_totals[warps - 1];
+    }
+
+    template <typename T, typename Op, typename F, typename UserTag>
+    MUDA_GLOBAL void map_reduce_kernel(MapReduceCallable<T, Op, F> f)
+    {
+        int tid       = blockIdx.x * blockDim.x + threadIdx.x;
+        int grid_size = gridDim.x * blockDim.x;
+
+        // the grid never has more threads than items, but the last block may be partial
+        T value{};
+        if(tid < f.count)
+        {
+            value = f.callable(tid);
+            for(int i = tid + grid_size; i < f.count; i += grid_size)
+                value = f.op(value, f.callable(i));
+        }
+
+        int block_begin   = blockIdx.x * blockDim.x;
+        int valid_threads = min(static_cast<int>(blockDim.x), f.count - block_begin);
+        value             = block_reduce(value, valid_threads, f.op);
+
+        if(threadIdx.x == 0)
+            atomic_combine(f.out, value, f.op);
+    }
+
+    template <typename T, typename Op, typename F, typename UserTag>
+    MUDA_GLOBAL void map_scan_kernel(MapScanCallable<T, Op, F> f)
+    {
+        __shared__ int             s_tile;
+        __shared__ alignas(T) char s_tile_prefix[sizeof(T)];
+
+        auto& state = f.state;
+
+        // tiles are handed out in launch order, so the look-back never waits for
+        // a block that is not resident yet
+        if(threadIdx.x == 0)
+            s_tile = atomicAdd(state.tile_counter, 1);
+        __syncthreads();
+        int tile = s_tile;
+
+        constexpr int N          = scan_items_per_thread;
+        int           tile_items = blockDim.x * N;
+        int           tile_begin = tile * tile_items;
+        int           begin      = tile_begin + threadIdx.x * N;
+        int           n          = max(0, min(N, f.count - begin));
+
+        // 1. scan the items of this thread
+        T items[N];
+#pragma unroll
+        for(int k = 0; k < N; ++k)
+        {
+            if(k < n)
+            {
+                items[k] = f.callable(begin + k);
+                if(k > 0)
+                    items[k] = f.op(items[k - 1], items[k]);
+            }
+        }
+
+        // 2. scan the thread totals of this tile
+        int  valid_threads = min(static_cast<int>(blockDim.x), (f.count - tile_begin + N - 1) / N);
+        T    thread_prefix;
+        bool has_thread_prefix = false;
+        T    aggregate         = block_exclusive_scan(
+            n > 0 ? items[n - 1] : T{}, valid_threads, f.op, thread_prefix, has_thread_prefix);
+
+        // 3. decoupled look-back for the prefix of the previous tiles
+        if(threadIdx.x == 0)
+        {
+            if(tile == 0)
+            {
+                state.prefixes[0] = aggregate;
+                __threadfence();
+                atomicExch(state.flags, TilePrefix);
+            }
+            else
+            {
+                state.aggregates[tile] = aggregate;
+                __threadfence();
+                atomicExch(state.flags + tile, TileAggregate);
+
+                T   exclusive;
+                int p = tile - 1;
+                for(bool first = true;; first = false, --p)
+                {
+                    int flag;
+                    while((flag = *reinterpret_cast<volatile int*>(state.flags + p)) == TileInvalid)
+                        ;
+                    __threadfence();
+
+                    T v = flag == TilePrefix ? load_volatile(state.prefixes + p) :
+                                               load_volatile(state.aggregates + p);
+                    exclusive = first ? v : f.op(v, exclusive);
+                    if(flag == TilePrefix)
+                        break;
+                }
+
+                state.prefixes[tile] = f.op(exclusive, aggregate);
+                __threadfence();
+                atomicExch(state.flags + tile, TilePrefix);
+
+                *reinterpret_cast<T*>(s_tile_prefix) = exclusive;
+            }
+        }
+        __syncthreads();
+
+        // 4. write
+        if(n == 0)
+            return;
+
+        T    prefix     = thread_prefix;
+        bool has_prefix = has_thread_prefix;
+        if(tile > 0)
+        {
+            T tile_prefix = *reinterpret_cast<T*>(s_tile_prefix);
+            prefix        = has_prefix ? f.op(tile_prefix, prefix) : tile_prefix;
+            has_prefix    = true;
+        }
+
+#pragma unroll
+        for(int k = 0; k < N; ++k)
+        {
+            if(k < n)
+                f.out[begin + k] = has_prefix ? f.op(prefix, items[k]) : items[k];
+        }
+    }
+
+    /*
+    **************************************************************************
+    * Host backend                                                           *
+    **************************************************************************
+    */
+
+    constexpr size_t host_grain_size = 4096;
+
+    MUDA_INLINE size_t host_chunk_count(size_t n)
+    {
+        auto by_grain = (n + host_grain_size - 1) / host_grain_size;
+        return std::min(by_grain, HostThreadPool::global().thread_count() * 4);
+    }
+
+    // call f(chunk, begin, end) for every chunk
+    template <typename F>
+    void host_for_each_chunk(size_t n, size_t chunks, F&& f)
+    {
+        HostThreadPool::global().run(chunks,
+                                     [&](size_t c)
+                                     {
+                                         auto b = n * c / chunks;
+                                         auto e = n * (c + 1) / chunks;
+                                         f(c, b, e);
+                                     });
+    }
+
+    template <typename T, typename Op, typename F>
+    T host_map_reduce(int count, T init, Op& op, F& f)
+    {
+        auto           chunks = host_chunk_count(count);
+        std::vector<T> partial(chunks);
+        host_for_each_chunk(count,
+                            chunks,
+                            [&](size_t c, size_t b, size_t e)
+                            {
+                                T acc = f(static_cast<int>(b));
+                                for(size_t i = b + 1; i < e; ++i)
+                                    acc = op(acc, f(static_cast<int>(i)));
+                                partial[c] = acc;
+                            });
+        for(auto& p : partial)
+            init = op(init, p);
+        return init;
+    }
+
+    template <typename T, typename Op, typename F>
+    void host_map_scan(int count, Op& op, F& f, T* out)
+    {
+        // scan each chunk in place, then add the prefix of the previous chunks
+        auto           chunks = host_chunk_count(count);
+        std::vector<T> carry(chunks);
+        host_for_each_chunk(count,
+                            chunks,
+                            [&](size_t c, size_t b, size_t e)
+                            {
+                                T acc  = f(static_cast<int>(b));
+                                out[b] = acc;
+                                for(size_t i = b + 1; i < e; ++i)
+                                {
+                                    acc    = op(acc, f(static_cast<int>(i)));
+                                    out[i] = acc;
+                                }
+                                carry[c] = acc;
+                            });
+
+        for(size_t c = 1; c < chunks; ++c)
+            carry[c] = op(carry[c - 1], carry[c]);
+
+        host_for_each_chunk(count,
+                            chunks,
+                            [&](size_t c, size_t b, size_t e)
+                            {
+                                if(c == 0)
+                                    return;
+                                for(size_t i = b; i < e; ++i)
+                                    out[i] = op(carry[c - 1], out[i]);
+                            });
+    }
+
+    MUDA_INLINE int resident_grid_dim(const void* kernel, int block_dim)
+    {
+        int device = 0, sm_count = 0, blocks_per_sm = 0;
+        checkCudaErrors(cudaGetDevice(&device));
+        checkCudaErrors(cudaDeviceGetAttribute(&sm_count, cudaDevAttrMultiProcessorCount, device));
+        checkCudaErrors(cudaOccupancyMaxActiveBlocksPerMultiprocessor(
+            &blocks_per_sm, kernel, block_dim, 0));
+        return std::max(1, sm_count * blocks_per_sm);
+    }
+
+    template <typename T>
+    class Plus
+    {
+      public:
+        MUDA_GENERIC T operator()(const T& a, const T& b) const { return a + b; }
+    };
+}  // namespace details::parallel_for_fused
+
+template <typename T, typename Op, typename F, typename UserTag>
+MUDA_HOST ParallelFor& ParallelFor::reduce(int count, T init, Op op, F&& f, VarView<T> out)
+{
+    using namespace details::parallel_for_fused;
+    using CallableType = raw_type_t<F>;
+
+    MUDA_ASSERT(count >= 0, "count must be >= 0");
+    MUDA_ASSERT(!ComputeGraphBuilder::is_building(),
+                "ParallelFor::reduce can't be captured by a compute graph");
+
+    if(m_backend == ParallelForBackend::Host)
+    {
+        if constexpr(is_device_lambda_v<CallableType> || is_device_lambda_v<Op>)
+            throw invalid_argument("ParallelFor::reduce: the host backend needs __host__ __device__ callables");
+        else
+            *out.data() = count > 0 ? host_map_reduce(count, init, op, f) : init;
+        pop_kernel_name();
+        return *this;
+    }
+
+    // out = init, then every block merges its partial into it
+    checkCudaErrors(cudaMemcpyAsync(out.data(), &init, sizeof(T), cudaMemcpyHostToDevice, m_stream));
+
+    if(count > 0)
+    {
+        details::LaunchInfoCache::prepare_launch();
+
+        auto kernel    = map_reduce_kernel<T, Op, CallableType, UserTag>;
+        int  block_dim = m_block_dim > 0 ? m_block_dim : default_block_dim;
+        MUDA_ASSERT(block_dim % warp_size == 0, "block dim must be a multiple of 32, yours=%d", block_dim);
+
+        int grid_dim = m_grid_dim > 0 ? m_grid_dim : resident_grid_dim((const void*)kernel, block_dim);
+        // every thread owns at least one item
+        grid_dim = std::min(grid_dim, round_up_blocks(count, block_dim));
+
+        MapReduceCallable<T, Op, CallableType> callable{f, op, out.data(), count};
+        kernel<<<grid_dim, block_dim, 0, m_stream>>>(callable);
+    }
+
+    pop_kernel_name();
+    return *this;
+}
+
+template <typename T, typename Op, typename F, typename UserTag>
+MUDA_HOST ParallelFor& ParallelFor::reduce(int count, T init, Op op, F&& f, VarView<T> out, Tag<UserTag>)
+{
+    return reduce<T, Op, F, UserTag>(count, init, op, std::forward<F>(f), out);
+}
+
+template <typename T, typename Op, typename F, typename UserTag>
+MUDA_HOST ParallelFor& ParallelFor::scan(int count, Op op, F&& f, BufferView<T> out)
+{
+    using namespace details::parallel_for_fused;
+    using CallableType = raw_type_t<F>;
+
+    MUDA_ASSERT(count >= 0, "count must be >= 0");
+    MUDA_ASSERT(out.size() >= static_cast<size_t>(count),
+                "out is too small, out.size()=%d, count=%d",
+                static_cast<int>(out.size()),
+                count);
+    MUDA_ASSERT(!ComputeGraphBuilder::is_building(),
+                "ParallelFor::scan can't be captured by a compute graph");
+
+    if(count == 0)
+    {
+        pop_kernel_name();
+        return *this;
+    }
+
+    if(m_backend == ParallelForBackend::Host)
+    {
+        if constexpr(is_device_lambda_v<CallableType> || is_device_lambda_v<Op>)
+            throw invalid_argument("ParallelFor::scan: the host backend needs __host__ __device__ callables");
+        else
+            host_map_scan(count, op, f, out.data());
+        pop_kernel_name();
+        return *this;
+    }
+
+    details::LaunchInfoCache::prepare_launch();
+
+    int block_dim = m_block_dim > 0 ? m_block_dim : default_block_dim;
+    MUDA_ASSERT(block_dim % warp_size == 0, "block dim must be a multiple of 32, yours=%d", block_dim);
+    int tiles = round_up_blocks(count, block_dim * scan_items_per_thread);
+
+    // [flags | tile counter | aggregates | prefixes]
+    size_t int_bytes = (tiles + 1) * sizeof(int);
+    size_t t_offset  = (int_bytes + alignof(T) - 1) / alignof(T) * alignof(T);
+    size_t bytes     = t_offset + 2 * tiles * sizeof(T);
+
+    std::byte* temp = nullptr;
+    Memory(m_stream).alloc(&temp, bytes).set(temp, int_bytes, 0);
+
+    TileState<T> state;
+    state.flags        = reinterpret_cast<int*>(temp);
+    state.tile_counter = state.flags + tiles;
+    state.aggregates   = reinterpret_cast<T*>(temp + t_offset);
+    state.prefixes     = state.aggregates + tiles;
+
+    MapScanCallable<T, Op, CallableType> callable{f, op, out.data(), count, state};
+    map_scan_kernel<T, Op, CallableType, UserTag><<<tiles, block_dim, 0, m_stream>>>(callable);
+
+    Memory(m_stream).free(temp);
+
+    pop_kernel_name();
+    return *this;
+}
+
+template <typename T, typename Op, typename F, typename UserTag>
+MUDA_HOST ParallelFor& ParallelFor::scan(int count, Op op, F&& f, BufferView<T> out, Tag<UserTag>)
+{
+    return scan<T, Op, F, UserTag>(count, op, std::forward<F>(f), out);
+}
+
+template <typename T, typename F, typename UserTag>
+MUDA_HOST ParallelFor& ParallelFor::scan(int count, F&& f, BufferView<T> out)
+{
+    return scan<T, details::parallel_for_fused::Plus<T>, F, UserTag>(
+        count, details::parallel_for_fused::Plus<T>{}, std::forward<F>(f), out);
+}
+}  // namespace muda
@@ -0,0 +1,158 @@
+namespace muda
+{
+namespace details::parallel_for_segmented
+{
+    /*
+    **************************************************************************
+    * Merge-path decomposition of ragged ranges                              *
+    **************************************************************************
+    * The merge path of A = segment ends (offsets + 1) and B = base, ...,    *
+    * base + total - 1 (base = offsets[0]) has segment_count + total steps.  *
+    * Every thread takes `items_per_thread` consecutive steps: consume the   *
+    * item if it is below the end of the current segment, otherwise move to *
+    * the next segment.                                                      *
+    **************************************************************************
+    */
+
+    constexpr int items_per_thread  = 8;
+    constexpr int default_block_dim = 256;
+
+    template <typename F>
+    class SegmentedCallable
+    {
+      public:
+        F          callable;
+        const int* offsets;
+        int        segment_count;
+        int        total;
+    };
+
+    // the number of segment ends consumed before `diagonal`
+    MUDA_INLINE MUDA_GENERIC int merge_path_search(int        diagonal,
+                                                   const int* segment_ends,
+                                                   int        base,
+                                                   int        segment_count,
+                                                   int        total)
+    {
+        int lo = diagonal > total ? diagonal - total : 0;
+        int hi = diagonal < segment_count ? diagonal : segment_count;
+        while(lo < hi)
+        {
+            int pivot = (lo + hi) / 2;
+            if(segment_ends[pivot] - base <= diagonal - pivot - 1)
+                lo = pivot + 1;
+            else
+                hi = pivot;
+        }
+        return lo;
+    }
+
+    template <typename F>
+    MUDA_GENERIC void invoke_segmented(F& f, int segment, int local_i, int i)
+    {
+        if constexpr(std::is_invocable_v<F, int, int, int>)
+        {
+            f(segment, local_i, i);
+        }
+        else if constexpr(std::is_invocable_v<F, int, int>)
+        {
+            f(segment, local_i);
+        }
+        else
+        {
+            static_assert(always_false_v<F>,
+                          "f must be void (int segment, int local_i) or void (int segment, int local_i, int i)");
+        }
+    }
+
+    template <typename F, typename UserTag>
+    MUDA_GLOBAL void segmented_kernel(SegmentedCallable<F> f)
+    {
+        int path_length  = f.segment_count + f.total;
+        int tid          = blockIdx.x * blockDim.x + threadIdx.x;
+        int diagonal     = min(tid * items_per_thread, path_length);
+        int diagonal_end = min(diagonal + items_per_thread, path_length);
+        if(diagonal >= diagonal_end)
+            return;
+
+        const int* segment_ends = f.offsets + 1;
+        const int  base         = f.offsets[0];
+
+        int segment = merge_path_search(diagonal, segment_ends, base, f.segment_count, f.total);
+        int i       = base + diagonal - segment;
+        int begin   = segment < f.segment_count ? f.offsets[segment] : 0;
+        int end     = segment < f.segment_count ? segment_ends[segment] : 0;
+
+        for(int d = diagonal; d < diagonal_end; ++d)
+        {
+            if(segment < f.segment_count && i < end)
+            {
+                invoke_segmented(f.callable, segment, i - begin, i);
+                ++i;
+            }
+            else
+            {
+                ++segment;
+                begin = end;
+                if(segment < f.segment_count)
+                    end = segment_ends[segment];
+            }
+        }
+    }
+}  // namespace details::parallel_for_segmented
+
+template <typename F, typename UserTag>
+MUDA_HOST ParallelFor& ParallelFor::apply_segmented(CBufferView<int> offsets, F&& f)
+{
+    MUDA_ASSERT(offsets.size() > 0, "offsets must have segment_count + 1 entries");
+
+    int first = 0, last = 0;
+    checkCudaErrors(cudaMemcpyAsync(
+        &first, offsets.data(), sizeof(int), cudaMemcpyDeviceToHost, m_stream));
+    checkCudaErrors(cudaMemcpyAsync(&last,
+                                    offsets.data() + offsets.size() - 1,
+                                    sizeof(int),
+                                    cudaMemcpyDeviceToHost,
+                                    m_stream));
+    checkCudaErrors(cudaStreamSynchronize(m_stream));
+
+    return apply_segmented<F, UserTag>(offsets, last - first, std::forward<F>(f));
+}
+
+template <typename F, typename UserTag>
+MUDA_HOST ParallelFor& ParallelFor::apply_segmented(CBufferView<int> offsets, F&& f, Tag<UserTag>)
+{
+    return apply_segmented<F, UserTag>(offsets, std::forward<F>(f));
+}
+
+template <typename F, typename UserTag>
+MUDA_HOST ParallelFor& ParallelFor::apply_segmented(CBufferView<int> offsets, int total, F&& f)
+{
+    using namespace details::parallel_for_segmented;
+    using CallableType = raw_type_t<F>;
+
+    MUDA_ASSERT(offsets.size() > 0, "offsets must have segment_count + 1 entries");
+    MUDA_ASSERT(total >= 0, "total must be >= 0");
+    MUDA_ASSERT(!ComputeGraphBuilder::is_building(),
+                "ParallelFor::apply_segmented can't be captured by a compute graph");
+
+    int segment_count = static_cast<int>(offsets.size()) - 1;
+    int path_length   = segment_count + total;
+
+    if(path_length > 0)
+    {
+        details::LaunchInfoCache::prepare_launch();
+
+        int block_dim = m_block_dim > 0 ? m_block_dim : default_block_dim;
+        int threads   = (path_length + items_per_thread - 1) / items_per_thread;
+        int grid_dim  = round_up_blocks(threads, block_dim);
+
+        SegmentedCallable<CallableType> callable{f, offsets.data(), segment_count, total};
+        segmented_kernel<CallableType, UserTag>
+            <<<grid_dim, block_dim, m_shared_mem_size, m_stream>>>(callable);
+    }
+
+    pop_kernel_name();
+    return *this;
+}
+}  // namespace muda
@@ -0,0 +1,300 @@
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <muda/cuda/cooperative_groups.h>
+#include <muda/cub/host/host_thread_pool.h>
+#include <muda/exception.h>
+
+namespace muda
+{
+namespace details::persistent
+{
+    /*
+    **************************************************************************
+    * Persistent grid                                                        *
+    **************************************************************************
+    * Every task of a stage is cut into chunks of blockDim.x items. A block  *
+    * pulls the next chunk of the stage with one atomicAdd, finds its task   *
+    * by a binary search over the chunk offsets and runs one item per        *
+    * thread. When the stage is drained the grid meets at `grid.sync()`.     *
+    **************************************************************************
+    */
+
+    template <typename... F>
+    class PersistentCallable
+    {
+      public:
+        CallableList<F...> callables;
+        const Stage*       stages;
+        const TaskChunks*  tasks;
+        // one pull counter per stage, zeroed by the upload
+        int* counters;
+        int  stage_count;
+    };
+
+    // the task holding `chunk`, the last one with chunk_begin <= chunk
+    MUDA_INLINE MUDA_GENERIC int find_task(const TaskChunks* tasks, const Stage& stage, int chunk)
+    {
+        int lo = stage.task_begin;
+        int hi = stage.task_end - 1;
+        while(lo < hi)
+        {
+            int mid = (lo + hi + 1) / 2;
+            if(tasks[mid].chunk_begin <= chunk)
+                lo = mid;
+            else
+                hi = mid - 1;
+        }
+        return lo;
+    }
+
+    // returns the chunk count of the largest stage
+    MUDA_INLINE int layout(const std::vector<Task>& tasks,
+                           const std::vector<int>&  stage_begins,
+                           int                      block_dim,
+                           std::vector<TaskChunks>& out_tasks,
+                           std::vector<Stage>&      out_stages)
+    {
+        out_tasks.clear();
+        out_stages.clear();
+        out_tasks.reserve(tasks.size());
+
+        int max_chunks = 0;
+        for(size_t s = 0; s < stage_begins.size(); ++s)
+        {
+            int begin = stage_begins[s];
+            int end   = s + 1 < stage_begins.size() ? stage_begins[s + 1] :
+                                                      static_cast<int>(tasks.size());
+            if(begin == end)
+                continue;
+
+            int chunks = 0;
+            for(int t = begin; t < end; ++t)
+            {
+                auto& task = tasks[t];
+                out_tasks.push_back({task.callable, task.begin, task.end, chunks});
+                chunks += (task.end - task.begin + block_dim - 1) / block_dim;
+            }
+            out_stages.push_back({begin, end, chunks});
+            max_chunks = std::max(max_chunks, chunks);
+        }
+        return max_chunks;
+    }
+
+    template <typename... F>
+    MUDA_GLOBAL void persistent_kernel(PersistentCallable<F...> c)
+    {
+        __shared__ int s_chunk;
+        __shared__ int s_task;
+
+        auto grid = cooperative_groups::this_grid();
+        for(int s = 0; s < c.stage_count; ++s)
+        {
+            const Stage stage = c.stages[s];
+            while(true)
+            {
+                if(threadIdx.x == 0)
+                {
+                    int chunk = atomicAdd(c.counters + s, 1);
+                    s_chunk   = chunk;
+                    s_task = chunk < stage.chunk_count ? find_task(c.tasks, stage, chunk) : -1;
+                }
+                __syncthreads();
+                int chunk = s_chunk;
+                int t     = s_task;
+                // thread 0 overwrites both in the next round
+                __syncthreads();
+
+                if(t < 0)
+                    break;
+
+                const TaskChunks task = c.tasks[t];
+                int i = task.begin + (chunk - task.chunk_begin) * blockDim.x + threadIdx.x;
+                if(i < task.end)
+                    c.callables.invoke(task.callable, i);
+            }
+            if(s + 1 < c.stage_count)
+                grid.sync();
+        }
+    }
+
+    MUDA_INLINE int resident_block_count(const void* kernel, int block_dim)
+    {
+        int device = 0, sm_count = 0, blocks_per_sm = 0;
+        checkCudaErrors(cudaGetDevice(&device));
+        checkCudaErrors(cudaDeviceGetAttribute(&sm_count, cudaDevAttrMultiProcessorCount, device));
+        checkCudaErrors(cudaOccupancyMaxActiveBlocksPerMultiprocessor(
+            &blocks_per_sm, kernel, block_dim, 0));
+        return std::max(1, sm_count * blocks_per_sm);
+    }
+
+    MUDA_INLINE DeviceBatch::DeviceBatch(DeviceBatch&& other) MUDA_NOEXCEPT
+        : m_data(other.m_data),
+          m_capacity(other.m_capacity)
+    {
+        other.m_data     = nullptr;
+        other.m_capacity = 0;
+    }
+
+    MUDA_INLINE DeviceBatch& DeviceBatch::operator=(DeviceBatch&& other) MUDA_NOEXCEPT
+    {
+        if(this != &other)
+        {
+            std::swap(m_data, other.m_data);
+            std::swap(m_capacity, other.m_capacity);
+        }
+        return *this;
+    }
+
+    MUDA_INLINE DeviceBatch::~DeviceBatch()
+    {
+        if(m_data)
+            checkCudaErrors(cudaFree(m_data));
+    }
+
+    MUDA_INLINE void* DeviceBatch::reserve(size_t bytes)
+    {
+        if(bytes <= m_capacity)
+            return m_data;
+
+        // cudaFree waits for the kernels still reading the old batch
+        if(m_data)
+            checkCudaErrors(cudaFree(m_data));
+        m_capacity = std::max(bytes, m_capacity * 2);
+        checkCudaErrors(cudaMalloc(&m_data, m_capacity));
+        return m_data;
+    }
+}  // namespace details::persistent
+
+template <typename... F>
+PersistentQueue<F...>& PersistentQueue<F...>::push(int callable, int begin, int end)
+{
+    MUDA_ASSERT(callable >= 0 && callable < static_cast<int>(sizeof...(F)),
+                "callable index out of range, callable=%d, callable count=%d",
+                callable,
+                static_cast<int>(sizeof...(F)));
+    MUDA_ASSERT(begin <= end, "begin(%d) > end(%d)", begin, end);
+
+    if(begin < end)
+        m_tasks.push_back({callable, begin, end});
+    return *this;
+}
+
+template <typename... F>
+PersistentQueue<F...>& PersistentQueue<F...>::barrier()
+{
+    // consecutive barriers collapse into one
+    if(m_stage_begins.back() != static_cast<int>(m_tasks.size()))
+        m_stage_begins.push_back(static_cast<int>(m_tasks.size()));
+    return *this;
+}
+
+template <typename... F>
+void PersistentQueue<F...>::clear()
+{
+    m_tasks.clear();
+    m_stage_begins.assign(1, 0);
+}
+
+template <typename... F>
+size_t PersistentQueue<F...>::stage_count() const
+{
+    bool trailing_empty = m_stage_begins.back() == static_cast<int>(m_tasks.size());
+    return m_stage_begins.size() - (trailing_empty ? 1 : 0);
+}
+
+template <typename... F>
+MUDA_HOST PersistentLaunch& PersistentLaunch::apply(PersistentQueue<F...>& queue)
+{
+    using namespace details::persistent;
+
+    MUDA_ASSERT(m_block_dim > 0, "block dim must be > 0, yours=%d", m_block_dim);
+    MUDA_ASSERT(!ComputeGraphBuilder::is_building(),
+                "PersistentLaunch can't be captured by a compute graph");
+
+    std::vector<TaskChunks> tasks;
+    std::vector<Stage>      stages;
+    int max_chunks = layout(queue.m_tasks, queue.m_stage_begins, m_block_dim, tasks, stages);
+
+    if(stages.empty())
+    {
+        pop_kernel_name();
+        return *this;
+    }
+
+    if(m_backend == ParallelForBackend::Host)
+    {
+        if constexpr((is_device_lambda_v<F> || ...))
+            throw invalid_argument("PersistentLaunch: the host backend needs __host__ __device__ callables");
+        else
+            apply_host(queue, tasks, stages);
+        pop_kernel_name();
+        return *this;
+    }
+
+    details::LaunchInfoCache::prepare_launch();
+
+    // [stages | tasks | counters], uploaded with one copy
+    size_t stage_bytes   = stages.size() * sizeof(Stage);
+    size_t task_bytes    = tasks.size() * sizeof(TaskChunks);
+    size_t counter_bytes = stages.size() * sizeof(int);
+
+    std::vector<std::byte> staging(stage_bytes + task_bytes + counter_bytes);
+    std::memcpy(staging.data(), stages.data(), stage_bytes);
+    std::memcpy(staging.data() + stage_bytes, tasks.data(), task_bytes);
+
+    auto device = static_cast<std::byte*>(queue.m_device.reserve(staging.size()));
+    checkCudaErrors(cudaMemcpyAsync(
+        device, staging.data(), staging.size(), cudaMemcpyHostToDevice, m_stream));
+
+    PersistentCallable<F...> callable{queue.m_callables,
+                                      reinterpret_cast<const Stage*>(device),
+                                      reinterpret_cast<const TaskChunks*>(device + stage_bytes),
+                                      reinterpret_cast<int*>(device + stage_bytes + task_bytes),
+                                      static_cast<int>(stages.size())};
+
+    // all blocks must be resident for grid.sync()
+    auto kernel   = persistent_kernel<F...>;
+    int  resident = resident_block_count((const void*)kernel, m_block_dim);
+    int  grid_dim = m_grid_dim > 0 ? std::min(m_grid_dim, resident) : resident;
+    grid_dim      = std::min(grid_dim, max_chunks);
+
+    void* args[] = {&callable};
+    checkCudaErrors(cudaLaunchCooperativeKernel(
+        (const void*)kernel, grid_dim, m_block_dim, args, 0, m_stream));
+
+    pop_kernel_name();
+    return *this;
+}
+
+template <typename... F>
+MUDA_HOST void PersistentLaunch::apply_host(PersistentQueue<F...>& queue,
+                                            const std::vector<details::persistent::TaskChunks>& tasks,
+                                            const std::vector<details::persistent::Stage>& stages)
+{
+    using namespace details::persistent;
+
+    // one worker per emulated block, returning from run() is the grid barrier
+    auto& pool    = HostThreadPool::global();
+    int   workers = m_grid_dim > 0 ? m_grid_dim : static_cast<int>(pool.thread_count());
+
+    for(auto& stage : stages)
+    {
+        std::atomic<int> next{0};
+        pool.run(workers,
+                 [&](size_t)
+                 {
+                     // like the kernel parameter, every block has its own copy
+                     auto callables = queue.m_callables;
+                     for(int chunk = next++; chunk < stage.chunk_count; chunk = next++)
+                     {
+                         auto& task  = tasks[find_task(tasks.data(), stage, chunk)];
+                         int   first = task.begin + (chunk - task.chunk_begin) * m_block_dim;
+                         int   last  = std::min(first + m_block_dim, task.end);
+                         for(int i = first; i < last; ++i)
+                             callables.invoke(task.callable, i);
+                     }
+                 });
+    }
+}
+}  // namespace muda
@@ -0,0 +1,216 @@
+#include <algorithm>
+#include <muda/cuda/cooperative_groups.h>
+
+namespace muda
+{
+namespace details::spawn
+{
+    /*
+    **************************************************************************
+    * Waves                                                                  *
+    **************************************************************************
+    * Wave w reads the items of buffer w % 2 (count in counts[w % 3]) and    *
+    * spawns into buffer (w + 1) % 2 (count in counts[(w + 1) % 3]). The     *
+    * third count is the one of wave w - 1, reset during wave w so that      *
+    * wave w + 1 spawns from zero. Waves are separated by `grid.sync()`.     *
+    **************************************************************************
+    */
+
+    template <typename T, typename F>
+    class SpawnCallable
+    {
+      public:
+        F                callable;
+        T*               items;
+        SpawnQueueState* state;
+        int              capacity;
+        int              max_waves;
+    };
+
+    template <typename T, typename F>
+    MUDA_GLOBAL void spawn_kernel(SpawnCallable<T, F> c)
+    {
+        auto grid = cooperative_groups::this_grid();
+        int  rank = static_cast<int>(grid.thread_rank());
+        int  size = static_cast<int>(grid.size());
+
+        auto&     state = *c.state;
+        const int front = *static_cast<volatile int*>(&state.front);
+
+        int wave = 0;
+        for(; wave < c.max_waves; ++wave)
+        {
+            int w     = front + wave;
+            int count = min(*static_cast<volatile int*>(&state.counts[w % 3]), c.capacity);
+            if(count == 0)
+                break;
+
+            // nobody reads the count of wave w - 1 anymore, wave w + 1 spawns into it
+            if(rank == 0)
+                state.counts[(w + 2) % 3] = 0;
+
+            const T*   in = c.items + (w % 2) * c.capacity;
+            Spawner<T> spawner{c.items + ((w + 1) % 2) * c.capacity,
+                               &state.counts[(w + 1) % 3],
+                               &state.overflow,
+                               c.capacity,
+                               wave};
+            for(int i = rank; i < count; i += size)
+                c.callable(in[i], spawner);
+
+            grid.sync();
+        }
+
+        // every block has read `front` before the first grid.sync()
+        if(rank == 0 && wave > 0)
+            state.front = front + wave;
+    }
+}  // namespace details::spawn
+
+template <typename T>
+MUDA_DEVICE bool Spawner<T>::spawn(const T& item) MUDA_NOEXCEPT
+{
+    // one atomic per warp: the leader reserves the slots of all active lanes
+    auto g    = cooperative_groups::coalesced_threads();
+    int  base = 0;
+    if(g.thread_rank() == 0)
+        base = atomicAdd(m_count, static_cast<int>(g.size()));
+    base     = g.shfl(base, 0);
+    int slot = base + static_cast<int>(g.thread_rank());
+
+    if(slot < m_capacity)
+    {
+        m_items[slot] = item;
+        return true;
+    }
+    atomicExch(m_overflow, 1);
+    return false;
+}
+
+template <typename T>
+SpawnQueue<T>::SpawnQueue(int capacity)
+    : m_capacity(capacity)
+{
+    MUDA_ASSERT(capacity > 0, "capacity must be > 0, yours=%d", capacity);
+    checkCudaErrors(cudaMalloc(&m_items, 2 * sizeof(T) * capacity));
+    checkCudaErrors(cudaMalloc(&m_state, sizeof(details::spawn::SpawnQueueState)));
+    checkCudaErrors(cudaMemset(m_state, 0, sizeof(details::spawn::SpawnQueueState)));
+}
+
+template <typename T>
+SpawnQueue<T>::SpawnQueue(SpawnQueue&& other) MUDA_NOEXCEPT
+    : m_items(other.m_items),
+      m_state(other.m_state),
+      m_capacity(other.m_capacity)
+{
+    other.m_items    = nullptr;
+    other.m_state    = nullptr;
+    other.m_capacity = 0;
+}
+
+template <typename T>
+SpawnQueue<T>& SpawnQueue<T>::operator=(SpawnQueue&& other) MUDA_NOEXCEPT
+{
+    if(this != &other)
+    {
+        std::swap(m_items, other.m_items);
+        std::swap(m_state, other.m_state);
+        std::swap(m_capacity, other.m_capacity);
+    }
+    return *this;
+}
+
+template <typename T>
+SpawnQueue<T>::~SpawnQueue()
+{
+    if(m_items)
+        checkCudaErrors(cudaFree(m_items));
+    if(m_state)
+        checkCudaErrors(cudaFree(m_state));
+}
+
+template <typename T>
+details::spawn::SpawnQueueState SpawnQueue<T>::download_state() const
+{
+    details::spawn::SpawnQueueState state;
+    checkCudaErrors(cudaMemcpy(&state, m_state, sizeof(state), cudaMemcpyDeviceToHost));
+    return state;
+}
+
+template <typename T>
+void SpawnQueue<T>::push(const std::vector<T>& items)
+{
+    if(items.empty())
+        return;
+
+    auto state = download_state();
+    int& count = state.counts[state.front % 3];
+    int  begin = std::min(count, m_capacity);
+    int  n     = static_cast<int>(items.size());
+    MUDA_ASSERT(begin + n <= m_capacity,
+                "SpawnQueue overflow, waiting=%d, pushed=%d, capacity=%d",
+                begin,
+                n,
+                m_capacity);
+
+    T* dst = m_items + (state.front % 2) * m_capacity + begin;
+    checkCudaErrors(cudaMemcpy(dst, items.data(), sizeof(T) * n, cudaMemcpyHostToDevice));
+    count = begin + n;
+    checkCudaErrors(cudaMemcpy(&m_state->counts[state.front % 3],
+                               &count,
+                               sizeof(int),
+                               cudaMemcpyHostToDevice));
+}
+
+template <typename T>
+void SpawnQueue<T>::clear()
+{
+    auto state = download_state();
+    // keep `front`, the buffers stay where the next launch expects them
+    std::fill(std::begin(state.counts), std::end(state.counts), 0);
+    state.overflow = 0;
+    checkCudaErrors(cudaMemcpy(m_state, &state, sizeof(state), cudaMemcpyHostToDevice));
+}
+
+template <typename T>
+int SpawnQueue<T>::size() const
+{
+    auto state = download_state();
+    return std::min(state.counts[state.front % 3], m_capacity);
+}
+
+template <typename T>
+bool SpawnQueue<T>::overflowed() const
+{
+    return download_state().overflow != 0;
+}
+
+template <typename T, typename F>
+MUDA_HOST SpawnLaunch& SpawnLaunch::apply(SpawnQueue<T>& queue, F&& f, int max_waves)
+{
+    using namespace details::spawn;
+    using CallableType = raw_type_t<F>;
+
+    MUDA_ASSERT(m_block_dim > 0, "block dim must be > 0, yours=%d", m_block_dim);
+    MUDA_ASSERT(max_waves >= 0, "max_waves must be >= 0, yours=%d", max_waves);
+    MUDA_ASSERT(!ComputeGraphBuilder::is_building(),
+                "SpawnLaunch can't be captured by a compute graph");
+
+    details::LaunchInfoCache::prepare_launch();
+
+    SpawnCallable<T, CallableType> callable{
+        std::forward<F>(f), queue.m_items, queue.m_state, queue.m_capacity, max_waves};
+
+    // all blocks must be resident for grid.sync()
+    auto kernel   = spawn_kernel<T, CallableType>;
+    int  resident = details::persistent::resident_block_count((const void*)kernel, m_block_dim);
+    int  grid_dim = m_grid_dim > 0 ? std::min(m_grid_dim, resident) : resident;
+
+    void* args[] = {&callable};
+    checkCudaErrors(cudaLaunchCooperativeKernel(
+        (const void*)kernel, grid_dim, m_block_dim, args, 0, m_stream));
+
+    pop_kernel_name();
+    return *this;
+}
+}  // namespace muda
@@ -0,0 +1,277 @@
+#include <algorithm>
+#include <cstring>
+#include <muda/cub/host/host_thread_pool.h>
+#include <muda/exception.h>
+
+namespace muda
+{
+namespace details::streaming
+{
+    template <typename T, typename U, typename F>
+    class ChunkCallable
+    {
+      public:
+        F               f;
+        CChunkViewer<T> in;
+        ChunkViewer<U>  out;
+        int64_t         begin;
+
+        MUDA_GENERIC void operator()(int j)
+        {
+            if constexpr(std::is_same_v<U, NoOutput>)
+                f(begin + j, in);
+            else
+                f(begin + j, in, out);
+        }
+    };
+
+    // registered (cudaHostAlloc/cudaHostRegister) host memory
+    MUDA_INLINE bool is_pinned(const void* ptr)
+    {
+        cudaPointerAttributes attr;
+        if(cudaPointerGetAttributes(&attr, ptr) != cudaSuccess)
+        {
+            cudaGetLastError();  // pageable memory on old runtimes, clear the error
+            return false;
+        }
+        return attr.type == cudaMemoryTypeHost;
+    }
+
+    MUDA_INLINE PinnedBuffer::PinnedBuffer(PinnedBuffer&& other) MUDA_NOEXCEPT
+        : m_data(other.m_data),
+          m_capacity(other.m_capacity)
+    {
+        other.m_data     = nullptr;
+        other.m_capacity = 0;
+    }
+
+    MUDA_INLINE PinnedBuffer& PinnedBuffer::operator=(PinnedBuffer&& other) MUDA_NOEXCEPT
+    {
+        if(this != &other)
+        {
+            std::swap(m_data, other.m_data);
+            std::swap(m_capacity, other.m_capacity);
+        }
+        return *this;
+    }
+
+    MUDA_INLINE PinnedBuffer::~PinnedBuffer()
+    {
+        if(m_data)
+            checkCudaErrors(cudaFreeHost(m_data));
+    }
+
+    MUDA_INLINE std::byte* PinnedBuffer::reserve(size_t bytes)
+    {
+        if(bytes <= m_capacity)
+            return m_data;
+
+        if(m_data)
+            checkCudaErrors(cudaFreeHost(m_data));
+        m_capacity = bytes;
+        checkCudaErrors(cudaMallocHost(&m_data, m_capacity));
+        return m_data;
+    }
+}  // namespace details::streaming
+
+MUDA_INLINE MUDA_HOST StreamingFor::StreamingFor(int chunk_size, int halo, int block_dim)
+    : m_chunk_size(chunk_size),
+      m_halo(halo),
+      m_block_dim(block_dim)
+{
+    MUDA_ASSERT(chunk_size > 0, "chunk size must be > 0, yours=%d", chunk_size);
+    MUDA_ASSERT(halo >= 0, "halo must be >= 0, yours=%d", halo);
+    MUDA_ASSERT(static_cast<int64_t>(chunk_size) + 2 * static_cast<int64_t>(halo) <= INT_MAX,
+                "chunk size + 2 * halo must fit in int, chunk size=%d, halo=%d",
+                chunk_size,
+                halo);
+}
+
+MUDA_INLINE MUDA_HOST details::streaming::ChunkRange StreamingFor::chunk_range(int64_t count,
+                                                                               int64_t k) const MUDA_NOEXCEPT
+{
+    details::streaming::ChunkRange r;
+    r.begin    = k * m_chunk_size;
+    r.end      = std::min(r.begin + m_chunk_size, count);
+    r.in_begin = std::max<int64_t>(r.begin - m_halo, 0);
+    r.in_end   = std::min<int64_t>(r.end + m_halo, count);
+    r.slot     = static_cast<int>(k % details::streaming::SlotCount);
+    return r;
+}
+
+template <typename T, typename F>
+MUDA_HOST StreamingFor& StreamingFor::apply(const T* in, int64_t count, F&& f)
+{
+    run(in, count, static_cast<details::streaming::NoOutput*>(nullptr), std::forward<F>(f));
+    return *this;
+}
+
+template <typename T, typename U, typename F>
+MUDA_HOST StreamingFor& StreamingFor::apply(const T* in, int64_t count, U* out, F&& f)
+{
+    run(in, count, out, std::forward<F>(f));
+    return *this;
+}
+
+template <typename T, typename U, typename F>
+MUDA_HOST void StreamingFor::run(const T* in, int64_t count, U* out, F&& f)
+{
+    using namespace details::streaming;
+    using CallableType       = raw_type_t<F>;
+    constexpr bool HasOutput = !std::is_same_v<U, NoOutput>;
+
+    MUDA_ASSERT(!ComputeGraphBuilder::is_building(),
+                "StreamingFor can't be captured by a compute graph");
+    if(count <= 0)
+        return;
+
+    if(m_backend == ParallelForBackend::Host)
+    {
+        if constexpr(is_device_lambda_v<CallableType>)
+            throw invalid_argument("StreamingFor: the host backend needs a __host__ __device__ body");
+        else
+            run_host(in, count, out, f);
+        return;
+    }
+
+    if(!m_pipeline)
+        m_pipeline = std::make_unique<Pipeline>();
+    auto& p = *m_pipeline;
+
+    bool in_pinned  = is_pinned(in);
+    bool out_pinned = HasOutput && is_pinned(out);
+
+    size_t in_bytes  = sizeof(T) * std::min<int64_t>(count, m_chunk_size + 2 * m_halo);
+    size_t out_bytes = sizeof(U) * std::min<int64_t>(count, m_chunk_size);
+    for(auto& slot : p.slots)
+    {
+        slot.device_in.resize(in_bytes);
+        if(!in_pinned)
+            slot.staging_in.reserve(in_bytes);
+        if constexpr(HasOutput)
+        {
+            slot.device_out.resize(out_bytes);
+            if(!out_pinned)
+                slot.staging_out.reserve(out_bytes);
+        }
+        slot.pending_chunk = -1;
+    }
+
+    // wait for the chunk in flight in `slot`, and write its staged output back
+    auto drain = [&](Slot& slot)
+    {
+        if(slot.pending_chunk < 0)
+            return;
+        checkCudaErrors(cudaEventSynchronize(slot.out_done));
+        if constexpr(HasOutput)
+        {
+            if(!out_pinned)
+            {
+                auto r = chunk_range(count, slot.pending_chunk);
+                std::memcpy(out + r.begin,
+                            slot.staging_out.reserve(out_bytes),
+                            sizeof(U) * (r.end - r.begin));
+            }
+        }
+        slot.pending_chunk = -1;
+    };
+
+    int64_t chunks = chunk_count(count);
+    for(int64_t k = 0; k < chunks; ++k)
+    {
+        auto  r    = chunk_range(count, k);
+        auto& slot = p.slots[r.slot];
+        // chunk k - 3 is done with the slot buffers
+        drain(slot);
+
+        int in_n = static_cast<int>(r.in_end - r.in_begin);
+        int n    = static_cast<int>(r.end - r.begin);
+
+        // copy in
+        const void* src = in + r.in_begin;
+        if(!in_pinned)
+        {
+            auto staging = slot.staging_in.reserve(in_bytes);
+            std::memcpy(staging, src, sizeof(T) * in_n);
+            src = staging;
+        }
+        checkCudaErrors(cudaMemcpyAsync(
+            slot.device_in.data(), src, sizeof(T) * in_n, cudaMemcpyHostToDevice, p.copy_in));
+        checkCudaErrors(cudaEventRecord(slot.in_ready, p.copy_in));
+
+        // compute
+        checkCudaErrors(cudaStreamWaitEvent(p.compute, slot.in_ready, 0));
+        ChunkCallable<T, U, CallableType> callable{
+            f,
+            CChunkViewer<T>{reinterpret_cast<const T*>(slot.device_in.data()), r.in_begin, in_n},
+            ChunkViewer<U>{reinterpret_cast<U*>(slot.device_out.data()), r.begin, n},
+            r.begin};
+        ParallelFor(m_block_dim, 0, p.compute).apply(n, callable);
+        checkCudaErrors(cudaEventRecord(slot.computed, p.compute));
+
+        // copy out
+        if constexpr(HasOutput)
+        {
+            void* dst = out_pinned ? static_cast<void*>(out + r.begin) :
+                                     slot.staging_out.reserve(out_bytes);
+            checkCudaErrors(cudaStreamWaitEvent(p.copy_out, slot.computed, 0));
+            checkCudaErrors(cudaMemcpyAsync(
+                dst, slot.device_out.data(), sizeof(U) * n, cudaMemcpyDeviceToHost, p.copy_out));
+            checkCudaErrors(cudaEventRecord(slot.out_done, p.copy_out));
+        }
+        else
+        {
+            checkCudaErrors(cudaEventRecord(slot.out_done, p.compute));
+        }
+        slot.pending_chunk = k;
+    }
+
+    for(int64_t k = std::max<int64_t>(chunks - SlotCount, 0); k < chunks; ++k)
+        drain(p.slots[k % SlotCount]);
+}
+
+template <typename T, typename U, typename F>
+MUDA_HOST void StreamingFor::run_host(const T* in, int64_t count, U* out, const F& f)
+{
+    using namespace details::streaming;
+    constexpr bool HasOutput = !std::is_same_v<U, NoOutput>;
+    // items per pool job
+    constexpr int Grain = 1024;
+
+    // the slot buffers stand in for the device memory, so a chunk only sees
+    // what the device path would have copied in
+    std::array<std::vector<T>, SlotCount> slot_in;
+    std::array<std::vector<U>, SlotCount> slot_out;
+
+    auto& pool = HostThreadPool::global();
+    for(int64_t k = 0, chunks = chunk_count(count); k < chunks; ++k)
+    {
+        auto r    = chunk_range(count, k);
+        int  in_n = static_cast<int>(r.in_end - r.in_begin);
+        int  n    = static_cast<int>(r.end - r.begin);
+
+        auto& buffer_in = slot_in[r.slot];
+        buffer_in.assign(in + r.in_begin, in + r.in_end);
+        auto& buffer_out = slot_out[r.slot];
+        if constexpr(HasOutput)
+            buffer_out.resize(n);
+
+        ChunkCallable<T, U, F> callable{f,
+                                        CChunkViewer<T>{buffer_in.data(), r.in_begin, in_n},
+                                        ChunkViewer<U>{buffer_out.data(), r.begin, n},
+                                        r.begin};
+        pool.run((n + Grain - 1) / Grain,
+                 [&](size_t g)
+                 {
+                     auto c     = callable;
+                     int  first = static_cast<int>(g) * Grain;
+                     int  last  = std::min(first + Grain, n);
+                     for(int j = first; j < last; ++j)
+                         c(j);
+                 });
+
+        if constexpr(HasOutput)
+            std::copy(buffer_out.begin(), buffer_out.end(), out + r.begin);
+    }
+}
+}  // namespace muda
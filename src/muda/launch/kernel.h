@@ -60,7 +60,12 @@ class Kernel
     MUDA_GENERIC void operator()(Args&&... args) &&
     {
         static_assert(std::is_invocable_v<F, Args...>, "invalid arguments");
-#if MUDA_WITH_DEVICE_STREAM_MODEL
+#if defined(__CUDA_ARCH__) && !defined(__CUDACC_RDC__)
+        // device side launches need relocatable device code
+        MUDA_KERNEL_ERROR_WITH_LOCATION(
+            "Kernel: launching a kernel on device needs -rdc=true (MUDA_WITH_RDC), "
+            "use SpawnLaunch to spawn device side work without it");
+#elif MUDA_WITH_DEVICE_STREAM_MODEL
         m_kernel<<<m_grid_dim, m_block_dim, m_shared_memory_size, m_stream>>>(
             std::forward<Args>(args)...);
         checkCudaErrors(cudaGetLastError());
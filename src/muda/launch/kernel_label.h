@@ -8,13 +8,19 @@ class KernelLabel
   public:
     KernelLabel(std::string_view name)
     {
-        if constexpr(muda::RUNTIME_CHECK_ON)
+        if constexpr(muda::CHECK_INFO_ON)
+            details::LaunchInfoCache::current_kernel_name(name);
+    }
+
+    KernelLabel(const InternedName& name)
+    {
+        if constexpr(muda::CHECK_INFO_ON)
             details::LaunchInfoCache::current_kernel_name(name);
     }
 
     ~KernelLabel()
     {
-        if constexpr(muda::RUNTIME_CHECK_ON)
+        if constexpr(muda::CHECK_INFO_ON)
             details::LaunchInfoCache::current_kernel_name("");
     }
 };
@@ -50,6 +50,7 @@ class LaunchCore
 
   public:
     static void             kernel_name(std::string_view name);
+    static void             kernel_name(const InternedName& name);
     static std::string_view kernel_name();
 
     MUDA_GENERIC LaunchCore(::cudaStream_t stream) MUDA_NOEXCEPT;
@@ -106,6 +107,11 @@ class LaunchBase : public LaunchCore
     // create a name for the following kernel launch
     // viewers will record this name for the sake of better recognization when debugging
     T&               kernel_name(std::string_view name);
+    // same as above, but the name id is computed at compile time, e.g. `kernel_name("fill"_name)`
+    T&               kernel_name(const InternedName& name);
+    // name the kernel after a user tag, e.g. to match `RuntimeCheck::enable<UserTag>()`
+    template <typename UserTag>
+    T&               kernel_name(Tag<UserTag>);
     std::string_view kernel_name() const { return Base::kernel_name(); }
 
     // record an event on this point with current stream, you could use .when() to
@@ -11,6 +11,7 @@
 #pragma once
 #include <muda/launch/launch_base.h>
 #include <muda/launch/kernel_tag.h>
+#include <muda/buffer/buffer_fwd.h>
 #include <stdexcept>
 #include <exception>
 
@@ -46,6 +47,16 @@ enum class ParallelForType : uint32_t
     GridStrideLoop
 };
 
+enum class ParallelForBackend
+{
+    // kernels on the stream of the launch, the default
+    Device,
+    // `reduce`, `scan` and PersistentLaunch only: run on `HostThreadPool::global()`, synchronous,
+    // f must be __host__ __device__ (invalid_argument otherwise) and the
+    // output view host accessible
+    Host,
+};
+
 class ParallelForDetails
 {
   public:
@@ -114,9 +125,10 @@ using details::parallel_for_kernel;
  */
 class ParallelFor : public LaunchBase<ParallelFor>
 {
-    int    m_grid_dim;
-    int    m_block_dim;
-    size_t m_shared_mem_size;
+    int                m_grid_dim;
+    int                m_block_dim;
+    size_t             m_shared_mem_size;
+    ParallelForBackend m_backend = ParallelForBackend::Device;
 
   public:
     template <typename F>
@@ -207,6 +219,93 @@ class ParallelFor : public LaunchBase<ParallelFor>
     MUDA_HOST ParallelFor& apply(int count, F&& f, Tag<UserTag>);
 
 
+    /**
+     * \brief Fused map-reduce: `*out = init op f(0) op f(1) ... op f(count - 1)`.
+     *
+     * The mapped values are never written to global memory. Each block reduces its
+     * values with cooperative groups, then merges into `out` with a single atomic
+     * compare-and-swap loop, so `op` must be associative and commutative and
+     * `sizeof(T)` must be 4 or 8. Only grid dim and block dim (a multiple of 32)
+     * of the launch are used, the kernel is a grid-stride loop.
+     *
+     * \code
+     *  DeviceVar<float> energy;
+     *  ParallelFor().reduce(
+     *      n, 0.0f, [] __device__(float a, float b) { return a + b; },
+     *      [x = x.cviewer()] __device__(int i) { return 0.5f * x(i) * x(i); },
+     *      energy.view());
+     * \endcode
+     */
+    template <typename T, typename Op, typename F, typename UserTag = Default>
+    MUDA_HOST ParallelFor& reduce(int count, T init, Op op, F&& f, VarView<T> out);
+
+    template <typename T, typename Op, typename F, typename UserTag = Default>
+    MUDA_HOST ParallelFor& reduce(int count, T init, Op op, F&& f, VarView<T> out, Tag<UserTag>);
+
+    /**
+     * \brief Fused map-scan: `out(i) = f(0) op f(1) ... op f(i)` (inclusive).
+     *
+     * Single pass with decoupled look-back between tiles, `op` only needs to be
+     * associative. A small tile state is allocated on the stream of the launch.
+     *
+     * \code
+     *  ParallelFor().scan(
+     *      n, [] __device__(int a, int b) { return a + b; },
+     *      [flags = flags.cviewer()] __device__(int i) { return flags(i) ? 1 : 0; },
+     *      offsets.view());
+     * \endcode
+     */
+    template <typename T, typename Op, typename F, typename UserTag = Default>
+    MUDA_HOST ParallelFor& scan(int count, Op op, F&& f, BufferView<T> out);
+
+    template <typename T, typename Op, typename F, typename UserTag = Default>
+    MUDA_HOST ParallelFor& scan(int count, Op op, F&& f, BufferView<T> out, Tag<UserTag>);
+
+    // prefix sum of f, same as `scan` with `a + b`
+    template <typename T, typename F, typename UserTag = Default>
+    MUDA_HOST ParallelFor& scan(int count, F&& f, BufferView<T> out);
+
+    /**
+     * \brief Load balanced loop over ragged ranges: segment `s` covers
+     * `[offsets(s), offsets(s + 1))` (CSR style), `offsets(0)` needn't be 0, e.g.
+     * for a subview of a row offset array.
+     *
+     * Threads walk the merge path of the segment ends and the items, so every thread
+     * takes the same number of steps however skewed the segment sizes are, and empty
+     * segments cost one step. `f` is `void(int segment, int local_i)` or
+     * `void(int segment, int local_i, int i)` with the global index `i = offsets(segment) + local_i`.
+     *
+     * The total (`offsets(segment_count) - offsets(0)`) is read back to the host before
+     * the launch, use the overload taking `total` to avoid the synchronization.
+     *
+     * \code
+     *  // one row per segment of a CSR matrix
+     *  ParallelFor().apply_segmented(row_offsets.view(),
+     *      [values = values.viewer()] __device__(int row, int j, int i) mutable
+     *      {
+     *          values(i) *= 2;
+     *      });
+     * \endcode
+     */
+    template <typename F, typename UserTag = Default>
+    MUDA_HOST ParallelFor& apply_segmented(CBufferView<int> offsets, F&& f);
+
+    template <typename F, typename UserTag = Default>
+    MUDA_HOST ParallelFor& apply_segmented(CBufferView<int> offsets, F&& f, Tag<UserTag>);
+
+    template <typename F, typename UserTag = Default>
+    MUDA_HOST ParallelFor& apply_segmented(CBufferView<int> offsets, int total, F&& f);
+
+    MUDA_HOST ParallelFor& backend(ParallelForBackend backend) MUDA_NOEXCEPT
+    {
+        m_backend = backend;
+        return *this;
+    }
+    MUDA_HOST ParallelForBackend backend() const MUDA_NOEXCEPT
+    {
+        return m_backend;
+    }
+
     template <typename F, typename UserTag = Default>
     MUDA_HOST MUDA_NODISCARD auto as_node_parms(int count, F&& f) -> S<NodeParms<F>>;
 
@@ -234,4 +333,6 @@ class ParallelFor : public LaunchBase<ParallelFor>
 };
 }  // namespace muda
 
-#include "details/parallel_for.inl"
\ No newline at end of file
+#include "details/parallel_for.inl"
+#include "details/parallel_for_fused.inl"
+#include "details/parallel_for_segmented.inl"
\ No newline at end of file
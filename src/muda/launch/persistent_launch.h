@@ -0,0 +1,225 @@
+/*****************************************************************/ /**
+ * \file   persistent_launch.h
+ * \brief  Run a batch of small data parallel tasks in a single resident
+ * (persistent) grid, instead of one kernel launch per task.
+ *********************************************************************/
+
+#pragma once
+#include <vector>
+#include <muda/launch/launch_base.h>
+#include <muda/launch/parallel_for.h>
+#include <muda/type_traits/device_lambda.h>
+
+namespace muda
+{
+namespace details::persistent
+{
+    // the host side of a task: call callable `callable` for i in [begin, end)
+    class Task
+    {
+      public:
+        int callable;
+        int begin;
+        int end;
+    };
+
+    // a task laid out on chunks of `block_dim` items, one chunk per block pull
+    class TaskChunks
+    {
+      public:
+        int callable;
+        int begin;
+        int end;
+        // the first chunk of this task, counted from the start of its stage
+        int chunk_begin;
+    };
+
+    // tasks between two barriers
+    class Stage
+    {
+      public:
+        int task_begin;
+        int task_end;
+        int chunk_count;
+    };
+
+    // F[callable](i), without std::tuple on the device
+    template <typename... F>
+    class CallableList;
+
+    template <>
+    class CallableList<>
+    {
+      public:
+        MUDA_GENERIC void invoke(int, int) {}
+    };
+
+    template <typename F, typename... Rest>
+    class CallableList<F, Rest...>
+    {
+      public:
+        F                     head;
+        CallableList<Rest...> tail;
+
+        CallableList(const F& f, const Rest&... rest)
+            : head(f)
+            , tail(rest...)
+        {
+        }
+
+        MUDA_GENERIC void invoke(int callable, int i)
+        {
+            if(callable == 0)
+                head(i);
+            else
+                tail.invoke(callable - 1, i);
+        }
+    };
+
+    // device copy of a laid out batch, see PersistentQueue
+    class DeviceBatch
+    {
+        void*  m_data     = nullptr;
+        size_t m_capacity = 0;
+
+      public:
+        DeviceBatch() = default;
+        DeviceBatch(DeviceBatch&& other) MUDA_NOEXCEPT;
+        DeviceBatch& operator=(DeviceBatch&& other) MUDA_NOEXCEPT;
+        DeviceBatch(const DeviceBatch&)            = delete;
+        DeviceBatch& operator=(const DeviceBatch&) = delete;
+        ~DeviceBatch();
+
+        // grow to at least `bytes`, the old content is dropped
+        void* reserve(size_t bytes);
+    };
+}  // namespace details::persistent
+
+/**
+ * \class PersistentQueue
+ *
+ * \brief A batch of tasks for PersistentLaunch, filled on the host.
+ *
+ * A task runs one of the callables `F...` (by index) over a range of items.
+ * Tasks between two `barrier()`s may run concurrently, in any order; every
+ * task after a barrier sees the writes of every task before it.
+ *
+ * \code
+ *  PersistentQueue queue{integrate, collide}; // [] __device__(int i) mutable {...}
+ *  for(int s = 0; s < substeps; ++s)
+ *      queue.push(0, particle_count).barrier().push(1, contact_count).barrier();
+ *  PersistentLaunch().apply(queue).wait();
+ * \endcode
+ */
+template <typename... F>
+class PersistentQueue
+{
+    static_assert(sizeof...(F) > 0, "PersistentQueue needs at least one callable");
+
+    friend class PersistentLaunch;
+
+    details::persistent::CallableList<F...> m_callables;
+    std::vector<details::persistent::Task>  m_tasks;
+    // the first task of every stage
+    std::vector<int> m_stage_begins{0};
+    // reused across batches, so refilling the queue doesn't allocate
+    details::persistent::DeviceBatch m_device;
+
+  public:
+    PersistentQueue(const F&... callables)
+        : m_callables(callables...)
+    {
+    }
+
+    // run callable `callable` for i in [0, count)
+    PersistentQueue& push(int callable, int count) { return push(callable, 0, count); }
+
+    // run callable `callable` for i in [begin, end)
+    PersistentQueue& push(int callable, int begin, int end);
+
+    // the following tasks wait for all the previous ones
+    PersistentQueue& barrier();
+
+    // drop all tasks, keep the callables and the device storage
+    void clear();
+
+    size_t task_count() const { return m_tasks.size(); }
+    bool   empty() const { return m_tasks.empty(); }
+    // the number of barrier separated stages (an empty trailing stage is not counted)
+    size_t stage_count() const;
+};
+
+/**
+ * \class PersistentLaunch
+ *
+ * \ingroup Launcher
+ *
+ * \brief Run a PersistentQueue in one cooperative kernel launch.
+ *
+ * \details
+ * Chains of tiny kernels are dominated by the launch overhead and fill only a
+ * few SMs. PersistentLaunch starts as many blocks as can be resident, and the
+ * blocks pull chunks of `block_dim` items from a device side counter per
+ * stage. A grid wide barrier separates the stages.
+ *
+ * With `backend(ParallelForBackend::Host)` the same schedule is emulated on
+ * `HostThreadPool::global()` (one worker per emulated block), synchronously.
+ * The callables must be __host__ __device__ and only touch host memory then.
+ *
+ * \code
+ *  PersistentQueue queue{
+ *      [x = x.viewer()] __device__(int i) mutable { x(i) += 1; },
+ *      [x = x.viewer(), y = y.viewer()] __device__(int i) mutable { y(i) = x(i); }};
+ *  queue.push(0, N).barrier().push(1, N);
+ *  PersistentLaunch(stream).apply(queue);
+ * \endcode
+ */
+class PersistentLaunch : public LaunchBase<PersistentLaunch>
+{
+    int                m_grid_dim;
+    int                m_block_dim;
+    ParallelForBackend m_backend = ParallelForBackend::Device;
+
+  public:
+    // grid_dim <= 0: as many blocks as can be resident on the device
+    MUDA_HOST PersistentLaunch(int          grid_dim  = 0,
+                               int          block_dim = 256,
+                               cudaStream_t stream    = nullptr) MUDA_NOEXCEPT
+        : LaunchBase(stream),
+          m_grid_dim(grid_dim),
+          m_block_dim(block_dim)
+    {
+    }
+
+    MUDA_HOST PersistentLaunch(cudaStream_t stream) MUDA_NOEXCEPT
+        : LaunchBase(stream),
+          m_grid_dim(0),
+          m_block_dim(256)
+    {
+    }
+
+    // the batch is uploaded on the launch stream, so the queue can be refilled
+    // and applied again right away on the same stream
+    template <typename... F>
+    MUDA_HOST PersistentLaunch& apply(PersistentQueue<F...>& queue);
+
+    MUDA_HOST PersistentLaunch& backend(ParallelForBackend backend) MUDA_NOEXCEPT
+    {
+        m_backend = backend;
+        return *this;
+    }
+
+    MUDA_HOST ParallelForBackend backend() const MUDA_NOEXCEPT
+    {
+        return m_backend;
+    }
+
+  private:
+    template <typename... F>
+    MUDA_HOST void apply_host(PersistentQueue<F...>& queue,
+                              const std::vector<details::persistent::TaskChunks>& tasks,
+                              const std::vector<details::persistent::Stage>& stages);
+};
+}  // namespace muda
+
+#include "details/persistent_launch.inl"
@@ -0,0 +1,174 @@
+/*****************************************************************/ /**
+ * \file   spawn_launch.h
+ * \brief  Device side work spawning without dynamic parallelism: child work
+ * items go to a global queue, consumed by the next wave of the same launch.
+ *********************************************************************/
+
+#pragma once
+#include <climits>
+#include <vector>
+#include <muda/launch/launch_base.h>
+#include <muda/launch/persistent_launch.h>
+
+namespace muda
+{
+namespace details::spawn
+{
+    // device side bookkeeping of a SpawnQueue
+    class SpawnQueueState
+    {
+      public:
+        // item counts, wave w reads counts[w % 3] and spawns into counts[(w + 1) % 3]
+        int counts[3];
+        // the wave the waiting items belong to, the items live in buffer front % 2
+        int front;
+        // set when a spawn didn't fit
+        int overflow;
+    };
+
+    template <typename T, typename F>
+    class SpawnCallable;
+
+    template <typename T, typename F>
+    MUDA_GLOBAL void spawn_kernel(SpawnCallable<T, F> c);
+}  // namespace details::spawn
+
+/**
+ * \class Spawner
+ *
+ * \brief Passed to the callable of SpawnLaunch, spawns child work items into
+ * the next wave.
+ */
+template <typename T>
+class Spawner
+{
+    template <typename U, typename F>
+    friend MUDA_GLOBAL void details::spawn::spawn_kernel(details::spawn::SpawnCallable<U, F> c);
+
+    T*   m_items;
+    int* m_count;
+    int* m_overflow;
+    int  m_capacity;
+    int  m_wave;
+
+    MUDA_GENERIC Spawner(T* items, int* count, int* overflow, int capacity, int wave) MUDA_NOEXCEPT
+        : m_items(items),
+          m_count(count),
+          m_overflow(overflow),
+          m_capacity(capacity),
+          m_wave(wave)
+    {
+    }
+
+  public:
+    // false if the queue is full, the item is dropped and SpawnQueue::overflowed() is set
+    MUDA_DEVICE bool spawn(const T& item) MUDA_NOEXCEPT;
+
+    // the wave of the item being processed, counted from the start of the launch
+    MUDA_GENERIC int wave() const MUDA_NOEXCEPT { return m_wave; }
+};
+
+/**
+ * \class SpawnQueue
+ *
+ * \brief Two item buffers of a fixed capacity, the items waiting for the next
+ * SpawnLaunch and the items spawned by the current wave.
+ *
+ * The queue persists across launches: when a launch stops at `max_waves`,
+ * the next one continues with the waiting items.
+ */
+template <typename T>
+class SpawnQueue
+{
+    static_assert(std::is_trivially_copyable_v<T>, "SpawnQueue items must be trivially copyable");
+
+    friend class SpawnLaunch;
+
+    T*                               m_items    = nullptr;  // [2][capacity]
+    details::spawn::SpawnQueueState* m_state    = nullptr;
+    int                              m_capacity = 0;
+
+    details::spawn::SpawnQueueState download_state() const;
+
+  public:
+    explicit SpawnQueue(int capacity);
+    SpawnQueue(SpawnQueue&& other) MUDA_NOEXCEPT;
+    SpawnQueue& operator=(SpawnQueue&& other) MUDA_NOEXCEPT;
+    SpawnQueue(const SpawnQueue&)            = delete;
+    SpawnQueue& operator=(const SpawnQueue&) = delete;
+    ~SpawnQueue();
+
+    // append seed items to the waiting items (synchronous)
+    void push(const std::vector<T>& items);
+
+    // drop all waiting items and clear the overflow flag (synchronous)
+    void clear();
+
+    // the number of waiting items (synchronous)
+    int size() const;
+    // whether a spawn was dropped since the last clear() (synchronous)
+    bool overflowed() const;
+    int  capacity() const { return m_capacity; }
+};
+
+/**
+ * \class SpawnLaunch
+ *
+ * \ingroup Launcher
+ *
+ * \brief Process a SpawnQueue wave by wave in one cooperative kernel launch,
+ * an alternative to device side kernel launches (CUDA dynamic parallelism).
+ *
+ * \details
+ * `f(const T& item, Spawner<T>& spawner)` is called once per waiting item.
+ * Items spawned by `spawner.spawn(child)` form the next wave, waves are
+ * separated by a grid wide barrier. The launch returns when a wave is empty
+ * or after `max_waves` waves.
+ *
+ * Unlike `Kernel{..., Stream::FireAndForget{}, ...}` on the device, this
+ * doesn't need relocatable device code, see `MUDA_WITH_RDC`.
+ *
+ * \code
+ *  SpawnQueue<int2> queue(1 << 20);
+ *  queue.push({make_int2(0, 0)}); // (depth, id)
+ *  SpawnLaunch()
+ *      .apply(queue,
+ *             [visits = visits.viewer()] __device__(const int2& node, Spawner<int2>& spawner) mutable
+ *             {
+ *                 atomicAdd(&visits(node.x), 1);
+ *                 if(node.x + 1 < depth)
+ *                 {
+ *                     spawner.spawn(make_int2(node.x + 1, 2 * node.y));
+ *                     spawner.spawn(make_int2(node.x + 1, 2 * node.y + 1));
+ *                 }
+ *             })
+ *      .wait();
+ * \endcode
+ */
+class SpawnLaunch : public LaunchBase<SpawnLaunch>
+{
+    int m_grid_dim;
+    int m_block_dim;
+
+  public:
+    // grid_dim <= 0: as many blocks as can be resident on the device
+    MUDA_HOST SpawnLaunch(int grid_dim = 0, int block_dim = 256, cudaStream_t stream = nullptr) MUDA_NOEXCEPT
+        : LaunchBase(stream),
+          m_grid_dim(grid_dim),
+          m_block_dim(block_dim)
+    {
+    }
+
+    MUDA_HOST SpawnLaunch(cudaStream_t stream) MUDA_NOEXCEPT
+        : LaunchBase(stream),
+          m_grid_dim(0),
+          m_block_dim(256)
+    {
+    }
+
+    template <typename T, typename F>
+    MUDA_HOST SpawnLaunch& apply(SpawnQueue<T>& queue, F&& f, int max_waves = INT_MAX);
+};
+}  // namespace muda
+
+#include "details/spawn_launch.inl"
@@ -0,0 +1,282 @@
+/*****************************************************************/ /**
+ * \file   streaming_for.h
+ * \brief  Run a ParallelFor body over a host array larger than device
+ * memory, chunk by chunk, overlapping the copies with the compute.
+ *********************************************************************/
+
+#pragma once
+#include <array>
+#include <climits>
+#include <cstdint>
+#include <memory>
+#include <muda/launch/parallel_for.h>
+#include <muda/launch/stream.h>
+#include <muda/launch/event.h>
+#include <muda/tools/temp_buffer.h>
+#include <muda/type_traits/device_lambda.h>
+#include <muda/viewer/viewer_base.h>
+
+namespace muda
+{
+/**
+ * \class ChunkViewerBase
+ *
+ * \brief The part of a streamed array resident on the device (or the host
+ * backend) for the current chunk, indexed by the global index.
+ */
+template <bool IsConst, typename T>
+class ChunkViewerBase : public ViewerBase<IsConst>
+{
+    using Base = ViewerBase<IsConst>;
+    template <typename U>
+    using auto_const_t = typename Base::template auto_const_t<U>;
+
+    MUDA_VIEWER_COMMON_NAME(ChunkViewerBase);
+
+  public:
+    using ConstViewer    = ChunkViewerBase<true, T>;
+    using NonConstViewer = ChunkViewerBase<false, T>;
+    using ThisViewer     = ChunkViewerBase<IsConst, T>;
+
+  protected:
+    auto_const_t<T>* m_data;
+    int64_t          m_offset;
+    int              m_size;
+
+  public:
+    using value_type = T;
+
+    MUDA_GENERIC ChunkViewerBase() MUDA_NOEXCEPT : m_data(nullptr),
+                                                   m_offset(0),
+                                                   m_size(0)
+    {
+    }
+
+    // `data[0]` is the element `offset` of the streamed array
+    MUDA_GENERIC ChunkViewerBase(auto_const_t<T>* data, int64_t offset, int size) MUDA_NOEXCEPT
+        : m_data(data),
+          m_offset(offset),
+          m_size(size)
+    {
+    }
+
+    MUDA_GENERIC auto as_const() const MUDA_NOEXCEPT
+    {
+        return ConstViewer{m_data, m_offset, m_size};
+    }
+
+    MUDA_GENERIC operator ConstViewer() const MUDA_NOEXCEPT
+    {
+        return as_const();
+    }
+
+    // `i` is the global index, in [offset(), offset() + total_size())
+    MUDA_GENERIC auto_const_t<T>& operator()(int64_t i) MUDA_NOEXCEPT
+    {
+        return m_data[map(i)];
+    }
+
+    MUDA_GENERIC const T& operator()(int64_t i) const MUDA_NOEXCEPT
+    {
+        return remove_const(*this)(i);
+    }
+
+    // whether the global index `i` is resident, false for the halo cut by the array ends
+    MUDA_GENERIC bool contains(int64_t i) const MUDA_NOEXCEPT
+    {
+        return i >= m_offset && i < m_offset + m_size;
+    }
+
+    MUDA_GENERIC auto_const_t<T>* data() MUDA_NOEXCEPT { return m_data; }
+    MUDA_GENERIC const T*         data() const MUDA_NOEXCEPT { return m_data; }
+
+    MUDA_GENERIC int64_t offset() const MUDA_NOEXCEPT { return m_offset; }
+    MUDA_GENERIC int     total_size() const MUDA_NOEXCEPT { return m_size; }
+
+  protected:
+    MUDA_GENERIC int map(int64_t i) const MUDA_NOEXCEPT
+    {
+        if(this->checked())
+            if(!contains(i))
+                MUDA_KERNEL_ERROR("ChunkViewer[%s:%s]: out of range, index=(%lld) resident=[%lld, %lld)",
+                                  this->name(),
+                                  this->kernel_name(),
+                                  (long long)i,
+                                  (long long)m_offset,
+                                  (long long)(m_offset + m_size));
+        return static_cast<int>(i - m_offset);
+    }
+};
+
+template <typename T>
+using ChunkViewer = ChunkViewerBase<false, T>;
+
+template <typename T>
+using CChunkViewer = ChunkViewerBase<true, T>;
+
+// viewer traits
+template <typename T>
+struct read_only_viewer<ChunkViewer<T>>
+{
+    using type = CChunkViewer<T>;
+};
+
+template <typename T>
+struct read_write_viewer<CChunkViewer<T>>
+{
+    using type = ChunkViewer<T>;
+};
+
+namespace details::streaming
+{
+    constexpr int SlotCount = 3;
+
+    // chunk k covers [begin, end), and reads [in_begin, in_end) with the halo
+    class ChunkRange
+    {
+      public:
+        int64_t begin;
+        int64_t end;
+        int64_t in_begin;
+        int64_t in_end;
+        int     slot;
+    };
+
+    // page locked staging memory, so the copies of pageable (e.g. mmap'ed) arrays stay async
+    class PinnedBuffer
+    {
+        std::byte* m_data     = nullptr;
+        size_t     m_capacity = 0;
+
+      public:
+        PinnedBuffer() = default;
+        PinnedBuffer(PinnedBuffer&& other) MUDA_NOEXCEPT;
+        PinnedBuffer& operator=(PinnedBuffer&& other) MUDA_NOEXCEPT;
+        PinnedBuffer(const PinnedBuffer&)            = delete;
+        PinnedBuffer& operator=(const PinnedBuffer&) = delete;
+        ~PinnedBuffer();
+
+        // grow to at least `bytes`, the old content is dropped
+        std::byte* reserve(size_t bytes);
+    };
+
+    // the buffers and events of one chunk in flight
+    class Slot
+    {
+      public:
+        ByteTempBuffer device_in;
+        ByteTempBuffer device_out;
+        PinnedBuffer   staging_in;
+        PinnedBuffer   staging_out;
+        Event          in_ready;
+        Event          computed;
+        Event          out_done;
+        // the chunk still in flight in this slot, -1 if none
+        int64_t pending_chunk = -1;
+    };
+
+    class Pipeline
+    {
+      public:
+        Stream copy_in{Stream::Flag::eNonBlocking};
+        Stream compute{Stream::Flag::eNonBlocking};
+        Stream copy_out{Stream::Flag::eNonBlocking};
+
+        std::array<Slot, SlotCount> slots;
+    };
+
+    // the output type of the read only `apply`
+    class NoOutput
+    {
+    };
+
+    template <typename T, typename U, typename F>
+    class ChunkCallable;
+}  // namespace details::streaming
+
+/**
+ * \class StreamingFor
+ *
+ * \brief Out-of-core ParallelFor: stream a host array through the device in
+ * chunks of `chunk_size` elements.
+ *
+ * \details
+ * Three chunks are in flight at a time (triple buffering): while chunk k is
+ * computed, chunk k + 1 is copied in and chunk k - 1 is copied out, each on
+ * its own stream. The input of a chunk is extended by `halo` elements on both
+ * sides (clamped to the array), so stencil like bodies can read neighbours
+ * across chunk boundaries. The output is written back for the chunk itself.
+ *
+ * Pinned host arrays are copied directly, pageable ones (e.g. a mmap'ed file)
+ * are staged through page locked buffers. `apply` returns once every chunk
+ * has been written back. The slot buffers are kept across `apply` calls.
+ *
+ * With `backend(ParallelForBackend::Host)` the same chunk schedule runs on
+ * `HostThreadPool::global()`, the body must be __host__ __device__ then.
+ *
+ * \code
+ *  // 1D blur of a 200 GB file, 16M particles per chunk
+ *  StreamingFor(1 << 24, 1)
+ *      .apply(mapped_in, count, mapped_out,
+ *             [count] __device__(int64_t i, const CChunkViewer<float>& in, ChunkViewer<float>& out) mutable
+ *             {
+ *                 float l = i > 0 ? in(i - 1) : in(i);
+ *                 float r = i + 1 < count ? in(i + 1) : in(i);
+ *                 out(i)  = (l + in(i) + r) / 3.0f;
+ *             });
+ * \endcode
+ */
+class StreamingFor
+{
+    int                m_chunk_size;
+    int                m_halo;
+    int                m_block_dim;
+    ParallelForBackend m_backend = ParallelForBackend::Device;
+
+    // created on the first device apply, the host backend needs no CUDA objects
+    std::unique_ptr<details::streaming::Pipeline> m_pipeline;
+
+  public:
+    MUDA_HOST StreamingFor(int chunk_size, int halo = 0, int block_dim = 256);
+
+    // f(int64_t i, const CChunkViewer<T>& in), for i in [0, count)
+    template <typename T, typename F>
+    MUDA_HOST StreamingFor& apply(const T* in, int64_t count, F&& f);
+
+    // f(int64_t i, const CChunkViewer<T>& in, ChunkViewer<U>& out), for i in [0, count),
+    // `out` has the same length as `in`
+    template <typename T, typename U, typename F>
+    MUDA_HOST StreamingFor& apply(const T* in, int64_t count, U* out, F&& f);
+
+    MUDA_HOST StreamingFor& backend(ParallelForBackend backend) MUDA_NOEXCEPT
+    {
+        m_backend = backend;
+        return *this;
+    }
+
+    MUDA_HOST ParallelForBackend backend() const MUDA_NOEXCEPT
+    {
+        return m_backend;
+    }
+
+    MUDA_HOST int chunk_size() const MUDA_NOEXCEPT { return m_chunk_size; }
+    MUDA_HOST int halo() const MUDA_NOEXCEPT { return m_halo; }
+
+    MUDA_HOST int64_t chunk_count(int64_t count) const MUDA_NOEXCEPT
+    {
+        return (count + m_chunk_size - 1) / m_chunk_size;
+    }
+
+    // the elements chunk k computes and the elements it reads
+    MUDA_HOST details::streaming::ChunkRange chunk_range(int64_t count, int64_t k) const MUDA_NOEXCEPT;
+
+  private:
+    template <typename T, typename U, typename F>
+    MUDA_HOST void run(const T* in, int64_t count, U* out, F&& f);
+
+    template <typename T, typename U, typename F>
+    MUDA_HOST void run_host(const T* in, int64_t count, U* out, const F& f);
+};
+}  // namespace muda
+
+#include "details/streaming_for.inl"
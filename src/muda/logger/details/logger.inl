@@ -1,5 +1,8 @@
 #include <algorithm>
+#include <cctype>
+#include <fstream>
 #include <sstream>
+#include <muda/exception.h>
 #include <muda/mstl/span.h>
 #include <muda/cub/device/device_radix_sort.h>
 namespace muda
@@ -64,6 +67,7 @@ MUDA_INLINE Logger::Logger(LoggerViewer* global_viewer, size_t meta_size, size_t
     , m_h_buffer(buffer_size)
     , m_log_viewer_ptr(global_viewer)
     , m_offset(1)
+    , m_site_counter(DEFAULT_SITE_COUNTER_SIZE)
 {
     upload();
 }
@@ -78,7 +82,11 @@ MUDA_INLINE Logger::Logger(Logger&& other) noexcept
     , m_h_buffer(std::move(other.m_h_buffer))
     , m_offset(std::move(other.m_offset))
     , m_h_offset(std::move(other.m_h_offset))
+    , m_site_counter(std::move(other.m_site_counter))
+    , m_default_filter(other.m_default_filter)
+    , m_kernel_filters(std::move(other.m_kernel_filters))
     , m_log_viewer_ptr(std::move(other.m_log_viewer_ptr))
+    , m_viewer(other.m_viewer)
 {
     other.m_log_viewer_ptr = nullptr;
     other.m_viewer         = {};
@@ -98,7 +106,11 @@ MUDA_INLINE Logger& Logger::operator=(Logger&& other) noexcept
     m_h_buffer             = std::move(other.m_h_buffer);
     m_offset               = std::move(other.m_offset);
     m_h_offset             = std::move(other.m_h_offset);
+    m_site_counter         = std::move(other.m_site_counter);
+    m_default_filter       = other.m_default_filter;
+    m_kernel_filters       = std::move(other.m_kernel_filters);
     m_log_viewer_ptr       = std::move(other.m_log_viewer_ptr);
+    m_viewer               = other.m_viewer;
     other.m_log_viewer_ptr = nullptr;
     other.m_viewer         = {};
 
@@ -201,12 +213,137 @@ MUDA_INLINE void Logger::upload()
     m_viewer.m_buffer            = m_buffer.data();
     m_viewer.m_buffer_size       = m_buffer.size();
 
+    // the first-K-per-site caps restart after every retrieve
+    checkCudaErrors(cudaMemsetAsync(
+        m_site_counter.data(), 0, m_site_counter.size() * sizeof(uint32_t), nullptr));
+    m_viewer.m_site_counter      = m_site_counter.data();
+    m_viewer.m_site_counter_size = m_site_counter.size();
+    m_viewer.m_filter            = m_default_filter;
+
+    upload_global_viewer();
+    checkCudaErrors(cudaDeviceSynchronize());
+}
+
+MUDA_INLINE void Logger::upload_global_viewer()
+{
     if(m_log_viewer_ptr)
     {
         checkCudaErrors(cudaMemcpyAsync(
             m_log_viewer_ptr, &m_viewer, sizeof(m_viewer), cudaMemcpyHostToDevice, nullptr));
     }
-    checkCudaErrors(cudaDeviceSynchronize());
+}
+
+MUDA_INLINE LoggerViewer Logger::viewer(std::string_view kernel_name) const
+{
+    auto v     = viewer();
+    v.m_filter = filter(kernel_name);
+    return v;
+}
+
+MUDA_INLINE const LoggerFilter& Logger::filter(std::string_view kernel_name) const
+{
+    auto it = m_kernel_filters.find(std::string{kernel_name});
+    return it != m_kernel_filters.end() ? it->second : m_default_filter;
+}
+
+MUDA_INLINE void Logger::filter(const LoggerFilter& filter)
+{
+    m_default_filter              = filter;
+    m_default_filter.sample_every = std::max(filter.sample_every, 1u);
+    m_viewer.m_filter             = m_default_filter;
+    upload_global_viewer();
+}
+
+MUDA_INLINE void Logger::filter(std::string_view kernel_name, const LoggerFilter& filter)
+{
+    auto& f        = m_kernel_filters[std::string{kernel_name}];
+    f              = filter;
+    f.sample_every = std::max(filter.sample_every, 1u);
+}
+
+MUDA_INLINE void Logger::clear_kernel_filters()
+{
+    m_kernel_filters.clear();
+}
+
+namespace details
+{
+    MUDA_INLINE LogLevel parse_log_level(std::string level)
+    {
+        std::transform(level.begin(),
+                       level.end(),
+                       level.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        if(level == "trace")
+            return LogLevel::Trace;
+        if(level == "debug")
+            return LogLevel::Debug;
+        if(level == "info")
+            return LogLevel::Info;
+        if(level == "warn" || level == "warning")
+            return LogLevel::Warn;
+        if(level == "error")
+            return LogLevel::Error;
+        if(level == "off")
+            return LogLevel::Off;
+        throw invalid_argument("unknown log level: " + level);
+    }
+}  // namespace details
+
+MUDA_INLINE void Logger::load_filters(std::istream& config)
+{
+    LoggerFilter                                  default_filter;
+    std::unordered_map<std::string, LoggerFilter> kernel_filters;
+
+    std::string line;
+    size_t      line_no = 0;
+    while(std::getline(config, line))
+    {
+        ++line_no;
+        line = line.substr(0, line.find('#'));
+
+        std::istringstream ss{line};
+        std::string        name, level;
+        if(!(ss >> name))
+            continue;  // empty or comment
+        if(!(ss >> level))
+            throw invalid_argument("log filter line " + std::to_string(line_no)
+                                   + ": missing level");
+
+        LoggerFilter f;
+        f.level = details::parse_log_level(level);
+
+        std::string option;
+        while(ss >> option)
+        {
+            auto eq  = option.find('=');
+            auto key = option.substr(0, eq);
+            if(eq == std::string::npos || (key != "every" && key != "first"))
+                throw invalid_argument("log filter line " + std::to_string(line_no)
+                                       + ": unknown option " + option);
+            auto value = static_cast<uint32_t>(std::stoul(option.substr(eq + 1)));
+            if(key == "every")
+                f.sample_every = std::max(value, 1u);
+            else
+                f.max_per_site = value;
+        }
+
+        if(name == "*")
+            default_filter = f;
+        else
+            kernel_filters[name] = f;
+    }
+
+    m_kernel_filters = std::move(kernel_filters);
+    filter(default_filter);
+}
+
+MUDA_INLINE void Logger::load_filters_from_file(std::string_view path)
+{
+    std::ifstream file{std::string{path}};
+    if(!file)
+        throw invalid_argument("can't open log filter file: " + std::string{path});
+    load_filters(file);
 }
 
 MUDA_INLINE void Logger::download()
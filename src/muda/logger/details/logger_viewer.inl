@@ -12,6 +12,9 @@ MUDA_INLINE MUDA_DEVICE LogProxy::LogProxy(LoggerViewer& viewer)
 template <bool IsFmt>
 MUDA_INLINE MUDA_DEVICE LogProxy& LogProxy::push_string(const char* str)
 {
+    if(!m_viewer)
+        return *this;
+
     auto strlen = [](const char* s)
     {
         size_t len = 0;
@@ -39,6 +42,9 @@ MUDA_INLINE MUDA_DEVICE LogProxy& LogProxy::push_string(const char* str)
 template <typename T>
 MUDA_DEVICE void LogProxy::push_fmt_arg(const T& obj, LoggerFmtArg func)
 {
+    if(!m_viewer)
+        return;
+
     details::LoggerMetaData meta;
     meta.type    = LoggerBasicType::Object;
     meta.size    = sizeof(T);
@@ -50,6 +56,8 @@ MUDA_DEVICE void LogProxy::push_fmt_arg(const T& obj, LoggerFmtArg func)
 MUDA_INLINE MUDA_DEVICE bool LogProxy::push_data(const details::LoggerMetaData& meta,
                                             const void*                    data)
 {
+    if(!m_viewer)
+        return false;
     return m_viewer->push_data(meta, data);
 }
 
@@ -58,10 +66,11 @@ MUDA_INLINE MUDA_DEVICE LogProxy& LogProxy::operator<<(const char* str)
     return push_string<false>(str);
 }
 
+// plain `<<` logs at LogLevel::Info
 template <typename T>
 MUDA_INLINE MUDA_DEVICE LogProxy& LoggerViewer::operator<<(const T& t)
 {
-    m_proxy = LogProxy(*this);
+    log(LogLevel::Info);
     m_proxy << t;
     return m_proxy;
 }
@@ -69,18 +78,48 @@ MUDA_INLINE MUDA_DEVICE LogProxy& LoggerViewer::operator<<(const T& t)
 template <bool IsFmt>
 MUDA_INLINE MUDA_DEVICE LogProxy& LoggerViewer::push_string(const char* str)
 {
-    m_proxy = LogProxy(*this);
+    log(LogLevel::Info);
     m_proxy.push_string<IsFmt>(str);
     return m_proxy;
 }
 
 MUDA_INLINE MUDA_DEVICE LogProxy& LoggerViewer::operator<<(const char* s)
 {
-    m_proxy = LogProxy(*this);
+    log(LogLevel::Info);
     m_proxy << s;
     return m_proxy;
 }
 
+MUDA_INLINE MUDA_DEVICE bool LoggerViewer::accept(LogLevel level) const
+{
+    return level >= m_filter.level && level != LogLevel::Off;
+}
+
+MUDA_INLINE MUDA_DEVICE bool LoggerViewer::accept(LogLevel level, uint32_t site) const
+{
+    if(!accept(level))
+        return false;
+    if(!m_filter.is_sampling() || !m_site_counter)
+        return true;
+
+    auto hit = atomic_add(m_site_counter + (site & (m_site_counter_size - 1)), 1u);
+    if(hit % m_filter.sample_every != 0)
+        return false;
+    return hit / m_filter.sample_every < m_filter.max_per_site;
+}
+
+MUDA_INLINE MUDA_DEVICE LogProxy& LoggerViewer::log(LogLevel level)
+{
+    m_proxy = accept(level) ? LogProxy(*this) : LogProxy();
+    return m_proxy;
+}
+
+MUDA_INLINE MUDA_DEVICE LogProxy& LoggerViewer::log(LogLevel level, uint32_t site)
+{
+    m_proxy = accept(level, site) ? LogProxy(*this) : LogProxy();
+    return m_proxy;
+}
+
 MUDA_INLINE MUDA_DEVICE uint32_t next_idx(uint32_t* data_offset, uint32_t size, uint32_t total_size)
 {
 
@@ -6,6 +6,9 @@
 #include <muda/logger/logger_viewer.h>
 #include <muda/buffer/device_var.h>
 #include <vector>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 #include <muda/tools/temp_buffer.h>
 
 namespace muda
@@ -77,6 +80,47 @@ class Logger
         return m_log_viewer_ptr ? *m_log_viewer_ptr : m_viewer;
     }
 
+    // a viewer using the filter of `kernel_name` (the default filter if it has none)
+    MUDA_NODISCARD LoggerViewer viewer(std::string_view kernel_name) const;
+
+    /**
+     * \brief Filters are evaluated on the device, they take effect for the viewers
+     * created afterwards (and immediately for the global viewer).
+     *
+     * \code
+     *  Logger logger;
+     *  logger.filter(LoggerFilter{LogLevel::Warn});             // default: warnings and errors
+     *  logger.filter("cg_step", LoggerFilter{LogLevel::Debug, 100, 10}); // every 100th, <= 10 per site
+     *  ParallelFor().kernel_name("cg_step").apply(n,
+     *      [log = logger.viewer("cg_step")] __device__(int i) mutable
+     *      { MUDA_LOG(log, Debug) << "i=" << i << "\n"; });
+     * \endcode
+     */
+    void filter(const LoggerFilter& filter);
+    void filter(std::string_view kernel_name, const LoggerFilter& filter);
+    const LoggerFilter& filter() const { return m_default_filter; }
+    const LoggerFilter& filter(std::string_view kernel_name) const;
+    // drop all per-kernel filters
+    void clear_kernel_filters();
+
+    /**
+     * \brief (Re)load filters from a text config, one rule per line, e.g.
+     *
+     * \code
+     *  # kernel_name level [every=N] [first=K]
+     *  *        warn
+     *  cg_step  debug every=100 first=10
+     * \endcode
+     *
+     * `*` sets the default filter, levels are trace/debug/info/warn/error/off.
+     * Per-kernel filters not mentioned in the config are dropped.
+     * Throws `invalid_argument` on a malformed line.
+     */
+    void load_filters(std::istream& config);
+    void load_filters_from_file(std::string_view path);
+
+    static constexpr uint32_t DEFAULT_SITE_COUNTER_SIZE = 4096;
+
   private:
     friend class LaunchCore;
     friend class Debug;
@@ -107,8 +151,14 @@ class Logger
     details::TempBuffer<details::LoggerOffset> m_offset;
     details::LoggerOffset                      m_h_offset;
 
+    details::TempBuffer<uint32_t> m_site_counter;
+
+    LoggerFilter                                  m_default_filter;
+    std::unordered_map<std::string, LoggerFilter> m_kernel_filters;
+
     LoggerViewer* m_log_viewer_ptr = nullptr;
     LoggerViewer  m_viewer;
+    void          upload_global_viewer();
     template <typename F>
     void _retrieve(F&&);
     void put(std::ostream& os, const details::LoggerMetaData& meta_data) const;
@@ -1,5 +1,6 @@
 #pragma once
 #include <cinttypes>
+#include <muda/muda_def.h>
 
 namespace muda
 {
@@ -33,6 +34,39 @@ enum class LoggerBasicType : uint16_t
 
 using LoggerFmtArg = void (*)(void* formatter, const void* obj);
 
+enum class LogLevel : uint32_t
+{
+    Trace,
+    Debug,
+    Info,
+    Warn,
+    Error,
+    // record nothing
+    Off,
+};
+
+/**
+ * \class LoggerFilter
+ *
+ * \brief Which logs a `LoggerViewer` records, evaluated on the device.
+ *
+ * A log passes if its level is not below `level`; logs with a site id (see `MUDA_LOG`)
+ * additionally keep every `sample_every`-th hit of the site, at most `max_per_site`
+ * of them between two `Logger::retrieve()`.
+ */
+class LoggerFilter
+{
+  public:
+    LogLevel level        = LogLevel::Trace;
+    uint32_t sample_every = 1;
+    uint32_t max_per_site = ~0u;
+
+    MUDA_GENERIC bool is_sampling() const
+    {
+        return sample_every > 1 || max_per_site != ~0u;
+    }
+};
+
 namespace details
 {
     class LoggerMetaData
@@ -1,4 +1,5 @@
 #pragma once
+#include <type_traits>
 #include <muda/logger/logger_basic_data.h>
 #include <muda/muda_def.h>
 #include <muda/check/check_cuda_errors.h>
@@ -7,6 +8,18 @@
 namespace muda
 {
 class LoggerViewer;
+namespace details
+{
+    // FNV-1a of the file name mixed with the line, the id of a log site
+    MUDA_INLINE MUDA_GENERIC constexpr uint32_t log_site_id(const char* file, uint32_t line)
+    {
+        uint32_t hash = 2166136261u;
+        for(; *file; ++file)
+            hash = (hash ^ static_cast<uint8_t>(*file)) * 16777619u;
+        return (hash ^ line) * 16777619u;
+    }
+}  // namespace details
+
 class LogProxy
 {
     LoggerViewer* m_viewer = nullptr;
@@ -16,6 +29,9 @@ class LogProxy
     MUDA_DEVICE LogProxy() = default;
     MUDA_DEVICE LogProxy(LoggerViewer& viewer);
 
+    // a disabled proxy (filtered out), every `<<` on it is a no-op
+    MUDA_DEVICE bool is_enabled() const { return m_viewer != nullptr; }
+
     MUDA_DEVICE LogProxy(const LogProxy& other)
         : m_viewer(other.m_viewer)
         , m_log_id(other.m_log_id)
@@ -79,6 +95,24 @@ class LoggerViewer
     MUDA_DEVICE LogProxy& push_string(const char* str);
     MUDA_DEVICE LogProxy  proxy() { return LogProxy(*this); }
 
+    /**
+     * \brief Start a log of `level` from log site `site`, filtered on the device by the
+     * `LoggerFilter` of this viewer. A filtered out log costs the level comparison
+     * (plus one atomic on the site counter when sampling), the following `<<` do nothing.
+     *
+     * \code
+     *  MUDA_LOG(logger, Debug) << "x=" << x << "\n";
+     *  // same as
+     *  logger.log(LogLevel::Debug, MUDA_LOG_SITE()) << "x=" << x << "\n";
+     * \endcode
+     */
+    MUDA_DEVICE LogProxy& log(LogLevel level, uint32_t site);
+    // no site: only the level threshold applies
+    MUDA_DEVICE LogProxy& log(LogLevel level);
+
+    MUDA_DEVICE bool accept(LogLevel level) const;
+    MUDA_DEVICE bool accept(LogLevel level, uint32_t site) const;
+
     LogProxy m_proxy;
 
   public:
@@ -91,6 +125,10 @@ class LoggerViewer
     char*                    m_buffer            = nullptr;
     int                      m_buffer_size       = 0;
     details::LoggerOffset*   m_offset            = nullptr;
+    LoggerFilter             m_filter;
+    // hits per log site since the last retrieve, size is a power of 2
+    uint32_t* m_site_counter      = nullptr;
+    uint32_t  m_site_counter_size = 0;
 
     MUDA_DEVICE uint32_t next_meta_data_idx() const;
     MUDA_DEVICE uint32_t next_buffer_idx(uint32_t size) const;
@@ -98,4 +136,10 @@ class LoggerViewer
 };
 }  // namespace muda
 
+// a compile time constant, the file name is never hashed at run time
+#define MUDA_LOG_SITE()                                                        \
+    ::std::integral_constant<uint32_t, ::muda::details::log_site_id(__FILE__, __LINE__)>::value
+// log with a level and a log site, e.g. `MUDA_LOG(logger, Warn) << "nan at " << i;`
+#define MUDA_LOG(viewer, level) (viewer).log(::muda::LogLevel::level, MUDA_LOG_SITE())
+
 #include <muda/logger/details/logger_viewer.inl>
\ No newline at end of file
@@ -2,6 +2,12 @@
 #ifndef MUDA_CHECK_ON
 #define MUDA_CHECK_ON 0
 #endif
+// checks compiled in, enabled per kernel at runtime (see muda::RuntimeCheck)
+#ifndef MUDA_SELECTIVE_CHECK_ON
+#define MUDA_SELECTIVE_CHECK_ON 0
+#endif
+// kernel and viewer names are tracked whenever any check can fire
+#define MUDA_CHECK_INFO_ON (MUDA_CHECK_ON || MUDA_SELECTIVE_CHECK_ON)
 #ifndef MUDA_COMPUTE_GRAPH_ON
 #define MUDA_COMPUTE_GRAPH_ON 0
 #endif
@@ -10,6 +16,9 @@ namespace muda
 {
 constexpr bool RUNTIME_CHECK_ON = MUDA_CHECK_ON;
 constexpr bool COMPUTE_GRAPH_ON = MUDA_COMPUTE_GRAPH_ON;
+// MUDA_CHECK_ON wins, everything is checked
+constexpr bool SELECTIVE_CHECK_ON = MUDA_SELECTIVE_CHECK_ON && !MUDA_CHECK_ON;
+constexpr bool CHECK_INFO_ON      = MUDA_CHECK_INFO_ON;
 namespace config
 {
     constexpr bool on(bool cond = false)
@@ -20,7 +29,7 @@ namespace config
 // debug viewer
 constexpr bool DEBUG_VIEWER = config::on(true);
 // trap on error happens
-constexpr bool TRAP_ON_ERROR = config::on(true);
+constexpr bool TRAP_ON_ERROR = config::on(true) || SELECTIVE_CHECK_ON;
 // light workload block size
 constexpr int LIGHT_WORKLOAD_BLOCK_SIZE = 256;
 // middle workload block size
@@ -65,7 +65,8 @@
     }
 
 // check whether (res == true), if not, print the error info (when muda::TRAP_ON_ERROR == true
-// trap the device)
+// trap the device). Only on with MUDA_CHECK_ON, checks of viewer accesses use
+// MUDA_VIEWER_ASSERT / MUDA_CHECKED_ASSERT to follow the RuntimeCheck allowlist
 #define MUDA_KERNEL_ASSERT(res, fmt, ...)                                         \
     {                                                                             \
         if constexpr(::muda::RUNTIME_CHECK_ON)                                    \
@@ -82,6 +83,27 @@
         }                                                                         \
     }
 
+// same as MUDA_KERNEL_ASSERT, but only when the checks of `viewer` are on, see
+// ViewerBase::checked() (always with MUDA_CHECK_ON, per kernel with MUDA_SELECTIVE_CHECK_ON)
+#define MUDA_CHECKED_ASSERT(viewer, res, fmt, ...)                                \
+    {                                                                             \
+        if((viewer).checked())                                                    \
+        {                                                                         \
+            if(!(res))                                                            \
+            {                                                                     \
+                MUDA_KERNEL_PRINT("%s(%d): %s:\n <assert> " #res " failed. " fmt, \
+                                  __FILE__,                                       \
+                                  __LINE__,                                       \
+                                  MUDA_FUNCTION_SIG,                              \
+                                  ##__VA_ARGS__);                                 \
+                MUDA_DEBUG_TRAP();                                                \
+            }                                                                     \
+        }                                                                         \
+    }
+
+// MUDA_CHECKED_ASSERT on the viewer itself, for use in viewer member functions
+#define MUDA_VIEWER_ASSERT(res, fmt, ...) MUDA_CHECKED_ASSERT((*this), res, fmt, ##__VA_ARGS__)
+
 // check whether (res == true), if not, print the error info(never trap the device)
 #define MUDA_KERNEL_CHECK(res, fmt, ...)                                         \
     {                                                                            \
@@ -0,0 +1,82 @@
+#pragma once
+#include <cinttypes>
+#include <string_view>
+
+namespace muda
+{
+namespace details
+{
+    // 32-bit FNV-1a, usable in constant expressions
+    constexpr uint32_t fnv1a_32(const char* s, size_t size) noexcept
+    {
+        uint32_t hash = 2166136261u;
+        for(size_t i = 0; i < size; ++i)
+        {
+            hash ^= static_cast<uint8_t>(s[i]);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    // id 0 is reserved for the empty name
+    constexpr uint32_t interned_name_id(std::string_view s) noexcept
+    {
+        if(s.empty())
+            return 0;
+        auto hash = fnv1a_32(s.data(), s.size());
+        return hash == 0 ? 1 : hash;
+    }
+}  // namespace details
+
+/**
+ * \brief A name with a 32-bit id computed at compile time.
+ *
+ * Viewers and kernels only carry the id, the string itself is registered
+ * on the host and resolved on the device when an error is reported.
+ *
+ * \code
+ *  using namespace muda;
+ *  ParallelFor()
+ *      .kernel_name("set_buffer"_name) // no hashing at runtime
+ *      .apply(N,
+ *          [
+ *              buffer = buffer.viewer().name("buffer"_name)
+ *          ] __device__(int i) mutable { buffer(i) = 1; });
+ * \endcode
+ */
+class InternedName
+{
+    uint32_t    m_id   = 0;
+    const char* m_data = "";
+    size_t      m_size = 0;
+
+  public:
+    constexpr InternedName() noexcept = default;
+
+    constexpr explicit InternedName(std::string_view s) noexcept
+        : m_id(details::interned_name_id(s))
+        , m_data(s.data())
+        , m_size(s.size())
+    {
+    }
+
+    constexpr InternedName(uint32_t id, std::string_view s) noexcept
+        : m_id(id)
+        , m_data(s.data())
+        , m_size(s.size())
+    {
+    }
+
+    constexpr uint32_t         id() const noexcept { return m_id; }
+    constexpr std::string_view view() const noexcept
+    {
+        return std::string_view{m_data, m_size};
+    }
+    constexpr bool empty() const noexcept { return m_id == 0; }
+};
+
+constexpr InternedName operator"" _name(const char* s, size_t size) noexcept
+{
+    return InternedName{std::string_view{s, size}};
+}
+}  // namespace muda
@@ -0,0 +1,319 @@
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <unordered_map>
+#include <cuda_runtime.h>
+#include <muda/muda_def.h>
+#include <muda/muda_config.h>
+#include <muda/check/check_cuda_errors.h>
+#include <muda/tools/debug_log.h>
+#include <muda/tools/interned_name.h>
+
+namespace muda::details
+{
+// device side copy of the interned names: an open addressing hash table
+// (id 0 marks a free slot) in mapped host memory, immutable except for
+// free slots being filled
+struct InternedNameTableBlock
+{
+    const char* chars;
+    uint32_t*   ids;
+    uint32_t*   offsets;  // into chars
+    uint32_t    capacity;  // power of 2
+};
+
+// the mapped slot holding the current block, its address never changes
+using InternedNameTableSlot = InternedNameTableBlock* volatile;
+
+/**
+ * \brief Host registry of all names used by kernels and viewers.
+ *
+ * Registration is a lookup in a per-thread cache, the table is only locked
+ * when an id is new to the calling thread. With MUDA_CHECK_INFO_ON a new name
+ * is also written to the device side table right away, so names resolve in
+ * every kernel, whatever launched it.
+ *
+ * The device table is reached through a pointer that each translation unit
+ * (each device module without -rdc) keeps in its own `__device__` variable,
+ * see `interned_name_table_slot` below.
+ */
+class InternedNameTable
+{
+  public:
+    // writes the address of the table slot to the device variable of one module
+    using ModulePublisher = void (*)(cudaStream_t, InternedNameTableSlot*);
+
+  private:
+    std::unordered_map<uint32_t, std::string> m_names;
+    std::mutex                                m_mutex;
+
+#if MUDA_CHECK_INFO_ON
+    InternedNameTableSlot*       m_slot           = nullptr;
+    InternedNameTableBlock*      m_block          = nullptr;
+    char*                        m_chars          = nullptr;
+    size_t                       m_chars_size     = 0;
+    size_t                       m_chars_capacity = 0;
+    uint32_t                     m_count          = 0;
+    cudaStream_t                 m_stream         = nullptr;
+    std::vector<ModulePublisher> m_pending_modules;
+    std::atomic<bool>            m_has_pending_modules = false;
+    // old blocks are kept alive, kernels in flight may still read them
+    std::vector<void*> m_host_buffers;
+#endif
+
+    InternedNameTable() { m_names.emplace(0u, std::string{}); }
+
+    static auto& thread_cache()
+    {
+        thread_local std::unordered_map<uint32_t, InternedName> cache;
+        return cache;
+    }
+
+  public:
+    ~InternedNameTable()
+    {
+#if MUDA_CHECK_INFO_ON
+        // the runtime may already be shut down at exit, errors are ignored
+        for(auto b : m_host_buffers)
+            cudaFreeHost(b);
+#endif
+    }
+
+    InternedNameTable(const InternedNameTable&)            = delete;
+    InternedNameTable& operator=(const InternedNameTable&) = delete;
+
+    static InternedNameTable& instance()
+    {
+        static InternedNameTable table;
+        return table;
+    }
+
+    // the returned name refers to the storage of the table
+    InternedName intern(const InternedName& name)
+    {
+        if(name.empty())
+            return InternedName{};
+
+        auto& cache = thread_cache();
+        if(auto it = cache.find(name.id()); it != cache.end() && it->second.view() == name.view())
+            return it->second;
+
+        std::lock_guard lock{m_mutex};
+        auto [it, inserted] = m_names.try_emplace(name.id(), name.view());
+        if(!inserted && it->second != name.view())
+            MUDA_ERROR_WITH_LOCATION(
+                "InternedNameTable: the names \"%s\" and \"%.*s\" have the same id (%u), rename one of them",
+                it->second.c_str(),
+                static_cast<int>(name.view().size()),
+                name.view().data(),
+                name.id());
+#if MUDA_CHECK_INFO_ON
+        publish_pending_modules();
+        if(inserted)
+            insert_device(it->first, it->second);
+#endif
+        InternedName interned{it->first, it->second};
+        cache.emplace(interned.id(), interned);
+        return interned;
+    }
+
+    InternedName intern(std::string_view name)
+    {
+        return intern(InternedName{name});
+    }
+
+    const char* find(uint32_t id)
+    {
+        auto& cache = thread_cache();
+        if(auto it = cache.find(id); it != cache.end())
+            return it->second.view().data();
+
+        std::lock_guard lock{m_mutex};
+        auto            it = m_names.find(id);
+        return it == m_names.end() ? nullptr : it->second.c_str();
+    }
+
+    // called once per translation unit (at static initialization, so no CUDA
+    // call is made here), the module is published with the next registration
+    // or launch
+    bool register_module(ModulePublisher publisher)
+    {
+#if MUDA_CHECK_INFO_ON
+        std::lock_guard lock{m_mutex};
+        m_pending_modules.push_back(publisher);
+        m_has_pending_modules.store(true, std::memory_order_release);
+#endif
+        return true;
+    }
+
+    // make the table reachable from the modules registered since the last call
+    void publish_modules()
+    {
+#if MUDA_CHECK_INFO_ON
+        if(!m_has_pending_modules.load(std::memory_order_acquire))
+            return;
+        std::lock_guard lock{m_mutex};
+        publish_pending_modules();
+#endif
+    }
+
+    // resolve an id to a null-terminated string, nullptr if not found
+    MUDA_INLINE MUDA_GENERIC static const char* resolve(uint32_t id) MUDA_NOEXCEPT;
+
+  private:
+#if MUDA_CHECK_INFO_ON
+    // the CUDA calls below may run while a graph is captured on this thread
+    class RelaxedCapture
+    {
+        cudaStreamCaptureMode m_mode = cudaStreamCaptureModeRelaxed;
+
+      public:
+        RelaxedCapture() { cudaThreadExchangeStreamCaptureMode(&m_mode); }
+        ~RelaxedCapture() { cudaThreadExchangeStreamCaptureMode(&m_mode); }
+    };
+
+    void* alloc_mapped(size_t bytes)
+    {
+        void* ptr = nullptr;
+        checkCudaErrors(cudaHostAlloc(&ptr, bytes, cudaHostAllocMapped | cudaHostAllocPortable));
+        std::memset(ptr, 0, bytes);
+        m_host_buffers.push_back(ptr);
+        return ptr;
+    }
+
+    void ensure_slot()
+    {
+        if(!m_slot)
+            m_slot = static_cast<InternedNameTableSlot*>(
+                alloc_mapped(sizeof(InternedNameTableSlot)));
+    }
+
+    void publish_pending_modules()
+    {
+        if(m_pending_modules.empty())
+            return;
+
+        RelaxedCapture relaxed;
+        ensure_slot();
+        // a private stream, the copies must not sync with captured streams
+        if(!m_stream)
+            checkCudaErrors(cudaStreamCreateWithFlags(&m_stream, cudaStreamNonBlocking));
+        for(auto publish : m_pending_modules)
+            publish(m_stream, m_slot);
+        checkCudaErrors(cudaStreamSynchronize(m_stream));
+        m_pending_modules.clear();
+        m_has_pending_modules.store(false, std::memory_order_release);
+    }
+
+    static void insert_slot(InternedNameTableBlock* block, uint32_t id, uint32_t offset)
+    {
+        auto mask = block->capacity - 1;
+        auto i    = id & mask;
+        while(block->ids[i] != 0)
+            i = (i + 1) & mask;
+        block->offsets[i] = offset;
+        // a reader seeing the id sees the offset and the chars
+        std::atomic_thread_fence(std::memory_order_release);
+        reinterpret_cast<volatile uint32_t*>(block->ids)[i] = id;
+    }
+
+    // rebuild the table into new storage, the old storage stays valid
+    void grow(uint32_t capacity, size_t chars_capacity)
+    {
+        RelaxedCapture relaxed;
+        auto chars = static_cast<char*>(alloc_mapped(chars_capacity));
+        if(m_chars_size)
+            std::memcpy(chars, m_chars, m_chars_size);
+
+        auto bytes = sizeof(InternedNameTableBlock) + 2 * capacity * sizeof(uint32_t);
+        auto block = static_cast<InternedNameTableBlock*>(alloc_mapped(bytes));
+        block->chars    = chars;
+        block->ids      = reinterpret_cast<uint32_t*>(block + 1);
+        block->offsets  = block->ids + capacity;
+        block->capacity = capacity;
+        if(m_block)
+            for(uint32_t i = 0; i < m_block->capacity; ++i)
+                if(m_block->ids[i] != 0)
+                    insert_slot(block, m_block->ids[i], m_block->offsets[i]);
+
+        m_block          = block;
+        m_chars          = chars;
+        m_chars_capacity = chars_capacity;
+        std::atomic_thread_fence(std::memory_order_release);
+        ensure_slot();
+        *m_slot = block;
+    }
+
+    void insert_device(uint32_t id, const std::string& name)
+    {
+        auto bytes = name.size() + 1;
+        // load factor <= 1/2
+        uint32_t capacity       = m_block ? m_block->capacity : 256;
+        size_t   chars_capacity = m_block ? m_chars_capacity : 8192;
+        while(2 * (m_count + 1) > capacity)
+            capacity *= 2;
+        while(m_chars_size + bytes > chars_capacity)
+            chars_capacity *= 2;
+        if(!m_block || capacity != m_block->capacity || chars_capacity != m_chars_capacity)
+            grow(capacity, chars_capacity);
+
+        std::memcpy(m_chars + m_chars_size, name.c_str(), bytes);
+        insert_slot(m_block, id, static_cast<uint32_t>(m_chars_size));
+        m_chars_size += bytes;
+        ++m_count;
+    }
+#endif
+};
+
+#if MUDA_CHECK_INFO_ON
+namespace
+{
+    // one per translation unit, and so one per device module also without
+    // -rdc (an `inline __device__` variable would be duplicated per module
+    // while its host shadow is shared, so only one copy could be filled)
+    MUDA_DEVICE InternedNameTableSlot* interned_name_table_slot = nullptr;
+
+#ifdef __CUDACC__
+    void publish_interned_name_table(cudaStream_t stream, InternedNameTableSlot* slot)
+    {
+        checkCudaErrors(cudaMemcpyToSymbolAsync(
+            interned_name_table_slot, &slot, sizeof(slot), 0, cudaMemcpyHostToDevice, stream));
+    }
+
+    [[maybe_unused]] const bool interned_name_table_registered =
+        InternedNameTable::instance().register_module(publish_interned_name_table);
+#endif
+}  // namespace
+#endif
+
+MUDA_INLINE MUDA_GENERIC const char* InternedNameTable::resolve(uint32_t id) MUDA_NOEXCEPT
+{
+    if(id == 0)
+        return "";
+#ifdef __CUDA_ARCH__
+#if MUDA_CHECK_INFO_ON
+    if(!interned_name_table_slot)
+        return nullptr;
+    const InternedNameTableBlock* block = *interned_name_table_slot;
+    if(!block)
+        return nullptr;
+    auto                     mask = block->capacity - 1;
+    const volatile uint32_t* ids  = block->ids;
+    for(uint32_t i = id & mask, n = 0; n < block->capacity; i = (i + 1) & mask, ++n)
+    {
+        auto m = ids[i];
+        if(m == id)
+            return block->chars + block->offsets[i];
+        if(m == 0)
+            break;
+    }
+#endif
+    return nullptr;
+#else
+    return instance().find(id);
+#endif
+}
+}  // namespace muda::details
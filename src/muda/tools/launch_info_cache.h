@@ -1,33 +1,53 @@
 #pragma once
-#include <muda/tools/host_device_string_cache.h>
+#include <muda/tools/interned_name_table.h>
+#include <muda/tools/runtime_check.h>
 namespace muda::details
 {
 class LaunchInfoCache
 {
   private:
-    HostDeviceStringCache m_view_name_string_cache;
-    HostDeviceStringCache m_kernel_name_string_cache;
-    HostDeviceStringCache m_capture_name_string_cache;
+    InternedName m_current_kernel_name;
+    InternedName m_current_capture_name;
+    // whether the current kernel is on the RuntimeCheck allowlist
+    bool m_current_kernel_checked = RUNTIME_CHECK_ON;
 
-    StringPointer m_current_kernel_name;
-    StringPointer m_current_capture_name;
+    LaunchInfoCache() MUDA_NOEXCEPT = default;
 
-    LaunchInfoCache() MUDA_NOEXCEPT
+    static auto& table() MUDA_NOEXCEPT
     {
-        m_current_kernel_name = m_kernel_name_string_cache[std::string_view{""}];
-        m_current_capture_name = m_capture_name_string_cache[std::string_view{""}];
+        return InternedNameTable::instance();
     }
 
   public:
+    // the names of viewers and kernels are only kept with MUDA_CHECK_INFO_ON,
+    // otherwise the name is returned as is, without a lookup
+    static InternedName view_name(std::string_view name) MUDA_NOEXCEPT
+    {
+        return view_name(InternedName{name});
+    }
+
+    static InternedName view_name(const InternedName& name) MUDA_NOEXCEPT
+    {
+        if constexpr(muda::CHECK_INFO_ON)
+            return table().intern(name);
+        else
+            return name;
+    }
 
-    static auto view_name(std::string_view name) MUDA_NOEXCEPT
+    static InternedName current_kernel_name(std::string_view name) MUDA_NOEXCEPT
     {
-        return instance().m_view_name_string_cache[name];
+        return current_kernel_name(InternedName{name});
     }
-    static auto current_kernel_name(std::string_view name) MUDA_NOEXCEPT
+
+    static InternedName current_kernel_name(const InternedName& name) MUDA_NOEXCEPT
     {
-        auto& ins                 = instance();
-        ins.m_current_kernel_name = ins.m_kernel_name_string_cache[name];
+        auto& ins = instance();
+        if constexpr(muda::CHECK_INFO_ON)
+        {
+            ins.m_current_kernel_name = table().intern(name);
+            if constexpr(muda::SELECTIVE_CHECK_ON)
+                ins.m_current_kernel_checked = RuntimeCheck::is_enabled(name.id());
+        }
         return ins.m_current_kernel_name;
     }
 
@@ -36,10 +56,15 @@ class LaunchInfoCache
         return instance().m_current_kernel_name;
     }
 
+    static bool current_kernel_checked() MUDA_NOEXCEPT
+    {
+        return instance().m_current_kernel_checked;
+    }
+
     static auto current_capture_name(std::string_view name) MUDA_NOEXCEPT
     {
         auto& ins                  = instance();
-        ins.m_current_capture_name = ins.m_capture_name_string_cache[name];
+        ins.m_current_capture_name = table().intern(name);
         return ins.m_current_capture_name;
     }
 
@@ -48,10 +73,18 @@ class LaunchInfoCache
         return instance().m_current_capture_name;
     }
 
+    // names are uploaded when registered, this only covers modules loaded
+    // after the last registration
+    static void prepare_launch() MUDA_NOEXCEPT
+    {
+        if constexpr(muda::CHECK_INFO_ON)
+            table().publish_modules();
+    }
+
     static LaunchInfoCache& instance() MUDA_NOEXCEPT
     {
         thread_local static LaunchInfoCache instance;
         return instance;
     }
 };
-}  // namespace muda::details
\ No newline at end of file
+}  // namespace muda::details
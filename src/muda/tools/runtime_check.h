@@ -0,0 +1,168 @@
+#pragma once
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <string_view>
+#include <typeinfo>
+#include <unordered_set>
+#include <muda/muda_config.h>
+#include <muda/tools/interned_name.h>
+
+namespace muda
+{
+namespace details
+{
+    // the kernel name a `Tag<UserTag>` launch is known by
+    template <typename UserTag>
+    std::string_view tag_kernel_name() noexcept
+    {
+        return typeid(UserTag).name();
+    }
+}  // namespace details
+
+/**
+ * \brief The allowlist of kernels whose viewer checks are on, used when muda is
+ * compiled with `MUDA_SELECTIVE_CHECK_ON=1` (and `MUDA_CHECK_ON=0`).
+ *
+ * A viewer records whether the kernel it is captured by is on the list (by the
+ * current `kernel_name`) when it's created on the host, so the viewer must be
+ * created after `kernel_name()` is called, e.g. in the capture list of the
+ * lambda passed to `apply()`. A viewer created earlier keeps the setting of
+ * the kernel name current at that time. Checked viewers do the usual
+ * bounds/null checks, the others skip them behind a uniform branch.
+ * The list is read from `MUDA_CHECK_KERNELS` (comma separated) on first use.
+ *
+ * \code
+ *  RuntimeCheck::enable("suspect");
+ *  ParallelFor()
+ *      .kernel_name("suspect") // checked
+ *      .apply(N, [x = x.viewer()] __device__(int i) mutable { x(i) = 1; });
+ *
+ *  RuntimeCheck::enable<MyTag>();
+ *  ParallelFor()
+ *      .kernel_name(Tag<MyTag>{}) // checked
+ *      .apply(N, [x = x.viewer()] __device__(int i) mutable { x(i) = 1; });
+ * \endcode
+ */
+class RuntimeCheck
+{
+    std::unordered_set<uint32_t> m_kernels;
+    std::mutex                   m_mutex;
+    // bumped (under the lock) on every change, readers keep a per-thread copy
+    // of the list and only lock when it is stale
+    std::atomic<uint64_t> m_generation = 1;
+
+    RuntimeCheck()
+    {
+        if(auto env = std::getenv("MUDA_CHECK_KERNELS"))
+            add_list(env);
+    }
+
+    void add_list(std::string_view list)
+    {
+        while(!list.empty())
+        {
+            auto comma = list.find(',');
+            auto name  = list.substr(0, comma);
+            while(!name.empty() && name.front() == ' ')
+                name.remove_prefix(1);
+            while(!name.empty() && name.back() == ' ')
+                name.remove_suffix(1);
+            if(!name.empty())
+                m_kernels.insert(details::interned_name_id(name));
+            list = comma == std::string_view::npos ? std::string_view{} :
+                                                     list.substr(comma + 1);
+        }
+    }
+
+    static RuntimeCheck& instance()
+    {
+        static RuntimeCheck list;
+        return list;
+    }
+
+  public:
+    // check the kernels named `kernel_name`
+    static void enable(std::string_view kernel_name)
+    {
+        auto&           ins = instance();
+        std::lock_guard lock{ins.m_mutex};
+        ins.m_kernels.insert(details::interned_name_id(kernel_name));
+        ins.m_generation.fetch_add(1, std::memory_order_release);
+    }
+
+    // check the kernels named by `kernel_name(Tag<UserTag>{})`
+    template <typename UserTag>
+    static void enable()
+    {
+        enable(details::tag_kernel_name<UserTag>());
+    }
+
+    // check the kernels in a comma separated list, e.g. "integrate, collide"
+    static void enable_list(std::string_view kernel_names)
+    {
+        auto&           ins = instance();
+        std::lock_guard lock{ins.m_mutex};
+        ins.add_list(kernel_names);
+        ins.m_generation.fetch_add(1, std::memory_order_release);
+    }
+
+    static void disable(std::string_view kernel_name)
+    {
+        auto&           ins = instance();
+        std::lock_guard lock{ins.m_mutex};
+        ins.m_kernels.erase(details::interned_name_id(kernel_name));
+        ins.m_generation.fetch_add(1, std::memory_order_release);
+    }
+
+    template <typename UserTag>
+    static void disable()
+    {
+        disable(details::tag_kernel_name<UserTag>());
+    }
+
+    static void clear()
+    {
+        auto&           ins = instance();
+        std::lock_guard lock{ins.m_mutex};
+        ins.m_kernels.clear();
+        ins.m_generation.fetch_add(1, std::memory_order_release);
+    }
+
+    // always true with MUDA_CHECK_ON, always false without any check mode
+    static bool is_enabled(uint32_t kernel_name_id)
+    {
+        if constexpr(RUNTIME_CHECK_ON)
+            return true;
+        else if constexpr(SELECTIVE_CHECK_ON)
+        {
+            if(kernel_name_id == 0)
+                return false;
+            thread_local uint64_t                     generation = 0;
+            thread_local std::unordered_set<uint32_t> kernels;
+
+            auto& ins = instance();
+            if(ins.m_generation.load(std::memory_order_acquire) != generation)
+            {
+                std::lock_guard lock{ins.m_mutex};
+                kernels    = ins.m_kernels;
+                generation = ins.m_generation.load(std::memory_order_relaxed);
+            }
+            return kernels.count(kernel_name_id) != 0;
+        }
+        else
+            return false;
+    }
+
+    static bool is_enabled(std::string_view kernel_name)
+    {
+        return is_enabled(details::interned_name_id(kernel_name));
+    }
+
+    template <typename UserTag>
+    static bool is_enabled()
+    {
+        return is_enabled(details::tag_kernel_name<UserTag>());
+    }
+};
+}  // namespace muda
@@ -31,4 +31,11 @@ constexpr bool DEFAULT_ASYNC_ALLOC_FREE = false;
 #define MUDA_WITH_DEVICE_STREAM_MODEL 1
 #else
 #define MUDA_WITH_DEVICE_STREAM_MODEL 0
+#endif
+
+#if(__CUDACC_VER_MAJOR__ > 12)                                                  \
+    || ((__CUDACC_VER_MAJOR__ == 12) && (__CUDACC_VER_MINOR__ >= 4))
+#define MUDA_WITH_GRAPH_CONDITIONAL_NODE 1
+#else
+#define MUDA_WITH_GRAPH_CONDITIONAL_NODE 0
 #endif
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+namespace muda
+{
+// `[] __device__ (...) {...}` (--extended-lambda), its call operator can't be
+// used in host code, unlike `[] __host__ __device__ (...) {...}`
+template <typename F>
+struct is_device_lambda
+{
+#if defined(__CUDACC__) && defined(__CUDACC_EXTENDED_LAMBDA__)
+    constexpr static bool value = __nv_is_extended_device_lambda_closure_type(F);
+#else
+    constexpr static bool value = false;
+#endif
+};
+
+template <typename F>
+constexpr bool is_device_lambda_v = is_device_lambda<F>::value;
+}  // namespace muda
@@ -1,2 +1,3 @@
 #pragma once
-#include <muda/viewer/dense.h>
\ No newline at end of file
+#include <muda/viewer/dense.h>
+#include <muda/viewer/append_buffer_viewer.h>
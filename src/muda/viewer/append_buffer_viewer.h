@@ -0,0 +1,82 @@
+#pragma once
+#include <muda/viewer/viewer_base.h>
+#include <muda/cuda/cooperative_groups.h>
+
+namespace muda
+{
+/**
+ * \brief In-kernel appender of a `DeviceAppendBuffer<T>`.
+ *
+ * `push_back` is warp-aggregated: the active threads of a warp reserve their
+ * slots with one atomic. The counter keeps counting past the capacity, so the
+ * host knows the exact required size when the buffer overflows, the elements
+ * that don't fit are dropped.
+ */
+template <typename T>
+class AppendBufferViewer : public ViewerBase<false>
+{
+    using Base = ViewerBase<false>;
+    MUDA_VIEWER_COMMON_NAME(AppendBufferViewer);
+
+  public:
+    using value_type = T;
+
+  protected:
+    T*   m_data     = nullptr;
+    int* m_count    = nullptr;
+    int  m_capacity = 0;
+
+  public:
+    MUDA_GENERIC AppendBufferViewer() MUDA_NOEXCEPT = default;
+
+    MUDA_GENERIC AppendBufferViewer(T* data, int* count, int capacity) MUDA_NOEXCEPT
+        : m_data(data),
+          m_count(count),
+          m_capacity(capacity)
+    {
+    }
+
+    MUDA_GENERIC int capacity() const MUDA_NOEXCEPT { return m_capacity; }
+
+    /**
+     * \brief Append a value.
+     *
+     * \return the index of the value, -1 if the buffer overflows.
+     */
+    MUDA_GENERIC int push_back(const T& value) MUDA_NOEXCEPT
+    {
+        auto i = next_index();
+        if(i >= m_capacity)
+            return -1;
+        m_data[i] = value;
+        return i;
+    }
+
+  private:
+    MUDA_INLINE MUDA_GENERIC int next_index() MUDA_NOEXCEPT
+    {
+        check();
+#ifdef __CUDA_ARCH__
+        namespace cg = cooperative_groups;
+        auto g    = cg::coalesced_threads();
+        int  base = 0;
+        if(g.thread_rank() == 0)
+            base = atomicAdd(m_count, static_cast<int>(g.size()));
+        return g.shfl(base, 0) + static_cast<int>(g.thread_rank());
+#else
+        return (*m_count)++;
+#endif
+    }
+
+    MUDA_INLINE MUDA_GENERIC void check() const MUDA_NOEXCEPT
+    {
+        if(this->checked())
+        {
+            MUDA_VIEWER_ASSERT(m_count,
+                               "AppendBuffer[%s:%s]: m_count is null",
+                               this->name(),
+                               this->kernel_name());
+        }
+    }
+};
+}  // namespace muda
@@ -69,9 +69,9 @@ class DenseViewerBase : public ViewerBase<IsConst>
   protected:
     MUDA_INLINE MUDA_GENERIC void check() const MUDA_NOEXCEPT
     {
-        if constexpr(DEBUG_VIEWER)
+        if(this->checked())
         {
-            MUDA_KERNEL_ASSERT(m_data,
+            MUDA_VIEWER_ASSERT(m_data,
                                "Dense[%s:%s]: m_data is null",
                                this->name(),
                                this->kernel_name());
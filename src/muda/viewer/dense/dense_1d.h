@@ -82,7 +82,7 @@ class Dense1DBase : public ViewerBase<IsConst>
     MUDA_GENERIC ThisViewer subview(int offset) MUDA_NOEXCEPT
     {
         auto size = this->m_dim - offset;
-        if constexpr(DEBUG_VIEWER)
+        if(this->checked())
         {
             if(offset < 0)
                 MUDA_KERNEL_ERROR("Dense1D[%s:%s]: subview out of range, offset=%d size=%d m_dim=(%d)",
@@ -92,12 +92,14 @@ class Dense1DBase : public ViewerBase<IsConst>
                                   size,
                                   this->m_dim);
         }
-        return ThisViewer{this->m_data + offset, size};
+        ThisViewer ret{this->m_data + offset, size};
+        ret.copy_name(*this);
+        return ret;
     }
 
     MUDA_GENERIC ThisViewer subview(int offset, int size) MUDA_NOEXCEPT
     {
-        if constexpr(DEBUG_VIEWER)
+        if(this->checked())
         {
             if(offset < 0 || offset + size > m_dim)
                 MUDA_KERNEL_ERROR("Dense1D[%s:%s]: subview out of range, offset=%d size=%d m_dim=(%d)",
@@ -107,7 +109,9 @@ class Dense1DBase : public ViewerBase<IsConst>
                                   size,
                                   this->m_dim);
         }
-        return ThisViewer{this->m_data + offset, size};
+        ThisViewer ret{this->m_data + offset, size};
+        ret.copy_name(*this);
+        return ret;
     }
 
     MUDA_GENERIC ConstViewer subview(int offset) const MUDA_NOEXCEPT
@@ -123,7 +127,7 @@ class Dense1DBase : public ViewerBase<IsConst>
   protected:
     MUDA_INLINE MUDA_GENERIC void check() const MUDA_NOEXCEPT
     {
-        if constexpr(DEBUG_VIEWER)
+        if(this->checked())
             if(m_data == nullptr)
                 MUDA_KERNEL_ERROR("Dense1D[%s:%s]: m_data is null",
                                   this->name(),
@@ -132,7 +136,7 @@ class Dense1DBase : public ViewerBase<IsConst>
 
     MUDA_GENERIC int map(int x) const MUDA_NOEXCEPT
     {
-        if constexpr(DEBUG_VIEWER)
+        if(this->checked())
             if(!(x >= 0 && x < m_dim))
                 MUDA_KERNEL_ERROR("Dense1D[%s:%s]: out of range, index=(%d) m_dim=(%d)",
                                   this->name(),
@@ -79,9 +79,9 @@ class Dense2DBase : public ViewerBase<IsConst>  // TODO
 
     MUDA_GENERIC auto_const_t<T>& flatten(int i)
     {
-        if constexpr(DEBUG_VIEWER)
+        if(this->checked())
         {
-            MUDA_KERNEL_ASSERT(i >= 0 && i < total_size(),
+            MUDA_VIEWER_ASSERT(i >= 0 && i < total_size(),
                                "Dense2D[%s:%s]: out of range, index=%d, total_size=%d",
                                this->name(),
                                this->kernel_name(),
@@ -131,7 +131,7 @@ class Dense2DBase : public ViewerBase<IsConst>  // TODO
   protected:
     MUDA_INLINE MUDA_GENERIC void check_range(int x, int y) const MUDA_NOEXCEPT
     {
-        if constexpr(DEBUG_VIEWER)
+        if(this->checked())
             if(!(x >= 0 && x < m_dim.x && y >= 0 && y < m_dim.y))
             {
                 MUDA_KERNEL_ERROR("Dense2D[%s:%s]: out of range, index=(%d,%d) dim=(%d,%d)",
@@ -146,9 +146,9 @@ class Dense2DBase : public ViewerBase<IsConst>  // TODO
 
     MUDA_INLINE MUDA_GENERIC void check() const MUDA_NOEXCEPT
     {
-        if constexpr(DEBUG_VIEWER)
+        if(this->checked())
         {
-            MUDA_KERNEL_ASSERT(m_data,
+            MUDA_VIEWER_ASSERT(m_data,
                                "Dense2D[%s:%s]: m_data is null",
                                this->name(),
                                this->kernel_name());
@@ -78,9 +78,9 @@ class Dense3DBase : public ViewerBase<IsConst>
 
     MUDA_GENERIC auto_const_t<T>& flatten(int i) MUDA_NOEXCEPT
     {
-        if constexpr(DEBUG_VIEWER)
+        if(this->checked())
         {
-            MUDA_KERNEL_ASSERT(i >= 0 && i < total_size(),
+            MUDA_VIEWER_ASSERT(i >= 0 && i < total_size(),
                                "Dense3D[%s:%s]: out of range, index=%d, total_size=%d",
                                this->name(),
                                this->kernel_name(),
@@ -138,7 +138,7 @@ class Dense3DBase : public ViewerBase<IsConst>
   protected:
     MUDA_INLINE MUDA_GENERIC void check_range(int x, int y, int z) const MUDA_NOEXCEPT
     {
-        if constexpr(DEBUG_VIEWER)
+        if(this->checked())
         {
             if(!(x >= 0 && x < m_dim.x && y >= 0 && y < m_dim.y && z >= 0
                  && z < m_dim.z))
@@ -156,7 +156,7 @@ class Dense3DBase : public ViewerBase<IsConst>
 
     MUDA_INLINE MUDA_GENERIC void check() const MUDA_NOEXCEPT
     {
-        if constexpr(DEBUG_VIEWER)
+        if(this->checked())
             if(m_data == nullptr)
                 MUDA_KERNEL_ERROR("Dense3D[%s:%s]: data is null",
                                   this->name(),
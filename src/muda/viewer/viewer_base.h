@@ -33,26 +33,50 @@ class ViewerBase
   private:
     // friend class details::ViewerBaseAccessor;
 
-#if MUDA_CHECK_ON
-    details::StringPointer m_viewer_name;
-    details::StringPointer m_kernel_name;
-#else
+#if MUDA_CHECK_INFO_ON
+    // interned name ids, resolved only when an error is reported
+    uint32_t m_viewer_name = 0;
+    uint32_t m_kernel_name = 0;
+#endif
+#if MUDA_SELECTIVE_CHECK_ON && !MUDA_CHECK_ON
+    // the capturing kernel is on the RuntimeCheck allowlist, taken from the
+    // current kernel name at construction, so a viewer must be created after
+    // `kernel_name()` of the launch it is captured by
+    bool m_checked = false;
+#endif
+#if !MUDA_CHECK_INFO_ON
     char m_dummy = 0; // a dummy member to avoid empty class 
 #endif
   public:
     MUDA_GENERIC ViewerBase()
     {
-#if MUDA_CHECK_ON
+#if MUDA_CHECK_INFO_ON
 #ifndef __CUDA_ARCH__
-        m_kernel_name = details::LaunchInfoCache::current_kernel_name();
+        m_kernel_name = details::LaunchInfoCache::current_kernel_name().id();
+#if MUDA_SELECTIVE_CHECK_ON && !MUDA_CHECK_ON
+        m_checked = details::LaunchInfoCache::current_kernel_checked();
+#endif
 #endif
 #endif
     }
 
-    MUDA_GENERIC const char* name() const MUDA_NOEXCEPT
+    // whether the checks of this viewer are on, known at compile time unless
+    // MUDA_SELECTIVE_CHECK_ON is set
+    MUDA_GENERIC bool checked() const MUDA_NOEXCEPT
     {
 #if MUDA_CHECK_ON
-        auto n = m_viewer_name.auto_select();
+        return true;
+#elif MUDA_SELECTIVE_CHECK_ON
+        return m_checked;
+#else
+        return false;
+#endif
+    }
+
+    MUDA_GENERIC const char* name() const MUDA_NOEXCEPT
+    {
+#if MUDA_CHECK_INFO_ON
+        auto n = details::InternedNameTable::resolve(m_viewer_name);
         if(n && *n != '\0')
             return n;
 #endif
@@ -61,9 +85,9 @@ class ViewerBase
 
     MUDA_GENERIC const char* kernel_name() const MUDA_NOEXCEPT
     {
-#if MUDA_CHECK_ON
-        auto n = m_kernel_name.auto_select();
-        if(n && n != '\0')
+#if MUDA_CHECK_INFO_ON
+        auto n = details::InternedNameTable::resolve(m_kernel_name);
+        if(n && *n != '\0')
             return n;
 #endif
         return "~";
@@ -78,23 +102,26 @@ class ViewerBase
   protected:
     MUDA_INLINE MUDA_HOST void name(const char* n) MUDA_NOEXCEPT
     {
-#if MUDA_CHECK_ON
-        m_viewer_name = details::LaunchInfoCache::view_name(n);
+#if MUDA_CHECK_INFO_ON
+        m_viewer_name = details::LaunchInfoCache::view_name(n).id();
 #endif
     }
 
-    MUDA_INLINE MUDA_GENERIC void name(details::StringPointer pointer) MUDA_NOEXCEPT
+    MUDA_INLINE MUDA_HOST void name(const InternedName& n) MUDA_NOEXCEPT
     {
-#if MUDA_CHECK_ON
-        m_viewer_name = pointer;
+#if MUDA_CHECK_INFO_ON
+        m_viewer_name = details::LaunchInfoCache::view_name(n).id();
 #endif
     }
 
     MUDA_INLINE MUDA_GENERIC void copy_name(const ViewerBase& other) MUDA_NOEXCEPT
     {
-#if MUDA_CHECK_ON
+#if MUDA_CHECK_INFO_ON
         m_kernel_name = other.m_kernel_name;
         m_viewer_name = other.m_viewer_name;
+#endif
+#if MUDA_SELECTIVE_CHECK_ON && !MUDA_CHECK_ON
+        m_checked = other.m_checked;
 #endif
     }
 };
@@ -104,6 +131,12 @@ class ViewerBase
     using this_type = viewer_name;                                             \
                                                                                \
     MUDA_INLINE MUDA_HOST this_type& name(const char* n) noexcept              \
+    {                                                                          \
+        ::muda::ViewerBase<viewer_name::IsConst>::name(n);                     \
+        return *this;                                                          \
+    }                                                                          \
+                                                                               \
+    MUDA_INLINE MUDA_HOST this_type& name(const ::muda::InternedName& n) noexcept \
     {                                                                          \
         ::muda::ViewerBase<viewer_name::IsConst>::name(n);                     \
         return *this;                                                          \
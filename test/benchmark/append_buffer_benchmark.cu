@@ -0,0 +1,81 @@
+#include <catch2/catch.hpp>
+#include <muda/muda.h>
+#include <muda/container.h>
+#include <muda/cub/device/device_scan.h>
+
+using namespace muda;
+
+// an expensive predicate, like a narrow phase test of the pairs in a cell
+MUDA_INLINE MUDA_DEVICE bool expensive_pred(int cell, int j)
+{
+    float x = cell * 0.618f + j;
+    for(int k = 0; k < 64; ++k)
+        x = sinf(x) * 1.5f + 0.5f;
+    return x > 0.9f;
+}
+
+// emit the pairs of every cell: DeviceAppendBuffer vs. count / scan / fill
+void append_buffer_benchmark()
+{
+    constexpr int Cells        = 1 << 16;
+    constexpr int PairsPerCell = 32;
+
+    DeviceBuffer<int> counts(Cells + 1);
+    DeviceBuffer<int> offsets(Cells + 1);
+    DeviceBuffer<int> two_pass_out;
+
+    BENCHMARK("two-pass (count, scan, fill)")
+    {
+        ParallelFor(256)
+            .kernel_name("count")
+            .apply(Cells,
+                   [counts = counts.viewer()] __device__(int cell) mutable
+                   {
+                       int n = 0;
+                       for(int j = 0; j < PairsPerCell; ++j)
+                           n += expensive_pred(cell, j);
+                       counts(cell) = n;
+                   });
+        DeviceScan().ExclusiveSum(counts.data(), offsets.data(), Cells + 1);
+        int total = 0;
+        BufferLaunch().copy(&total, offsets.view(Cells, 1)).wait();
+        two_pass_out.resize(total);
+        ParallelFor(256)
+            .kernel_name("fill")
+            .apply(Cells,
+                   [offsets = offsets.viewer(), out = two_pass_out.viewer()] __device__(int cell) mutable
+                   {
+                       int offset = offsets(cell);
+                       for(int j = 0; j < PairsPerCell; ++j)
+                           if(expensive_pred(cell, j))
+                               out(offset++) = cell * PairsPerCell + j;
+                   });
+        return total;
+    };
+
+    // the hint comes from the last frame
+    DeviceAppendBuffer<int> append_out(two_pass_out.size());
+
+    BENCHMARK("single pass (append buffer)")
+    {
+        append_out.clear();
+        return append_out.retry_if_overflow(
+            [&]
+            {
+                ParallelFor(256)
+                    .kernel_name("append")
+                    .apply(Cells,
+                           [out = append_out.viewer()] __device__(int cell) mutable
+                           {
+                               for(int j = 0; j < PairsPerCell; ++j)
+                                   if(expensive_pred(cell, j))
+                                       out.push_back(cell * PairsPerCell + j);
+                           });
+            });
+    };
+}
+
+TEST_CASE("append_buffer_benchmark", "[benchmark]")
+{
+    append_buffer_benchmark();
+}
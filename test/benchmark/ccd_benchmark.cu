@@ -0,0 +1,175 @@
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <muda/muda.h>
+#include <muda/ext/geo/distance/batched_ccd.h>
+#include <muda/ext/geo/distance/inclusion_ccd.h>
+#include "../unit_test/ccd_dataset.h"
+
+using namespace muda;
+using namespace muda::distance;
+using namespace Eigen;
+
+template <typename T>
+static std::vector<Eigen::Matrix<T, 3, 1>> cast(const std::vector<Vector3d>& v)
+{
+    std::vector<Eigen::Matrix<T, 3, 1>> out(v.size());
+    for(size_t i = 0; i < v.size(); ++i)
+        out[i] = v[i].cast<T>();
+    return out;
+}
+
+// the dataset repeated to `n` pairs, enough to fill the device
+static std::vector<Vector4i> repeat(const std::vector<Vector4i>& prims, size_t n)
+{
+    std::vector<Vector4i> out(n);
+    for(size_t i = 0; i < n; ++i)
+        out[i] = prims[i % prims.size()];
+    return out;
+}
+
+class CCDReport
+{
+  public:
+    explicit CCDReport(const std::vector<int>& truth)
+        : m_truth(truth)
+    {
+        std::cout << std::left << std::setw(36) << "algorithm" << std::setw(8)
+                  << "fp" << std::setw(8) << "fn" << "queries/s\n";
+    }
+
+    // `run()` fills `tois` for the repeated pairs, the first ones are checked
+    template <typename T, typename Run>
+    void add(const char* name, size_t pairs, std::vector<T>& tois, Run&& run)
+    {
+        run();  // warm up
+        constexpr int repeats = 5;
+        auto          start   = std::chrono::steady_clock::now();
+        for(int r = 0; r < repeats; ++r)
+            run();
+        double seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        size_t fp = 0, fn = 0;
+        for(size_t i = 0; i < m_truth.size(); ++i)
+        {
+            // nan counts as a hit
+            bool hit = !(tois[i] >= T(1));
+            fp += hit && !m_truth[i];
+            fn += !hit && m_truth[i];
+        }
+        std::cout << std::left << std::setw(36) << name << std::setw(8) << fp
+                  << std::setw(8) << fn << std::fixed << std::setprecision(0)
+                  << pairs * repeats / seconds << "\n";
+    }
+
+  private:
+    const std::vector<int>& m_truth;
+};
+
+void ccd_benchmark(bool point_triangle)
+{
+    std::string dir = std::string{MUDA_TEST_DATA_DIR} + "/unit-tests/"
+                      + (point_triangle ? "vertex-face/" : "edge-edge/");
+    CCDDataset queries;
+    load_ccd_dataset(queries, dir + "data_0_0.csv");
+    load_ccd_dataset(queries, dir + "data_0_1.csv");
+    size_t positives = std::count(queries.truth.begin(), queries.truth.end(), 1);
+    std::cout << (point_triangle ? "vertex-face" : "edge-edge") << ": "
+              << queries.prims.size() << " queries, " << positives << " collisions\n";
+
+    constexpr size_t pairs = 1 << 16;
+    auto             prims = repeat(queries.prims, pairs);
+    auto             xf    = cast<float>(queries.x);
+    auto             dxf   = cast<float>(queries.dx);
+
+    DeviceBuffer<Vector4i> d_prims = prims;
+    DeviceBuffer<Vector3f> d_xf    = xf;
+    DeviceBuffer<Vector3f> d_dxf   = dxf;
+    DeviceBuffer<Vector3d> d_xd    = queries.x;
+    DeviceBuffer<Vector3d> d_dxd   = queries.dx;
+    DeviceBuffer<float>    d_toisf(pairs);
+    DeviceBuffer<double>   d_toisd(pairs);
+    std::vector<float>     toisf;
+    std::vector<double>    toisd;
+
+    CCDReport report{queries.truth};
+
+    // the additive CCD never terminates on some degenerate queries
+    BatchedCCDConfig accd_config;
+    accd_config.eta      = 0.1f;
+    accd_config.max_iter = 10000;
+
+    BatchedCCD accd;
+    accd.config() = accd_config;
+    report.add("additive float (device)",
+               pairs,
+               toisf,
+               [&]
+               {
+                   point_triangle ? accd.point_triangle(d_prims, d_xf, d_dxf, d_toisf) :
+                                    accd.edge_edge(d_prims, d_xf, d_dxf, d_toisf);
+                   d_toisf.copy_to(toisf);
+               });
+
+    HostBatchedCCD host_accd;
+    host_accd.config() = accd_config;
+    report.add("additive float (host, serial)",
+               pairs,
+               toisf,
+               [&]
+               {
+                   point_triangle ? host_accd.point_triangle(prims, xf, dxf, toisf) :
+                                    host_accd.edge_edge(prims, xf, dxf, toisf);
+               });
+
+    BatchedInclusionCCD<float> iccdf;
+    report.add("inclusion float (device)",
+               pairs,
+               toisf,
+               [&]
+               {
+                   point_triangle ? iccdf.point_triangle(d_prims, d_xf, d_dxf, d_toisf) :
+                                    iccdf.edge_edge(d_prims, d_xf, d_dxf, d_toisf);
+                   d_toisf.copy_to(toisf);
+               });
+
+    BatchedInclusionCCD<double> iccdd;
+    report.add("inclusion double (device)",
+               pairs,
+               toisd,
+               [&]
+               {
+                   point_triangle ? iccdd.point_triangle(d_prims, d_xd, d_dxd, d_toisd) :
+                                    iccdd.edge_edge(d_prims, d_xd, d_dxd, d_toisd);
+                   d_toisd.copy_to(toisd);
+               });
+
+    HostBatchedInclusionCCD<float> host_iccdf;
+    report.add("inclusion float (host, thread pool)",
+               pairs,
+               toisf,
+               [&]
+               {
+                   point_triangle ? host_iccdf.point_triangle(prims, xf, dxf, toisf) :
+                                    host_iccdf.edge_edge(prims, xf, dxf, toisf);
+               });
+
+    HostBatchedInclusionCCD<double> host_iccdd;
+    report.add("inclusion double (host, thread pool)",
+               pairs,
+               toisd,
+               [&]
+               {
+                   point_triangle ?
+                       host_iccdd.point_triangle(prims, queries.x, queries.dx, toisd) :
+                       host_iccdd.edge_edge(prims, queries.x, queries.dx, toisd);
+               });
+}
+
+TEST_CASE("ccd_benchmark", "[benchmark]")
+{
+    ccd_benchmark(true);
+    ccd_benchmark(false);
+}
@@ -0,0 +1,94 @@
+#if MUDA_COMPUTE_GRAPH_ON
+#include <catch2/catch.hpp>
+#include <atomic>
+#include <thread>
+#include <muda/muda.h>
+
+using namespace muda;
+
+// startup cost of an app building many ComputeGraphs: serial vs. thread pool
+namespace
+{
+constexpr int GraphCount   = 40;
+constexpr int NodePerGraph = 32;
+constexpr int N            = 1024;
+
+void build_graph(ComputeGraphVarManager& manager,
+                 int                     g,
+                 span<DeviceBuffer<float>> buffers,
+                 std::shared_ptr<ComputeGraph>& out)
+{
+    auto prefix = "g" + std::to_string(g);
+    auto graph  = manager.create_graph(prefix);
+
+    std::vector<ComputeGraphVar<BufferView<float>>*> xs;
+    for(int i = 0; i < NodePerGraph; ++i)
+        xs.push_back(&manager.create_var<BufferView<float>>(
+            prefix + "_x" + std::to_string(i), buffers[i].view()));
+
+    for(int i = 1; i < NodePerGraph; ++i)
+    {
+        graph->create_node(prefix + "_node" + std::to_string(i))
+            << [src = xs[i - 1], dst = xs[i]]
+        {
+            ParallelFor(256).apply(N,
+                                   [src = src->ceval().cviewer(),
+                                    dst = dst->eval().viewer()] __device__(int j) mutable
+                                   { dst(j) = src(j) + 1.0f; });
+        };
+    }
+
+    graph->build();
+    out = graph;
+}
+
+void build_graphs(std::vector<DeviceBuffer<float>>& buffers, int thread_count)
+{
+    ComputeGraphVarManager                     manager;
+    std::vector<std::shared_ptr<ComputeGraph>> graphs(GraphCount);
+
+    std::atomic<int> next{0};
+    auto             worker = [&]
+    {
+        for(int g = next++; g < GraphCount; g = next++)
+            build_graph(manager,
+                        g,
+                        span<DeviceBuffer<float>>{buffers}.subspan(g * NodePerGraph, NodePerGraph),
+                        graphs[g]);
+    };
+
+    std::vector<std::thread> threads;
+    for(int t = 0; t < thread_count; ++t)
+        threads.emplace_back(worker);
+    for(auto& t : threads)
+        t.join();
+    wait_device();
+}
+}  // namespace
+
+void compute_graph_benchmark()
+{
+    std::vector<DeviceBuffer<float>> buffers(GraphCount * NodePerGraph);
+    for(auto& b : buffers)
+        b.resize(N, 0.0f);
+
+    // warm up the cuda context and the kernel modules
+    build_graphs(buffers, 1);
+
+    BENCHMARK("build 40 graphs (1 thread)")
+    {
+        build_graphs(buffers, 1);
+    };
+
+    auto hw = static_cast<int>(std::max(2u, std::thread::hardware_concurrency()));
+    BENCHMARK("build 40 graphs (" + std::to_string(hw) + " threads)")
+    {
+        build_graphs(buffers, hw);
+    };
+}
+
+TEST_CASE("compute_graph_benchmark", "[benchmark]")
+{
+    compute_graph_benchmark();
+}
+#endif
@@ -0,0 +1,77 @@
+#include <catch2/catch.hpp>
+#include <muda/muda.h>
+#include <muda/ext/linear_system.h>
+
+using namespace muda;
+
+// separate cuBLAS/ParallelFor passes vs. the fused BLAS-1 routines of LinearSystemContext,
+// the effective bandwidth is bytes moved / time
+void fused_blas_benchmark()
+{
+    constexpr int N = 1 << 24;
+    using T         = float;
+
+    LinearSystemContext  ctx;
+    DeviceDenseVector<T> x(N), y(N), p(N), q(N), r(N);
+    x.fill(1);
+    y.fill(1);
+    p.fill(1);
+    q.fill(1);
+    r.fill(1);
+    DeviceVar<T> result;
+    const T      a = T(1e-6), one = T(1);
+
+    auto report = [](const char* name, double bytes)
+    { std::cout << name << ": " << bytes / (1 << 30) << " GiB per call\n"; };
+
+    // y = a * x + y (read x, y, write y), rr = dot(y, y) (read y, y)
+    report("axpy + dot, separate", 5.0 * N * sizeof(T));
+    report("axpy + dot, fused", 3.0 * N * sizeof(T));
+    BENCHMARK("axpy + dot: separate")
+    {
+        ctx.axpby(a, x.cview(), one, y.view());
+        ctx.dot(y.cview(), y.cview(), result.view());
+        ctx.sync();
+    };
+    BENCHMARK("axpy + dot: fused")
+    {
+        ctx.axpy_dot(a, x.cview(), y.view(), y.cview(), result.view());
+        ctx.sync();
+    };
+
+    // y = a * x + b * y (read x, y, write y), norm(y) (read y)
+    report("axpby + norm, separate", 4.0 * N * sizeof(T));
+    report("axpby + norm, fused", 3.0 * N * sizeof(T));
+    BENCHMARK("axpby + norm: separate")
+    {
+        ctx.axpby(a, x.cview(), one, y.view());
+        ctx.norm(y.cview(), result.view());
+        ctx.sync();
+    };
+    BENCHMARK("axpby + norm: fused")
+    {
+        ctx.axpby_norm(a, x.cview(), one, y.view(), result.view());
+        ctx.sync();
+    };
+
+    // x += a * p; r -= a * q (read p, x, q, r, write x, r), dot(r, r) (read r, r)
+    report("cg update, separate", 8.0 * N * sizeof(T));
+    report("cg update, fused", 6.0 * N * sizeof(T));
+    BENCHMARK("cg update: separate")
+    {
+        ctx.axpby(a, p.cview(), one, x.view());
+        ctx.axpby(-a, q.cview(), one, r.view());
+        ctx.dot(r.cview(), r.cview(), result.view());
+        ctx.sync();
+    };
+    BENCHMARK("cg update: fused")
+    {
+        ctx.cg_update(a, p.cview(), q.cview(), x.view(), r.view(), r.cview(), result.view());
+        ctx.sync();
+    };
+}
+
+TEST_CASE("fused_blas_benchmark", "[benchmark]")
+{
+    fused_blas_benchmark();
+}
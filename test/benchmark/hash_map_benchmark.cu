@@ -0,0 +1,62 @@
+#include <catch2/catch.hpp>
+#include <random>
+#include <muda/muda.h>
+#include <muda/container.h>
+#include <muda/cub/device/device_radix_sort.h>
+#include <muda/cub/device/device_select.h>
+#include <muda/ext/hash_map.h>
+
+using namespace muda;
+
+// dedupe of packed (i, j) pairs: hash set vs. sort + unique
+void hash_map_benchmark()
+{
+    constexpr int N = 1 << 20;
+
+    std::mt19937                            gen(0);
+    std::uniform_int_distribution<uint32_t> dist(0, 1 << 12);
+    std::vector<uint64_t>                   h_keys(N);
+    for(auto& k : h_keys)
+        k = (uint64_t{dist(gen)} << 32) | dist(gen) % 64;
+
+    DeviceBuffer<uint64_t> keys = h_keys;
+    DeviceBuffer<uint64_t> sorted(N);
+    DeviceBuffer<uint64_t> unique(N);
+    DeviceVar<int>         unique_count;
+
+    DeviceHashSet<uint64_t> set;
+    set.reserve(N);
+    DeviceBuffer<uint64_t> retrieved;
+
+    BENCHMARK("dedupe (hash set)")
+    {
+        set.clear();
+        set.insert(keys);
+        set.retrieve(retrieved);
+        return retrieved.size();
+    };
+
+    BENCHMARK("dedupe (radix sort + unique)")
+    {
+        DeviceRadixSort().SortKeys(keys.data(), sorted.data(), N);
+        DeviceSelect().Unique(sorted.data(), unique.data(), unique_count.data(), N);
+        return static_cast<int>(unique_count);
+    };
+
+    DeviceHashMap<uint64_t, int> map;
+    DeviceBuffer<int>            values(N);
+    DeviceBuffer<int>            result(N);
+    values.fill(1);
+    map.insert(keys, values);
+
+    BENCHMARK("lookup (hash map)")
+    {
+        map.find(keys, result, -1);
+        wait_device();
+    };
+}
+
+TEST_CASE("hash_map_benchmark", "[benchmark]")
+{
+    hash_map_benchmark();
+}
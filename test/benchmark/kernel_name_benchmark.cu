@@ -0,0 +1,57 @@
+#include <catch2/catch.hpp>
+#include <muda/muda.h>
+#include <muda/container.h>
+
+using namespace muda;
+
+// kernel parameter block size of a typical 4-viewer kernel
+template <typename F>
+constexpr size_t param_size(const F&)
+{
+    return sizeof(details::ParallelForCallable<F>);
+}
+
+void kernel_name_benchmark()
+{
+    constexpr int     N = 256;
+    DeviceBuffer<int> a(N), b(N), c(N), d(N);
+
+    auto f = [a = a.viewer(), b = b.viewer(), c = c.viewer(), d = d.viewer()] __device__(
+                 int i) mutable { a(i) = b(i) + c(i) + d(i); };
+
+    std::cout << "sizeof(ViewerBase)=" << sizeof(ViewerBase<false>)
+              << ", sizeof(Dense1D<int>)=" << sizeof(Dense1D<int>)
+              << ", 4-viewer kernel params=" << param_size(f) << " bytes"
+              << std::endl;
+
+    BENCHMARK("launch (runtime string names)")
+    {
+        ParallelFor(64)
+            .kernel_name("kernel_name_benchmark")
+            .apply(N,
+                   [a = a.viewer().name("a"),
+                    b = b.viewer().name("b"),
+                    c = c.viewer().name("c"),
+                    d = d.viewer().name("d")] __device__(int i) mutable
+                   { a(i) = b(i) + c(i) + d(i); });
+    };
+
+    BENCHMARK("launch (interned names)")
+    {
+        ParallelFor(64)
+            .kernel_name("kernel_name_benchmark"_name)
+            .apply(N,
+                   [a = a.viewer().name("a"_name),
+                    b = b.viewer().name("b"_name),
+                    c = c.viewer().name("c"_name),
+                    d = d.viewer().name("d"_name)] __device__(int i) mutable
+                   { a(i) = b(i) + c(i) + d(i); });
+    };
+
+    wait_device();
+}
+
+TEST_CASE("kernel_name_benchmark", "[benchmark]")
+{
+    kernel_name_benchmark();
+}
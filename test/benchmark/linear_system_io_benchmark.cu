@@ -0,0 +1,100 @@
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <muda/muda.h>
+#include <muda/ext/linear_system.h>
+#include <muda/ext/linear_system/linear_system_io.h>
+#include "../linear_system_test/stencil_grid.h"
+
+using namespace muda;
+
+// a 7-point stencil on a 32^3 grid with 3x3 double blocks (~2M scalar entries),
+// loaded with a hand-written serial loader, the parallel Matrix Market reader
+// and the binary format
+void linear_system_io_benchmark()
+{
+    constexpr int n = 32;
+    using T         = double;
+    using Block     = Eigen::Matrix<T, 3, 3>;
+
+    LinearSystemContext ctx;
+    LinearSystemIO      io;
+
+    auto               grid = make_stencil_grid<T>(n, false);
+    std::vector<Block> blocks(grid.row_indices.size());
+    for(auto& b : blocks)
+        b = Block::Random();
+
+    DeviceTripletMatrix<T, 3> A_triplet;
+    make_stencil_triplet(grid, blocks, A_triplet);
+    DeviceBCOOMatrix<T, 3> A_bcoo;
+    ctx.convert(A_triplet, A_bcoo);
+    DeviceBSRMatrix<T, 3> A;
+    ctx.convert(A_bcoo, A);
+    ctx.sync();
+
+    auto mtx = (std::filesystem::temp_directory_path() / "muda_io_benchmark.mtx").string();
+    auto bin = (std::filesystem::temp_directory_path() / "muda_io_benchmark.bin").string();
+    io.write_mtx(mtx, A);
+    io.write_binary(bin, A);
+    std::cout << "matrix market: " << std::filesystem::file_size(mtx) / (1 << 20)
+              << " MiB, binary: " << std::filesystem::file_size(bin) / (1 << 20) << " MiB\n";
+
+    std::vector<int> r, c;
+    std::vector<T>   v;
+    BENCHMARK("read matrix market: serial ifstream")
+    {
+        std::ifstream f{mtx};
+        std::string   line;
+        std::getline(f, line);  // banner
+        int     rows, cols;
+        int64_t entries;
+        f >> rows >> cols >> entries;
+        r.resize(entries);
+        c.resize(entries);
+        v.resize(entries);
+        for(int64_t e = 0; e < entries; ++e)
+        {
+            f >> r[e] >> c[e] >> v[e];
+            --r[e];
+            --c[e];
+        }
+        return v.size();
+    };
+    BENCHMARK("read matrix market: parallel mmap")
+    {
+        io.read_mtx(mtx, r, c, v);
+        return v.size();
+    };
+    BENCHMARK("read matrix market: to DeviceTripletMatrix")
+    {
+        DeviceTripletMatrix<T, 3> B;
+        io.read_mtx(mtx, B);
+        return B.triplet_count();
+    };
+
+    DeviceBSRMatrix<T, 3> B;
+    BENCHMARK("read binary: to DeviceBSRMatrix")
+    {
+        io.read_binary(bin, B);
+        return B.non_zero_blocks();
+    };
+
+    BENCHMARK("write matrix market")
+    {
+        io.write_mtx(mtx, A);
+    };
+    BENCHMARK("write binary")
+    {
+        io.write_binary(bin, A);
+    };
+
+    std::filesystem::remove(mtx);
+    std::filesystem::remove(bin);
+}
+
+TEST_CASE("linear_system_io_benchmark", "[benchmark]")
+{
+    linear_system_io_benchmark();
+}
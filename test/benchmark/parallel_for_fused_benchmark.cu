@@ -0,0 +1,73 @@
+#include <catch2/catch.hpp>
+#include <muda/muda.h>
+#include <muda/container.h>
+#include <muda/cub/device/device_reduce.h>
+#include <muda/cub/device/device_scan.h>
+
+using namespace muda;
+
+// a per-element quantity, like the kinetic energy of a particle
+MUDA_INLINE MUDA_DEVICE float energy(const float3& v)
+{
+    return 0.5f * (v.x * v.x + v.y * v.y + v.z * v.z);
+}
+
+// map + DeviceReduce/DeviceScan vs. fused ParallelFor::reduce/scan
+void parallel_for_fused_benchmark()
+{
+    constexpr int N = 1 << 24;
+
+    DeviceBuffer<float3> velocities(N);
+    velocities.fill(make_float3(1.0f, 2.0f, 3.0f));
+
+    DeviceBuffer<float> temp(N);
+    DeviceVar<float>    total;
+    DeviceBuffer<float> prefix(N);
+
+    auto plus = [] __device__(float a, float b) { return a + b; };
+
+    BENCHMARK("reduce: two-step (map, DeviceReduce::Sum)")
+    {
+        ParallelFor()
+            .kernel_name("map")
+            .apply(N,
+                   [v = velocities.cviewer(), e = temp.viewer()] __device__(int i) mutable
+                   { e(i) = energy(v(i)); });
+        DeviceReduce().Sum(temp.data(), total.data(), N).wait();
+        return float(total);
+    };
+
+    BENCHMARK("reduce: fused (ParallelFor::reduce)")
+    {
+        ParallelFor()
+            .reduce(N,
+                    0.0f,
+                    plus,
+                    [v = velocities.cviewer()] __device__(int i) { return energy(v(i)); },
+                    total.view())
+            .wait();
+        return float(total);
+    };
+
+    BENCHMARK("scan: two-step (map, DeviceScan::InclusiveSum)")
+    {
+        ParallelFor()
+            .kernel_name("map")
+            .apply(N,
+                   [v = velocities.cviewer(), e = temp.viewer()] __device__(int i) mutable
+                   { e(i) = energy(v(i)); });
+        DeviceScan().InclusiveSum(temp.data(), prefix.data(), N).wait();
+    };
+
+    BENCHMARK("scan: fused (ParallelFor::scan)")
+    {
+        ParallelFor()
+            .scan(N, [v = velocities.cviewer()] __device__(int i) { return energy(v(i)); }, prefix.view())
+            .wait();
+    };
+}
+
+TEST_CASE("parallel_for_fused_benchmark", "[benchmark]")
+{
+    parallel_for_fused_benchmark();
+}
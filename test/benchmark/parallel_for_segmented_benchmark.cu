@@ -0,0 +1,79 @@
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <random>
+#include <muda/muda.h>
+#include <muda/container.h>
+
+using namespace muda;
+
+// some work per item, like a per-nonzero or per-particle update
+MUDA_INLINE MUDA_DEVICE float work(int segment, int i)
+{
+    float x = segment * 0.618f + i;
+    for(int k = 0; k < 16; ++k)
+        x = sinf(x) * 1.5f + 0.5f;
+    return x;
+}
+
+// ragged ranges with power-law sizes: per-segment launches vs. one thread per segment
+// vs. the merge-path decomposition of ParallelFor::apply_segmented
+void parallel_for_segmented_benchmark()
+{
+    constexpr int Segments = 1 << 14;
+
+    std::mt19937                     rng(42);
+    std::uniform_real_distribution<> uniform(0.0, 1.0);
+
+    std::vector<int> h_offsets(Segments + 1, 0);
+    for(int s = 0; s < Segments; ++s)
+    {
+        // pareto, alpha = 1.2: mostly a handful of items, sometimes tens of thousands
+        int size         = std::min(static_cast<int>(4.0 / std::pow(1.0 - uniform(rng), 1.0 / 1.2)), 1 << 16);
+        h_offsets[s + 1] = h_offsets[s] + size;
+    }
+    int total = h_offsets.back();
+
+    DeviceBuffer<int>   offsets = h_offsets;
+    DeviceBuffer<float> out(total);
+
+    BENCHMARK("per-segment launches (first 1024 segments)")
+    {
+        for(int s = 0; s < 1024; ++s)
+        {
+            int begin = h_offsets[s];
+            int size  = h_offsets[s + 1] - begin;
+            ParallelFor(256).apply(size,
+                                   [out = out.viewer(), s, begin] __device__(int j) mutable
+                                   { out(begin + j) = work(s, j); });
+        }
+        wait_device();
+    };
+
+    BENCHMARK("thread per segment")
+    {
+        ParallelFor(256)
+            .apply(Segments,
+                   [offsets = offsets.cviewer(), out = out.viewer()] __device__(int s) mutable
+                   {
+                       int begin = offsets(s);
+                       for(int i = begin; i < offsets(s + 1); ++i)
+                           out(i) = work(s, i - begin);
+                   })
+            .wait();
+    };
+
+    BENCHMARK("apply_segmented (merge path)")
+    {
+        ParallelFor(256)
+            .apply_segmented(offsets.view(),
+                             total,
+                             [out = out.viewer()] __device__(int s, int j, int i) mutable
+                             { out(i) = work(s, j); })
+            .wait();
+    };
+}
+
+TEST_CASE("parallel_for_segmented_benchmark", "[benchmark]")
+{
+    parallel_for_segmented_benchmark();
+}
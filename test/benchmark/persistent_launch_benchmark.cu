@@ -0,0 +1,59 @@
+#include <catch2/catch.hpp>
+#include <muda/muda.h>
+#include <muda/container.h>
+
+using namespace muda;
+
+// a substep loop of tiny dependent kernels: discrete launches vs. one PersistentLaunch
+void persistent_launch_benchmark()
+{
+    constexpr int N        = 512;  // a few hundred particles
+    constexpr int Substeps = 200;
+
+    DeviceBuffer<float> x(N), v(N), f(N);
+    x.fill(1.0f);
+    v.fill(0.0f);
+    f.fill(0.0f);
+
+    constexpr float dt = 1e-3f;
+
+    auto force = [x = x.cviewer(), f = f.viewer()] __device__(int i) mutable
+    { f(i) = -x(i) + 0.1f * x((i + 1) % N); };
+    auto velocity = [v = v.viewer(), f = f.cviewer()] __device__(int i) mutable
+    { v(i) += dt * f(i); };
+    auto position = [x = x.viewer(), v = v.cviewer()] __device__(int i) mutable
+    { x(i) += dt * v(i); };
+
+    BENCHMARK("discrete launches")
+    {
+        for(int s = 0; s < Substeps; ++s)
+        {
+            ParallelFor(256).apply(N, force);
+            ParallelFor(256).apply(N, velocity);
+            ParallelFor(256).apply(N, position);
+        }
+        wait_device();
+    };
+
+    PersistentQueue queue{force, velocity, position};
+    for(int s = 0; s < Substeps; ++s)
+        queue.push(0, N).barrier().push(1, N).barrier().push(2, N).barrier();
+
+    BENCHMARK("persistent launch")
+    {
+        PersistentLaunch().apply(queue).wait();
+    };
+
+    BENCHMARK("persistent launch (refill every run)")
+    {
+        queue.clear();
+        for(int s = 0; s < Substeps; ++s)
+            queue.push(0, N).barrier().push(1, N).barrier().push(2, N).barrier();
+        PersistentLaunch().apply(queue).wait();
+    };
+}
+
+TEST_CASE("persistent_launch_benchmark", "[benchmark]")
+{
+    persistent_launch_benchmark();
+}
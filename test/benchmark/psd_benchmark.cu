@@ -0,0 +1,90 @@
+#include <catch2/catch.hpp>
+#include <muda/muda.h>
+#include <muda/container.h>
+#include <muda/cub/host/host_thread_pool.h>
+#include <muda/ext/eigen/evd.h>
+#include <muda/ext/eigen/psd.h>
+
+using namespace muda;
+
+// PSD projection of a batch of element Hessians: the Jacobi project_psd vs. eigen::evd
+// (SelfAdjointEigenSolver) on the device and on the host thread pool, a third of the
+// Hessians are positive definite
+template <typename T, int N>
+void psd_benchmark()
+{
+    using Matrix = Eigen::Matrix<T, N, N>;
+    using Vector = Eigen::Matrix<T, N, 1>;
+
+    constexpr int       Count = 1 << 16;
+    std::vector<Matrix> h_src(Count);
+    for(int i = 0; i < Count; ++i)
+    {
+        Matrix A = Matrix::Random();
+        h_src[i] = A + A.transpose();
+        if(i % 3 == 0)
+            h_src[i] += T(2 * N) * Matrix::Identity();
+    }
+    DeviceBuffer<Matrix> src = h_src;
+    DeviceBuffer<Matrix> hessians(Count);
+    std::vector<Matrix>  h_hessians(Count);
+
+    std::string name = std::to_string(N) + "x" + std::to_string(N)
+                       + (std::is_same_v<T, float> ? " float" : " double");
+
+    // every run starts from the same input
+    BENCHMARK((name + ": project_psd (device)").c_str())
+    {
+        hessians.view().copy_from(src.view());
+        eigen::project_psd<T, N>(hessians.view());
+        wait_device();
+    };
+
+    BENCHMARK((name + ": evd (device)").c_str())
+    {
+        hessians.view().copy_from(src.view());
+        ParallelFor(128)
+            .kernel_name("evd_project_psd")
+            .apply(Count,
+                   [hessians = hessians.viewer().name("hessians")] __device__(int i) mutable
+                   {
+                       Matrix H = hessians(i);
+                       Vector lambda;
+                       Matrix V;
+                       eigen::evd<T, N>(H, lambda, V);
+                       hessians(i) = V * lambda.cwiseMax(T(0)).asDiagonal() * V.transpose();
+                   });
+        wait_device();
+    };
+
+    BENCHMARK((name + ": project_psd (host, thread pool)").c_str())
+    {
+        HostThreadPool::global().run(Count,
+                                     [&](size_t i)
+                                     {
+                                         h_hessians[i] = h_src[i];
+                                         eigen::project_psd<T, N>(h_hessians[i]);
+                                     });
+    };
+
+    BENCHMARK((name + ": evd (host, thread pool)").c_str())
+    {
+        HostThreadPool::global().run(Count,
+                                     [&](size_t i)
+                                     {
+                                         Vector lambda;
+                                         Matrix V;
+                                         eigen::evd<T, N>(h_src[i], lambda, V);
+                                         h_hessians[i] = V * lambda.cwiseMax(T(0)).asDiagonal()
+                                                         * V.transpose();
+                                     });
+    };
+}
+
+TEST_CASE("psd_benchmark", "[benchmark]")
+{
+    psd_benchmark<float, 9>();
+    psd_benchmark<double, 9>();
+    psd_benchmark<float, 12>();
+    psd_benchmark<double, 12>();
+}
@@ -0,0 +1,78 @@
+#include <catch2/catch.hpp>
+#include <muda/muda.h>
+#include <muda/ext/linear_system.h>
+#include "../linear_system_test/stencil_grid.h"
+
+using namespace muda;
+
+// BSR SpMV of a 7-point stencil on a 64^3 grid (3x3 blocks, like an FEM/IPC Hessian),
+// the nodes numbered randomly, by RCM and by Morton code
+void reorder_benchmark()
+{
+    constexpr int n     = 64;
+    constexpr int nodes = n * n * n;
+    using T             = float;
+    using Block         = Eigen::Matrix<T, 3, 3>;
+
+    LinearSystemContext ctx;
+
+    auto                      grid = make_stencil_grid<T>(n, true);
+    std::vector<Block>        blocks(grid.row_indices.size(), Block::Identity());
+    DeviceTripletMatrix<T, 3> A_triplet;
+    make_stencil_triplet(grid, blocks, A_triplet);
+    DeviceBCOOMatrix<T, 3> A_bcoo;
+    ctx.convert(A_triplet, A_bcoo);
+    DeviceBSRMatrix<T, 3> A;
+    ctx.convert(A_bcoo, A);
+
+    DeviceBuffer<Eigen::Vector3<T>> d_positions = grid.positions;
+    LinearSystemPermutation         rcm, morton;
+    ctx.rcm(A.cview(), rcm);
+    ctx.morton(d_positions.view().as_const(), morton);
+
+    DeviceBSRMatrix<T, 3> A_rcm, A_morton;
+    ctx.permute(A.cview(), rcm, A_rcm);
+    ctx.permute(A.cview(), morton, A_morton);
+
+    DeviceDenseVector<T> x(nodes * 3), y(nodes * 3);
+    x.fill(1);
+    ctx.sync();
+
+    BENCHMARK("bsr spmv: random order")
+    {
+        ctx.spmv(A.cview(), x.cview(), y.view());
+        ctx.sync();
+    };
+    BENCHMARK("bsr spmv: rcm order")
+    {
+        ctx.spmv(A_rcm.cview(), x.cview(), y.view());
+        ctx.sync();
+    };
+    BENCHMARK("bsr spmv: morton order")
+    {
+        ctx.spmv(A_morton.cview(), x.cview(), y.view());
+        ctx.sync();
+    };
+
+    // the reordering itself, paid once per topology change
+    BENCHMARK("rcm")
+    {
+        ctx.rcm(A.cview(), rcm);
+        ctx.sync();
+    };
+    BENCHMARK("morton")
+    {
+        ctx.morton(d_positions.view().as_const(), morton);
+        ctx.sync();
+    };
+    BENCHMARK("permute")
+    {
+        ctx.permute(A.cview(), rcm, A_rcm);
+        ctx.sync();
+    };
+}
+
+TEST_CASE("reorder_benchmark", "[benchmark]")
+{
+    reorder_benchmark();
+}
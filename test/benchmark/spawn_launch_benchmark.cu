@@ -0,0 +1,71 @@
+#include <catch2/catch.hpp>
+#include <muda/muda.h>
+#include <muda/container.h>
+
+using namespace muda;
+
+// binary tree expansion, one level of nodes per wave
+constexpr int Depth = 16;
+
+#ifdef __CUDACC_RDC__
+// dynamic parallelism: every level launches the next one from the device
+__global__ void expand_level(int* visits, int depth, int count)
+{
+    int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if(i < count)
+        atomicAdd(visits + depth, 1);
+    if(i == 0 && depth + 1 < Depth)
+    {
+        int next = 2 * count;
+        Kernel{(next + 255) / 256, 256, Stream::FireAndForget{}, expand_level}(
+            visits, depth + 1, next);
+    }
+}
+#endif
+
+void spawn_launch_benchmark()
+{
+    DeviceBuffer<int> visits(Depth);
+    visits.fill(0);
+
+    BENCHMARK("host driven, one launch per level")
+    {
+        for(int d = 0; d < Depth; ++d)
+            ParallelFor(256).apply(1 << d,
+                                   [visits = visits.viewer(), d] __device__(int i) mutable
+                                   { atomicAdd(&visits(d), 1); });
+        wait_device();
+    };
+
+#ifdef __CUDACC_RDC__
+    BENCHMARK("dynamic parallelism (rdc)")
+    {
+        expand_level<<<1, 256>>>(visits.data(), 0, 1);
+        wait_device();
+    };
+#endif
+
+    SpawnQueue<int2> queue(1 << Depth);
+    BENCHMARK("spawn launch")
+    {
+        queue.push({make_int2(0, 0)});
+        SpawnLaunch()
+            .apply(queue,
+                   [visits = visits.viewer()] __device__(const int2& node,
+                                                         Spawner<int2>& spawner) mutable
+                   {
+                       atomicAdd(&visits(node.x), 1);
+                       if(node.x + 1 < Depth)
+                       {
+                           spawner.spawn(make_int2(node.x + 1, 2 * node.y));
+                           spawner.spawn(make_int2(node.x + 1, 2 * node.y + 1));
+                       }
+                   })
+            .wait();
+    };
+}
+
+TEST_CASE("spawn_launch_benchmark", "[benchmark]")
+{
+    spawn_launch_benchmark();
+}
@@ -0,0 +1,104 @@
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <muda/muda.h>
+#include <muda/ext/eigen/psd.h>
+#include <Eigen/Eigenvalues>
+#include "eigen_test_common.h"
+
+using namespace muda;
+using namespace Eigen;
+
+template <typename T, int N>
+Matrix<T, N, N> project_psd_reference(const Matrix<T, N, N>& M)
+{
+    SelfAdjointEigenSolver<Matrix<T, N, N>> solver(M);
+    Vector<T, N> lambda = solver.eigenvalues().cwiseMax(T(0));
+    return solver.eigenvectors() * lambda.asDiagonal() * solver.eigenvectors().transpose();
+}
+
+// the error is relative to the input, the projection itself may be close to 0
+template <typename T, int N>
+bool close(const Matrix<T, N, N>& a, const Matrix<T, N, N>& b, const Matrix<T, N, N>& M)
+{
+    T tol = std::is_same_v<T, float> ? T(1e-5) : T(1e-12);
+    if((a - b).norm() <= tol * M.norm())
+        return true;
+    return approx_equal(a, b);
+}
+
+// every third matrix is shifted to be positive definite
+template <typename T, int N>
+std::vector<Matrix<T, N, N>> random_symmetric(int count)
+{
+    std::vector<Matrix<T, N, N>> matrices(count);
+    for(int i = 0; i < count; i++)
+    {
+        Matrix<T, N, N> A = Matrix<T, N, N>::Random();
+        matrices[i]       = A + A.transpose();
+        if(i % 3 == 0)
+            matrices[i] += T(2 * N) * Matrix<T, N, N>::Identity();
+    }
+    return matrices;
+}
+
+template <typename T, int N>
+void psd_test()
+{
+    using Matrix = Eigen::Matrix<T, N, N>;
+    using Vector = Eigen::Matrix<T, N, 1>;
+
+    constexpr int count    = 300;
+    auto          matrices = random_symmetric<T, N>(count);
+
+    // host
+    for(int i = 0; i < count; i++)
+    {
+        const Matrix& M = matrices[i];
+
+        Vector lambda;
+        Matrix V;
+        int    sweeps = eigen::jacobi_evd<T, N>(M, lambda, V);
+        REQUIRE(sweeps < 16);
+        REQUIRE(close<T, N>(V * lambda.asDiagonal() * V.transpose(), M, M));
+        REQUIRE(close<T, N>(V.transpose() * V, Matrix::Identity(), Matrix::Identity()));
+
+        std::sort(lambda.data(), lambda.data() + N);
+        Vector expected = SelfAdjointEigenSolver<Matrix>(M).eigenvalues();
+        REQUIRE((lambda - expected).norm() <= T(1e-5) * M.norm());
+
+        Matrix P         = M;
+        bool   projected = eigen::project_psd<T, N>(P);
+        if(i % 3 == 0)
+        {
+            REQUIRE_FALSE(projected);
+            REQUIRE(P == M);
+        }
+        REQUIRE(close<T, N>(P, project_psd_reference<T, N>(M), M));
+    }
+
+    // device
+    DeviceBuffer<Matrix> d_matrices = matrices;
+    eigen::project_psd<T, N>(d_matrices.view());
+    std::vector<Matrix> result;
+    d_matrices.copy_to(result);
+    for(int i = 0; i < count; i++)
+        REQUIRE(close<T, N>(result[i], project_psd_reference<T, N>(matrices[i]), matrices[i]));
+
+    // a PSD but singular matrix fails the Cholesky, the projection keeps it
+    Matrix B = Matrix::Random();
+    B.col(0).setZero();
+    Matrix S = B * B.transpose();
+    Matrix P = S;
+    eigen::project_psd<T, N>(P);
+    REQUIRE(close<T, N>(P, S, S));
+}
+
+TEST_CASE("psd", "[psd_test]")
+{
+    psd_test<float, 6>();
+    psd_test<double, 6>();
+    psd_test<float, 9>();
+    psd_test<double, 9>();
+    psd_test<float, 12>();
+    psd_test<double, 12>();
+}
@@ -0,0 +1,124 @@
+#include <catch2/catch.hpp>
+#include <muda/muda.h>
+#include <muda/ext/linear_system.h>
+using namespace muda;
+using namespace Eigen;
+
+template <typename T>
+bool approx(T a, T b)
+{
+    return std::abs(a - b) <= T(1e-4) * std::max(T(1), std::abs(b));
+}
+
+template <typename T>
+void test_fused_blas(int size)
+{
+    LinearSystemContext     ctx;
+    HostLinearSystemContext host_ctx;
+
+    VectorX<T> x = VectorX<T>::Random(size);
+    VectorX<T> y = VectorX<T>::Random(size);
+    VectorX<T> z = VectorX<T>::Random(size);
+    VectorX<T> w = VectorX<T>::Random(size);
+    T          a = T(0.7), b = T(-1.3);
+
+    DeviceDenseVector<T> d_x = x, d_y = y, d_z = z, d_w = w;
+    DeviceVar<T>         alpha = a, beta = b, result;
+    VectorX<T>           res;
+
+    // axpy + dot, z = y aliased
+    {
+        VectorX<T> gt_y   = a * x + y;
+        T          gt     = gt_y.dot(gt_y);
+        VectorX<T> host_y = y;
+        REQUIRE(approx(host_ctx.axpy_dot(a, x, host_y, host_y), gt));
+        REQUIRE(host_y.isApprox(gt_y));
+
+        ctx.axpy_dot(a, d_x.cview(), d_y.view(), d_y.cview(), result.view());
+        ctx.sync();
+        d_y.copy_to(res);
+        REQUIRE(res.isApprox(gt_y));
+        REQUIRE(approx<T>(result, gt));
+
+        // the scalar from the device
+        VectorX<T> gt_y2 = a * x + gt_y;
+        ctx.axpy_dot(alpha.view().as_const(), d_x.cview(), d_y.view(), d_z.cview(), result.view());
+        ctx.sync();
+        d_y.copy_to(res);
+        REQUIRE(res.isApprox(gt_y2));
+        REQUIRE(approx<T>(result, gt_y2.dot(z)));
+        d_y = y;
+    }
+
+    // axpby + norm
+    {
+        VectorX<T> gt_y   = a * x + b * y;
+        VectorX<T> host_y = y;
+        REQUIRE(approx(host_ctx.axpby_norm(a, x, b, host_y), gt_y.norm()));
+        REQUIRE(host_y.isApprox(gt_y));
+
+        ctx.axpby_norm(alpha.view().as_const(), d_x.cview(), beta.view().as_const(), d_y.view(), result.view());
+        ctx.sync();
+        d_y.copy_to(res);
+        REQUIRE(res.isApprox(gt_y));
+        REQUIRE(approx<T>(result, gt_y.norm()));
+        d_y = y;
+    }
+
+    // x += a * p; r -= a * q; rr = dot(r, z), with p = z, q = w, r = y
+    {
+        VectorX<T> gt_x = x + a * z;
+        VectorX<T> gt_r = y - a * w;
+        T          gt   = gt_r.dot(gt_r);
+
+        VectorX<T> host_x = x, host_r = y;
+        REQUIRE(approx(host_ctx.cg_update(a, z, w, host_x, host_r, host_r), gt));
+        REQUIRE(host_x.isApprox(gt_x));
+        REQUIRE(host_r.isApprox(gt_r));
+
+        ctx.cg_update(a, d_z.cview(), d_w.cview(), d_x.view(), d_y.view(), d_y.cview(), result.view());
+        ctx.sync();
+        d_x.copy_to(res);
+        REQUIRE(res.isApprox(gt_x));
+        d_y.copy_to(res);
+        REQUIRE(res.isApprox(gt_r));
+        REQUIRE(approx<T>(result, gt));
+    }
+}
+
+// the squares of y leave the range of T, the norm itself does not
+template <typename T>
+void test_fused_norm_range(T magnitude)
+{
+    LinearSystemContext     ctx;
+    HostLinearSystemContext host_ctx;
+
+    int        size = 1000;
+    VectorX<T> x    = VectorX<T>::Random(size) * magnitude;
+    VectorX<T> y    = VectorX<T>::Zero(size);
+    T          gt   = x.stableNorm();
+    // relative only, `approx` would accept an underflowed 0
+    auto relative_approx = [&](T a) { return std::abs(a - gt) <= T(1e-4) * gt; };
+
+    VectorX<T> host_y = y;
+    REQUIRE(relative_approx(host_ctx.axpby_norm(T(1), x, T(0), host_y)));
+
+    DeviceDenseVector<T> d_x = x, d_y = y;
+    DeviceVar<T>         result;
+    ctx.axpby_norm(T(1), d_x.cview(), T(0), d_y.view(), result.view());
+    ctx.sync();
+    REQUIRE(relative_approx(result));
+}
+
+TEST_CASE("fused_blas", "[linear_system]")
+{
+    test_fused_blas<float>(1);
+    test_fused_blas<float>(1000);
+    test_fused_blas<double>(1000);
+    test_fused_blas<double>(1 << 20);
+
+    test_fused_norm_range<float>(1e30f);
+    test_fused_norm_range<float>(1e-30f);
+    test_fused_norm_range<double>(1e200);
+    test_fused_norm_range<double>(1e-200);
+}
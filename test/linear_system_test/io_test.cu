@@ -0,0 +1,211 @@
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <fstream>
+#include <muda/muda.h>
+#include <muda/ext/linear_system.h>
+#include <muda/ext/linear_system/linear_system_io.h>
+using namespace muda;
+using namespace Eigen;
+
+static std::string temp_path(const char* name)
+{
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+template <typename T>
+Eigen::MatrixX<T> to_dense(const DeviceCSRMatrix<T>& A)
+{
+    std::vector<int> row_offsets;
+    std::vector<int> col_indices;
+    std::vector<T>   values;
+    A.m_row_offsets.copy_to(row_offsets);
+    A.m_col_indices.copy_to(col_indices);
+    A.m_values.copy_to(values);
+
+    Eigen::MatrixX<T> dense = Eigen::MatrixX<T>::Zero(A.rows(), A.cols());
+    for(int i = 0; i < A.rows(); ++i)
+        for(int e = row_offsets[i]; e < row_offsets[i + 1]; ++e)
+            dense(i, col_indices[e]) += values[e];
+    return dense;
+}
+
+template <typename T>
+Eigen::MatrixX<T> to_dense(int rows, int cols, const std::vector<int>& r, const std::vector<int>& c, const std::vector<T>& v)
+{
+    Eigen::MatrixX<T> dense = Eigen::MatrixX<T>::Zero(rows, cols);
+    for(size_t e = 0; e < v.size(); ++e)
+        dense(r[e], c[e]) += v[e];
+    return dense;
+}
+
+TEST_CASE("io_matrix_market_parse", "[linear_system]")
+{
+    LinearSystemIO io;
+
+    // comments, blank lines, CRLF, mixed case banner and no final newline
+    auto path = temp_path("muda_io_symmetric.mtx");
+    {
+        std::ofstream f{path, std::ios::binary};
+        f << "%%MatrixMarket matrix coordinate Real Symmetric\r\n"
+          << "% a comment\r\n"
+          << "\r\n"
+          << "3 3 4\r\n"
+          << "1 1 2.5\r\n"
+          << "% a comment between entries\n"
+          << "2 1 -1\n"
+          << "   3 2 1e-3\n"
+          << "3 3 4";
+    }
+
+    std::vector<int>    r, c;
+    std::vector<double> v;
+    auto                info = io.read_mtx(path, r, c, v);
+    REQUIRE(info.symmetry == MatrixMarketSymmetry::Symmetric);
+    REQUIRE(info.rows == 3);
+    REQUIRE(info.entries == 4);
+    REQUIRE(v.size() == 6);
+
+    Eigen::Matrix3d expected;
+    expected << 2.5, -1, 0, -1, 0, 1e-3, 0, 1e-3, 4;
+    REQUIRE(to_dense(3, 3, r, c, v) == Eigen::MatrixXd(expected));
+
+    // skew-symmetric pattern
+    {
+        std::ofstream f{path, std::ios::binary};
+        f << "%%MatrixMarket matrix coordinate pattern skew-symmetric\n"
+          << "2 2 1\n"
+          << "2 1\n";
+    }
+    io.read_mtx(path, r, c, v);
+    Eigen::Matrix2d skew;
+    skew << 0, -1, 1, 0;
+    REQUIRE(to_dense(2, 2, r, c, v) == Eigen::MatrixXd(skew));
+
+    // errors
+    {
+        std::ofstream f{path, std::ios::binary};
+        f << "%%MatrixMarket matrix coordinate real general\n"
+          << "2 2 2\n"
+          << "1 1 1\n"
+          << "3 1 1\n";
+    }
+    REQUIRE_THROWS_AS(io.read_mtx(path, r, c, v), muda::invalid_argument);
+    {
+        std::ofstream f{path, std::ios::binary};
+        f << "%%MatrixMarket matrix coordinate real general\n"
+          << "2 2 3\n"
+          << "1 1 1\n";
+    }
+    REQUIRE_THROWS_AS(io.read_mtx(path, r, c, v), muda::invalid_argument);
+    REQUIRE_THROWS_AS(io.read_mtx(temp_path("muda_io_missing.mtx"), r, c, v),
+                      muda::runtime_error);
+
+    std::filesystem::remove(path);
+}
+
+template <typename T, int N>
+void test_io(int block_rows, int block_cols, int non_zero_block_count)
+{
+    LinearSystemContext ctx;
+    LinearSystemIO      io;
+
+    std::vector<int>                    row_indices(non_zero_block_count);
+    std::vector<int>                    col_indices(non_zero_block_count);
+    std::vector<Eigen::Matrix<T, N, N>> blocks(non_zero_block_count);
+    for(int i = 0; i < non_zero_block_count; ++i)
+    {
+        row_indices[i] = std::rand() % block_rows;
+        col_indices[i] = std::rand() % block_cols;
+        blocks[i]      = Eigen::Matrix<T, N, N>::Random();
+    }
+
+    DeviceTripletMatrix<T, N> A_triplet;
+    A_triplet.resize(block_rows, block_cols, non_zero_block_count);
+    A_triplet.block_row_indices().copy_from(row_indices.data());
+    A_triplet.block_col_indices().copy_from(col_indices.data());
+    A_triplet.block_values().copy_from(blocks.data());
+
+    DeviceBCOOMatrix<T, N> A_bcoo;
+    ctx.convert(A_triplet, A_bcoo);
+    DeviceBSRMatrix<T, N> A_bsr;
+    ctx.convert(A_bcoo, A_bsr);
+    DeviceCSRMatrix<T> A_csr;
+    ctx.convert(A_bsr, A_csr);
+    ctx.sync();
+    Eigen::MatrixX<T> ground_truth = to_dense(A_csr);
+
+    auto mtx = temp_path("muda_io_matrix.mtx");
+    auto bin = temp_path("muda_io_matrix.bin");
+
+    {  // BSR -> Matrix Market -> block triplets
+        io.write_mtx(mtx, A_bsr);
+        DeviceTripletMatrix<T, N> B_triplet;
+        io.read_mtx(mtx, B_triplet);
+        // one triplet per block of the file
+        REQUIRE(B_triplet.triplet_count() == A_bsr.non_zero_blocks());
+        DeviceBCOOMatrix<T, N> B_bcoo;
+        ctx.convert(B_triplet, B_bcoo);
+        DeviceBSRMatrix<T, N> B_bsr;
+        ctx.convert(B_bcoo, B_bsr);
+        DeviceCSRMatrix<T> B_csr;
+        ctx.convert(B_bsr, B_csr);
+        ctx.sync();
+        // full precision, every value is read back exactly
+        REQUIRE(to_dense(B_csr) == ground_truth);
+    }
+
+    {  // CSR -> Matrix Market -> triplets
+        io.write_mtx(mtx, A_csr);
+        DeviceTripletMatrix<T, 1> B_triplet;
+        io.read_mtx(mtx, B_triplet);
+        DeviceCOOMatrix<T> B_coo;
+        ctx.convert(B_triplet, B_coo);
+        DeviceCSRMatrix<T> B_csr;
+        ctx.convert(B_coo, B_csr);
+        ctx.sync();
+        REQUIRE(to_dense(B_csr) == ground_truth);
+    }
+
+    {  // binary
+        io.write_binary(bin, A_bsr);
+        DeviceBSRMatrix<T, N> B_bsr;
+        io.read_binary(bin, B_bsr);
+        REQUIRE(B_bsr.block_rows() == A_bsr.block_rows());
+        REQUIRE(B_bsr.non_zero_blocks() == A_bsr.non_zero_blocks());
+        DeviceCSRMatrix<T> B_csr;
+        ctx.convert(B_bsr, B_csr);
+        ctx.sync();
+        REQUIRE(to_dense(B_csr) == ground_truth);
+
+        // the block size and the value type are checked
+        DeviceBSRMatrix<T, N + 1> wrong_block;
+        REQUIRE_THROWS_AS(io.read_binary(bin, wrong_block), muda::invalid_argument);
+        DeviceCSRMatrix<T> wrong_format;
+        REQUIRE_THROWS_AS(io.read_binary(bin, wrong_format), muda::invalid_argument);
+
+        io.write_binary(bin, A_csr);
+        io.read_binary(bin, B_csr);
+        REQUIRE(to_dense(B_csr) == ground_truth);
+    }
+
+    {  // vector
+        VectorX<T>           x   = VectorX<T>::Random(block_rows * N);
+        DeviceDenseVector<T> d_x = x;
+        io.write_mtx(mtx, d_x);
+        DeviceDenseVector<T> d_y;
+        io.read_mtx(mtx, d_y);
+        VectorX<T> y;
+        d_y.copy_to(y);
+        REQUIRE(y == x);
+    }
+
+    std::filesystem::remove(mtx);
+    std::filesystem::remove(bin);
+}
+
+TEST_CASE("io", "[linear_system]")
+{
+    test_io<float, 3>(10, 7, 30);
+    // a few MB of Matrix Market text, parsed in several chunks
+    test_io<double, 3>(1000, 1000, 20000);
+}
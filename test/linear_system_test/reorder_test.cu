@@ -0,0 +1,168 @@
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <muda/muda.h>
+#include <muda/ext/linear_system.h>
+#include "stencil_grid.h"
+using namespace muda;
+using namespace Eigen;
+
+template <typename T>
+Eigen::SparseMatrix<T, Eigen::RowMajor> to_host_sparse(const DeviceCSRMatrix<T>& A)
+{
+    std::vector<int> row_offsets;
+    std::vector<int> col_indices;
+    std::vector<T>   values;
+    A.m_row_offsets.copy_to(row_offsets);
+    A.m_col_indices.copy_to(col_indices);
+    A.m_values.copy_to(values);
+
+    std::vector<Eigen::Triplet<T>> triplets;
+    for(int i = 0; i < A.rows(); ++i)
+        for(int e = row_offsets[i]; e < row_offsets[i + 1]; ++e)
+            triplets.emplace_back(i, col_indices[e], values[e]);
+
+    Eigen::SparseMatrix<T, Eigen::RowMajor> host(A.rows(), A.cols());
+    host.setFromTriplets(triplets.begin(), triplets.end());
+    return host;
+}
+
+template <typename T>
+int bandwidth(const Eigen::SparseMatrix<T, Eigen::RowMajor>& A)
+{
+    int b = 0;
+    for(int i = 0; i < A.outerSize(); ++i)
+        for(typename Eigen::SparseMatrix<T, Eigen::RowMajor>::InnerIterator a(A, i); a; ++a)
+            b = std::max(b, std::abs(i - static_cast<int>(a.col())));
+    return b;
+}
+
+// a 7-point stencil on an n x n x n grid, the nodes numbered in random order
+template <typename T, int N>
+void test_reorder(int n)
+{
+    LinearSystemContext     ctx;
+    HostLinearSystemContext host_ctx;
+
+    auto  grid      = make_stencil_grid<T>(n, true);
+    int   nodes     = grid.nodes;
+    auto& positions = grid.positions;
+
+    std::vector<Eigen::Matrix<T, N, N>> blocks(grid.row_indices.size());
+    std::vector<Eigen::Triplet<T>>      pattern;
+    for(size_t e = 0; e < blocks.size(); ++e)
+    {
+        blocks[e] = Eigen::Matrix<T, N, N>::Random();
+        pattern.emplace_back(grid.row_indices[e], grid.col_indices[e], T{1});
+    }
+
+    DeviceTripletMatrix<T, N> A_triplet;
+    make_stencil_triplet(grid, blocks, A_triplet);
+
+    DeviceBCOOMatrix<T, N> A_bcoo;
+    ctx.convert(A_triplet, A_bcoo);
+    DeviceBSRMatrix<T, N> A_bsr;
+    ctx.convert(A_bcoo, A_bsr);
+    DeviceCSRMatrix<T> A_csr;
+    ctx.convert(A_bsr, A_csr);
+
+    Eigen::SparseMatrix<T, Eigen::RowMajor> host_pattern(nodes, nodes);
+    host_pattern.setFromTriplets(pattern.begin(), pattern.end());
+    auto host_A = to_host_sparse(A_csr);
+
+    // RCM of the block structure
+    std::vector<int> host_perm;
+    host_ctx.rcm(host_pattern, host_perm);
+    {
+        std::vector<int> sorted = host_perm;
+        std::sort(sorted.begin(), sorted.end());
+        for(int i = 0; i < nodes; ++i)
+            REQUIRE(sorted[i] == i);
+
+        Eigen::SparseMatrix<T, Eigen::RowMajor> host_P_pattern;
+        host_ctx.permute(host_pattern, host_perm, host_P_pattern);
+        REQUIRE(bandwidth(host_P_pattern) < bandwidth(host_pattern));
+        // the natural numbering of the grid has bandwidth n * n
+        REQUIRE(bandwidth(host_P_pattern) <= 2 * n * n);
+    }
+
+    LinearSystemPermutation P;
+    ctx.rcm(A_bsr.cview(), P);
+    std::vector<int> perm;
+    P.copy_to(perm);
+    REQUIRE(perm == host_perm);
+
+    // the scalar permutation of the expanded blocks
+    std::vector<int> scalar_perm(nodes * N);
+    for(int i = 0; i < nodes; ++i)
+        for(int k = 0; k < N; ++k)
+            scalar_perm[i * N + k] = perm[i] * N + k;
+    Eigen::SparseMatrix<T, Eigen::RowMajor> host_PA;
+    host_ctx.permute(host_A, scalar_perm, host_PA);
+    Eigen::MatrixX<T> ground_truth = host_PA;
+
+    {  // BSR
+        DeviceBSRMatrix<T, N> PA;
+        ctx.permute(A_bsr.cview(), P, PA);
+        DeviceCSRMatrix<T> PA_csr;
+        ctx.convert(PA, PA_csr);
+        ctx.sync();
+        REQUIRE(Eigen::MatrixX<T>(to_host_sparse(PA_csr)).isApprox(ground_truth));
+
+        // A * x == P^T * (PA * (P * x))
+        VectorX<T>           x = VectorX<T>::Random(nodes * N);
+        DeviceDenseVector<T> d_x = x, d_px = x, d_py = x, d_y = x;
+        ctx.permute(d_x.cview(), P, d_px.view(), N);
+        ctx.spmv(PA.cview(), d_px.cview(), d_py.view());
+        ctx.inverse_permute(d_py.cview(), P, d_y.view(), N);
+        ctx.sync();
+        VectorX<T> y;
+        d_y.copy_to(y);
+        REQUIRE(y.isApprox(Eigen::MatrixX<T>(host_A) * x));
+
+        // vector roundtrip
+        ctx.inverse_permute(d_px.cview(), P, d_y.view(), N);
+        ctx.sync();
+        d_y.copy_to(y);
+        REQUIRE(y == x);
+    }
+
+    {  // CSR, its own (scalar) RCM
+        std::vector<int> host_scalar_perm;
+        host_ctx.rcm(host_A, host_scalar_perm);
+
+        LinearSystemPermutation scalar_P;
+        ctx.rcm(A_csr.cview(), scalar_P);
+        scalar_P.copy_to(perm);
+        REQUIRE(perm == host_scalar_perm);
+
+        Eigen::SparseMatrix<T, Eigen::RowMajor> host_scalar_PA;
+        host_ctx.permute(host_A, host_scalar_perm, host_scalar_PA);
+
+        DeviceCSRMatrix<T> PA;
+        ctx.permute(A_csr.cview(), scalar_P, PA);
+        ctx.sync();
+        REQUIRE(Eigen::MatrixX<T>(to_host_sparse(PA)).isApprox(Eigen::MatrixX<T>(host_scalar_PA)));
+    }
+
+    {  // Morton order of the node positions
+        std::vector<int> host_morton;
+        host_ctx.morton(positions, host_morton);
+
+        DeviceBuffer<Eigen::Vector3<T>> d_positions = positions;
+        LinearSystemPermutation         morton_P;
+        ctx.morton(d_positions.view().as_const(), morton_P);
+        ctx.sync();
+        morton_P.copy_to(perm);
+        REQUIRE(perm == host_morton);
+
+        // the lowest corner of the grid has code 0
+        REQUIRE(positions[perm.front()].isZero());
+    }
+}
+
+TEST_CASE("reorder", "[linear_system]")
+{
+    test_reorder<float, 3>(4);
+    test_reorder<float, 3>(12);
+    test_reorder<double, 3>(10);
+}
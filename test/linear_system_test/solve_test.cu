@@ -106,4 +106,76 @@ TEST_CASE("solve", "[linear_system]")
     test_linear_system_solve<float>(10);
     test_linear_system_solve<float>(100);
     test_linear_system_solve<float>(1000);
-}
\ No newline at end of file
+}
+
+template <typename T, int N>
+void test_linear_system_batched_solve(int batch, LinearSystemBatchedSolveMethod method)
+{
+    std::vector<Eigen::Matrix<T, N, N>> A(batch);
+    std::vector<Eigen::Vector<T, N>>    x(batch);
+    std::vector<Eigen::Vector<T, N>>    b(batch);
+    for(int i = 0; i < batch; ++i)
+    {
+        Eigen::Matrix<T, N, N> R = Eigen::Matrix<T, N, N>::Random();
+        // make A symmetric positive definite, so both LU and Cholesky apply
+        A[i] = R * R.transpose() + N * Eigen::Matrix<T, N, N>::Identity();
+        x[i] = Eigen::Vector<T, N>::Random();
+        b[i] = A[i] * x[i];
+    }
+    // one singular system
+    A[0].setZero();
+
+    {  // solve on host
+        HostLinearSystemContext ctx;
+        std::vector<Eigen::Vector<T, N>> x_host;
+        std::vector<int>                 info;
+        int failed = ctx.solve(x_host, A, b, method, &info);
+        REQUIRE(failed == 1);
+        REQUIRE(info[0] != 0);
+        REQUIRE(x_host[0].isZero());
+        for(int i = 1; i < batch; ++i)
+        {
+            REQUIRE(info[i] == 0);
+            REQUIRE(x[i].isApprox(x_host[i], T{1e-3}));
+        }
+    }
+
+    {  // solve on device
+        LinearSystemContext ctx;
+        DeviceBuffer<Eigen::Matrix<T, N, N>> A_device = A;
+        DeviceBuffer<Eigen::Vector<T, N>>    b_device = b;
+        DeviceBuffer<Eigen::Vector<T, N>>    x_device(batch);
+        DeviceBuffer<int>                    info_device(batch);
+
+        ctx.solve(x_device.view(),
+                  std::as_const(A_device).view(),
+                  std::as_const(b_device).view(),
+                  method,
+                  info_device.view());
+        ctx.sync();
+
+        std::vector<Eigen::Vector<T, N>> x_host;
+        std::vector<int>                 info;
+        x_device.copy_to(x_host);
+        info_device.copy_to(info);
+        REQUIRE(info[0] != 0);
+        REQUIRE(x_host[0].isZero());
+        for(int i = 1; i < batch; ++i)
+        {
+            REQUIRE(info[i] == 0);
+            REQUIRE(x[i].isApprox(x_host[i], T{1e-3}));
+        }
+    }
+}
+
+TEST_CASE("batched_solve", "[linear_system]")
+{
+    using Method = LinearSystemBatchedSolveMethod;
+    test_linear_system_batched_solve<float, 3>(1000, Method::LU);
+    test_linear_system_batched_solve<float, 3>(1000, Method::Cholesky);
+    test_linear_system_batched_solve<double, 12>(1000, Method::LU);
+    test_linear_system_batched_solve<double, 12>(1000, Method::Cholesky);
+    // larger systems go to the batched library routines
+    test_linear_system_batched_solve<double, 16>(100, Method::LU);
+    test_linear_system_batched_solve<double, 16>(100, Method::Cholesky);
+}
@@ -0,0 +1,133 @@
+#include <catch2/catch.hpp>
+#include <muda/muda.h>
+#include <muda/ext/linear_system.h>
+using namespace muda;
+using namespace Eigen;
+
+template <typename T>
+Eigen::MatrixX<T> to_dense(const DeviceCSRMatrix<T>& A)
+{
+    std::vector<int> row_offsets;
+    std::vector<int> col_indices;
+    std::vector<T>   values;
+    A.m_row_offsets.copy_to(row_offsets);
+    A.m_col_indices.copy_to(col_indices);
+    A.m_values.copy_to(values);
+
+    Eigen::MatrixX<T> dense = Eigen::MatrixX<T>::Zero(A.rows(), A.cols());
+    for(int i = 0; i < A.rows(); ++i)
+        for(int e = row_offsets[i]; e < row_offsets[i + 1]; ++e)
+            dense(i, col_indices[e]) += values[e];
+    return dense;
+}
+
+template <typename T>
+Eigen::SparseMatrix<T, Eigen::RowMajor> to_host_sparse(const DeviceCSRMatrix<T>& A)
+{
+    std::vector<int> row_offsets;
+    std::vector<int> col_indices;
+    std::vector<T>   values;
+    A.m_row_offsets.copy_to(row_offsets);
+    A.m_col_indices.copy_to(col_indices);
+    A.m_values.copy_to(values);
+
+    std::vector<Eigen::Triplet<T>> triplets;
+    for(int i = 0; i < A.rows(); ++i)
+        for(int e = row_offsets[i]; e < row_offsets[i + 1]; ++e)
+            triplets.emplace_back(i, col_indices[e], values[e]);
+
+    Eigen::SparseMatrix<T, Eigen::RowMajor> host(A.rows(), A.cols());
+    host.setFromTriplets(triplets.begin(), triplets.end());
+    return host;
+}
+
+// C = A * A^T for a random block_rows x block_cols BSR matrix A, checked against the host
+template <typename T, int N>
+void test_spgemm(int block_rows, int block_cols, int non_zero_block_count)
+{
+    LinearSystemContext     ctx;
+    HostLinearSystemContext host_ctx;
+
+    std::vector<int> row_indices(non_zero_block_count);
+    std::vector<int> col_indices(non_zero_block_count);
+    std::vector<Eigen::Matrix<T, N, N>> blocks(non_zero_block_count);
+    for(int i = 0; i < non_zero_block_count; ++i)
+    {
+        row_indices[i] = std::rand() % block_rows;
+        col_indices[i] = std::rand() % block_cols;
+        blocks[i]      = Eigen::Matrix<T, N, N>::Random();
+    }
+
+    DeviceTripletMatrix<T, N> A_triplet;
+    A_triplet.reshape(block_rows, block_cols);
+    A_triplet.resize_triplets(non_zero_block_count);
+    A_triplet.block_row_indices().copy_from(row_indices.data());
+    A_triplet.block_col_indices().copy_from(col_indices.data());
+    A_triplet.block_values().copy_from(blocks.data());
+
+    DeviceBCOOMatrix<T, N> A_bcoo;
+    ctx.convert(A_triplet, A_bcoo);
+    DeviceBSRMatrix<T, N> A_bsr;
+    ctx.convert(A_bcoo, A_bsr);
+    DeviceCSRMatrix<T> A_csr;
+    ctx.convert(A_bsr, A_csr);
+
+    auto host_A = to_host_sparse(A_csr);
+    Eigen::SparseMatrix<T, Eigen::RowMajor> host_AT;
+    Eigen::SparseMatrix<T, Eigen::RowMajor> host_C;
+    host_ctx.transpose(host_A, host_AT);
+    host_ctx.spgemm(host_A, host_AT, host_C);
+
+    {  // host reference
+        Eigen::MatrixX<T> dense_A = host_A;
+        REQUIRE(Eigen::MatrixX<T>(host_AT).isApprox(dense_A.transpose()));
+        REQUIRE(Eigen::MatrixX<T>(host_C).isApprox(dense_A * dense_A.transpose()));
+    }
+
+    Eigen::MatrixX<T> ground_truth = host_C;
+
+    {  // CSR
+        DeviceCSRMatrix<T> AT;
+        ctx.transpose(A_csr.cview(), AT);
+        ctx.sync();
+        REQUIRE(to_dense(AT).isApprox(Eigen::MatrixX<T>(host_AT)));
+
+        LinearSystemSpGEMMPlan plan;
+        DeviceCSRMatrix<T>     C;
+        ctx.spgemm_symbolic(A_csr.cview(), AT.cview(), plan, C);
+        ctx.spgemm_numeric(A_csr.cview(), AT.cview(), plan, C.view());
+        ctx.sync();
+        REQUIRE(C.non_zeros() == host_C.nonZeros());
+        REQUIRE(to_dense(C).isApprox(ground_truth));
+
+        // only the values of A change, the structure is reused
+        std::vector<T> values;
+        A_csr.m_values.copy_to(values);
+        for(auto& v : values)
+            v *= 2;
+        A_csr.m_values.copy_from(values);
+        ctx.spgemm_numeric(A_csr.cview(), AT.cview(), plan, C.view());
+        ctx.sync();
+        REQUIRE(to_dense(C).isApprox(T{2} * ground_truth));
+    }
+
+    {  // BSR
+        DeviceBSRMatrix<T, N> AT;
+        ctx.transpose(A_bsr.cview(), AT);
+
+        DeviceBSRMatrix<T, N> C;
+        ctx.spgemm(A_bsr.cview(), AT.cview(), C);
+
+        DeviceCSRMatrix<T> C_csr;
+        ctx.convert(C, C_csr);
+        ctx.sync();
+        REQUIRE(to_dense(C_csr).isApprox(ground_truth));
+    }
+}
+
+TEST_CASE("spgemm", "[linear_system]")
+{
+    test_spgemm<float, 3>(10, 7, 30);
+    test_spgemm<float, 3>(100, 80, 500);
+    test_spgemm<double, 4>(100, 120, 1000);
+}
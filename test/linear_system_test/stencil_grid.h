@@ -0,0 +1,65 @@
+#pragma once
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+#include <muda/ext/linear_system.h>
+
+// the block pattern of a 7-point stencil on an n x n x n grid: every node is
+// coupled to itself and to its (up to 6) face neighbours
+template <typename T>
+struct StencilGrid
+{
+    int                            n     = 0;
+    int                            nodes = 0;
+    std::vector<Eigen::Vector3<T>> positions;  // indexed by node
+    std::vector<int>               row_indices;
+    std::vector<int>               col_indices;
+};
+
+// the nodes are numbered x-major, or in random order (fixed seed) if `shuffled`
+template <typename T>
+StencilGrid<T> make_stencil_grid(int n, bool shuffled)
+{
+    StencilGrid<T> grid;
+    grid.n     = n;
+    grid.nodes = n * n * n;
+    grid.positions.resize(grid.nodes);
+
+    std::vector<int> numbering(grid.nodes);
+    std::iota(numbering.begin(), numbering.end(), 0);
+    if(shuffled)
+        std::shuffle(numbering.begin(), numbering.end(), std::mt19937{42});
+    auto id = [&](int x, int y, int z) { return numbering[(x * n + y) * n + z]; };
+
+    for(int x = 0; x < n; ++x)
+        for(int y = 0; y < n; ++y)
+            for(int z = 0; z < n; ++z)
+            {
+                int i                = id(x, y, z);
+                grid.positions[i]    = Eigen::Vector3<T>(x, y, z);
+                int neighbours[7][3] = {
+                    {x, y, z}, {x - 1, y, z}, {x + 1, y, z}, {x, y - 1, z}, {x, y + 1, z}, {x, y, z - 1}, {x, y, z + 1}};
+                for(auto& p : neighbours)
+                {
+                    if(p[0] < 0 || p[0] >= n || p[1] < 0 || p[1] >= n || p[2] < 0 || p[2] >= n)
+                        continue;
+                    grid.row_indices.push_back(i);
+                    grid.col_indices.push_back(id(p[0], p[1], p[2]));
+                }
+            }
+    return grid;
+}
+
+// one block per entry of the pattern
+template <typename T, int N>
+void make_stencil_triplet(const StencilGrid<T>&                      grid,
+                          const std::vector<Eigen::Matrix<T, N, N>>& blocks,
+                          muda::DeviceTripletMatrix<T, N>&           triplet)
+{
+    triplet.reshape(grid.nodes, grid.nodes);
+    triplet.resize_triplets(blocks.size());
+    triplet.block_row_indices().copy_from(grid.row_indices.data());
+    triplet.block_col_indices().copy_from(grid.col_indices.data());
+    triplet.block_values().copy_from(blocks.data());
+}
@@ -0,0 +1,81 @@
+#include <catch2/catch.hpp>
+#include <muda/muda.h>
+#include <muda/container.h>
+
+using namespace muda;
+
+void append_buffer_test(size_t hint)
+{
+    constexpr int N = 10000;
+
+    DeviceAppendBuffer<int> buffer(hint);
+    int                     runs = 0;
+
+    auto append_multiples_of = [&](int m)
+    {
+        return buffer.retry_if_overflow(
+            [&]
+            {
+                ++runs;
+                ParallelFor(256)
+                    .kernel_name(__FUNCTION__)
+                    .apply(N,
+                           [buffer = buffer.viewer().name("buffer"), m] __device__(int i) mutable
+                           {
+                               if(i % m == 0)
+                                   buffer.push_back(i);
+                           });
+            });
+    };
+
+    buffer.clear();
+    auto size3 = append_multiples_of(3);
+    auto size5 = append_multiples_of(5);  // appended after the multiples of 3
+
+    std::vector<int> gt3, gt5;
+    for(int i = 0; i < N; ++i)
+    {
+        if(i % 3 == 0)
+            gt3.push_back(i);
+        if(i % 5 == 0)
+            gt5.push_back(i);
+    }
+
+    REQUIRE(size3 == gt3.size());
+    REQUIRE(size5 == gt3.size() + gt5.size());
+    REQUIRE(buffer.size() == size5);
+    REQUIRE(!buffer.overflowed());
+    if(hint >= gt3.size() + gt5.size())
+        REQUIRE(runs == 2);
+
+    std::vector<int> h;
+    buffer.copy_to(h);
+    std::vector<int> h3(h.begin(), h.begin() + size3);
+    std::vector<int> h5(h.begin() + size3, h.end());
+    std::sort(h3.begin(), h3.end());
+    std::sort(h5.begin(), h5.end());
+    REQUIRE(h3 == gt3);
+    REQUIRE(h5 == gt5);
+
+    // the capacity is kept, the next pass runs once
+    buffer.clear();
+    runs = 0;
+    append_multiples_of(3);
+    REQUIRE(runs == 1);
+}
+
+TEST_CASE("append_buffer_test", "[buffer]")
+{
+    SECTION("no hint")
+    {
+        append_buffer_test(0);
+    }
+    SECTION("small hint")
+    {
+        append_buffer_test(100);
+    }
+    SECTION("enough hint")
+    {
+        append_buffer_test(10000);
+    }
+}
@@ -347,4 +347,95 @@ TEST_CASE("buffer_3d_test", "[buffer]")
     REQUIRE(dense3d(98, 99, 99) == 3);
     REQUIRE(dense3d(99, 98, 99) == 3);
     REQUIRE(dense3d(99, 99, 99) == 3);
-}
\ No newline at end of file
+}
+
+TEST_CASE("buffer_growth_policy", "[buffer]")
+{
+    // pure host logic
+    auto exact = BufferGrowthPolicy::exact();
+    REQUIRE(exact.grow(10, 11, sizeof(int)) == 11);
+    REQUIRE(exact.grow(10, 5, sizeof(int)) == 10);
+
+    auto geometric = BufferGrowthPolicy::geometric(1.5);
+    REQUIRE(geometric.grow(100, 101, sizeof(int)) == 150);
+    REQUIRE(geometric.grow(100, 200, sizeof(int)) == 200);
+    REQUIRE(geometric.grow(0, 1, sizeof(int)) == 1);
+
+    auto page = BufferGrowthPolicy::page_rounded(4096);
+    REQUIRE(page.grow(0, 1, sizeof(int)) == 1024);
+    REQUIRE(page.grow(1024, 1025, sizeof(int)) == 2048);
+    REQUIRE(page.grow(0, 3, 3000) == 4);  // 9000 bytes -> 12288 bytes
+
+    // 2D: only the exceeded dimension grows
+    auto e2 = geometric.grow(Extent2D{10, 10}, Extent2D{5, 11}, sizeof(int));
+    REQUIRE(e2.height() == 10);
+    REQUIRE(e2.width() == 15);
+    auto e3 = geometric.grow(Extent3D{10, 10, 10}, Extent3D{11, 5, 5}, sizeof(int));
+    REQUIRE(e3.depth() == 15);
+    REQUIRE(e3.height() == 10);
+    REQUIRE(e3.width() == 10);
+
+    // appending is amortized O(1) even with the exact policy
+    REQUIRE(exact.for_append().kind() == BufferGrowth::Geometric);
+    REQUIRE(page.for_append().kind() == BufferGrowth::PageRounded);
+
+    // copies take the policy along
+    DeviceBuffer<int> a(4);
+    a.growth_policy(geometric);
+    DeviceBuffer<int> b(a);
+    DeviceBuffer<int> c;
+    c = a;
+    REQUIRE(b.growth_policy().kind() == BufferGrowth::Geometric);
+    REQUIRE(c.growth_policy().kind() == BufferGrowth::Geometric);
+}
+
+TEST_CASE("buffer_append", "[buffer]")
+{
+    DeviceBuffer<int> buffer;
+    std::vector<int>  gt;
+    int               reallocations = 0;
+    for(int i = 0; i < 1000; ++i)
+    {
+        std::vector<int> chunk = {i, i + 1, i + 2};
+        auto             cap   = buffer.capacity();
+        buffer.append(chunk);
+        if(buffer.capacity() != cap)
+            ++reallocations;
+        gt.insert(gt.end(), chunk.begin(), chunk.end());
+    }
+    REQUIRE(reallocations < 20);
+
+    std::vector<int> h_res;
+    buffer.copy_to(h_res);
+    REQUIRE(h_res == gt);
+
+    // append a view of itself
+    buffer.append(std::as_const(buffer).view());
+    gt.insert(gt.end(), gt.begin(), gt.end());
+    buffer.copy_to(h_res);
+    REQUIRE(h_res == gt);
+
+    // growth policy of resize
+    DeviceBuffer<int> geometric;
+    geometric.growth_policy(BufferGrowthPolicy::geometric(2.0));
+    geometric.resize(100);
+    geometric.resize(101);
+    REQUIRE(geometric.capacity() == 200);
+
+    DeviceBuffer<int> exact;
+    exact.resize(100);
+    BufferLaunch().growth_policy(BufferGrowthPolicy::page_rounded(4096)).resize(exact, 101).wait();
+    REQUIRE(exact.capacity() == 1024);
+    exact.resize(1025);
+    REQUIRE(exact.capacity() == 1025);
+
+    DeviceBuffer2D<int> buffer2d;
+    buffer2d.growth_policy(BufferGrowthPolicy::geometric(2.0));
+    buffer2d.resize(Extent2D{10, 10}, 1);
+    buffer2d.resize(Extent2D{10, 11}, 2);
+    REQUIRE(buffer2d.capacity() == Extent2D{10, 20});
+    std::vector<int> h2d;
+    buffer2d.copy_to(h2d);
+    REQUIRE(std::count(h2d.begin(), h2d.end(), 1) == 100);
+    REQUIRE(std::count(h2d.begin(), h2d.end(), 2) == 10);
+}
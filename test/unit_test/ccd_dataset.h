@@ -0,0 +1,53 @@
+#pragma once
+#include <catch2/catch.hpp>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <Eigen/Core>
+
+// the rational queries of test/data/unit-tests, 8 lines per query: the 4
+// vertices at t = 0 and at t = 1, `x_num,x_den,y_num,y_den,z_num,z_den,truth`
+struct CCDDataset
+{
+    std::vector<Eigen::Vector4i> prims;
+    std::vector<Eigen::Vector3d> x;
+    std::vector<Eigen::Vector3d> dx;
+    std::vector<int>             truth;
+};
+
+inline void load_ccd_dataset(CCDDataset& dataset, const std::string& path)
+{
+    std::ifstream file{path};
+    REQUIRE(file.is_open());
+    std::string     line;
+    Eigen::Vector3d v[8];
+    int             row = 0, truth = 0;
+    while(std::getline(file, line))
+    {
+        if(line.empty())
+            continue;
+        std::stringstream ss{line};
+        std::string       token;
+        double            values[7];
+        for(auto& value : values)
+        {
+            std::getline(ss, token, ',');
+            value = std::stod(token);
+        }
+        v[row] = Eigen::Vector3d{values[0] / values[1], values[2] / values[3], values[4] / values[5]};
+        truth = static_cast<int>(values[6]);
+        if(++row < 8)
+            continue;
+
+        int base = static_cast<int>(dataset.x.size());
+        for(int k = 0; k < 4; ++k)
+        {
+            dataset.x.push_back(v[k]);
+            dataset.dx.push_back(v[k + 4] - v[k]);
+        }
+        dataset.prims.push_back({base, base + 1, base + 2, base + 3});
+        dataset.truth.push_back(truth);
+        row = 0;
+    }
+}
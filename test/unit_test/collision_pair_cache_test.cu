@@ -0,0 +1,115 @@
+#include <catch2/catch.hpp>
+#include <random>
+#include <muda/muda.h>
+#include <muda/container.h>
+#include <muda/ext/geo/spatial_hash.h>
+
+using namespace muda;
+using namespace muda::spatial_hash;
+
+static std::vector<CollisionPair> random_pairs(std::mt19937& gen, int n)
+{
+    std::uniform_int_distribution<int> dist(0, 63);
+    std::vector<CollisionPair>         pairs;
+    for(int k = 0; k < n; ++k)
+    {
+        int i = dist(gen), j = dist(gen);
+        if(i != j)
+            pairs.push_back(CollisionPair{i, j});
+    }
+    return pairs;  // with duplicates
+}
+
+template <typename T>
+static std::vector<T> to_host(CBufferView<T> view)
+{
+    std::vector<T> h(view.size());
+    if(!h.empty())
+        view.copy_to(h.data());
+    return h;
+}
+
+static void check_frame(const CollisionPairCache&         cache,
+                        const std::vector<CollisionPair>& old_frame,
+                        const std::vector<CollisionPair>& new_frame)
+{
+    auto sorted_unique = [](std::vector<CollisionPair> v)
+    {
+        std::sort(v.begin(), v.end());
+        v.erase(std::unique(v.begin(), v.end()), v.end());
+        return v;
+    };
+    auto old_gt = sorted_unique(old_frame);
+    auto new_gt = sorted_unique(new_frame);
+
+    auto pairs     = to_host(cache.pairs());
+    auto old_pairs = to_host(cache.old_pairs());
+    REQUIRE(pairs == new_gt);
+    REQUIRE(old_pairs == old_gt);
+
+    auto new_indices     = to_host(cache.new_indices());
+    auto kept_indices    = to_host(cache.kept_indices());
+    auto removed_indices = to_host(cache.removed_indices());
+    auto old_to_new      = to_host(cache.old_to_new());
+    auto new_to_old      = to_host(cache.new_to_old());
+
+    std::vector<int> new_gt_indices, kept_gt_indices, removed_gt_indices;
+    std::vector<int> old_to_new_gt(old_gt.size(), -1), new_to_old_gt(new_gt.size(), -1);
+    for(int i = 0; i < new_gt.size(); ++i)
+    {
+        auto it = std::lower_bound(old_gt.begin(), old_gt.end(), new_gt[i]);
+        if(it != old_gt.end() && *it == new_gt[i])
+        {
+            int o            = static_cast<int>(it - old_gt.begin());
+            new_to_old_gt[i] = o;
+            old_to_new_gt[o] = i;
+            kept_gt_indices.push_back(i);
+        }
+        else
+            new_gt_indices.push_back(i);
+    }
+    for(int o = 0; o < old_gt.size(); ++o)
+        if(old_to_new_gt[o] < 0)
+            removed_gt_indices.push_back(o);
+
+    REQUIRE(new_indices == new_gt_indices);
+    REQUIRE(kept_indices == kept_gt_indices);
+    REQUIRE(removed_indices == removed_gt_indices);
+    REQUIRE(old_to_new == old_to_new_gt);
+    REQUIRE(new_to_old == new_to_old_gt);
+}
+
+void collision_pair_cache_test()
+{
+    std::mt19937 gen(7);
+
+    CollisionPairCache          cache;
+    DeviceBuffer<CollisionPair> detected;
+
+    std::vector<CollisionPair> old_frame;
+    for(int frame = 0; frame < 4; ++frame)
+    {
+        // keep some of the last frame, add some new ones
+        std::vector<CollisionPair> new_frame(
+            old_frame.begin(), old_frame.begin() + old_frame.size() / 2);
+        auto fresh = random_pairs(gen, 200);
+        new_frame.insert(new_frame.end(), fresh.begin(), fresh.end());
+        std::shuffle(new_frame.begin(), new_frame.end(), gen);
+
+        detected = new_frame;
+        cache.update(detected);
+        check_frame(cache, old_frame, new_frame);
+
+        old_frame = new_frame;
+    }
+
+    // an empty frame removes everything
+    detected.clear();
+    cache.update(detected);
+    check_frame(cache, old_frame, {});
+}
+
+TEST_CASE("collision_pair_cache_test", "[spatial_hash]")
+{
+    collision_pair_cache_test();
+}
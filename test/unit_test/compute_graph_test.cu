@@ -4,6 +4,9 @@
 #include <muda/cub/device/device_scan.h>
 #include <muda/syntax_sugar.h>
 #include <Eigen/Core>
+#include <set>
+#include <thread>
+#include <sstream>
 
 using namespace muda;
 using Vector3 = Eigen::Vector3f;
@@ -558,4 +561,280 @@ TEST_CASE("compute_graph_capture", "[compute_graph]")
 {
     compute_graph_capture();
 }
+
+void compute_graph_conditional(bool single_stream)
+{
+    ComputeGraphVarManager manager;
+    // without conditional graph node, the body is tail launched from device
+    ComputeGraph graph{manager, "graph", ComputeGraphFlag::DeviceLaunch};
+    ComputeGraph loop_body{manager, "loop_body", ComputeGraphFlag::DeviceLaunch};
+    ComputeGraph if_body{manager, "if_body", ComputeGraphFlag::DeviceLaunch};
+
+    // define graph vars
+    auto& N        = manager.create_var<int>("N");
+    auto& counter  = manager.create_var<VarView<int>>("counter");
+    auto& cond     = manager.create_var<VarView<int>>("cond");
+    auto& if_cond  = manager.create_var<VarView<int>>("if_cond");
+    auto& if_count = manager.create_var<VarView<int>>("if_count");
+
+    graph.create_node("init") << [&]
+    {
+        ParallelFor(1).apply(1,
+                             [counter = counter.eval().viewer(),
+                              cond    = cond.eval().viewer(),
+                              N       = N.eval()] __device__(int i) mutable
+                             {
+                                 *counter = 0;
+                                 *cond    = N > 0;
+                             });
+    };
+
+    // counter += 1 until counter == N
+    loop_body.create_node("step") << [&]
+    {
+        ParallelFor(1).apply(1,
+                             [counter = counter.eval().viewer(),
+                              cond    = cond.eval().viewer(),
+                              N       = N.eval()] __device__(int i) mutable
+                             {
+                                 *counter += 1;
+                                 *cond = *counter < N;
+                             });
+    };
+
+    if_body.create_node("count") << [&]
+    {
+        ParallelFor(1).apply(1,
+                             [if_count = if_count.eval().viewer()] __device__(
+                                 int i) mutable { *if_count += 1; });
+    };
+
+    graph.create_while_node("loop", cond, loop_body);
+    graph.create_if_node("if", if_cond, if_body);
+
+    // prepare resources
+    DeviceVar<int> counter_var;
+    DeviceVar<int> cond_var;
+    DeviceVar<int> if_cond_var  = 0;
+    DeviceVar<int> if_count_var = 0;
+
+    N        = 10;
+    counter  = counter_var.view();
+    cond     = cond_var.view();
+    if_cond  = if_cond_var.view();
+    if_count = if_count_var.view();
+
+    graph.launch(single_stream);
+    wait_device();
+    REQUIRE(counter_var == 10);
+    REQUIRE(if_count_var == 0);
+
+    // update: change N and take the if branch
+    if_cond_var = 1;
+    N           = 3;
+    graph.launch(single_stream);
+    wait_device();
+    REQUIRE(counter_var == 3);
+    REQUIRE(if_count_var == 1);
+
+    // zero iteration
+    N = 0;
+    graph.launch(single_stream);
+    wait_device();
+    REQUIRE(counter_var == 0);
+    REQUIRE(if_count_var == 2);
+}
+
+TEST_CASE("compute_graph_conditional", "[compute_graph]")
+{
+    SECTION("serial launch")
+    {
+        compute_graph_conditional(true);
+    }
+
+#if MUDA_WITH_GRAPH_CONDITIONAL_NODE || defined(__CUDACC_RDC__)
+    SECTION("graph launch")
+    {
+        compute_graph_conditional(false);
+    }
+#endif
+}
+
+void compute_graph_concurrent_build()
+{
+    constexpr int GraphCount  = 32;
+    constexpr int VarPerGraph = 8;
+
+    ComputeGraphVarManager manager;
+    auto& N = manager.create_var<int>("N", 16);
+
+    std::vector<std::shared_ptr<ComputeGraph>> graphs(GraphCount);
+    std::vector<std::string>                   dots(GraphCount);
+    std::vector<std::thread>                   threads;
+
+    for(int g = 0; g < GraphCount; ++g)
+    {
+        threads.emplace_back(
+            [&, g]
+            {
+                auto prefix = "g" + std::to_string(g);
+                auto graph  = manager.create_graph(prefix);
+
+                // x_i = x_{i-1} + 1, a chain of dependencies
+                std::vector<ComputeGraphVar<BufferView<float>>*> xs;
+                for(int i = 0; i < VarPerGraph; ++i)
+                    xs.push_back(&manager.create_var<BufferView<float>>(
+                        prefix + "_x" + std::to_string(i)));
+
+                for(int i = 1; i < VarPerGraph; ++i)
+                {
+                    graph->create_node(prefix + "_node" + std::to_string(i))
+                        << [&N, src = xs[i - 1], dst = xs[i]]
+                    {
+                        ParallelFor(256).apply(N.eval(),
+                                               [src = src->ceval().cviewer(),
+                                                dst = dst->eval().viewer()] __device__(int j) mutable
+                                               { dst(j) = src(j) + 1.0f; });
+                    };
+                }
+
+                // topo building only, no cuda graph is created
+                std::stringstream ss;
+                graph->graphviz(ss);
+                dots[g]   = ss.str();
+                graphs[g] = graph;
+            });
+    }
+    for(auto& t : threads)
+        t.join();
+
+    REQUIRE(manager.graphs().size() == GraphCount);
+
+    std::set<VarId> var_ids;
+    for(int g = 0; g < GraphCount; ++g)
+    {
+        auto prefix = "g" + std::to_string(g);
+        for(int i = 0; i < VarPerGraph; ++i)
+        {
+            auto var = manager.find_var<BufferView<float>>(prefix + "_x" + std::to_string(i));
+            REQUIRE(var != nullptr);
+            var_ids.insert(var->var_id());
+        }
+        REQUIRE(dots[g].find(prefix + "_node" + std::to_string(VarPerGraph - 1))
+                != std::string::npos);
+    }
+    // all vars get a unique id
+    REQUIRE(var_ids.size() == GraphCount * VarPerGraph);
+    // nothing is launched
+    REQUIRE(!manager.is_using(N));
+}
+
+TEST_CASE("compute_graph_concurrent_build", "[compute_graph]")
+{
+    compute_graph_concurrent_build();
+}
+
+// y = x + 1, z = y * 2
+void compute_graph_topo_cache_define(ComputeGraphVarManager& manager,
+                                     ComputeGraph&           graph,
+                                     bool                    changed_body = false)
+{
+    auto& N = manager.create_var<int>("N");
+    auto& x = manager.create_var<BufferView<float>>("x");
+    auto& y = manager.create_var<BufferView<float>>("y");
+    auto& z = manager.create_var<BufferView<float>>("z");
+
+    graph.create_node("cal_y") << [&]
+    {
+        ParallelFor(256).apply(N.eval(),
+                               [x = x.ceval().cviewer(), y = y.eval().viewer()] __device__(
+                                   int i) mutable { y(i) = x(i) + 1.0f; });
+    };
+
+    graph.create_node("cal_z") << [&, changed_body]
+    {
+        // a stale cache: the closure reads x instead of y, with the same name
+        auto src = changed_body ? x.ceval() : y.ceval();
+        ParallelFor(256).apply(N.eval(),
+                               [src = src.cviewer(), z = z.eval().viewer()] __device__(
+                                   int i) mutable { z(i) = src(i) * 2.0f; });
+    };
+}
+
+void compute_graph_topo_cache()
+{
+    // first run: discover and export
+    std::vector<std::byte> blob;
+    {
+        ComputeGraphVarManager manager;
+        ComputeGraph           graph{manager};
+        compute_graph_topo_cache_define(manager, graph);
+        blob = graph.export_topo();
+    }
+
+    // later run: import, and the graph works without topo building
+    {
+        ComputeGraphVarManager manager;
+        ComputeGraph           graph{manager};
+        compute_graph_topo_cache_define(manager, graph);
+        REQUIRE(graph.import_topo(blob));
+        REQUIRE(graph.export_topo() == blob);
+
+        int                 N_value = 16;
+        DeviceBuffer<float> x_buffer(N_value);
+        DeviceBuffer<float> y_buffer(N_value);
+        DeviceBuffer<float> z_buffer(N_value);
+        x_buffer.fill(1.0f);
+
+        *manager.find_var<int>("N")               = N_value;
+        *manager.find_var<BufferView<float>>("x") = x_buffer.view();
+        *manager.find_var<BufferView<float>>("y") = y_buffer.view();
+        *manager.find_var<BufferView<float>>("z") = z_buffer.view();
+
+        graph.launch();
+        wait_device();
+
+        std::vector<float> h_z;
+        z_buffer.copy_to(h_z);
+        REQUIRE(std::all_of(h_z.begin(), h_z.end(), [](float v) { return v == 4.0f; }));
+    }
+
+    // the cache is up to date
+    {
+        ComputeGraphVarManager manager;
+        ComputeGraph           graph{manager};
+        compute_graph_topo_cache_define(manager, graph);
+        REQUIRE(graph.import_topo(blob, ComputeGraphTopoCacheMode::Validate));
+    }
+
+    // the signature can't see closure bodies, validation can
+    {
+        ComputeGraphVarManager manager;
+        ComputeGraph           graph{manager};
+        compute_graph_topo_cache_define(manager, graph, true);
+        REQUIRE(!graph.import_topo(blob, ComputeGraphTopoCacheMode::Validate));
+    }
+
+    // another graph
+    {
+        ComputeGraphVarManager manager;
+        ComputeGraph           graph{manager, "another_graph"};
+        compute_graph_topo_cache_define(manager, graph);
+        REQUIRE(!graph.import_topo(blob));
+    }
+
+    // a truncated blob
+    {
+        ComputeGraphVarManager manager;
+        ComputeGraph           graph{manager};
+        compute_graph_topo_cache_define(manager, graph);
+        auto truncated = span<const std::byte>{blob}.subspan(0, blob.size() - 1);
+        REQUIRE(!graph.import_topo(truncated));
+    }
+}
+
+TEST_CASE("compute_graph_topo_cache", "[compute_graph]")
+{
+    compute_graph_topo_cache();
+}
 #endif
\ No newline at end of file
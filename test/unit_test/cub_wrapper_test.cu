@@ -1387,3 +1387,243 @@ TEST_CASE("device_partition", "[cub]")
         REQUIRE(h_keys_out == gt_keys_out);
     }
 }
+
+// the host backend runs on host memory, cub runs on device memory, results must match
+TEST_CASE("cub_host_backend", "[cub]")
+{
+    // large enough to be split into several chunks
+    size_t size = 50000;
+
+    std::vector<int>   h_keys(size);
+    std::vector<float> h_float_keys(size);
+    std::vector<int>   h_values(size);
+    for(size_t i = 0; i < size; ++i)
+    {
+        h_keys[i]       = std::rand() % 2001 - 1000;
+        h_float_keys[i] = (std::rand() % 2001 - 1000) * 0.25f;
+        h_values[i]     = static_cast<int>(i);
+    }
+
+    DeviceBuffer<int>   d_keys       = h_keys;
+    DeviceBuffer<float> d_float_keys = h_float_keys;
+    DeviceBuffer<int>   d_values     = h_values;
+
+    SECTION("RadixSort")
+    {
+        DeviceBuffer<int> d_keys_out(size);
+        DeviceBuffer<int> d_values_out(size);
+        std::vector<int>  h_keys_out(size), h_values_out(size);
+        std::vector<int>  gt_keys_out, gt_values_out;
+
+        DeviceRadixSort()
+            .SortPairs(d_keys.data(), d_keys_out.data(), d_values.data(), d_values_out.data(), size)
+            .wait();
+        DeviceRadixSort()
+            .backend(CubBackend::Host)
+            .SortPairs(h_keys.data(), h_keys_out.data(), h_values.data(), h_values_out.data(), size);
+        d_keys_out.copy_to(gt_keys_out);
+        d_values_out.copy_to(gt_values_out);
+        REQUIRE(h_keys_out == gt_keys_out);
+        REQUIRE(h_values_out == gt_values_out);
+
+        DeviceRadixSort()
+            .SortPairsDescending(
+                d_keys.data(), d_keys_out.data(), d_values.data(), d_values_out.data(), size)
+            .wait();
+        DeviceRadixSort()
+            .backend(CubBackend::Host)
+            .SortPairsDescending(
+                h_keys.data(), h_keys_out.data(), h_values.data(), h_values_out.data(), size);
+        d_keys_out.copy_to(gt_keys_out);
+        d_values_out.copy_to(gt_values_out);
+        REQUIRE(h_keys_out == gt_keys_out);
+        REQUIRE(h_values_out == gt_values_out);
+
+        // a bit range only sorts by part of the key
+        DeviceRadixSort()
+            .SortPairs(d_keys.data(), d_keys_out.data(), d_values.data(), d_values_out.data(), size, 4, 12)
+            .wait();
+        DeviceRadixSort()
+            .backend(CubBackend::Host)
+            .SortPairs(h_keys.data(), h_keys_out.data(), h_values.data(), h_values_out.data(), size, 4, 12);
+        d_keys_out.copy_to(gt_keys_out);
+        d_values_out.copy_to(gt_values_out);
+        REQUIRE(h_keys_out == gt_keys_out);
+        REQUIRE(h_values_out == gt_values_out);
+
+        DeviceBuffer<float> d_float_keys_out(size);
+        std::vector<float>  h_float_keys_out(size), gt_float_keys_out;
+        DeviceRadixSort().SortKeys(d_float_keys.data(), d_float_keys_out.data(), size).wait();
+        DeviceRadixSort().backend(CubBackend::Host).SortKeys(h_float_keys.data(), h_float_keys_out.data(), size);
+        d_float_keys_out.copy_to(gt_float_keys_out);
+        REQUIRE(h_float_keys_out == gt_float_keys_out);
+    }
+
+    SECTION("Scan")
+    {
+        DeviceBuffer<int> d_out(size);
+        std::vector<int>  h_out(size), gt_out;
+
+        DeviceScan().ExclusiveSum(d_keys.data(), d_out.data(), size).wait();
+        DeviceScan().backend(CubBackend::Host).ExclusiveSum(h_keys.data(), h_out.data(), size);
+        d_out.copy_to(gt_out);
+        REQUIRE(h_out == gt_out);
+
+        DeviceScan()
+            .InclusiveScan(d_keys.data(), d_out.data(), cub::Max(), size)
+            .wait();
+        DeviceScan()
+            .backend(CubBackend::Host)
+            .InclusiveScan(h_keys.data(), h_out.data(), cub::Max(), size);
+        d_out.copy_to(gt_out);
+        REQUIRE(h_out == gt_out);
+    }
+
+    SECTION("Reduce")
+    {
+        DeviceVar<int> d_sum;
+        int            h_sum = 0;
+        DeviceReduce().Sum(d_keys.data(), d_sum.data(), size).wait();
+        DeviceReduce().backend(CubBackend::Host).Sum(h_keys.data(), &h_sum, size);
+        REQUIRE(h_sum == (int)d_sum);
+
+        DeviceVar<KeyValuePair<int, int>> d_arg_min;
+        KeyValuePair<int, int>            h_arg_min;
+        DeviceReduce().ArgMin(d_keys.data(), d_arg_min.data(), size).wait();
+        DeviceReduce().backend(CubBackend::Host).ArgMin(h_keys.data(), &h_arg_min, size);
+        KeyValuePair<int, int> gt_arg_min = d_arg_min;
+        REQUIRE(h_arg_min.key == gt_arg_min.key);
+        REQUIRE(h_arg_min.value == gt_arg_min.value);
+    }
+
+    SECTION("Select")
+    {
+        DeviceBuffer<int> d_out(size);
+        DeviceVar<int>    d_num;
+        std::vector<int>  h_out(size), gt_out;
+        int               h_num = 0;
+
+        auto is_even = [] __host__ __device__(int key) { return key % 2 == 0; };
+        DeviceSelect().If(d_keys.data(), d_out.data(), d_num.data(), size, is_even).wait();
+        DeviceSelect().backend(CubBackend::Host).If(h_keys.data(), h_out.data(), &h_num, size, is_even);
+        REQUIRE(h_num == (int)d_num);
+        d_out.resize(h_num);
+        d_out.copy_to(gt_out);
+        h_out.resize(h_num);
+        REQUIRE(h_out == gt_out);
+    }
+
+    SECTION("RunLengthEncode")
+    {
+        // runs of equal keys
+        std::vector<int> h_sorted = h_keys;
+        std::sort(h_sorted.begin(), h_sorted.end());
+        DeviceBuffer<int> d_sorted = h_sorted;
+
+        DeviceBuffer<int> d_unique(size), d_counts(size);
+        DeviceVar<int>    d_num_runs;
+        std::vector<int>  h_unique(size), h_counts(size), gt_unique, gt_counts;
+        int               h_num_runs = 0;
+
+        DeviceRunLengthEncode()
+            .Encode(d_sorted.data(), d_unique.data(), d_counts.data(), d_num_runs.data(), size)
+            .wait();
+        DeviceRunLengthEncode()
+            .backend(CubBackend::Host)
+            .Encode(h_sorted.data(), h_unique.data(), h_counts.data(), &h_num_runs, size);
+
+        REQUIRE(h_num_runs == (int)d_num_runs);
+        d_unique.resize(h_num_runs);
+        d_counts.resize(h_num_runs);
+        d_unique.copy_to(gt_unique);
+        d_counts.copy_to(gt_counts);
+        h_unique.resize(h_num_runs);
+        h_counts.resize(h_num_runs);
+        REQUIRE(h_unique == gt_unique);
+        REQUIRE(h_counts == gt_counts);
+    }
+
+    SECTION("Segmented")
+    {
+        // ragged segments, some of them empty
+        std::vector<int> h_offsets{0};
+        while(h_offsets.back() < (int)size)
+            h_offsets.push_back(std::min<int>(size, h_offsets.back() + std::rand() % 300));
+        int               num_segments = (int)h_offsets.size() - 1;
+        DeviceBuffer<int> d_offsets    = h_offsets;
+
+        DeviceBuffer<int> d_sums(num_segments);
+        std::vector<int>  h_sums(num_segments), gt_sums;
+        DeviceSegmentedReduce()
+            .Sum(d_keys.data(), d_sums.data(), num_segments, d_offsets.data(), d_offsets.data() + 1)
+            .wait();
+        DeviceSegmentedReduce()
+            .backend(CubBackend::Host)
+            .Sum(h_keys.data(), h_sums.data(), num_segments, h_offsets.data(), h_offsets.data() + 1);
+        d_sums.copy_to(gt_sums);
+        REQUIRE(h_sums == gt_sums);
+
+        DeviceBuffer<int> d_keys_out(size), d_values_out(size);
+        std::vector<int>  h_keys_out(size), h_values_out(size), gt_keys_out, gt_values_out;
+        DeviceSegmentedRadixSort()
+            .SortPairs(d_keys.data(),
+                       d_keys_out.data(),
+                       d_values.data(),
+                       d_values_out.data(),
+                       size,
+                       num_segments,
+                       d_offsets.data(),
+                       d_offsets.data() + 1,
+                       0,
+                       sizeof(int) * 8)
+            .wait();
+        DeviceSegmentedRadixSort()
+            .backend(CubBackend::Host)
+            .SortPairs(h_keys.data(),
+                       h_keys_out.data(),
+                       h_values.data(),
+                       h_values_out.data(),
+                       size,
+                       num_segments,
+                       h_offsets.data(),
+                       h_offsets.data() + 1,
+                       0,
+                       sizeof(int) * 8);
+        d_keys_out.copy_to(gt_keys_out);
+        d_values_out.copy_to(gt_values_out);
+        REQUIRE(h_keys_out == gt_keys_out);
+        REQUIRE(h_values_out == gt_values_out);
+    }
+
+    SECTION("Histogram")
+    {
+        int               num_levels = 65;
+        DeviceBuffer<int> d_histogram(num_levels - 1);
+        std::vector<int>  h_histogram(num_levels - 1), gt_histogram;
+
+        DeviceHistogram()
+            .HistogramEven(d_keys.data(), d_histogram.data(), num_levels, -800, 800, (int)size)
+            .wait();
+        DeviceHistogram()
+            .backend(CubBackend::Host)
+            .HistogramEven(h_keys.data(), h_histogram.data(), num_levels, -800, 800, (int)size);
+        d_histogram.copy_to(gt_histogram);
+        REQUIRE(h_histogram == gt_histogram);
+    }
+
+    SECTION("MergeSort")
+    {
+        auto less = [] __host__ __device__(int l, int r) { return l < r; };
+
+        std::vector<int> h_sorted_keys = h_keys, h_sorted_values = h_values;
+        std::vector<int> gt_keys, gt_values;
+        DeviceMergeSort().StableSortPairs(d_keys.data(), d_values.data(), size, less).wait();
+        DeviceMergeSort()
+            .backend(CubBackend::Host)
+            .StableSortPairs(h_sorted_keys.data(), h_sorted_values.data(), size, less);
+        d_keys.copy_to(gt_keys);
+        d_values.copy_to(gt_values);
+        REQUIRE(h_sorted_keys == gt_keys);
+        REQUIRE(h_sorted_values == gt_values);
+    }
+}
@@ -1,9 +1,15 @@
 #include <catch2/catch.hpp>
+#include <random>
 #include <muda/muda.h>
 #include <muda/container.h>
 #include <muda/ext/geo/distance/distance_type.h>
+#include <muda/ext/geo/distance/batched_ccd.h>
+#include <muda/ext/geo/distance/inclusion_ccd.h>
+#include "ccd_dataset.h"
 
 using namespace muda;
+using namespace muda::distance;
+using namespace Eigen;
 
 void distance_test()
 {
@@ -14,3 +20,199 @@ TEST_CASE("distance_test", "[geo]")
 {
     distance_test();
 }
+
+struct CCDProblem
+{
+    std::vector<Vector4i> prims;
+    std::vector<Vector3f> x;
+    std::vector<Vector3f> dx;
+};
+
+// random primitives moving towards each other, a few percent of them collide
+static CCDProblem make_ccd_problem(int n)
+{
+    std::mt19937                          gen(3);
+    std::uniform_real_distribution<float> pos(-1.0f, 1.0f);
+    auto rand3 = [&] { return Vector3f{pos(gen), pos(gen), pos(gen)}; };
+
+    CCDProblem problem;
+    for(int i = 0; i < n; ++i)
+    {
+        int      base = static_cast<int>(problem.x.size());
+        Vector3f dir  = rand3() * 2.0f;
+        // the first vertex (point / edge a) moves by dir, the others stay
+        for(int k = 0; k < 4; ++k)
+        {
+            Vector3f offset = k == 0 || k == 1 ? Vector3f{0, 0, 1.0f} : Vector3f::Zero();
+            problem.x.push_back(rand3() * 0.5f + offset);
+            problem.dx.push_back(k < 2 ? Vector3f(dir + rand3() * 0.1f) : Vector3f(rand3() * 0.1f));
+        }
+        problem.prims.push_back({base, base + 1, base + 2, base + 3});
+    }
+    return problem;
+}
+
+template <typename Scalar>
+static std::vector<float> scalar_ccd(const CCDProblem& problem, const BatchedCCDConfig& config, Scalar&& f)
+{
+    std::vector<float> tois(problem.prims.size());
+    for(size_t i = 0; i < problem.prims.size(); ++i)
+    {
+        Vector3f x[4], dx[4];
+        for(int k = 0; k < 4; ++k)
+        {
+            x[k]  = problem.x[problem.prims[i][k]];
+            dx[k] = problem.dx[problem.prims[i][k]];
+        }
+        float toc = 1.0f;
+        tois[i] = f(x, dx, config.eta, config.thickness, config.max_iter, toc) ? toc : 1.0f;
+    }
+    return tois;
+}
+
+void batched_ccd_test(bool point_triangle)
+{
+    auto problem = make_ccd_problem(2000);
+
+    BatchedCCDConfig config;
+    config.eta       = 0.1f;
+    config.thickness = 0.0f;
+    config.max_iter  = 1000;
+
+    auto gt = point_triangle ?
+                  scalar_ccd(problem,
+                             config,
+                             [](Vector3f* x, Vector3f* dx, float eta, float thickness, int max_iter, float& toc)
+                             {
+                                 return point_triangle_ccd(
+                                     x[0], x[1], x[2], x[3], dx[0], dx[1], dx[2], dx[3], eta, thickness, max_iter, toc);
+                             }) :
+                  scalar_ccd(problem,
+                             config,
+                             [](Vector3f* x, Vector3f* dx, float eta, float thickness, int max_iter, float& toc)
+                             {
+                                 return edge_edge_ccd(
+                                     x[0], x[1], x[2], x[3], dx[0], dx[1], dx[2], dx[3], eta, thickness, max_iter, toc);
+                             });
+    float gt_min = *std::min_element(gt.begin(), gt.end());
+    REQUIRE(gt_min < 1.0f);
+
+    // host rounds reproduce the one-shot loop exactly, whatever the round size
+    for(int iterations_per_round : {1, 3, 16, 10000})
+    {
+        HostBatchedCCD host;
+        host.config()                      = config;
+        host.config().iterations_per_round = iterations_per_round;
+
+        std::vector<float> tois;
+        float              min_toi =
+            point_triangle ? host.point_triangle(problem.prims, problem.x, problem.dx, tois) :
+                                          host.edge_edge(problem.prims, problem.x, problem.dx, tois);
+        REQUIRE(tois == gt);
+        REQUIRE(min_toi == gt_min);
+        if(iterations_per_round == 1)
+            REQUIRE(host.rounds() > 1);
+    }
+
+    // device
+    DeviceBuffer<Vector4i> prims = problem.prims;
+    DeviceBuffer<Vector3f> x     = problem.x;
+    DeviceBuffer<Vector3f> dx    = problem.dx;
+    DeviceBuffer<float>    tois(problem.prims.size());
+
+    BatchedCCD ccd;
+    ccd.config()                      = config;
+    ccd.config().iterations_per_round = 4;
+    float min_toi = point_triangle ? ccd.point_triangle(prims, x, dx, tois) :
+                                     ccd.edge_edge(prims, x, dx, tois);
+
+    std::vector<float> h_tois;
+    tois.copy_to(h_tois);
+    // the device may contract to fma, allow a few grazing pairs to differ
+    size_t mismatch = 0;
+    for(size_t i = 0; i < gt.size(); ++i)
+        mismatch += std::abs(h_tois[i] - gt[i]) > 1e-3f;
+    REQUIRE(mismatch <= gt.size() / 100);
+    REQUIRE(min_toi == Approx(gt_min).margin(1e-3f));
+}
+
+TEST_CASE("batched_ccd_test", "[geo]")
+{
+    SECTION("point_triangle")
+    {
+        batched_ccd_test(true);
+    }
+    SECTION("edge_edge")
+    {
+        batched_ccd_test(false);
+    }
+}
+
+void inclusion_ccd_test(bool point_triangle)
+{
+    std::string dir = std::string{MUDA_TEST_DATA_DIR} + "/unit-tests/"
+                      + (point_triangle ? "vertex-face/" : "edge-edge/");
+    CCDDataset dataset;
+    load_ccd_dataset(dataset, dir + "data_0_0.csv");
+    load_ccd_dataset(dataset, dir + "data_0_1.csv");
+    REQUIRE(dataset.prims.size() > 0);
+
+    HostBatchedInclusionCCD<double> host;
+    std::vector<double>             gt;
+    point_triangle ? host.point_triangle(dataset.prims, dataset.x, dataset.dx, gt) :
+                     host.edge_edge(dataset.prims, dataset.x, dataset.dx, gt);
+    // conservative: every collision is found
+    for(size_t i = 0; i < gt.size(); ++i)
+        if(dataset.truth[i])
+            REQUIRE(gt[i] < 1.0);
+
+    DeviceBuffer<Vector4i> prims = dataset.prims;
+    DeviceBuffer<Vector3d> x     = dataset.x;
+    DeviceBuffer<Vector3d> dx    = dataset.dx;
+    DeviceBuffer<double>   tois(dataset.prims.size());
+
+    BatchedInclusionCCD<double> ccd;
+    double min_toi = point_triangle ? ccd.point_triangle(prims, x, dx, tois) :
+                                      ccd.edge_edge(prims, x, dx, tois);
+    std::vector<double> h_tois;
+    tois.copy_to(h_tois);
+    for(size_t i = 0; i < gt.size(); ++i)
+        if(dataset.truth[i])
+            REQUIRE(h_tois[i] < 1.0);
+    REQUIRE(min_toi == *std::min_element(h_tois.begin(), h_tois.end()));
+}
+
+TEST_CASE("inclusion_ccd_test", "[geo]")
+{
+    SECTION("point_triangle")
+    {
+        inclusion_ccd_test(true);
+    }
+    SECTION("edge_edge")
+    {
+        inclusion_ccd_test(false);
+    }
+    SECTION("min_separation")
+    {
+        // the point falls through the triangle at t = 0.5
+        Vector3f p{0.2f, 0.2f, 1.0f}, dp{0, 0, -2.0f};
+        Vector3f t0{0, 0, 0}, t1{1, 0, 0}, t2{0, 1, 0}, dt = Vector3f::Zero();
+
+        float toi = 1.0f;
+        REQUIRE(point_triangle_inclusion_ccd(p, t0, t1, t2, dp, dt, dt, dt, 0.0f, 1e-6f, -1, toi));
+        REQUIRE(toi <= 0.5f);
+        REQUIRE(toi == Approx(0.5f).margin(1e-5f));
+
+        // closer than 0.1 from t = 0.45 on
+        toi = 1.0f;
+        REQUIRE(point_triangle_inclusion_ccd(p, t0, t1, t2, dp, dt, dt, dt, 0.1f, 1e-6f, -1, toi));
+        REQUIRE(toi <= 0.45f);
+        REQUIRE(toi == Approx(0.45f).margin(1e-5f));
+
+        // passing beside the triangle
+        Vector3f q{1.0f, 1.0f, 1.0f};
+        toi = 1.0f;
+        REQUIRE(!point_triangle_inclusion_ccd(q, t0, t1, t2, dp, dt, dt, dt, 0.1f, 1e-6f, -1, toi));
+        REQUIRE(toi == 1.0f);
+    }
+}
@@ -4,7 +4,8 @@
 
 using namespace muda;
 
-#ifndef __linux__
+// device side launches need -rdc=true (MUDA_WITH_RDC)
+#if !defined(__linux__) && defined(__CUDACC_RDC__)
 __global__ void copy(int* dst, const int* src)
 {
     auto i = blockIdx.x * blockDim.x + threadIdx.x;
@@ -46,7 +47,7 @@ TEST_CASE("dynamic_parallelism", "[dynamic_parallelism]")
 #endif
 
 
-#if MUDA_COMPUTE_GRAPH_ON
+#if MUDA_COMPUTE_GRAPH_ON && defined(__CUDACC_RDC__)
 void dynamic_parallelism_graph(std::vector<int>& gt, std::vector<int>& res)
 {
     gt.resize(16);
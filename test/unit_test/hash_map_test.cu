@@ -0,0 +1,200 @@
+#include <catch2/catch.hpp>
+#include <random>
+#include <unordered_map>
+#include <muda/muda.h>
+#include <muda/container.h>
+#include <muda/ext/hash_map.h>
+
+using namespace muda;
+
+// (row, col) -> packed key, the typical sparse assembly usage
+static uint64_t pack(uint32_t row, uint32_t col)
+{
+    return (uint64_t{row} << 32) | col;
+}
+
+void hash_map_test()
+{
+    constexpr int N = 10000;
+
+    std::mt19937                            gen(42);
+    std::uniform_int_distribution<uint32_t> dist(0, 200);
+
+    // with duplicates
+    std::vector<uint64_t> h_keys(N);
+    std::vector<int>      h_values(N);
+    for(int i = 0; i < N; ++i)
+    {
+        h_keys[i]   = pack(dist(gen), dist(gen));
+        h_values[i] = i;
+    }
+
+    // ground truth: the first value wins
+    std::unordered_map<uint64_t, int> gt;
+    for(int i = 0; i < N; ++i)
+        gt.emplace(h_keys[i], h_values[i]);
+
+    // erase every third distinct key
+    std::vector<uint64_t> h_erase;
+    {
+        int i = 0;
+        for(auto& [k, v] : gt)
+            if(i++ % 3 == 0)
+                h_erase.push_back(k);
+    }
+    for(auto& k : h_erase)
+        gt.erase(k);
+
+    std::vector<uint64_t> h_query = h_keys;
+    for(int i = 0; i < 100; ++i)
+        h_query.push_back(pack(1000 + i, 0));  // never inserted
+
+    std::vector<int> gt_find(h_query.size());
+    for(size_t i = 0; i < h_query.size(); ++i)
+    {
+        auto it    = gt.find(h_query[i]);
+        gt_find[i] = it == gt.end() ? -1 : it->second;
+    }
+
+    // device, start small to force several rehashes
+    DeviceHashMap<uint64_t, int> map(16);
+    DeviceBuffer<uint64_t>       keys   = h_keys;
+    DeviceBuffer<int>            values = h_values;
+    DeviceBuffer<uint64_t>       erase  = h_erase;
+    DeviceBuffer<uint64_t>       query  = h_query;
+    DeviceBuffer<int>            result(h_query.size());
+    DeviceBuffer<int>            found(h_query.size());
+
+    // insert in two halves, the second half mostly hits existing keys
+    map.insert(keys.view(0, N / 2), values.view(0, N / 2));
+    map.insert(keys.view(N / 2), values.view(N / 2));
+    map.erase(erase);
+    map.find(query, result, -1);
+    map.contains(query, found);
+
+    std::vector<int> h_result, h_found;
+    result.copy_to(h_result);
+    found.copy_to(h_found);
+
+    // host backend
+    HostHashMap<uint64_t, int> host_map(16);
+    host_map.insert(std::vector<uint64_t>(h_keys.begin(), h_keys.begin() + N / 2),
+                    std::vector<int>(h_values.begin(), h_values.begin() + N / 2));
+    host_map.insert(std::vector<uint64_t>(h_keys.begin() + N / 2, h_keys.end()),
+                    std::vector<int>(h_values.begin() + N / 2, h_values.end()));
+    host_map.erase(h_erase);
+    std::vector<int> host_result, host_found;
+    host_map.find(h_query, host_result, -1);
+    host_map.contains(h_query, host_found);
+
+    REQUIRE(map.size() == gt.size());
+    REQUIRE(host_map.size() == gt.size());
+    REQUIRE(map.capacity() >= gt.size() / map.max_load_factor());
+
+    // the first value wins only if the whole batch is ordered, the device
+    // batch is unordered, so compare the keys and check the values are valid
+    bool device_ok = true;
+    for(size_t i = 0; i < h_query.size(); ++i)
+    {
+        bool hit = gt_find[i] >= 0;
+        device_ok &= (h_found[i] == 1) == hit;
+        device_ok &= (h_result[i] >= 0) == hit;
+        if(hit)
+            device_ok &= h_keys[h_result[i]] == h_query[i];
+    }
+    REQUIRE(device_ok);
+    REQUIRE(host_result == gt_find);
+
+    std::vector<int> gt_found(h_query.size());
+    for(size_t i = 0; i < h_query.size(); ++i)
+        gt_found[i] = gt_find[i] >= 0 ? 1 : 0;
+    REQUIRE(host_found == gt_found);
+
+    // retrieve
+    DeviceBuffer<uint64_t> out_keys;
+    DeviceBuffer<int>      out_values;
+    map.retrieve(out_keys, out_values);
+    std::vector<uint64_t> h_out_keys;
+    std::vector<int>      h_out_values;
+    out_keys.copy_to(h_out_keys);
+    out_values.copy_to(h_out_values);
+    REQUIRE(h_out_keys.size() == gt.size());
+    bool retrieve_ok = true;
+    for(size_t i = 0; i < h_out_keys.size(); ++i)
+    {
+        retrieve_ok &= gt.count(h_out_keys[i]) == 1;
+        retrieve_ok &= h_keys[h_out_values[i]] == h_out_keys[i];
+    }
+    REQUIRE(retrieve_ok);
+
+    // rehash drops tombstones and keeps the content
+    map.rehash(map.capacity() * 2);
+    map.find(query, result, -1);
+    std::vector<int> h_result_after;
+    result.copy_to(h_result_after);
+    REQUIRE(h_result_after == h_result);
+}
+
+void hash_set_test()
+{
+    constexpr int N = 4096;
+
+    std::vector<uint32_t> h_keys(N);
+    for(int i = 0; i < N; ++i)
+        h_keys[i] = (i * 7) % 1000;  // 1000 distinct keys
+
+    DeviceBuffer<uint32_t> keys = h_keys;
+
+    // in-kernel insert through the viewer, one thread per key
+    DeviceHashSet<uint32_t> set;
+    set.reserve(1000);
+    DeviceVar<int> inserted = 0;
+    ParallelFor(256)
+        .kernel_name(__FUNCTION__)
+        .apply(N,
+               [set      = set.viewer().name("set"),
+                keys     = keys.cviewer().name("keys"),
+                inserted = inserted.viewer().name("inserted")] __device__(int i) mutable
+               {
+                   if(set.insert(keys(i)))
+                       atomic_add(inserted.data(), 1);
+               });
+    int h_inserted = inserted;
+    REQUIRE(h_inserted == 1000);
+    REQUIRE(set.size() == 1000);
+
+    // bulk insert of the same keys adds nothing
+    set.insert(keys);
+    REQUIRE(set.size() == 1000);
+
+    DeviceBuffer<uint32_t> unique;
+    set.retrieve(unique);
+    std::vector<uint32_t> h_unique;
+    unique.copy_to(h_unique);
+    std::sort(h_unique.begin(), h_unique.end());
+
+    HostHashSet<uint32_t> host_set;
+    host_set.insert(h_keys);
+    std::vector<uint32_t> host_unique;
+    host_set.retrieve(host_unique);
+    std::sort(host_unique.begin(), host_unique.end());
+
+    std::vector<uint32_t> gt(1000);
+    for(int i = 0; i < 1000; ++i)
+        gt[i] = i;
+    REQUIRE(h_unique == gt);
+    REQUIRE(host_unique == gt);
+
+    set.clear();
+    REQUIRE(set.size() == 0);
+}
+
+TEST_CASE("hash_map_test", "[hash_map]")
+{
+    hash_map_test();
+}
+
+TEST_CASE("hash_set_test", "[hash_map]")
+{
+    hash_set_test();
+}
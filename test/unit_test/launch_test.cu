@@ -60,4 +60,405 @@ void launch_test()
 TEST_CASE("launch_test", "[launch]")
 {
     launch_test();
-}
\ No newline at end of file
+}
+
+void parallel_for_reduce_scan_test(int n)
+{
+    std::vector<int> h_x(n);
+    for(int i = 0; i < n; ++i)
+        h_x[i] = (i * 7919) % 1001 - 500;
+    DeviceBuffer<int> x = h_x;
+
+    auto plus    = [] __host__ __device__(int a, int b) { return a + b; };
+    auto maximum = [] __host__ __device__(int a, int b) { return a > b ? a : b; };
+
+    // map-reduce: sum of squares (mod 97) and max of |x|
+    DeviceVar<int> sum, max_abs;
+    ParallelFor()
+        .reduce(n, 3, plus, [x = x.cviewer()] __device__(int i) { return x(i) * x(i) % 97; }, sum.view())
+        .reduce(n,
+                0,
+                maximum,
+                [x = x.cviewer()] __device__(int i) { return x(i) < 0 ? -x(i) : x(i); },
+                max_abs.view())
+        .wait();
+
+    int gt_sum = 3, gt_max = 0;
+    for(auto v : h_x)
+    {
+        gt_sum += v * v % 97;
+        gt_max = std::max(gt_max, std::abs(v));
+    }
+    REQUIRE(int(sum) == gt_sum);
+    REQUIRE(int(max_abs) == gt_max);
+
+    // host backend
+    int h_sum = 0;
+    ParallelFor()
+        .backend(ParallelForBackend::Host)
+        .reduce(n,
+                3,
+                plus,
+                [x = h_x.data()] __host__ __device__(int i) { return x[i] * x[i] % 97; },
+                VarView<int>{&h_sum});
+    REQUIRE(h_sum == gt_sum);
+
+    // map-scan: inclusive prefix sum and running max
+    DeviceBuffer<int> prefix(n), running_max(n);
+    ParallelFor()
+        .scan(n, [x = x.cviewer()] __device__(int i) { return x(i) % 3; }, prefix.view())
+        .scan(n, maximum, [x = x.cviewer()] __device__(int i) { return x(i); }, running_max.view())
+        .wait();
+
+    std::vector<int> gt_prefix(n), gt_running_max(n);
+    for(int i = 0, acc = 0, m = 0; i < n; ++i)
+    {
+        acc += h_x[i] % 3;
+        m                 = i == 0 ? h_x[i] : std::max(m, h_x[i]);
+        gt_prefix[i]      = acc;
+        gt_running_max[i] = m;
+    }
+
+    std::vector<int> h_res;
+    prefix.copy_to(h_res);
+    REQUIRE(h_res == gt_prefix);
+    running_max.copy_to(h_res);
+    REQUIRE(h_res == gt_running_max);
+
+    // host backend
+    std::vector<int> h_prefix(n);
+    ParallelFor()
+        .backend(ParallelForBackend::Host)
+        .scan(n,
+              [x = h_x.data()] __host__ __device__(int i) { return x[i] % 3; },
+              BufferView<int>{h_prefix.data(), h_prefix.size()});
+    REQUIRE(h_prefix == gt_prefix);
+}
+
+TEST_CASE("parallel_for_reduce_scan", "[launch]")
+{
+    for(int n : {0, 1, 31, 1000, 12345, (1 << 20) + 7})
+        parallel_for_reduce_scan_test(n);
+}
+
+void parallel_for_segmented_test(int segment_count)
+{
+    // skewed sizes: most segments are tiny or empty, a few are huge
+    std::vector<int> h_offsets(segment_count + 1, 0);
+    for(int s = 0; s < segment_count; ++s)
+    {
+        int size         = s % 97 == 0 ? 1000 + s : s % 3;
+        h_offsets[s + 1] = h_offsets[s] + size;
+    }
+    int total = h_offsets.back();
+
+    DeviceBuffer<int> offsets = h_offsets;
+    DeviceBuffer<int> segment_of(total), local_of(total);
+    segment_of.fill(-1);
+
+    ParallelFor()
+        .apply_segmented(offsets.view(),
+                         [segment_of = segment_of.viewer(), local_of = local_of.viewer()] __device__(
+                             int segment, int local_i, int i) mutable
+                         {
+                             segment_of(i) = segment;
+                             local_of(i)   = local_i;
+                         })
+        .wait();
+
+    std::vector<int> gt_segment(total), gt_local(total);
+    for(int s = 0; s < segment_count; ++s)
+        for(int i = h_offsets[s]; i < h_offsets[s + 1]; ++i)
+        {
+            gt_segment[i] = s;
+            gt_local[i]   = i - h_offsets[s];
+        }
+
+    std::vector<int> h_res;
+    segment_of.copy_to(h_res);
+    REQUIRE(h_res == gt_segment);
+    local_of.copy_to(h_res);
+    REQUIRE(h_res == gt_local);
+
+    // count per segment with the 2-arg form and a known total
+    DeviceBuffer<int> counts(segment_count);
+    counts.fill(0);
+    ParallelFor()
+        .apply_segmented(offsets.view(),
+                         total,
+                         [counts = counts.viewer()] __device__(int segment, int local_i) mutable
+                         { atomicAdd(&counts(segment), 1); })
+        .wait();
+
+    std::vector<int> gt_counts(segment_count);
+    for(int s = 0; s < segment_count; ++s)
+        gt_counts[s] = h_offsets[s + 1] - h_offsets[s];
+    counts.copy_to(h_res);
+    REQUIRE(h_res == gt_counts);
+
+    // a subview of the offsets, the first offset is not 0
+    if(segment_count < 4)
+        return;
+    int first = 1, count = segment_count - 2;
+    segment_of.fill(-1);
+    local_of.fill(-1);
+    ParallelFor()
+        .apply_segmented(offsets.view(first, count + 1),
+                         [segment_of = segment_of.viewer(), local_of = local_of.viewer()] __device__(
+                             int segment, int local_i, int i) mutable
+                         {
+                             segment_of(i) = segment;
+                             local_of(i)   = local_i;
+                         })
+        .wait();
+
+    std::fill(gt_segment.begin(), gt_segment.end(), -1);
+    std::fill(gt_local.begin(), gt_local.end(), -1);
+    for(int s = 0; s < count; ++s)
+        for(int i = h_offsets[first + s]; i < h_offsets[first + s + 1]; ++i)
+        {
+            gt_segment[i] = s;
+            gt_local[i]   = i - h_offsets[first + s];
+        }
+    segment_of.copy_to(h_res);
+    REQUIRE(h_res == gt_segment);
+    local_of.copy_to(h_res);
+    REQUIRE(h_res == gt_local);
+}
+
+TEST_CASE("parallel_for_segmented", "[launch]")
+{
+    for(int segment_count : {0, 1, 7, 1000, 100000})
+        parallel_for_segmented_test(segment_count);
+}
+
+void persistent_launch_test(int n, int substeps)
+{
+    // x += 1 | y += x reversed (needs every x of the substep) | z(i) = i on a sub range
+    std::vector<int> gt_x(n, substeps), gt_y(n, substeps * (substeps + 1) / 2), gt_z(n, 0);
+    for(int i = std::min(3, n); i < std::min(10, n); ++i)
+        gt_z[i] = i;
+
+    auto fill = [&](auto& queue)
+    {
+        for(int s = 0; s < substeps; ++s)
+        {
+            queue.push(0, n);
+            if(s == 0)
+                queue.push(2, std::min(3, n), std::min(10, n));
+            queue.barrier().push(1, n).barrier().barrier();
+        }
+    };
+
+    // host emulation
+    {
+        std::vector<int> x(n, 0), y(n, 0), z(n, 0);
+        PersistentQueue  queue{[x = x.data()] __host__ __device__(int i) { x[i] += 1; },
+                              [x = x.data(), y = y.data(), n] __host__ __device__(int i)
+                              { y[i] += x[n - 1 - i]; },
+                              [z = z.data()] __host__ __device__(int i) { z[i] = i; }};
+        fill(queue);
+        if(n > 0)
+            REQUIRE(queue.stage_count() == 2 * substeps);
+
+        PersistentLaunch(4, 32).backend(ParallelForBackend::Host).apply(queue);
+        REQUIRE(x == gt_x);
+        REQUIRE(y == gt_y);
+        REQUIRE(z == gt_z);
+    }
+
+    // device
+    {
+        DeviceBuffer<int> x(n), y(n), z(n);
+        x.fill(0);
+        y.fill(0);
+        z.fill(0);
+        PersistentQueue queue{[x = x.viewer()] __device__(int i) mutable { x(i) += 1; },
+                              [x = x.cviewer(), y = y.viewer(), n] __device__(int i) mutable
+                              { y(i) += x(n - 1 - i); },
+                              [z = z.viewer()] __device__(int i) mutable { z(i) = i; }};
+        fill(queue);
+        PersistentLaunch().apply(queue).wait();
+
+        std::vector<int> h_res;
+        x.copy_to(h_res);
+        REQUIRE(h_res == gt_x);
+        y.copy_to(h_res);
+        REQUIRE(h_res == gt_y);
+        z.copy_to(h_res);
+        REQUIRE(h_res == gt_z);
+
+        // refill, the device batch is reused
+        queue.clear();
+        queue.push(0, n);
+        PersistentLaunch().apply(queue).wait();
+        x.copy_to(h_res);
+        REQUIRE(std::all_of(h_res.begin(), h_res.end(), [&](int v) { return v == substeps + 1; }));
+    }
+}
+
+TEST_CASE("persistent_launch", "[launch]")
+{
+    persistent_launch_test(0, 3);
+    persistent_launch_test(100, 1);
+    persistent_launch_test(1000, 10);
+    persistent_launch_test(100000, 4);
+}
+
+void spawn_launch_test(int depth, int max_waves)
+{
+    // a full binary tree, every node spawns its two children
+    std::vector<int> gt(depth);
+    for(int d = 0; d < depth; ++d)
+        gt[d] = 1 << d;
+
+    DeviceBuffer<int> visits(depth);
+    visits.fill(0);
+
+    auto expand = [visits = visits.viewer(), depth] __device__(const int2& node,
+                                                               Spawner<int2>& spawner) mutable
+    {
+        atomicAdd(&visits(node.x), 1);
+        if(node.x + 1 < depth)
+        {
+            spawner.spawn(make_int2(node.x + 1, 2 * node.y));
+            spawner.spawn(make_int2(node.x + 1, 2 * node.y + 1));
+        }
+    };
+
+    SpawnQueue<int2> queue(1 << depth);
+    queue.push({make_int2(0, 0)});
+
+    // stop every `max_waves` waves, the next launch continues with the waiting items
+    int launches = 0;
+    while(queue.size() > 0)
+    {
+        SpawnLaunch().apply(queue, expand, max_waves).wait();
+        ++launches;
+    }
+    REQUIRE(!queue.overflowed());
+    REQUIRE(launches == (max_waves >= depth ? 1 : (depth + max_waves - 1) / max_waves));
+
+    std::vector<int> res;
+    visits.copy_to(res);
+    REQUIRE(res == gt);
+
+    // a queue too small for the last level drops spawns and reports it
+    visits.fill(0);
+    SpawnQueue<int2> small(1 << (depth - 2));
+    small.push({make_int2(0, 0)});
+    SpawnLaunch().apply(small, expand).wait();
+    REQUIRE(small.overflowed());
+    small.clear();
+    REQUIRE(small.size() == 0);
+    REQUIRE(!small.overflowed());
+}
+
+TEST_CASE("spawn_launch", "[launch]")
+{
+    spawn_launch_test(4, INT_MAX);
+    spawn_launch_test(12, INT_MAX);
+    spawn_launch_test(12, 5);
+    spawn_launch_test(16, 1);
+}
+
+void streaming_for_test(int64_t count, int chunk_size, int halo)
+{
+    // a (2 * halo + 1) wide box sum, clamped at the array ends
+    std::vector<float> in(count), gt(count);
+    for(int64_t i = 0; i < count; ++i)
+        in[i] = static_cast<float>(i % 17);
+    for(int64_t i = 0; i < count; ++i)
+    {
+        float sum = 0;
+        for(int64_t j = std::max<int64_t>(i - halo, 0); j <= std::min<int64_t>(i + halo, count - 1); ++j)
+            sum += in[j];
+        gt[i] = sum;
+    }
+
+    auto box = [count, halo] __host__ __device__(int64_t i, const CChunkViewer<float>& in, ChunkViewer<float>& out)
+    {
+        float sum = 0;
+        for(int64_t j = i - halo; j <= i + halo; ++j)
+            if(j >= 0 && j < count)
+                sum += in(j);
+        out(i) = sum;
+    };
+
+    StreamingFor streaming(chunk_size, halo);
+    REQUIRE(streaming.chunk_count(count) == (count + chunk_size - 1) / chunk_size);
+
+    // host backend, same chunk schedule
+    {
+        std::vector<float> res(count, -1.0f);
+        streaming.backend(ParallelForBackend::Host).apply(in.data(), count, res.data(), box);
+        REQUIRE(res == gt);
+    }
+
+    streaming.backend(ParallelForBackend::Device);
+
+    // pageable host memory, staged
+    {
+        std::vector<float> res(count, -1.0f);
+        streaming.apply(in.data(), count, res.data(), box);
+        REQUIRE(res == gt);
+    }
+
+    // pinned host memory, copied directly
+    if(count > 0)
+    {
+        float *pinned_in, *pinned_out;
+        checkCudaErrors(cudaMallocHost(&pinned_in, sizeof(float) * count));
+        checkCudaErrors(cudaMallocHost(&pinned_out, sizeof(float) * count));
+        std::copy(in.begin(), in.end(), pinned_in);
+        streaming.apply(pinned_in, count, pinned_out, box);
+        REQUIRE(std::equal(gt.begin(), gt.end(), pinned_out));
+        checkCudaErrors(cudaFreeHost(pinned_in));
+        checkCudaErrors(cudaFreeHost(pinned_out));
+    }
+
+    // read only, every element is visited once
+    {
+        DeviceBuffer<int> visits(count);
+        visits.fill(0);
+        streaming.apply(in.data(),
+                        count,
+                        [visits = visits.viewer()] __device__(int64_t i, const CChunkViewer<float>& in) mutable
+                        { atomicAdd(&visits(static_cast<int>(i)), 1); });
+        std::vector<int> res;
+        visits.copy_to(res);
+        REQUIRE(std::all_of(res.begin(), res.end(), [](int v) { return v == 1; }));
+    }
+}
+
+TEST_CASE("streaming_for", "[launch]")
+{
+    streaming_for_test(0, 16, 0);
+    streaming_for_test(10, 16, 2);
+    streaming_for_test(100, 7, 0);
+    streaming_for_test(1000, 64, 3);
+    // halo wider than a chunk
+    streaming_for_test(1000, 5, 9);
+    streaming_for_test(1 << 20, 100000, 1);
+}
+
+// this file is a separate device module without -rdc, the names registered
+// here must resolve as well as in named_viewer_test.cu
+void kernel_name_test()
+{
+    DeviceVar<int> first_char = 0;
+    ParallelFor(1)
+        .kernel_name("module_kernel")
+        .apply(1,
+               [c = first_char.viewer()] __device__(int i) mutable
+               { *c = c.kernel_name()[0]; })
+        .wait();
+
+    int h_first = first_char;
+    REQUIRE(h_first == (CHECK_INFO_ON ? 'm' : '~'));
+}
+
+TEST_CASE("kernel_name_test", "[launch]")
+{
+    kernel_name_test();
+}
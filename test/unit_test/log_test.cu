@@ -1,4 +1,5 @@
 #include <catch2/catch.hpp>
+#include <sstream>
 #include <muda/muda.h>
 using namespace muda;
 
@@ -31,3 +32,59 @@ TEST_CASE("log_test", "[log]")
 {
     log_test();
 }
+
+size_t log_filter_count(Logger& logger, std::string_view kernel_name, int n)
+{
+    ParallelFor(64)
+        .kernel_name(kernel_name)
+        .apply(n,
+               [log = logger.viewer(kernel_name)] __device__(int i) mutable
+               {
+                   MUDA_LOG(log, Debug) << i;
+                   MUDA_LOG(log, Error) << -i;
+               })
+        .wait();
+    return logger.retrieve_meta().meta_data().size();
+}
+
+void log_filter_test()
+{
+    // log sites are compile time constants, one per line
+    constexpr uint32_t site_a = MUDA_LOG_SITE();
+    constexpr uint32_t site_b = MUDA_LOG_SITE();
+    static_assert(site_a != site_b);
+
+    Logger logger;
+
+    // everything
+    REQUIRE(log_filter_count(logger, "all", 100) == 200);
+
+    // level threshold
+    logger.filter(LoggerFilter{LogLevel::Warn});
+    REQUIRE(log_filter_count(logger, "warn", 100) == 100);
+
+    // per kernel: every 10th hit of each site, at most 3 per site
+    logger.filter("sampled", LoggerFilter{LogLevel::Trace, 10, 3});
+    REQUIRE(log_filter_count(logger, "sampled", 1000) == 6);
+    // the caps restart after retrieve
+    REQUIRE(log_filter_count(logger, "sampled", 1000) == 6);
+    REQUIRE(log_filter_count(logger, "other", 100) == 100);
+
+    // reload at runtime
+    std::istringstream config{R"(
+        # kernel_name level [every=N] [first=K]
+        *       off
+        sampled debug first=7
+    )"};
+    logger.load_filters(config);
+    REQUIRE(log_filter_count(logger, "other", 100) == 0);
+    REQUIRE(log_filter_count(logger, "sampled", 100) == 14);
+
+    std::istringstream bad{"k verbose"};
+    REQUIRE_THROWS_AS(logger.load_filters(bad), invalid_argument);
+}
+
+TEST_CASE("log_filter_test", "[log]")
+{
+    log_filter_test();
+}
@@ -1,4 +1,5 @@
 #include <catch2/catch.hpp>
+#include <thread>
 #include <muda/muda.h>
 #include <muda/container.h>
 
@@ -9,3 +10,155 @@ TEST_CASE("named_viewer_test", "[viewer]")
     auto v = Dense1D<float>(nullptr, 1);
     REQUIRE(v.name() == std::string("~"));
 }
+
+void interned_name_test()
+{
+    constexpr auto viewer_name = "interned_viewer"_name;
+    static_assert(viewer_name.id() == details::interned_name_id("interned_viewer"));
+    static_assert(""_name.empty());
+
+    DeviceVar<int> first_char = 0;
+    DeviceVar<int> length     = 0;
+
+    ParallelFor(1)
+        .kernel_name("interned_kernel"_name)
+        .apply(1,
+               [v = first_char.viewer().name(viewer_name),
+                l = length.viewer().name("runtime_name")] __device__(int i) mutable
+               {
+                   // resolve the names on device, as an error report would do
+                   auto k = v.kernel_name();
+                   *v     = k[0];
+                   int n  = 0;
+                   for(auto c = l.name(); *c != '\0'; ++c)
+                       ++n;
+                   *l = n;
+               })
+        .wait();
+
+    auto h_v      = Dense1D<float>(nullptr, 1).name(viewer_name);
+    int  h_first  = first_char;
+    int  h_length = length;
+
+    if constexpr(CHECK_INFO_ON)
+    {
+        REQUIRE(h_v.name() == std::string("interned_viewer"));
+        REQUIRE(h_first == 'i');
+        REQUIRE(h_length == static_cast<int>(std::string_view{"runtime_name"}.size()));
+    }
+    else
+    {
+        REQUIRE(h_v.name() == std::string("~"));
+        REQUIRE(h_first == '~');
+        REQUIRE(h_length == 1);
+    }
+}
+
+TEST_CASE("interned_name_test", "[viewer]")
+{
+    interned_name_test();
+}
+
+// no muda launcher involved, the name must still resolve on device
+template <typename Viewer>
+__global__ void raw_name_length_kernel(Viewer v)
+{
+    int n = 0;
+    for(auto c = v.name(); *c != '\0'; ++c)
+        ++n;
+    *v = n;
+}
+
+void raw_kernel_name_test()
+{
+    DeviceVar<int> length = 0;
+    raw_name_length_kernel<<<1, 1>>>(length.viewer().name("raw_kernel_viewer"));
+    wait_device();
+
+    int h_length = length;
+    if constexpr(CHECK_INFO_ON)
+        REQUIRE(h_length == static_cast<int>(std::string_view{"raw_kernel_viewer"}.size()));
+    else
+        REQUIRE(h_length == 1);
+}
+
+TEST_CASE("raw_kernel_name_test", "[viewer]")
+{
+    raw_kernel_name_test();
+}
+
+struct SuspectTag
+{
+};
+
+// what `checked()` should say for a viewer captured by a listed kernel
+constexpr bool expect_checked(bool listed)
+{
+    return RUNTIME_CHECK_ON || (SELECTIVE_CHECK_ON && listed);
+}
+
+void runtime_check_test()
+{
+    RuntimeCheck::clear();
+    RuntimeCheck::enable("suspect");
+    RuntimeCheck::enable<SuspectTag>();
+    RuntimeCheck::enable_list(" a, b ,,c");
+
+    REQUIRE(RuntimeCheck::is_enabled("suspect") == expect_checked(true));
+    REQUIRE(RuntimeCheck::is_enabled<SuspectTag>() == expect_checked(true));
+    REQUIRE(RuntimeCheck::is_enabled("b") == expect_checked(true));
+    REQUIRE(RuntimeCheck::is_enabled("other") == expect_checked(false));
+
+    DeviceBuffer<int> buffer(4);
+    {
+        KernelLabel label{"suspect"};
+        REQUIRE(buffer.viewer().checked() == expect_checked(true));
+    }
+    {
+        KernelLabel label{"other"};
+        REQUIRE(buffer.viewer().checked() == expect_checked(false));
+    }
+    // unnamed kernels are never on the list
+    REQUIRE(buffer.viewer().checked() == expect_checked(false));
+
+    // the flag is carried to the device, also by subviews
+    DeviceVar<int> flag = -1;
+    ParallelFor(1)
+        .kernel_name(Tag<SuspectTag>{})
+        .apply(1,
+               [b = buffer.viewer(), flag = flag.viewer()] __device__(int i) mutable
+               { *flag = b.subview(1).checked(); })
+        .wait();
+    int h_flag = flag;
+    REQUIRE(h_flag == int(expect_checked(true)));
+
+    // a viewer created before kernel_name() keeps the kernel name of that time
+    auto early = buffer.viewer();
+    ParallelFor(1)
+        .kernel_name(Tag<SuspectTag>{})
+        .apply(1,
+               [early, flag = flag.viewer()] __device__(int i) mutable
+               { *flag = early.checked(); })
+        .wait();
+    h_flag = flag;
+    REQUIRE(h_flag == int(expect_checked(false)));
+
+    RuntimeCheck::disable("suspect");
+    {
+        KernelLabel label{"suspect"};
+        REQUIRE(buffer.viewer().checked() == expect_checked(false));
+    }
+
+    // other threads see the changes of the list
+    bool enabled = false;
+    std::thread{[&] { enabled = RuntimeCheck::is_enabled("b"); }}.join();
+    REQUIRE(enabled == expect_checked(true));
+
+    RuntimeCheck::clear();
+    REQUIRE(RuntimeCheck::is_enabled("b") == expect_checked(false));
+}
+
+TEST_CASE("runtime_check_test", "[viewer]")
+{
+    runtime_check_test();
+}
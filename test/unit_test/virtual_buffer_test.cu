@@ -0,0 +1,172 @@
+#include <catch2/catch.hpp>
+#include <cstring>
+#include <numeric>
+#include <muda/muda.h>
+#include <muda/buffer.h>
+using namespace muda;
+
+TEST_CASE("virtual_reservation", "[buffer]")
+{
+    constexpr size_t G = 4096;
+
+    SECTION("round_up")
+    {
+        REQUIRE(VirtualReservation::round_up(0, G) == 0);
+        REQUIRE(VirtualReservation::round_up(1, G) == G);
+        REQUIRE(VirtualReservation::round_up(G, G) == G);
+        REQUIRE(VirtualReservation::round_up(G + 1, G) == 2 * G);
+        REQUIRE(VirtualReservation::round_up(123, 0) == 123);
+    }
+
+    SECTION("commit")
+    {
+        VirtualReservation r{10 * G + 1, G};
+        REQUIRE(r.reserved() == 11 * G);
+        REQUIRE(r.committed() == 0);
+
+        auto c = r.plan_commit(1);
+        REQUIRE(c.offset == 0);
+        REQUIRE(c.bytes == G);
+        r.record_commit(c);
+        REQUIRE(r.committed() == G);
+
+        // already committed, nothing to do
+        REQUIRE(r.plan_commit(G).bytes == 0);
+
+        c = r.plan_commit(3 * G - 5);
+        REQUIRE(c.offset == G);
+        REQUIRE(c.bytes == 2 * G);
+        r.record_commit(c);
+        REQUIRE(r.committed() == 3 * G);
+        REQUIRE(r.chunks().size() == 2);
+
+        // beyond the reservation
+        REQUIRE_THROWS_AS(r.plan_commit(11 * G + 1), out_of_range);
+        REQUIRE(r.committed() == 3 * G);
+    }
+
+    SECTION("growth")
+    {
+        VirtualReservation r{16 * G, G};
+        r.record_commit(r.plan_commit(2 * G));
+
+        // geometric: 2G * 2 = 4G
+        auto c = r.plan_commit(2 * G + 1, BufferGrowthPolicy::geometric(2.0));
+        REQUIRE(c.offset == 2 * G);
+        REQUIRE(c.bytes == 2 * G);
+        r.record_commit(c);
+
+        // page rounded to 3G, then to the granularity
+        c = r.plan_commit(5 * G, BufferGrowthPolicy::page_rounded(3 * G));
+        REQUIRE(c.offset + c.bytes == 6 * G);
+        r.record_commit(c);
+
+        // growth is clamped to the reservation
+        c = r.plan_commit(7 * G, BufferGrowthPolicy::geometric(10.0));
+        REQUIRE(c.offset + c.bytes == 16 * G);
+    }
+
+    SECTION("decommit")
+    {
+        VirtualReservation r{8 * G, G};
+        r.record_commit(r.plan_commit(G));      // [0, G)
+        r.record_commit(r.plan_commit(3 * G));  // [G, 3G)
+        r.record_commit(r.plan_commit(6 * G));  // [3G, 6G)
+
+        // the last chunk overlaps the kept bytes
+        REQUIRE(r.plan_decommit(3 * G + 1) == nullptr);
+
+        auto c = r.plan_decommit(2 * G);
+        REQUIRE(c);
+        REQUIRE(c->offset == 3 * G);
+        r.record_decommit();
+        REQUIRE(r.committed() == 3 * G);
+
+        // [G, 3G) is still needed by the first 2G bytes
+        REQUIRE(r.plan_decommit(2 * G) == nullptr);
+
+        while(r.plan_decommit(0))
+            r.record_decommit();
+        REQUIRE(r.committed() == 0);
+        REQUIRE(r.chunks().empty());
+    }
+}
+
+TEST_CASE("virtual_memory_host", "[buffer]")
+{
+    VirtualMemory memory(size_t{1} << 32, VirtualMemoryBackend::Host);
+    auto          base = memory.data();
+    REQUIRE(base != nullptr);
+    REQUIRE(memory.committed_bytes() == 0);
+
+    memory.commit(100);
+    REQUIRE(memory.committed_bytes() == memory.granularity());
+    std::memset(memory.data(), 1, 100);
+
+    memory.commit(10 * memory.granularity() + 1);
+    REQUIRE(memory.data() == base);
+    std::memset(memory.data() + 100, 2, memory.committed_bytes() - 100);
+    REQUIRE(static_cast<int>(memory.data()[99]) == 1);
+    REQUIRE(static_cast<int>(memory.data()[100]) == 2);
+
+    memory.decommit(100);
+    REQUIRE(memory.committed_bytes() == memory.granularity());
+    REQUIRE(static_cast<int>(memory.data()[99]) == 1);
+
+    VirtualMemory moved = std::move(memory);
+    REQUIRE(memory.data() == nullptr);
+    REQUIRE(moved.data() == base);
+    moved.release();
+    REQUIRE(moved.data() == nullptr);
+}
+
+template <VirtualMemoryBackend Backend>
+void virtual_buffer_test()
+{
+    VirtualBuffer<int> buffer(size_t{1} << 28, Backend);
+    REQUIRE(buffer.max_size() >= (size_t{1} << 28));
+
+    buffer.resize(1000, 1);
+    auto data = buffer.data();
+
+    std::vector<int> gt(1000, 1);
+    std::vector<int> chunk(12345);
+    std::iota(chunk.begin(), chunk.end(), 0);
+    for(int i = 0; i < 50; ++i)
+    {
+        buffer.append(chunk);
+        gt.insert(gt.end(), chunk.begin(), chunk.end());
+    }
+    // growth never moves the data
+    REQUIRE(buffer.data() == data);
+
+    std::vector<int> h_res;
+    buffer.copy_to(h_res);
+    REQUIRE(h_res == gt);
+
+    buffer.resize(gt.size() + 5000, 7);
+    REQUIRE(buffer.data() == data);
+    buffer.copy_to(h_res);
+    REQUIRE(std::equal(gt.begin(), gt.end(), h_res.begin()));
+    REQUIRE(std::count(h_res.begin() + gt.size(), h_res.end(), 7) == 5000);
+
+    buffer.resize(10);
+    buffer.shrink_to_fit();
+    REQUIRE(buffer.capacity() < gt.size());
+    buffer.copy_to(h_res);
+    REQUIRE(h_res == std::vector<int>(10, 1));
+
+    REQUIRE_THROWS_AS(buffer.resize(buffer.max_size() + 1), out_of_range);
+}
+
+TEST_CASE("virtual_buffer", "[buffer]")
+{
+    SECTION("host")
+    {
+        virtual_buffer_test<VirtualMemoryBackend::Host>();
+    }
+    SECTION("device")
+    {
+        virtual_buffer_test<VirtualMemoryBackend::Device>();
+    }
+}
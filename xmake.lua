@@ -22,16 +22,22 @@ target("muda")
     else
         add_defines("MUDA_CHECK_ON=0", {public = true})
     end
+    if(has_config("with_selective_check")) then
+        add_defines("MUDA_SELECTIVE_CHECK_ON=1", {public = true})
+    end
     if(has_config("with_compute_graph")) then
         add_defines("MUDA_COMPUTE_GRAPH_ON=1", {public = true})
     else
         add_defines("MUDA_COMPUTE_GRAPH_ON=0", {public = true})
     end 
     add_packages("cuda", {public = true})
+    add_syslinks("cuda", {public = true}) -- driver api, for VirtualMemory
     -- add_packages("eigen", {public = true})
     add_cuflags("--extended-lambda", {public = true}) -- must be set for muda
     add_cuflags("--expt-relaxed-constexpr", {public = true}) -- must be set for muda
-    add_cuflags("-rdc=true", {public = true})
+    if(has_config("with_rdc")) then
+        add_cuflags("-rdc=true", {public = true})
+    end
 target_end()
 
 
@@ -50,6 +56,13 @@ if has_config("test") then
         muda_app_base("cui")
         add_files("test/eigen_test/**.cu","test/eigen_test/**.cpp")
     target_end()
+
+    target("muda_benchmark")
+        muda_app_base("cui")
+        local test_data_dir = path.absolute("test/data")
+        add_defines("MUDA_TEST_DATA_DIR=R\"(".. test_data_dir..")\"")
+        add_files("test/benchmark/**.cu","test/benchmark/**.cpp")
+    target_end()
 end
 
 if has_config("example") then
@@ -55,6 +55,20 @@ option("with_check")
     set_category("root menu/config")
 option_end()
 
+option("with_selective_check")
+    set_default(false)
+    set_showmenu(true)
+    set_description("compile muda runtime check in, but only enable it for the kernels on the RuntimeCheck allowlist.")
+    set_category("root menu/config")
+option_end()
+
+option("with_rdc")
+    set_default(true)
+    set_showmenu(true)
+    set_description("compile with relocatable device code (-rdc=true), needed by device side kernel/graph launches only, runtime check info works without it.")
+    set_category("root menu/config")
+option_end()
+
 option("with_compute_graph")
     set_default(false)
     set_showmenu(true)